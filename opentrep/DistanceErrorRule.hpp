@@ -151,6 +151,11 @@ namespace OPENTREP {
       }
     }
 
+    /**
+     * Destructor. 
+     */
+    virtual ~DistanceErrorRule() {}
+
   private:
     /**
      * Default Constructor. 
@@ -161,11 +166,6 @@ namespace OPENTREP {
      * Default copy constructor. 
      */
     DistanceErrorRule (const DistanceErrorRule&);
-    
-    /**
-     * Destructor. 
-     */
-    virtual ~DistanceErrorRule() {}
 
     
   private:
@@ -12,6 +12,9 @@
 #include <opentrep/DBType.hpp>
 #include <opentrep/LocationList.hpp>
 #include <opentrep/DistanceErrorRule.hpp>
+#include <opentrep/SearchStatistics.hpp>
+#include <opentrep/SearchExplanation.hpp>
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
 
 namespace OPENTREP {
 
@@ -21,6 +24,29 @@ namespace OPENTREP {
 
   /** 
    * @brief Interface for the OPENTREP Services.
+   *
+   * \note Thread-safety. Once the service has been initialised, a single
+   *       service instance may be used concurrently by several threads
+   *       for the search-related methods, namely interpretTravelRequest(),
+   *       getIndexSize() and drawRandomLocations():
+   *       <ul>
+   *         <li>every thread gets its own clone of the Unicode
+   *             transliterator and its own Xapian database handle,</li>
+   *         <li>the BOM objects instantiated while interpreting a query
+   *             are owned by a memory scope dedicated to that query
+   *             (see FacQueryScope),</li>
+   *         <li>the connections to the SQL database are borrowed from
+   *             a pool, opened only once,</li>
+   *         <li>the query slices are searched for on a pool of threads
+   *             shared by all the queries, each search leasing its own
+   *             Xapian database handle (see setNbOfSearchThreads()),</li>
+   *         <li>the log entries of the different threads are not
+   *             interleaved.</li>
+   *       </ul>
+   *       The other methods (e.g., buildSearchIndex(), the SQL database
+   *       management methods and the setters) alter the shared resources
+   *       of the service: they must not be called while searches are
+   *       running within other threads.
    */
   class OPENTREP_Service {
   public:
@@ -67,6 +93,28 @@ namespace OPENTREP {
     NbOfMatches_T interpretTravelRequest (const std::string& iTravelQuery,
                                           LocationList_T&, WordList_T&);
 
+    /**
+     * Match the given string, as above, and trace the search: slices,
+     * string partitions evaluated, full-text matches of the word
+     * combinations (with their spelling corrections and the scores of
+     * their documents), and chosen string partitions.
+     *
+     * The results are never taken from the cache, so that the whole
+     * search be traced. Without that explain mode (i.e., with the above
+     * method), nothing is traced.
+     *
+     * @param const std::string& (Travel-related) query string.
+     * @param LocationList_T& List of (geographical) locations, if any,
+     *        matching the given query string.
+     * @param WordList_T& List of non-matched words of the query string.
+     * @param SearchExplanation& Trace of the search (see
+     *        SearchExplanation::toJSONString() to export it in JSON).
+     * @return NbOfMatches_T Number of matches.
+     */
+    NbOfMatches_T interpretTravelRequest (const std::string& iTravelQuery,
+                                          LocationList_T&, WordList_T&,
+                                          SearchExplanation&);
+
 
     /**
      * Get the file-paths of the Xapian database/index and of the ORI-maintained
@@ -110,6 +158,161 @@ namespace OPENTREP {
      */
     void setSQLDBConnectString (const SQLDBConnectionString_T&);
 
+    /**
+     * Update the number of connections of the pool of SQL database
+     * connections. That number bounds the number of connections opened
+     * on the SQL database by the service.
+     *
+     * The pool is (re-)opened with that number of connections when the SQL
+     * database is next looked up.
+     *
+     * @param const NbOfDBConnections_T& Number of connections of the pool.
+     */
+    void setSQLDBConnectionPoolSize (const NbOfDBConnections_T&);
+
+    /**
+     * Set whether the travel queries should be interpreted by going
+     * through all the partitions of their slices (exhaustive search).
+     *
+     * By default, the best partition of every query slice is found by
+     * dynamic programming, each distinct word combination being searched
+     * for only once in the Xapian index. The exhaustive search, the cost
+     * of which is exponential in the number of words, is kept in order
+     * to compare the results of both strategies.
+     *
+     * @param const ExhaustiveSearch_T& Whether to search exhaustively.
+     */
+    void setExhaustiveSearch (const ExhaustiveSearch_T&);
+
+    /**
+     * Set whether the expired POR (points of reference), i.e., the POR
+     * having a non-null envelope ID, should be filtered out of the results
+     * of the travel queries.
+     *
+     * By default, the expired POR are matched, but their weight is
+     * decreased. When they are filtered out, that is done by Xapian,
+     * within the matcher, so that they do not take any room within the
+     * matching sets.
+     *
+     * @param const ExpiredPORFiltering_T& Whether to filter out the
+     *        expired POR.
+     */
+    void setExpiredPORFiltering (const ExpiredPORFiltering_T&);
+
+    /**
+     * Set the date ("as of date") at which the POR (points of reference)
+     * of the results of the travel queries must be valid. The POR, the
+     * validity period of which (from date_from to date_until) does not
+     * contain that date, are filtered out by Xapian, within the matcher.
+     * That allows to look up the POR as they were at some point in
+     * the past (in which case the expired POR should not be filtered out;
+     * see setExpiredPORFiltering()).
+     *
+     * When the date is not a date (e.g., Date_T()), which is the default,
+     * the POR are not filtered on their validity period.
+     *
+     * \note The validity periods are stored by the Xapian indexes built
+     *       from that version onwards. With older indexes, all the POR
+     *       are considered as valid.
+     *
+     * @param const Date_T& Validity date.
+     */
+    void setValidityDate (const Date_T&);
+
+    /**
+     * Set the number of threads, on which the slices of the travel queries,
+     * and the full-text matches within those slices, are searched for
+     * in parallel. The results are merged back in the order of the query
+     * slices, so that they do not depend on that number.
+     *
+     * When that number is null, the travel queries are interpreted within
+     * the calling threads only.
+     *
+     * @param const NbOfThreads_T& Number of search threads.
+     */
+    void setNbOfSearchThreads (const NbOfThreads_T&);
+
+    /**
+     * Set the level of the logs (e.g., LOG::DEBUG). The log entries of
+     * a more detailed level are neither formatted nor written.
+     *
+     * \note The debug and verbose log entries are compiled in only when
+     *       OPENTREP_LOG_MAX_LEVEL allows it (by default, not within
+     *       the release builds).
+     *
+     * @param const LOG::EN_LogLevel& Level of the logs.
+     */
+    void setLogLevel (const LOG::EN_LogLevel&);
+
+    /**
+     * Set the policy applied when the buffer of the (asynchronous) logger
+     * is full: either drop the log entries (LOG::DROP_RECORDS, the
+     * default), or make the threads issuing them wait for the log file
+     * (LOG::BLOCK_PRODUCERS).
+     *
+     * @param const LOG::EN_OverflowPolicy& Overflow policy of the logs.
+     */
+    void setLogOverflowPolicy (const LOG::EN_OverflowPolicy&);
+
+    /**
+     * Set the maximal size, in bytes, of the cache of the results of the
+     * travel queries. The cache, keyed on the normalised travel queries
+     * (i.e., without punctuation nor quotation characters), is emptied.
+     *
+     * When that size is null (the default), the results are not cached.
+     *
+     * The cached results are discarded as soon as the Xapian index has been
+     * re-built, or when the search strategy, the filtering of the POR
+     * or the SQL database change.
+     *
+     * @param const NbOfBytes_T& Maximal size of the cache, in bytes.
+     */
+    void setResultCacheSize (const NbOfBytes_T&);
+
+    /**
+     * Pre-warm the cache of the results with the travel queries of the
+     * given log file, one travel query per line. That method has no effect
+     * when the results are not cached (see setResultCacheSize()).
+     *
+     * @param const QueryLogFilePath_T& File-path of the log of travel queries.
+     * @return NbOfMatches_T Number of travel queries of the log which have
+     *         been interpreted.
+     */
+    NbOfMatches_T warmUpResultCache (const QueryLogFilePath_T&);
+
+    /**
+     * Get the number of travel queries, the results of which have been
+     * found within the cache.
+     */
+    NbOfLookups_T getNbOfResultCacheHits() const;
+
+    /**
+     * Get the number of travel queries, the results of which have not been
+     * found within the cache, and which have therefore been interpreted.
+     */
+    NbOfLookups_T getNbOfResultCacheMisses() const;
+
+    /**
+     * Get a snapshot of the statistics of the search of the travel queries:
+     * latency percentiles of every stage of the search (normalisation,
+     * slicing, partitioning, full-text matching, spelling corrections,
+     * weight calculation, place creation, SQL look ups, export, and the
+     * whole travel query), and counters (e.g., number of Xapian queries).
+     *
+     * 
+ote The statistics are shared by all the OPENTREP_Service instances
+     *       of the process. They may be dumped in the Prometheus text
+     *       format, with SearchStatistics::toPrometheusString().
+     *
+     * @return SearchStatistics Snapshot of the statistics.
+     */
+    SearchStatistics getStatistics() const;
+
+    /**
+     * Reset the statistics of the search of the travel queries.
+     */
+    void resetStatistics();
+
     /**
      * Create the SQL database tables and leave them empty.
      *
@@ -194,9 +397,12 @@ namespace OPENTREP {
      * @param const TravelDBFilePath_T& File-path of the Xapian index/database.
      * @param const DBType& SQL database type (can be no database at all).
      * @param const SQLDBConnectionString_T& SQL DB connection string.
+     * @param const LOG::EN_LogLevel& Level of the logs.
      */
     OPENTREP_Service (std::ostream& ioLogStream, const TravelDBFilePath_T&,
-                      const DBType&, const SQLDBConnectionString_T&);
+                      const DBType&, const SQLDBConnectionString_T&,
+                      const LOG::EN_LogLevel& iLogLevel
+                      = DEFAULT_OPENTREP_LOG_LEVEL);
 
     /**
      *  Constructor.
@@ -207,10 +413,13 @@ namespace OPENTREP {
      * @param const TravelDBFilePath_T& File-path of the Xapian index/database. 
      * @param const DBType& SQL database type (can be no database at all).
      * @param const SQLDBConnectionString_T& SQL DB connection string.
+     * @param const LOG::EN_LogLevel& Level of the logs.
      */
     OPENTREP_Service (std::ostream& ioLogStream, const PORFilePath_T&,
                       const TravelDBFilePath_T&,
-                      const DBType&, const SQLDBConnectionString_T&);
+                      const DBType&, const SQLDBConnectionString_T&,
+                      const LOG::EN_LogLevel& iLogLevel
+                      = DEFAULT_OPENTREP_LOG_LEVEL);
 
     /** 
      * Destructor. 
@@ -236,9 +445,11 @@ namespace OPENTREP {
      * @param const TravelDBFilePath_T& File-path of the Xapian index/database. 
      * @param const DBType& SQL database type (can be no database at all).
      * @param const SQLDBConnectionString_T& SQL DB connection string.
+     * @param const LOG::EN_LogLevel& Level of the logs.
      */
     void init (std::ostream& ioLogStream, const TravelDBFilePath_T&,
-               const DBType&, const SQLDBConnectionString_T&);
+               const DBType&, const SQLDBConnectionString_T&,
+               const LOG::EN_LogLevel&);
 
     /**
      * Initialise.
@@ -249,16 +460,64 @@ namespace OPENTREP {
      * @param const TravelDBFilePath_T& File-path of the Xapian index/database. 
      * @param const DBType& SQL database type (can be no database at all).
      * @param const SQLDBConnectionString_T& SQL DB connection string.
+     * @param const LOG::EN_LogLevel& Level of the logs.
      */
     void init (std::ostream& ioLogStream, const PORFilePath_T&,
                const TravelDBFilePath_T&,
-               const DBType&, const SQLDBConnectionString_T&);
+               const DBType&, const SQLDBConnectionString_T&,
+               const LOG::EN_LogLevel&);
 
     /**
-     *  Finalise. 
+     * Finalise. The pending log entries are written.
      */
     void finalise();
 
+    /**
+     * Make sure that the Xapian database (index) handle, held by the
+     * service context, is opened and refers to the latest revision
+     * of the index.
+     *
+     * The handle is opened only once, the first time that method is called.
+     * Afterwards, it is just refreshed (Xapian::Database::reopen()),
+     * which is cheap when the index has not changed in the meantime.
+     */
+    void refreshXapianDatabase();
+
+    /**
+     * Make sure that the pool of SQL database connections, held by the
+     * service context, is opened, when there is a SQL database.
+     *
+     * The connections of the pool are opened only once, the first time
+     * that method is called (or after the pool has been reset, for instance
+     * because the SQL database has been re-created).
+     */
+    void initSQLDBConnectionPool();
+
+    /**
+     * Make sure that the pool of search threads, held by the service
+     * context, is started, unless the number of search threads is null.
+     *
+     * The threads are started only once, the first time that method
+     * is called (or after the number of threads has been changed).
+     */
+    void initSearchThreadPool();
+
+    /**
+     * Discard all the results of the cache, if any.
+     */
+    void clearResultCache();
+
+    /**
+     * Match the given string, and trace the search when an explanation
+     * structure is given (see both interpretTravelRequest() methods).
+     *
+     * @param SearchExplanation* Trace of the search (NULL when the search
+     *        is not to be explained).
+     */
+    NbOfMatches_T searchTravelQuery (const std::string& iTravelQuery,
+                                     LocationList_T&, WordList_T&,
+                                     SearchExplanation*);
+
 
   private:
     // ///////// Service Context /////////
@@ -39,6 +39,16 @@ namespace OPENTREP {
     explicit PORFilePath_T (const std::string& iValue) : FilePath_T (iValue) { }
   };
 
+  /** 
+   * File-path for a log of travel queries (one query per line), for instance
+   * used to pre-warm the cache of the results.
+   */
+  struct QueryLogFilePath_T : public FilePath_T {
+  public:
+    explicit QueryLogFilePath_T (const std::string& iValue)
+      : FilePath_T (iValue) { }
+  };
+
   /** 
    * Xapian database file-path/name, corresponding to the (potentially relative)
    * directory name (on the filesystem) where Xapian stores its index.
@@ -65,6 +75,20 @@ namespace OPENTREP {
    */
   typedef bool FillSQLDB_T;
 
+  /**
+   * Whether or not all the partitions of the query slices should be
+   * searched for (exhaustive search), rather than only the distinct
+   * word combinations (optimal segmentation by dynamic programming).
+   */
+  typedef bool ExhaustiveSearch_T;
+
+  /**
+   * Whether or not the expired POR (points of reference), i.e., the POR
+   * having a non-null envelope ID, should be filtered out of the results
+   * of the travel queries.
+   */
+  typedef bool ExpiredPORFiltering_T;
+
   /** 
    * SQLite database file-path, corresponding to the (potentially relative)
    * directory name (on the filesystem) where SQLite stores its database.
@@ -430,6 +454,16 @@ namespace OPENTREP {
    */
   typedef int XapianDocID_T;
 
+  /**
+   * Xapian value slot number (e.g., 0 for the PageRank).
+   */
+  typedef unsigned int XapianValueSlot_T;
+
+  /**
+   * Version of the format of the Xapian index (e.g., 1).
+   */
+  typedef unsigned short IndexFormatVersion_T;
+
   /**
    * GMT offset (e.g., 1)
    */
@@ -490,6 +524,45 @@ namespace OPENTREP {
    * Number of entries in the Xapian database.
    */
   typedef unsigned int NbOfDBEntries_T;
+
+  /**
+   * Number of connections to the SQL database (e.g., size of the pool
+   * of SQL database connections).
+   */
+  typedef unsigned short NbOfDBConnections_T;
+
+  /**
+   * Number of threads (e.g., size of the pool of search threads).
+   */
+  typedef unsigned short NbOfThreads_T;
+
+  /**
+   * Number of bytes (e.g., size of the cache of the results).
+   */
+  typedef unsigned long NbOfBytes_T;
+
+  /**
+   * Number of look ups (e.g., hits or misses of the cache of the results).
+   */
+  typedef unsigned long NbOfLookups_T;
+
+  /**
+   * Number of log entries (e.g., size of the ring buffer of the
+   * asynchronous logger).
+   */
+  typedef unsigned long NbOfLogRecords_T;
+
+  /**
+   * Latency, in microseconds (e.g., time spent by a stage of the search
+   * of a travel query).
+   */
+  typedef unsigned long Latency_T;
+
+  /**
+   * Revision of the Xapian index, which changes every time the index
+   * is re-built.
+   */
+  typedef std::string IndexRevision_T;
   
   /**
    * Word, which is the atomic element of a query string.
@@ -21,6 +21,16 @@ namespace OPENTREP {
       VERBOSE,
       LAST_VALUE
     } EN_LogLevel;
+
+    /**
+     * Policy applied by the asynchronous logger, when its ring buffer
+     * is full.
+     */
+    typedef enum {
+      DROP_RECORDS = 0,
+      BLOCK_PRODUCERS,
+      LAST_POLICY
+    } EN_OverflowPolicy;
   }
   
 }
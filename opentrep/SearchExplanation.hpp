@@ -0,0 +1,323 @@
+#ifndef __OPENTREP_SEARCHEXPLANATION_HPP
+#define __OPENTREP_SEARCHEXPLANATION_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iosfwd>
+#include <string>
+#include <vector>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/OPENTREP_Abstract.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Enumeration of the ways a travel query slice may be searched for.
+   */
+  struct SearchMethod {
+  public:
+    typedef enum {
+      CODE_INDEX = 0,
+      SQL_DATABASE,
+      FULL_TEXT,
+      EXHAUSTIVE_FULL_TEXT,
+      LAST_VALUE
+    } EN_SearchMethod;
+
+    /**
+     * Get the label as a string (e.g., "code_index", "full_text").
+     */
+    static const std::string& getLabel (const EN_SearchMethod&);
+
+  private:
+    /**
+     * String version of the enumeration.
+     */
+    static const std::string _labels[LAST_VALUE];
+  };
+
+  /**
+   * Score of a matching document, as a pair of the one-letter label of the
+   * score type (e.g., 'X' for the Xapian percentage, 'R' for the PageRank;
+   * see ScoreType) and of the score value.
+   */
+  typedef std::pair<char, Score_T> ScoreExplanation_T;
+
+  /**
+   * (STL) List of the scores of a matching document.
+   */
+  typedef std::vector<ScoreExplanation_T> ScoreExplanationList_T;
+
+  /**
+   * @brief Xapian document having matched a word combination.
+   */
+  struct DocumentExplanation {
+    /**
+     * Key of the POR (e.g., "NCE-A-6299418").
+     */
+    std::string _key;
+
+    /**
+     * Values of the scores, by score type.
+     */
+    ScoreExplanationList_T _scoreList;
+  };
+
+  /**
+   * (STL) List of the matching documents of a word combination.
+   */
+  typedef std::vector<DocumentExplanation> DocumentExplanationList_T;
+
+  /**
+   * @brief Full-text match of a word combination (i.e., of a contiguous
+   *        sub-string) of a travel query slice.
+   */
+  struct WordCombinationExplanation {
+    /**
+     * Default constructor.
+     */
+    WordCombinationExplanation()
+      : _hasFullTextMatched (false), _editDistance (0),
+        _allowableEditDistance (0), _weight (0.0) {
+    }
+
+    /**
+     * Word combination (e.g., "rio de janero").
+     */
+    TravelQuery_T _queryString;
+
+    /**
+     * Spelling correction of the word combination (e.g., "rio de janeiro"),
+     * empty when no correction was necessary.
+     */
+    TravelQuery_T _correctedQueryString;
+
+    /**
+     * Whether the word combination has been matched by Xapian.
+     */
+    bool _hasFullTextMatched;
+
+    /**
+     * Edit distance of the spelling correction, and the maximal allowable
+     * one for the word combination.
+     */
+    NbOfErrors_T _editDistance;
+    NbOfErrors_T _allowableEditDistance;
+
+    /**
+     * Combined weight of the best matching document (in percentage).
+     */
+    Percentage_T _weight;
+
+    /**
+     * Matching documents, in the order of the Xapian matching set.
+     */
+    DocumentExplanationList_T _documentList;
+  };
+
+  /**
+   * (STL) List of the word combinations of a travel query slice.
+   */
+  typedef std::vector<WordCombinationExplanation>
+  WordCombinationExplanationList_T;
+
+  /**
+   * @brief String partition of a travel query slice, i.e., a list of
+   *        word combinations covering that slice.
+   */
+  struct PartitionExplanation {
+    /**
+     * Default constructor.
+     */
+    PartitionExplanation() : _weight (0.0) {
+    }
+
+    /**
+     * Word combinations of the string partition (e.g., "sna francicso",
+     * "rio de janero").
+     */
+    WordList_T _wordCombinationList;
+
+    /**
+     * Weight of the string partition.
+     */
+    Percentage_T _weight;
+  };
+
+  /**
+   * (STL) List of string partitions.
+   */
+  typedef std::vector<PartitionExplanation> PartitionExplanationList_T;
+
+  /**
+   * @brief Search of a single travel query slice.
+   */
+  struct SliceExplanation {
+    /**
+     * Default constructor.
+     */
+    SliceExplanation()
+      : _searchMethod (SearchMethod::FULL_TEXT), _hasChosenPartition (false) {
+    }
+
+    /**
+     * Query slice.
+     */
+    TravelQuery_T _querySlice;
+
+    /**
+     * Way the query slice has been searched for.
+     */
+    SearchMethod::EN_SearchMethod _searchMethod;
+
+    /**
+     * Full-text matches of the word combinations of the query slice.
+     */
+    WordCombinationExplanationList_T _wordCombinationList;
+
+    /**
+     * String partitions evaluated. With the default search, those are the
+     * candidates compared by the last step of the dynamic programming,
+     * i.e., for every length of the first word combination, the best
+     * partition starting with it.
+     */
+    PartitionExplanationList_T _partitionList;
+
+    /**
+     * Whether a string partition has been chosen, and that partition.
+     */
+    bool _hasChosenPartition;
+    PartitionExplanation _chosenPartition;
+  };
+
+  /**
+   * (STL) List of the slices of a travel query.
+   */
+  typedef std::vector<SliceExplanation> SliceExplanationList_T;
+
+  /**
+   * @brief Trace of the search of a travel query: slices, string partitions
+   *        evaluated, full-text matches of the word combinations (with
+   *        their spelling corrections and the scores of their documents),
+   *        and chosen string partitions.
+   *
+   * That trace is recorded only when explicitly requested.
+   * \see OPENTREP_Service::interpretTravelRequest()
+   */
+  struct SearchExplanation : public OPENTREP_Abstract {
+  public:
+    // ///////// Getters ////////
+    /**
+     * Get the travel query.
+     */
+    const TravelQuery_T& getTravelQuery() const {
+      return _travelQuery;
+    }
+
+    /**
+     * Get the normalised travel query.
+     */
+    const TravelQuery_T& getNormalisedQuery() const {
+      return _normalisedQuery;
+    }
+
+    /**
+     * Get the list of the slices of the travel query.
+     */
+    const SliceExplanationList_T& getSliceList() const {
+      return _sliceList;
+    }
+
+    /**
+     * Get the list of the slices of the travel query, to be filled.
+     */
+    SliceExplanationList_T& getSliceList() {
+      return _sliceList;
+    }
+
+    // ///////// Setters //////////
+    /**
+     * Set the travel query.
+     */
+    void setTravelQuery (const TravelQuery_T& iTravelQuery) {
+      _travelQuery = iTravelQuery;
+    }
+
+    /**
+     * Set the normalised travel query.
+     */
+    void setNormalisedQuery (const TravelQuery_T& iNormalisedQuery) {
+      _normalisedQuery = iNormalisedQuery;
+    }
+
+    /**
+     * Forget the whole trace.
+     */
+    void reset();
+
+  public:
+    // ///////// Display methods ////////
+    /**
+     * Dump the trace in a JSON format.
+     */
+    std::string toJSONString() const;
+
+    /**
+     * Dump a structure into an output stream.
+     *
+     * @param ostream& the output stream.
+     */
+    void toStream (std::ostream&) const;
+
+    /**
+     * Read a structure from an input stream.
+     *
+     * @param istream& the input stream.
+     */
+    void fromStream (std::istream&);
+
+    /**
+     * Get the serialised version of the structure.
+     */
+    std::string toString() const;
+
+  public:
+    // ///////// Constructors and destructors ////////
+    /**
+     * Default constructor.
+     */
+    SearchExplanation();
+
+    /**
+     * Copy constructor.
+     */
+    SearchExplanation (const SearchExplanation&);
+
+    /**
+     * Destructor.
+     */
+    virtual ~SearchExplanation();
+
+  private:
+    // ///////// Attributes ////////
+    /**
+     * Travel query.
+     */
+    TravelQuery_T _travelQuery;
+
+    /**
+     * Normalised travel query.
+     */
+    TravelQuery_T _normalisedQuery;
+
+    /**
+     * Slices of the travel query.
+     */
+    SliceExplanationList_T _sliceList;
+  };
+
+}
+#endif // __OPENTREP_SEARCHEXPLANATION_HPP
@@ -0,0 +1,228 @@
+#ifndef __OPENTREP_SEARCHSTATISTICS_HPP
+#define __OPENTREP_SEARCHSTATISTICS_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iosfwd>
+#include <string>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/OPENTREP_Abstract.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Enumeration of the stages of the search of a travel query.
+   *
+   * \note The stages may be nested (e.g., the spelling corrections are
+   *       sought while slicing the travel query, and while performing
+   *       the full-text matches).
+   */
+  struct SearchStage {
+  public:
+    typedef enum {
+      NORMALISATION = 0,
+      SLICING,
+      PARTITIONING,
+      FULL_TEXT_MATCHING,
+      SPELLING,
+      WEIGHT_CALCULATION,
+      PLACE_CREATION,
+      SQL_LOOKUP,
+      EXPORT,
+      TRAVEL_QUERY,
+      LAST_VALUE
+    } EN_SearchStage;
+
+    /**
+     * Get the label as a string (e.g., "normalisation", "slicing").
+     */
+    static const std::string& getLabel (const EN_SearchStage&);
+
+  private:
+    /**
+     * String version of the enumeration.
+     */
+    static const std::string _labels[LAST_VALUE];
+  };
+
+  /**
+   * @brief Enumeration of the counters of the search of travel queries.
+   */
+  struct SearchCounter {
+  public:
+    typedef enum {
+      TRAVEL_QUERIES = 0,
+      RESULT_CACHE_HITS,
+      XAPIAN_QUERIES,
+      SPELLING_CALLS,
+      PARTITIONS,
+      SQL_LOOKUPS,
+      LAST_VALUE
+    } EN_SearchCounter;
+
+    /**
+     * Get the label as a string (e.g., "travel_queries").
+     */
+    static const std::string& getLabel (const EN_SearchCounter&);
+
+    /**
+     * Get the description of the counter (e.g., "Number of travel
+     * queries").
+     */
+    static const std::string& getDescription (const EN_SearchCounter&);
+
+  private:
+    /**
+     * String version of the enumeration.
+     */
+    static const std::string _labels[LAST_VALUE];
+
+    /**
+     * Descriptions of the counters.
+     */
+    static const std::string _descriptions[LAST_VALUE];
+  };
+
+  /**
+   * @brief Summary of the latencies of a stage of the search.
+   */
+  struct LatencySummary {
+    /**
+     * Default constructor.
+     */
+    LatencySummary()
+      : _count (0), _sum (0), _max (0), _p50 (0), _p90 (0), _p99 (0),
+        _p999 (0) {
+    }
+
+    /**
+     * Number of recorded latencies.
+     */
+    NbOfLookups_T _count;
+
+    /**
+     * Sum of the recorded latencies (in microseconds).
+     */
+    Latency_T _sum;
+
+    /**
+     * Highest recorded latency (in microseconds).
+     */
+    Latency_T _max;
+
+    /**
+     * Percentiles 50, 90, 99 and 99.9 of the recorded latencies (in
+     * microseconds).
+     */
+    Latency_T _p50;
+    Latency_T _p90;
+    Latency_T _p99;
+    Latency_T _p999;
+  };
+
+  /**
+   * @brief Snapshot of the statistics of the search of travel queries,
+   *        i.e., of the latencies of every stage and of the counters.
+   *
+   * \see OPENTREP_Service::getStatistics()
+   */
+  struct SearchStatistics : public OPENTREP_Abstract {
+  public:
+    // ///////// Getters ////////
+    /**
+     * Get the summary of the latencies of the given stage.
+     */
+    const LatencySummary&
+    getLatencySummary (const SearchStage::EN_SearchStage& iStage) const {
+      return _latencySummaryArray[iStage];
+    }
+
+    /**
+     * Get the value of the given counter.
+     */
+    const NbOfLookups_T&
+    getCounter (const SearchCounter::EN_SearchCounter& iCounter) const {
+      return _counterArray[iCounter];
+    }
+
+    // ///////// Setters //////////
+    /**
+     * Set the summary of the latencies of the given stage.
+     */
+    void setLatencySummary (const SearchStage::EN_SearchStage& iStage,
+                            const LatencySummary& iLatencySummary) {
+      _latencySummaryArray[iStage] = iLatencySummary;
+    }
+
+    /**
+     * Set the value of the given counter.
+     */
+    void setCounter (const SearchCounter::EN_SearchCounter& iCounter,
+                     const NbOfLookups_T& iValue) {
+      _counterArray[iCounter] = iValue;
+    }
+
+  public:
+    // ///////// Display methods ////////
+    /**
+     * Dump the statistics in the Prometheus text exposition format: the
+     * latencies of the stages as summaries (in seconds, with their
+     * quantiles), and the counters as counters.
+     */
+    std::string toPrometheusString() const;
+
+    /**
+     * Dump a structure into an output stream.
+     *
+     * @param ostream& the output stream.
+     */
+    void toStream (std::ostream&) const;
+
+    /**
+     * Read a structure from an input stream.
+     *
+     * @param istream& the input stream.
+     */
+    void fromStream (std::istream&);
+
+    /**
+     * Get the serialised version of the structure, one line by stage and
+     * by counter.
+     */
+    std::string toString() const;
+
+  public:
+    // ///////// Constructors and destructors ////////
+    /**
+     * Default constructor.
+     */
+    SearchStatistics();
+
+    /**
+     * Copy constructor.
+     */
+    SearchStatistics (const SearchStatistics&);
+
+    /**
+     * Destructor.
+     */
+    virtual ~SearchStatistics();
+
+  private:
+    // ///////// Attributes ////////
+    /**
+     * Summaries of the latencies, by stage.
+     */
+    LatencySummary _latencySummaryArray[SearchStage::LAST_VALUE];
+
+    /**
+     * Values of the counters.
+     */
+    NbOfLookups_T _counterArray[SearchCounter::LAST_VALUE];
+  };
+
+}
+#endif // __OPENTREP_SEARCHSTATISTICS_HPP
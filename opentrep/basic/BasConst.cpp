@@ -37,6 +37,53 @@ namespace OPENTREP {
   const std::string
   DEFAULT_OPENTREP_MYSQL_CONN_STRING ("db=trep_trep user=trep password=trep");
 
+  /**
+   * Default number of connections held by the pool of SQL database
+   * connections.
+   */
+  const NbOfDBConnections_T DEFAULT_OPENTREP_SQL_DB_CONN_POOL_SIZE (4);
+
+  /**
+   * Default boolean indicator for the exhaustive search.
+   */
+  const ExhaustiveSearch_T DEFAULT_OPENTREP_EXHAUSTIVE_SEARCH (false);
+
+  /**
+   * Default boolean indicator for the filtering of the expired POR.
+   */
+  const ExpiredPORFiltering_T DEFAULT_OPENTREP_EXPIRED_POR_FILTERING (false);
+
+  /**
+   * Default number of threads of the pool of search threads.
+   */
+  const NbOfThreads_T DEFAULT_OPENTREP_NB_OF_SEARCH_THREADS (4);
+
+  /**
+   * Default maximal size (in bytes) of the cache of the results.
+   */
+  const NbOfBytes_T DEFAULT_OPENTREP_RESULT_CACHE_SIZE (0);
+
+  /**
+   * Number of shards of the cache of the results.
+   */
+  const unsigned short DEFAULT_OPENTREP_RESULT_CACHE_NB_OF_SHARDS (16);
+
+  /**
+   * Default level of the logs.
+   */
+  const LOG::EN_LogLevel DEFAULT_OPENTREP_LOG_LEVEL (LOG::NOTIFICATION);
+
+  /**
+   * Default number of slots of the ring buffer of the asynchronous logger.
+   */
+  const NbOfLogRecords_T DEFAULT_OPENTREP_LOG_BUFFER_SIZE (8192);
+
+  /**
+   * Default policy of the asynchronous logger, when its buffer is full.
+   */
+  const LOG::EN_OverflowPolicy
+  DEFAULT_OPENTREP_LOG_OVERFLOW_POLICY (LOG::DROP_RECORDS);
+
   /**
    * Default name and location for the SQLite3 database.
    */
@@ -96,6 +143,112 @@ namespace OPENTREP {
    */
   const NbOfMatches_T K_DEFAULT_XAPIAN_MATCHING_SET_SIZE (30);
 
+  /**
+   * Default factor (e.g., 2.0) applied to the prior of the POR (see
+   * K_XAPIAN_VALUE_SLOT_PRIOR), when it is added to the full-text
+   * relevance by the Xapian matcher.
+   */
+  const Score_T K_DEFAULT_XAPIAN_PRIOR_WEIGHT_FACTOR (2.0);
+
+  /**
+   * Version of the format of the Xapian index, as generated by the
+   * current version of OpenTREP. Version 1 is the first one storing
+   * the scoring fields within Xapian value slots. Version 2 adds the
+   * validity period (date_from and date_until) of the POR, within
+   * the value slots 6 and 7. Version 3 adds the prior of the POR, within
+   * the value slot 8. Version 4 folds the non-ASCII letters in lower
+   * case too, within the table of the adjacent word pairs (now built from
+   * the Xapian terms) and within the spelling dictionary.
+   */
+  const IndexFormatVersion_T K_XAPIAN_INDEX_FORMAT_VERSION (4);
+
+  /**
+   * Key of the Xapian meta-data entry storing the version of the format
+   * of the index.
+   */
+  const std::string
+  K_XAPIAN_INDEX_FORMAT_VERSION_KEY ("opentrep:index_format_version");
+
+  /**
+   * Name of the file holding the table of the adjacent word pairs,
+   * within the directory of the Xapian index.
+   */
+  const std::string K_WORD_PAIR_TABLE_FILENAME ("opentrep_word_pairs.txt");
+
+  /**
+   * Name of the file holding the spelling dictionary, within the directory
+   * of the Xapian index.
+   */
+  const std::string K_SPELLING_DICTIONARY_FILENAME ("opentrep_spelling.txt");
+
+  /**
+   * Name of the file holding the vocabulary of the index, within the
+   * directory of the Xapian index.
+   */
+  const std::string K_TERM_VOCABULARY_FILENAME ("opentrep_vocabulary.bin");
+
+  /**
+   * Number of terms of the front-coded blocks of the vocabulary.
+   */
+  const unsigned short K_TERM_VOCABULARY_BLOCK_SIZE (16);
+
+  /**
+   * Maximal number of log entries written in one go by the asynchronous
+   * logger.
+   */
+  const NbOfLogRecords_T K_LOG_WRITER_BATCH_SIZE (512);
+
+  /**
+   * Period (in milliseconds) at which the idle asynchronous logger checks
+   * for new log entries.
+   */
+  const unsigned short K_LOG_WRITER_IDLE_PERIOD (10);
+
+  /**
+   * Xapian value slot storing the PageRank.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_PAGE_RANK (0);
+
+  /**
+   * Xapian value slot storing the envelope ID.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_ENVELOPE_ID (1);
+
+  /**
+   * Xapian value slot storing the IATA code.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_IATA_CODE (2);
+
+  /**
+   * Xapian value slot storing the IATA location type.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_IATA_TYPE (3);
+
+  /**
+   * Xapian value slot storing the Geonames ID.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_GEONAMES_ID (4);
+
+  /**
+   * Xapian value slot storing the feature code.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_FEATURE_CODE (5);
+
+  /**
+   * Xapian value slot storing the beginning date of the validity period.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_DATE_FROM (6);
+
+  /**
+   * Xapian value slot storing the end date of the validity period.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_DATE_END (7);
+
+  /**
+   * Xapian value slot storing the prior of the POR.
+   */
+  const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_PRIOR (8);
+
   /**
    * Default indexing weight for standard terms (e.g., 1)
    */
@@ -142,6 +295,18 @@ namespace OPENTREP {
    */
   const NbOfErrors_T K_DEFAULT_SIZE_FOR_SPELLING_ERROR_UNIT (4);
 
+  /**
+   * Maximal number of deletions, within the prefix of a term, recorded
+   * by the spelling dictionary.
+   */
+  const NbOfErrors_T K_DEFAULT_SPELLING_MAX_PREFIX_ERRORS (2);
+
+  /**
+   * Length of the prefix of the terms, from which the deletions are
+   * derived by the spelling dictionary.
+   */
+  const NbOfLetters_T K_DEFAULT_SPELLING_PREFIX_LENGTH (7);
+
   /**
    * Black list, i.e., a list of words which should not be indexed
    * and/or searched for (e.g., "airport", "international").
@@ -6,6 +6,7 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <ctime>
+#include <string>
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
 
@@ -17,6 +18,114 @@ namespace OPENTREP {
    */
   extern const NbOfMatches_T K_DEFAULT_XAPIAN_MATCHING_SET_SIZE;
 
+  /**
+   * Default factor applied to the prior of the POR, when it is added to
+   * the full-text relevance by the Xapian matcher (e.g., 2.0).
+   */
+  extern const Score_T K_DEFAULT_XAPIAN_PRIOR_WEIGHT_FACTOR;
+
+  /**
+   * Version of the format of the Xapian index, as generated by the
+   * current version of OpenTREP (e.g., 4).
+   */
+  extern const IndexFormatVersion_T K_XAPIAN_INDEX_FORMAT_VERSION;
+
+  /**
+   * Key of the Xapian meta-data entry storing the version of the format
+   * of the index (e.g., "opentrep:index_format_version").
+   */
+  extern const std::string K_XAPIAN_INDEX_FORMAT_VERSION_KEY;
+
+  /**
+   * Name of the file, stored within the directory of the Xapian index,
+   * holding the table of the adjacent word pairs of the indexed names
+   * (e.g., "opentrep_word_pairs.txt").
+   */
+  extern const std::string K_WORD_PAIR_TABLE_FILENAME;
+
+  /**
+   * Name of the file, stored within the directory of the Xapian index,
+   * holding the spelling dictionary (e.g., "opentrep_spelling.txt").
+   */
+  extern const std::string K_SPELLING_DICTIONARY_FILENAME;
+
+  /**
+   * Name of the file, stored within the directory of the Xapian index,
+   * holding the vocabulary of the index (e.g., "opentrep_vocabulary.bin").
+   */
+  extern const std::string K_TERM_VOCABULARY_FILENAME;
+
+  /**
+   * Number of terms of the blocks of the vocabulary, within which the
+   * terms are front-coded (e.g., 16).
+   */
+  extern const unsigned short K_TERM_VOCABULARY_BLOCK_SIZE;
+
+  /**
+   * Maximal number of log entries written in one go (i.e., with a single
+   * write onto the log stream) by the asynchronous logger (e.g., 512).
+   */
+  extern const NbOfLogRecords_T K_LOG_WRITER_BATCH_SIZE;
+
+  /**
+   * Period, in milliseconds, at which the asynchronous logger checks for
+   * new log entries, when it has got nothing to write (e.g., 10).
+   */
+  extern const unsigned short K_LOG_WRITER_IDLE_PERIOD;
+
+  /**
+   * Xapian value slot storing the PageRank, as a sortable serialised
+   * floating point value (e.g., 0).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_PAGE_RANK;
+
+  /**
+   * Xapian value slot storing the envelope ID, as a sortable serialised
+   * floating point value (e.g., 1).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_ENVELOPE_ID;
+
+  /**
+   * Xapian value slot storing the IATA code, as is (e.g., 2).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_IATA_CODE;
+
+  /**
+   * Xapian value slot storing the IATA location type, as a single
+   * character (e.g., 3).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_IATA_TYPE;
+
+  /**
+   * Xapian value slot storing the Geonames ID, as a sortable serialised
+   * floating point value (e.g., 4).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_GEONAMES_ID;
+
+  /**
+   * Xapian value slot storing the feature code, as is (e.g., 5).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_FEATURE_CODE;
+
+  /**
+   * Xapian value slot storing the beginning date of the validity period,
+   * as a sortable serialised day number (e.g., 6).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_DATE_FROM;
+
+  /**
+   * Xapian value slot storing the end date of the validity period,
+   * as a sortable serialised day number (e.g., 7).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_DATE_END;
+
+  /**
+   * Xapian value slot storing the prior of the POR, i.e., the logarithm
+   * of its weights not depending on the full-text matching (PageRank and
+   * envelope), as a sortable serialised floating point value (e.g., 8).
+   */
+  extern const XapianValueSlot_T K_XAPIAN_VALUE_SLOT_PRIOR;
+
   /**
    * Default indexing weight for standard terms (e.g., 1)
    */
@@ -63,6 +172,18 @@ namespace OPENTREP {
    */
   extern const NbOfErrors_T K_DEFAULT_SIZE_FOR_SPELLING_ERROR_UNIT;
 
+  /**
+   * Maximal number of deletions, within the prefix of a term, recorded
+   * by the spelling dictionary (e.g., 2).
+   */
+  extern const NbOfErrors_T K_DEFAULT_SPELLING_MAX_PREFIX_ERRORS;
+
+  /**
+   * Length, in characters, of the prefix of the terms from which the
+   * deletions are derived by the spelling dictionary (e.g., 7).
+   */
+  extern const NbOfLetters_T K_DEFAULT_SPELLING_PREFIX_LENGTH;
+
   /**
    * Default "black list".
    */
@@ -4,7 +4,10 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
 #include <string>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
 
 namespace OPENTREP {
 
@@ -57,6 +60,71 @@ namespace OPENTREP {
    */
   extern const std::string DEFAULT_OPENTREP_MYSQL_CONN_STRING;
 
+  /**
+   * Default number of connections held by the pool of SQL database
+   * connections. That is also the maximum number of concurrent look ups
+   * on the SQL database.
+   */
+  extern const NbOfDBConnections_T DEFAULT_OPENTREP_SQL_DB_CONN_POOL_SIZE;
+
+  /**
+   * Default boolean indicator for the exhaustive search.
+   *
+   * Usually, the best partition of every query slice is found by
+   * dynamic programming, each distinct word combination being searched
+   * for only once. The exhaustive search, going through all the
+   * partitions, is kept for comparison purposes.
+   */
+  extern const ExhaustiveSearch_T DEFAULT_OPENTREP_EXHAUSTIVE_SEARCH;
+
+  /**
+   * Default boolean indicator for the filtering of the expired POR
+   * (points of reference). By default, the expired POR are matched,
+   * but their weight is decreased (see K_DEFAULT_ENVELOPE_PCT).
+   */
+  extern const ExpiredPORFiltering_T DEFAULT_OPENTREP_EXPIRED_POR_FILTERING;
+
+  /**
+   * Default number of threads of the pool, on which the query slices,
+   * and the full-text matches of their word combinations, are evaluated
+   * in parallel. With no thread (0), the travel queries are evaluated
+   * sequentially, within the calling thread.
+   */
+  extern const NbOfThreads_T DEFAULT_OPENTREP_NB_OF_SEARCH_THREADS;
+
+  /**
+   * Default maximal size (in bytes) of the cache of the results of the
+   * travel queries. With no byte (0), the results are not cached.
+   */
+  extern const NbOfBytes_T DEFAULT_OPENTREP_RESULT_CACHE_SIZE;
+
+  /**
+   * Number of shards of the cache of the results. Every shard has got
+   * its own lock, so that concurrent look ups seldom wait for one another.
+   */
+  extern const unsigned short DEFAULT_OPENTREP_RESULT_CACHE_NB_OF_SHARDS;
+
+  /**
+   * Default level of the logs. The debug and verbose log entries, which
+   * are issued for every travel query and every matching document, are
+   * not written by default.
+   */
+  extern const LOG::EN_LogLevel DEFAULT_OPENTREP_LOG_LEVEL;
+
+  /**
+   * Default number of slots of the ring buffer of the asynchronous logger
+   * (e.g., 8192 log entries). When the buffer is full, the log entries
+   * are either dropped or waited for, according to the overflow policy.
+   */
+  extern const NbOfLogRecords_T DEFAULT_OPENTREP_LOG_BUFFER_SIZE;
+
+  /**
+   * Default policy of the asynchronous logger, when its ring buffer is
+   * full (e.g., LOG::DROP_RECORDS, so that the search threads never wait
+   * for the log file).
+   */
+  extern const LOG::EN_OverflowPolicy DEFAULT_OPENTREP_LOG_OVERFLOW_POLICY;
+
   /**
    * Default name and location for the SQLite3 database.
    *
@@ -0,0 +1,136 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cmath>
+// OpenTrep
+#include <opentrep/basic/BasLatencyHistogram.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  BasLatencyHistogram::BasLatencyHistogram() {
+    reset();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BasLatencyHistogram::~BasLatencyHistogram() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BasLatencyHistogram::reset() {
+    for (unsigned int idx = 0; idx != NB_OF_BUCKETS; ++idx) {
+      _bucketArray[idx].store (0, boost::memory_order_relaxed);
+    }
+    _count.store (0, boost::memory_order_relaxed);
+    _sum.store (0, boost::memory_order_relaxed);
+    _max.store (0, boost::memory_order_relaxed);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  unsigned int BasLatencyHistogram::getBucketIdx (const Latency_T iLatency) {
+    if (iLatency < SUB_BUCKET_COUNT) {
+      return iLatency;
+    }
+
+    // Magnitude (i.e., position of the highest bit set) of the latency
+    unsigned int lMagnitude = SUB_BUCKET_BITS;
+    while (lMagnitude < MAX_MAGNITUDE && (iLatency >> (lMagnitude + 1)) != 0) {
+      ++lMagnitude;
+    }
+
+    // Position of the latency within its power of two
+    const unsigned int lShift = lMagnitude - SUB_BUCKET_BITS;
+    Latency_T lSubBucketIdx = (iLatency >> lShift) - SUB_BUCKET_COUNT;
+    if (lSubBucketIdx >= SUB_BUCKET_COUNT) {
+      // Beyond the highest magnitude: the latency goes into the last bucket
+      lSubBucketIdx = SUB_BUCKET_COUNT - 1;
+    }
+
+    const unsigned int oBucketIdx =
+      (lShift + 1) * SUB_BUCKET_COUNT + lSubBucketIdx;
+    assert (oBucketIdx < NB_OF_BUCKETS);
+    return oBucketIdx;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Latency_T BasLatencyHistogram::
+  getBucketUpperBound (const unsigned int iBucketIdx) {
+    if (iBucketIdx < SUB_BUCKET_COUNT) {
+      return iBucketIdx;
+    }
+
+    const unsigned int lShift = iBucketIdx / SUB_BUCKET_COUNT - 1;
+    const Latency_T lSubBucketIdx = iBucketIdx % SUB_BUCKET_COUNT;
+    const Latency_T lLowerBound = (SUB_BUCKET_COUNT + lSubBucketIdx) << lShift;
+    return lLowerBound + (static_cast<Latency_T> (1) << lShift) - 1;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BasLatencyHistogram::record (const Latency_T iLatency) {
+    const unsigned int lBucketIdx = getBucketIdx (iLatency);
+    _bucketArray[lBucketIdx].fetch_add (1, boost::memory_order_relaxed);
+    _count.fetch_add (1, boost::memory_order_relaxed);
+    _sum.fetch_add (iLatency, boost::memory_order_relaxed);
+
+    Latency_T lMax = _max.load (boost::memory_order_relaxed);
+    while (iLatency > lMax
+           && _max.compare_exchange_weak (lMax, iLatency,
+                                          boost::memory_order_relaxed)
+           == false) {
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfLookups_T BasLatencyHistogram::getCount() const {
+    return _count.load (boost::memory_order_relaxed);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Latency_T BasLatencyHistogram::getSum() const {
+    return _sum.load (boost::memory_order_relaxed);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Latency_T BasLatencyHistogram::getMax() const {
+    return _max.load (boost::memory_order_relaxed);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Latency_T BasLatencyHistogram::
+  getPercentile (const double iPercentile) const {
+    // The buckets are read one by one, while other threads may still be
+    // recording: their total, rather than the counter, is relied upon
+    NbOfLookups_T lCountArray[NB_OF_BUCKETS];
+    NbOfLookups_T lCount = 0;
+    for (unsigned int idx = 0; idx != NB_OF_BUCKETS; ++idx) {
+      lCountArray[idx] = _bucketArray[idx].load (boost::memory_order_relaxed);
+      lCount += lCountArray[idx];
+    }
+    if (lCount == 0) {
+      return 0;
+    }
+
+    // Rank of the percentile, between 1 and the number of latencies
+    NbOfLookups_T lRank =
+      static_cast<NbOfLookups_T> (std::ceil (iPercentile / 100.0 * lCount));
+    if (lRank == 0) {
+      lRank = 1;
+    } else if (lRank > lCount) {
+      lRank = lCount;
+    }
+
+    const Latency_T lMax = getMax();
+    NbOfLookups_T lCumulatedCount = 0;
+    for (unsigned int idx = 0; idx != NB_OF_BUCKETS; ++idx) {
+      lCumulatedCount += lCountArray[idx];
+      if (lCumulatedCount >= lRank) {
+        const Latency_T lUpperBound = getBucketUpperBound (idx);
+        return (lUpperBound < lMax) ? lUpperBound : lMax;
+      }
+    }
+    return lMax;
+  }
+
+}
@@ -0,0 +1,132 @@
+#ifndef __OPENTREP_BAS_BASLATENCYHISTOGRAM_HPP
+#define __OPENTREP_BAS_BASLATENCYHISTOGRAM_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/atomic.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Histogram of latencies, into which several threads may record
+   *        concurrently, without any lock.
+   *
+   * As with HDR histograms, the buckets are log-linear: every power of two
+   * is split into SUB_BUCKET_COUNT buckets of the same width, so that the
+   * relative error on a percentile is bounded (about 6%), whatever the
+   * magnitude of the latency. Recording a latency is a few relaxed atomic
+   * increments.
+   */
+  class BasLatencyHistogram {
+  public:
+    // ////////////////// Business Methods ////////////////
+    /**
+     * Record the given latency.
+     *
+     * @param const Latency_T Latency, in microseconds.
+     */
+    void record (const Latency_T);
+
+    /**
+     * Get the number of recorded latencies.
+     */
+    NbOfLookups_T getCount() const;
+
+    /**
+     * Get the sum, in microseconds, of the recorded latencies.
+     */
+    Latency_T getSum() const;
+
+    /**
+     * Get the highest recorded latency, in microseconds.
+     */
+    Latency_T getMax() const;
+
+    /**
+     * Get the given percentile of the recorded latencies, i.e., the upper
+     * bound of the bucket holding it (and at most the highest latency).
+     *
+     * @param const double Percentile (e.g., 99.9).
+     * @return Latency_T Latency, in microseconds (0 when nothing has been
+     *         recorded).
+     */
+    Latency_T getPercentile (const double) const;
+
+    /**
+     * Forget all the recorded latencies.
+     */
+    void reset();
+
+  public:
+    // ////////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    BasLatencyHistogram();
+
+    /**
+     * Destructor.
+     */
+    ~BasLatencyHistogram();
+
+  private:
+    /**
+     * Copy constructor, not implemented.
+     */
+    BasLatencyHistogram (const BasLatencyHistogram&);
+
+  private:
+    // ////////////////// Helper Methods ////////////////
+    /**
+     * Get the index of the bucket of the given latency.
+     */
+    static unsigned int getBucketIdx (const Latency_T);
+
+    /**
+     * Get the highest latency of the given bucket.
+     */
+    static Latency_T getBucketUpperBound (const unsigned int);
+
+  private:
+    // //////////////// Type definitions ////////////////
+    /**
+     * Layout of the buckets: the latencies lower than SUB_BUCKET_COUNT
+     * have got their own bucket; the higher ones, up to 2^MAX_MAGNITUDE,
+     * share SUB_BUCKET_COUNT buckets by power of two.
+     */
+    enum {
+      SUB_BUCKET_BITS = 4,
+      SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS,
+      MAX_MAGNITUDE = 40,
+      NB_OF_BUCKETS = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT
+    };
+
+  private:
+    // ////////////// Attributes ///////////////
+    /**
+     * Number of recorded latencies, by bucket.
+     */
+    boost::atomic<NbOfLookups_T> _bucketArray[NB_OF_BUCKETS];
+
+    /**
+     * Number of recorded latencies.
+     */
+    boost::atomic<NbOfLookups_T> _count;
+
+    /**
+     * Sum of the recorded latencies.
+     */
+    boost::atomic<Latency_T> _sum;
+
+    /**
+     * Highest recorded latency.
+     */
+    boost::atomic<Latency_T> _max;
+  };
+
+}
+#endif // __OPENTREP_BAS_BASLATENCYHISTOGRAM_HPP
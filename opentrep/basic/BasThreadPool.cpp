@@ -0,0 +1,229 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// Boost
+#include <boost/bind.hpp>
+// OpenTrep
+#include <opentrep/basic/BasThreadPool.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  void BasThreadPool::doNotDeleteQueue (TaskQueue*) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BasThreadPool::BasThreadPool (const NbOfThreads_T& iNbOfThreads)
+    : _currentQueue (&doNotDeleteQueue), _nbOfPendingTasks (0),
+      _nbOfIdleWorkers (0), _nextQueueIdx (0), _isStopping (false) {
+    const NbOfThreads_T lNbOfThreads = (iNbOfThreads == 0) ? 1 : iNbOfThreads;
+
+    // The queues must all exist before the workers start stealing tasks
+    for (NbOfThreads_T idx = 0; idx != lNbOfThreads; ++idx) {
+      _queueList.push_back (new TaskQueue());
+    }
+
+    for (NbOfThreads_T idx = 0; idx != lNbOfThreads; ++idx) {
+      _threadGroup.create_thread (boost::bind (&BasThreadPool::runWorker,
+                                               this, idx));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BasThreadPool::~BasThreadPool() {
+    {
+      boost::mutex::scoped_lock lGuard (_mutex);
+      _isStopping = true;
+    }
+    _condition.notify_all();
+    _threadGroup.join_all();
+
+    for (TaskQueueList_T::iterator itQueue = _queueList.begin();
+         itQueue != _queueList.end(); ++itQueue) {
+      TaskQueue* lTaskQueue_ptr = *itQueue;
+      assert (lTaskQueue_ptr != NULL);
+      assert (lTaskQueue_ptr->_taskList.empty() == true);
+
+      delete lTaskQueue_ptr; lTaskQueue_ptr = NULL;
+    }
+    _queueList.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BasThreadPool::runWorker (const NbOfThreads_T& iWorkerIdx) {
+    assert (iWorkerIdx < _queueList.size());
+    _currentQueue.reset (_queueList[iWorkerIdx]);
+
+    while (true) {
+      if (runPendingTask (NULL) == true) {
+        continue;
+      }
+
+      // Wait for tasks to be submitted. The worker is declared idle before
+      // the number of pending tasks is checked, so that a task submitted
+      // in the meantime either is seen here, or wakes the worker up.
+      boost::mutex::scoped_lock lGuard (_mutex);
+      ++_nbOfIdleWorkers;
+      while (_nbOfPendingTasks.load() <= 0 && _isStopping == false) {
+        _condition.wait (lGuard);
+      }
+      --_nbOfIdleWorkers;
+      if (_nbOfPendingTasks.load() <= 0 && _isStopping == true) {
+        break;
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BasThreadPool::submit (const Task_T& iTask, TaskGroup& ioTaskGroup) {
+    {
+      boost::mutex::scoped_lock lGuard (ioTaskGroup._mutex);
+      ++ioTaskGroup._nbOfOutstandingTasks;
+    }
+
+    // The tasks submitted by the other threads are spread over the workers
+    TaskQueue* lTaskQueue_ptr = _currentQueue.get();
+    if (lTaskQueue_ptr == NULL) {
+      const NbOfThreads_T lQueueIdx = _nextQueueIdx.fetch_add (1);
+      lTaskQueue_ptr = _queueList[lQueueIdx % _queueList.size()];
+    }
+    assert (lTaskQueue_ptr != NULL);
+
+    {
+      boost::mutex::scoped_lock lGuard (lTaskQueue_ptr->_mutex);
+      lTaskQueue_ptr->_taskList.push_back (TaskItem (iTask, ioTaskGroup));
+    }
+    ++_nbOfPendingTasks;
+
+    // Wake up a single idle worker, if any. The mutex is taken, so that
+    // a worker about to wait does not miss the notification.
+    if (_nbOfIdleWorkers.load() > 0) {
+      boost::mutex::scoped_lock lGuard (_mutex);
+      _condition.notify_one();
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool BasThreadPool::takeTask (TaskQueue& ioTaskQueue, const bool iIsOwnQueue,
+                                const TaskGroup* iTaskGroup_ptr,
+                                TaskItem& ioTaskItem) {
+    boost::mutex::scoped_lock lGuard (ioTaskQueue._mutex);
+    std::deque<TaskItem>& lTaskList = ioTaskQueue._taskList;
+    if (lTaskList.empty() == true) {
+      return false;
+    }
+
+    // Any task will do: the most recent one of the own queue of the worker,
+    // or the oldest one of another queue
+    if (iTaskGroup_ptr == NULL) {
+      if (iIsOwnQueue == true) {
+        ioTaskItem = lTaskList.back();
+        lTaskList.pop_back();
+      } else {
+        ioTaskItem = lTaskList.front();
+        lTaskList.pop_front();
+      }
+      return true;
+    }
+
+    // Only a task of the given group will do
+    for (std::deque<TaskItem>::iterator itTask = lTaskList.begin();
+         itTask != lTaskList.end(); ++itTask) {
+      if (itTask->_group == iTaskGroup_ptr) {
+        ioTaskItem = *itTask;
+        lTaskList.erase (itTask);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool BasThreadPool::runPendingTask (const TaskGroup* iTaskGroup_ptr) {
+    TaskItem lTaskItem;
+    bool hasFoundTask = false;
+
+    // First, a task of the own queue of the worker, if any
+    TaskQueue* lOwnQueue_ptr = _currentQueue.get();
+    if (lOwnQueue_ptr != NULL) {
+      hasFoundTask = takeTask (*lOwnQueue_ptr, true, iTaskGroup_ptr,
+                               lTaskItem);
+    }
+
+    // Otherwise, steal a task from another queue
+    for (TaskQueueList_T::iterator itQueue = _queueList.begin();
+         hasFoundTask == false && itQueue != _queueList.end(); ++itQueue) {
+      TaskQueue* lTaskQueue_ptr = *itQueue;
+      assert (lTaskQueue_ptr != NULL);
+      if (lTaskQueue_ptr == lOwnQueue_ptr) {
+        continue;
+      }
+
+      hasFoundTask = takeTask (*lTaskQueue_ptr, false, iTaskGroup_ptr,
+                               lTaskItem);
+    }
+
+    if (hasFoundTask == false) {
+      return false;
+    }
+    --_nbOfPendingTasks;
+
+    // Run the task, keeping track of the exception it may throw
+    boost::exception_ptr lException;
+    try {
+      lTaskItem._task();
+
+    } catch (...) {
+      lException = boost::current_exception();
+    }
+
+    // Account for the end of the task. The group may be destroyed as soon
+    // as its last task is over and its lock released: it must not be
+    // referred to afterwards.
+    TaskGroup* lTaskGroup_ptr = lTaskItem._group;
+    assert (lTaskGroup_ptr != NULL);
+    {
+      boost::mutex::scoped_lock lGuard (lTaskGroup_ptr->_mutex);
+      if (lException && !lTaskGroup_ptr->_exception) {
+        lTaskGroup_ptr->_exception = lException;
+      }
+      assert (lTaskGroup_ptr->_nbOfOutstandingTasks > 0);
+      --lTaskGroup_ptr->_nbOfOutstandingTasks;
+      if (lTaskGroup_ptr->_nbOfOutstandingTasks == 0) {
+        lTaskGroup_ptr->_condition.notify_one();
+      }
+    }
+
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BasThreadPool::run (const TaskList_T& iTaskList) {
+    TaskGroup lTaskGroup;
+
+    for (TaskList_T::const_iterator itTask = iTaskList.begin();
+         itTask != iTaskList.end(); ++itTask) {
+      const Task_T& lTask = *itTask;
+      submit (lTask, lTaskGroup);
+    }
+
+    // Take part in the processing of the pending tasks of the group. Once
+    // none of them is pending any more, the remaining ones are being run
+    // by other threads: wait for them to be over.
+    while (runPendingTask (&lTaskGroup) == true) {
+    }
+
+    boost::mutex::scoped_lock lGuard (lTaskGroup._mutex);
+    while (lTaskGroup._nbOfOutstandingTasks != 0) {
+      lTaskGroup._condition.wait (lGuard);
+    }
+
+    // Re-throw the first exception thrown by the tasks, if any
+    if (lTaskGroup._exception) {
+      boost::rethrow_exception (lTaskGroup._exception);
+    }
+  }
+
+}
@@ -0,0 +1,277 @@
+#ifndef __OPENTREP_BAS_BASTHREADPOOL_HPP
+#define __OPENTREP_BAS_BASTHREADPOOL_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <deque>
+#include <vector>
+// Boost
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/tss.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Pool of threads, on which independent tasks are run in parallel.
+   *
+   * Every thread of the pool (worker) has got its own queue of tasks.
+   * The tasks submitted by a worker (e.g., by a task splitting its work
+   * into sub-tasks) are added to the queue of that worker, which takes
+   * them back in the reverse order (the most recent first). The tasks
+   * submitted by any other thread are spread over the queues of the
+   * workers. A worker having no more task in its own queue steals the
+   * oldest tasks from the queues of the other workers.
+   *
+   * A thread waiting for its tasks to be over (see run()) does not stay
+   * idle: it takes part in the processing of its own pending tasks (but
+   * not of the tasks submitted by other threads, so that it is not delayed
+   * by unrelated work). Hence, tasks may run (and wait for) sub-tasks,
+   * without exhausting the pool.
+   *
+   * The idle workers are woken up one at a time, only when tasks are
+   * submitted while some of them are waiting; every group of tasks has
+   * got its own lock, on which only the thread waiting for that group
+   * is notified.
+   */
+  class BasThreadPool {
+  public:
+    // //////////////// Type definitions ////////////////
+    /**
+     * Task, i.e., function to be called by one of the threads.
+     */
+    typedef boost::function<void ()> Task_T;
+
+    /**
+     * List of tasks.
+     */
+    typedef std::vector<Task_T> TaskList_T;
+
+  public:
+    // ////////////////// Business Methods ////////////////
+    /**
+     * Run the given tasks in parallel, and wait for all of them to be over.
+     *
+     * If some of the tasks throw an exception, the first of those
+     * exceptions is re-thrown, once all the tasks are over.
+     *
+     * @param const TaskList_T& List of tasks to be run.
+     */
+    void run (const TaskList_T&);
+
+    /**
+     * Get the number of threads of the pool.
+     */
+    NbOfThreads_T getNbOfThreads() const {
+      return _queueList.size();
+    }
+
+  public:
+    // ////////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor. The threads are started straight away.
+     *
+     * @param const NbOfThreads_T& Number of threads (at least one).
+     */
+    BasThreadPool (const NbOfThreads_T&);
+
+    /**
+     * Destructor. The threads are stopped, once all the pending tasks
+     * are over.
+     */
+    ~BasThreadPool();
+
+  private:
+    /**
+     * Default constructor, not implemented.
+     */
+    BasThreadPool();
+
+    /**
+     * Copy constructor, not implemented.
+     */
+    BasThreadPool (const BasThreadPool&);
+
+  private:
+    // //////////////// Type definitions ////////////////
+    /**
+     * Group of tasks, for which a thread waits.
+     */
+    struct TaskGroup {
+      /**
+       * Constructor.
+       */
+      TaskGroup() : _nbOfOutstandingTasks (0) {
+      }
+
+      /**
+       * Mutex protecting the state of the group.
+       */
+      boost::mutex _mutex;
+
+      /**
+       * Condition notified when the last task of the group is over.
+       */
+      boost::condition_variable _condition;
+
+      /**
+       * Number of tasks of the group, not over yet.
+       */
+      unsigned int _nbOfOutstandingTasks;
+
+      /**
+       * First exception thrown by the tasks of the group, if any.
+       */
+      boost::exception_ptr _exception;
+    };
+
+    /**
+     * Task, along with the group to which it belongs.
+     */
+    struct TaskItem {
+      /**
+       * Constructors.
+       */
+      TaskItem() : _group (NULL) {
+      }
+      TaskItem (const Task_T& iTask, TaskGroup& ioGroup)
+        : _task (iTask), _group (&ioGroup) {
+      }
+
+      /**
+       * Task to be run.
+       */
+      Task_T _task;
+
+      /**
+       * Group to which the task belongs.
+       */
+      TaskGroup* _group;
+    };
+
+    /**
+     * Queue of tasks of a worker.
+     */
+    struct TaskQueue {
+      /**
+       * Mutex protecting the queue.
+       */
+      boost::mutex _mutex;
+
+      /**
+       * Pending tasks.
+       */
+      std::deque<TaskItem> _taskList;
+    };
+
+    /**
+     * List of the queues of the workers.
+     */
+    typedef std::vector<TaskQueue*> TaskQueueList_T;
+
+  private:
+    // ////////////////// Helper Methods ////////////////
+    /**
+     * Clean-up function of the queue of the calling worker. The queues are
+     * owned by the pool: they must not be deleted when the workers exit.
+     */
+    static void doNotDeleteQueue (TaskQueue*);
+
+    /**
+     * Main loop of a worker.
+     *
+     * @param const NbOfThreads_T& Index of the worker (and of its queue).
+     */
+    void runWorker (const NbOfThreads_T&);
+
+    /**
+     * Add the given task to the queue of the calling worker or, when the
+     * calling thread does not belong to the pool, to the queue of one
+     * of the workers.
+     */
+    void submit (const Task_T&, TaskGroup&);
+
+    /**
+     * Take a pending task, if any, and run it. The task is taken from the
+     * queue of the calling worker first and, when that latter is empty,
+     * stolen from the queues of the other workers.
+     *
+     * @param const TaskGroup* Group to which the task must belong (NULL
+     *        when the task may belong to any group).
+     * @return bool Whether a task has been run.
+     */
+    bool runPendingTask (const TaskGroup*);
+
+    /**
+     * Take, from the given queue, the most recent (when the queue belongs
+     * to the calling worker) or the oldest (otherwise) task belonging to
+     * the given group (or to any group, when no group is given).
+     *
+     * @return bool Whether a task has been taken.
+     */
+    static bool takeTask (TaskQueue&, const bool iIsOwnQueue,
+                          const TaskGroup*, TaskItem&);
+
+  private:
+    // ////////////// Attributes ///////////////
+    /**
+     * Queues of the workers.
+     */
+    TaskQueueList_T _queueList;
+
+    /**
+     * Threads of the workers.
+     */
+    boost::thread_group _threadGroup;
+
+    /**
+     * Queue of the calling worker (NULL for the threads not belonging
+     * to the pool).
+     */
+    boost::thread_specific_ptr<TaskQueue> _currentQueue;
+
+    /**
+     * Mutex on which the idle workers wait, also protecting the state
+     * of the pool.
+     */
+    boost::mutex _mutex;
+
+    /**
+     * Condition notified when tasks are submitted while some workers are
+     * idle, and when the pool is stopped.
+     */
+    boost::condition_variable _condition;
+
+    /**
+     * Number of tasks waiting in the queues. That number may transiently
+     * be negative, when a task is taken before being accounted for.
+     */
+    boost::atomic<int> _nbOfPendingTasks;
+
+    /**
+     * Number of workers waiting for tasks to be submitted.
+     */
+    boost::atomic<int> _nbOfIdleWorkers;
+
+    /**
+     * Index of the queue to which the next task, submitted by a thread
+     * not belonging to the pool, is added.
+     */
+    boost::atomic<NbOfThreads_T> _nextQueueIdx;
+
+    /**
+     * Whether the pool is being stopped.
+     */
+    bool _isStopping;
+  };
+
+}
+#endif // __OPENTREP_BAS_BASTHREADPOOL_HPP
@@ -0,0 +1,220 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// Boost Property Tree (PT)
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+// OpenTrep
+#include <opentrep/SearchExplanation.hpp>
+#include <opentrep/basic/ScoreType.hpp>
+
+namespace bpt = boost::property_tree;
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string SearchMethod::_labels[LAST_VALUE] =
+    { "code_index", "sql_database", "full_text", "exhaustive_full_text" };
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string& SearchMethod::getLabel (const EN_SearchMethod& iMethod) {
+    assert (iMethod < LAST_VALUE);
+    return _labels[iMethod];
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SearchExplanation::SearchExplanation() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SearchExplanation::SearchExplanation (const SearchExplanation& iExplanation)
+    : OPENTREP_Abstract (iExplanation),
+      _travelQuery (iExplanation._travelQuery),
+      _normalisedQuery (iExplanation._normalisedQuery),
+      _sliceList (iExplanation._sliceList) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SearchExplanation::~SearchExplanation() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SearchExplanation::reset() {
+    _travelQuery.clear();
+    _normalisedQuery.clear();
+    _sliceList.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SearchExplanation::toStream (std::ostream& ioOut) const {
+    ioOut << toString();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SearchExplanation::fromStream (std::istream& ioIn) {
+  }
+
+  /**
+   * Describe a string partition, e.g., "{sna francicso; rio de janero}".
+   */
+  // //////////////////////////////////////////////////////////////////////
+  static std::string
+  describePartition (const PartitionExplanation& iPartition) {
+    std::ostringstream oStr;
+    oStr << "{";
+    for (WordList_T::const_iterator itString =
+           iPartition._wordCombinationList.begin();
+         itString != iPartition._wordCombinationList.end(); ++itString) {
+      if (itString != iPartition._wordCombinationList.begin()) {
+        oStr << "; ";
+      }
+      oStr << *itString;
+    }
+    oStr << "} (" << iPartition._weight << "%)";
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SearchExplanation::toString() const {
+    std::ostringstream oStr;
+    oStr << "Travel query: '" << _travelQuery << "', normalised into '"
+         << _normalisedQuery << "'" << std::endl;
+
+    for (SliceExplanationList_T::const_iterator itSlice = _sliceList.begin();
+         itSlice != _sliceList.end(); ++itSlice) {
+      const SliceExplanation& lSlice = *itSlice;
+      oStr << "Slice: '" << lSlice._querySlice << "' ("
+           << SearchMethod::getLabel (lSlice._searchMethod) << ")" << std::endl;
+
+      for (WordCombinationExplanationList_T::const_iterator itString =
+             lSlice._wordCombinationList.begin();
+           itString != lSlice._wordCombinationList.end(); ++itString) {
+        const WordCombinationExplanation& lString = *itString;
+        oStr << "  '" << lString._queryString << "'";
+        if (lString._correctedQueryString.empty() == false) {
+          oStr << " corrected into '" << lString._correctedQueryString
+               << "' (" << lString._editDistance << "/"
+               << lString._allowableEditDistance << ")";
+        }
+        oStr << ": " << lString._documentList.size() << " document(s), "
+             << lString._weight << "%" << std::endl;
+      }
+
+      for (PartitionExplanationList_T::const_iterator itPartition =
+             lSlice._partitionList.begin();
+           itPartition != lSlice._partitionList.end(); ++itPartition) {
+        oStr << "  Partition: " << describePartition (*itPartition)
+             << std::endl;
+      }
+
+      if (lSlice._hasChosenPartition == true) {
+        oStr << "  Chosen partition: "
+             << describePartition (lSlice._chosenPartition) << std::endl;
+      }
+    }
+    return oStr.str();
+  }
+
+  /**
+   * Fill the given property tree with a string partition.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  static void jsonExportPartition (bpt::ptree& ioPTPartition,
+                                   const PartitionExplanation& iPartition) {
+    bpt::ptree lPTStringList;
+    for (WordList_T::const_iterator itString =
+           iPartition._wordCombinationList.begin();
+         itString != iPartition._wordCombinationList.end(); ++itString) {
+      bpt::ptree lPTString;
+      lPTString.put ("", *itString);
+      lPTStringList.push_back (std::make_pair ("", lPTString));
+    }
+    ioPTPartition.add_child ("word_combinations", lPTStringList);
+    ioPTPartition.put ("weight", iPartition._weight);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SearchExplanation::toJSONString() const {
+    bpt::ptree lPT;
+    lPT.put ("travel_query", _travelQuery);
+    lPT.put ("normalised_query", _normalisedQuery);
+
+    bpt::ptree lPTSliceList;
+    for (SliceExplanationList_T::const_iterator itSlice = _sliceList.begin();
+         itSlice != _sliceList.end(); ++itSlice) {
+      const SliceExplanation& lSlice = *itSlice;
+      bpt::ptree lPTSlice;
+      lPTSlice.put ("query_slice", lSlice._querySlice);
+      lPTSlice.put ("search_method",
+                    SearchMethod::getLabel (lSlice._searchMethod));
+
+      // Full-text matches of the word combinations
+      bpt::ptree lPTStringList;
+      for (WordCombinationExplanationList_T::const_iterator itString =
+             lSlice._wordCombinationList.begin();
+           itString != lSlice._wordCombinationList.end(); ++itString) {
+        const WordCombinationExplanation& lString = *itString;
+        bpt::ptree lPTString;
+        lPTString.put ("query_string", lString._queryString);
+        lPTString.put ("corrected_query_string",
+                       lString._correctedQueryString);
+        lPTString.put ("has_matched", lString._hasFullTextMatched);
+        lPTString.put ("edit_distance", lString._editDistance);
+        lPTString.put ("allowable_distance", lString._allowableEditDistance);
+        lPTString.put ("weight", lString._weight);
+
+        bpt::ptree lPTDocumentList;
+        for (DocumentExplanationList_T::const_iterator itDoc =
+               lString._documentList.begin();
+             itDoc != lString._documentList.end(); ++itDoc) {
+          const DocumentExplanation& lDocument = *itDoc;
+          bpt::ptree lPTDocument;
+          lPTDocument.put ("key", lDocument._key);
+
+          bpt::ptree lPTScoreList;
+          for (ScoreExplanationList_T::const_iterator itScore =
+                 lDocument._scoreList.begin();
+               itScore != lDocument._scoreList.end(); ++itScore) {
+            const ScoreType lScoreType (itScore->first);
+            lPTScoreList.put (lScoreType.describe(), itScore->second);
+          }
+          lPTDocument.add_child ("scores", lPTScoreList);
+          lPTDocumentList.push_back (std::make_pair ("", lPTDocument));
+        }
+        lPTString.add_child ("documents", lPTDocumentList);
+        lPTStringList.push_back (std::make_pair ("", lPTString));
+      }
+      lPTSlice.add_child ("word_combinations", lPTStringList);
+
+      // String partitions evaluated
+      bpt::ptree lPTPartitionList;
+      for (PartitionExplanationList_T::const_iterator itPartition =
+             lSlice._partitionList.begin();
+           itPartition != lSlice._partitionList.end(); ++itPartition) {
+        bpt::ptree lPTPartition;
+        jsonExportPartition (lPTPartition, *itPartition);
+        lPTPartitionList.push_back (std::make_pair ("", lPTPartition));
+      }
+      lPTSlice.add_child ("partitions", lPTPartitionList);
+
+      // Chosen string partition
+      if (lSlice._hasChosenPartition == true) {
+        bpt::ptree lPTPartition;
+        jsonExportPartition (lPTPartition, lSlice._chosenPartition);
+        lPTSlice.add_child ("chosen_partition", lPTPartition);
+      }
+
+      lPTSliceList.push_back (std::make_pair ("", lPTSlice));
+    }
+    lPT.add_child ("slices", lPTSliceList);
+
+    // Write the property tree into a JSON string
+    std::ostringstream oStr;
+    write_json (oStr, lPT);
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,161 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+// OpenTrep
+#include <opentrep/SearchStatistics.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string SearchStage::_labels[LAST_VALUE] =
+    { "normalisation", "slicing", "partitioning", "full_text_matching",
+      "spelling", "weight_calculation", "place_creation", "sql_lookup",
+      "export", "travel_query" };
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string SearchCounter::_labels[LAST_VALUE] =
+    { "travel_queries", "result_cache_hits", "xapian_queries",
+      "spelling_calls", "partitions", "sql_lookups" };
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string SearchCounter::_descriptions[LAST_VALUE] =
+    { "Number of travel queries",
+      "Number of travel queries answered from the cache of the results",
+      "Number of queries issued on the Xapian index",
+      "Number of spelling corrections sought",
+      "Number of string partitions evaluated",
+      "Number of look ups of codes within the SQL database" };
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string& SearchStage::getLabel (const EN_SearchStage& iStage) {
+    assert (iStage < LAST_VALUE);
+    return _labels[iStage];
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string& SearchCounter::
+  getLabel (const EN_SearchCounter& iCounter) {
+    assert (iCounter < LAST_VALUE);
+    return _labels[iCounter];
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string& SearchCounter::
+  getDescription (const EN_SearchCounter& iCounter) {
+    assert (iCounter < LAST_VALUE);
+    return _descriptions[iCounter];
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SearchStatistics::SearchStatistics() {
+    for (unsigned short idx = 0; idx != SearchCounter::LAST_VALUE; ++idx) {
+      _counterArray[idx] = 0;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SearchStatistics::SearchStatistics (const SearchStatistics& iStatistics)
+    : OPENTREP_Abstract (iStatistics) {
+    for (unsigned short idx = 0; idx != SearchStage::LAST_VALUE; ++idx) {
+      _latencySummaryArray[idx] = iStatistics._latencySummaryArray[idx];
+    }
+    for (unsigned short idx = 0; idx != SearchCounter::LAST_VALUE; ++idx) {
+      _counterArray[idx] = iStatistics._counterArray[idx];
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SearchStatistics::~SearchStatistics() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SearchStatistics::toStream (std::ostream& ioOut) const {
+    ioOut << toString();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SearchStatistics::fromStream (std::istream& ioIn) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SearchStatistics::toString() const {
+    std::ostringstream oStr;
+    for (unsigned short idx = 0; idx != SearchStage::LAST_VALUE; ++idx) {
+      const SearchStage::EN_SearchStage lStage =
+        static_cast<SearchStage::EN_SearchStage> (idx);
+      const LatencySummary& lSummary = _latencySummaryArray[idx];
+      oStr << SearchStage::getLabel (lStage) << ": " << lSummary._count
+           << " measures; p50: " << lSummary._p50 << "us; p90: "
+           << lSummary._p90 << "us; p99: " << lSummary._p99
+           << "us; p99.9: " << lSummary._p999 << "us; max: "
+           << lSummary._max << "us" << std::endl;
+    }
+    for (unsigned short idx = 0; idx != SearchCounter::LAST_VALUE; ++idx) {
+      const SearchCounter::EN_SearchCounter lCounter =
+        static_cast<SearchCounter::EN_SearchCounter> (idx);
+      oStr << SearchCounter::getLabel (lCounter) << ": "
+           << _counterArray[idx] << std::endl;
+    }
+    return oStr.str();
+  }
+
+  /**
+   * Convert a latency, from microseconds into seconds, for Prometheus.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  static double toSeconds (const Latency_T& iLatency) {
+    return static_cast<double> (iLatency) / 1e6;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SearchStatistics::toPrometheusString() const {
+    std::ostringstream oStr;
+    oStr << std::setprecision (9);
+
+    // Latencies of the stages
+    const std::string lLatencyMetric ("opentrep_search_stage_latency_seconds");
+    oStr << "# HELP " << lLatencyMetric
+         << " Latency of the stages of the search of the travel queries."
+         << std::endl;
+    oStr << "# TYPE " << lLatencyMetric << " summary" << std::endl;
+    for (unsigned short idx = 0; idx != SearchStage::LAST_VALUE; ++idx) {
+      const SearchStage::EN_SearchStage lStage =
+        static_cast<SearchStage::EN_SearchStage> (idx);
+      const std::string& lLabel = SearchStage::getLabel (lStage);
+      const LatencySummary& lSummary = _latencySummaryArray[idx];
+
+      const std::string lQuantileArray[] = { "0.5", "0.9", "0.99", "0.999" };
+      const Latency_T lValueArray[] = { lSummary._p50, lSummary._p90,
+                                        lSummary._p99, lSummary._p999 };
+      for (unsigned short idxQuantile = 0; idxQuantile != 4; ++idxQuantile) {
+        oStr << lLatencyMetric << "{stage=\"" << lLabel << "\",quantile=\""
+             << lQuantileArray[idxQuantile] << "\"} "
+             << toSeconds (lValueArray[idxQuantile]) << std::endl;
+      }
+      oStr << lLatencyMetric << "_sum{stage=\"" << lLabel << "\"} "
+           << toSeconds (lSummary._sum) << std::endl;
+      oStr << lLatencyMetric << "_count{stage=\"" << lLabel << "\"} "
+           << lSummary._count << std::endl;
+    }
+
+    // Counters
+    for (unsigned short idx = 0; idx != SearchCounter::LAST_VALUE; ++idx) {
+      const SearchCounter::EN_SearchCounter lCounter =
+        static_cast<SearchCounter::EN_SearchCounter> (idx);
+      const std::string lCounterMetric ("opentrep_"
+                                        + SearchCounter::getLabel (lCounter)
+                                        + "_total");
+      oStr << "# HELP " << lCounterMetric << " "
+           << SearchCounter::getDescription (lCounter) << "." << std::endl;
+      oStr << "# TYPE " << lCounterMetric << " counter" << std::endl;
+      oStr << lCounterMetric << " " << _counterArray[idx] << std::endl;
+    }
+
+    return oStr.str();
+  }
+
+}
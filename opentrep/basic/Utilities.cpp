@@ -99,4 +99,57 @@ namespace OPENTREP {
     return oStr.str();
   }
 
+  /**
+   * State whether the given character is an ASCII letter.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  inline bool isAlpha (const char iChar) {
+    return (iChar >= 'a' && iChar <= 'z') || (iChar >= 'A' && iChar <= 'Z');
+  }
+
+  /**
+   * State whether the given character is an ASCII digit.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  inline bool isDigit (const char iChar) {
+    return (iChar >= '0' && iChar <= '9');
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool isIATACode (const std::string& iWord) {
+    if (iWord.size() != 3) {
+      return false;
+    }
+    return isAlpha (iWord[0]) && isAlpha (iWord[1]) && isAlpha (iWord[2]);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool isICAOCode (const std::string& iWord) {
+    if (iWord.size() != 4) {
+      return false;
+    }
+    for (std::string::const_iterator itChar = iWord.begin();
+         itChar != iWord.end(); ++itChar) {
+      const char lChar = *itChar;
+      if (isAlpha (lChar) == false && isDigit (lChar) == false) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool isGeonamesID (const std::string& iWord) {
+    if (iWord.empty() == true || iWord.size() > 11) {
+      return false;
+    }
+    for (std::string::const_iterator itChar = iWord.begin();
+         itChar != iWord.end(); ++itChar) {
+      if (isDigit (*itChar) == false) {
+        return false;
+      }
+    }
+    return true;
+  }
+
 }
@@ -31,5 +31,30 @@ namespace OPENTREP {
                                         const unsigned short iSplitIdx = 0,
                                         const bool iFromBeginningFlag = true);
 
+  /**
+   * State whether the given word has the shape of a IATA code, i.e.,
+   * is made of 3 (ASCII) letters (e.g., "sfo").
+   *
+   * The classification relies only on character ranges, and therefore does
+   * not depend on the locale (contrary to the [[:alpha:]] regex classes).
+   *
+   * \note That classifier, as the two ones below, is a plain function:
+   *       OpenTREP is built as C++98, without constexpr, and the words are
+   *       given at run-time anyway.
+   */
+  bool isIATACode (const std::string&);
+
+  /**
+   * State whether the given word has the shape of a ICAO code, i.e.,
+   * is made of 4 (ASCII) letters or digits (e.g., "lfmn").
+   */
+  bool isICAOCode (const std::string&);
+
+  /**
+   * State whether the given word has the shape of a Geonames ID, i.e.,
+   * is made of 1 to 11 digits (e.g., "5391989").
+   */
+  bool isGeonamesID (const std::string&);
+
 }
 #endif // __OPENTREP_BAS_UTILITIES_HPP
@@ -0,0 +1,78 @@
+#ifndef __OPENTREP_BATCHES_ALLOCATIONCOUNTER_HPP
+#define __OPENTREP_BATCHES_ALLOCATIONCOUNTER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstdlib>
+#include <new>
+// Boost
+#include <boost/atomic.hpp>
+
+/**
+ * @file AllocationCounter.hpp
+ * @brief Replacements of the global operators new and delete, counting
+ *        the memory allocations of the whole process, for the benchmark
+ *        batches (opentrep-bench and opentrep-microbench).
+ *
+ * The allocations of all the threads are counted, including the search
+ * threads and the log writer of the OpenTREP library. Hence, the
+ * counters are atomic (and updated with a relaxed ordering, as only
+ * their totals matter).
+ *
+ * \note As the operators are defined here, that header must be included
+ *       by a single source file of a given binary (normally, the one
+ *       holding its main() function).
+ */
+
+// //////// Memory allocations //////
+/**
+ * Number of memory allocations, counted by the global operator new below.
+ */
+static boost::atomic<unsigned long> gNbOfAllocations (0);
+
+/**
+ * Total size (in bytes) of the memory allocations.
+ */
+static boost::atomic<unsigned long> gNbOfAllocatedBytes (0);
+
+/**
+ * Exception specifications of the global operators new and delete, which
+ * have changed with C++11.
+ */
+#if __cplusplus >= 201103L
+#define OPENTREP_ALLOCATION_NEW_SPEC
+#define OPENTREP_ALLOCATION_DELETE_SPEC noexcept
+#else
+#define OPENTREP_ALLOCATION_NEW_SPEC throw (std::bad_alloc)
+#define OPENTREP_ALLOCATION_DELETE_SPEC throw()
+#endif
+
+// //////////////////////////////////////////////////////////////////////
+void* operator new (std::size_t iSize) OPENTREP_ALLOCATION_NEW_SPEC {
+  gNbOfAllocations.fetch_add (1, boost::memory_order_relaxed);
+  gNbOfAllocatedBytes.fetch_add (iSize, boost::memory_order_relaxed);
+  void* oPtr = std::malloc (iSize == 0 ? 1 : iSize);
+  if (oPtr == NULL) {
+    throw std::bad_alloc();
+  }
+  return oPtr;
+}
+
+// //////////////////////////////////////////////////////////////////////
+void* operator new[] (std::size_t iSize) OPENTREP_ALLOCATION_NEW_SPEC {
+  return operator new (iSize);
+}
+
+// //////////////////////////////////////////////////////////////////////
+void operator delete (void* iPtr) OPENTREP_ALLOCATION_DELETE_SPEC {
+  std::free (iPtr);
+}
+
+// //////////////////////////////////////////////////////////////////////
+void operator delete[] (void* iPtr) OPENTREP_ALLOCATION_DELETE_SPEC {
+  std::free (iPtr);
+}
+
+#endif // __OPENTREP_BATCHES_ALLOCATIONCOUNTER_HPP
@@ -0,0 +1,574 @@
+// STL
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+// Boost (Extended STL)
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/program_options.hpp>
+// OpenTREP
+#include <opentrep/OPENTREP_Service.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/basic/BasLatencyHistogram.hpp>
+#include <opentrep/config/opentrep-paths.hpp>
+#include <opentrep/batches/AllocationCounter.hpp>
+
+
+// //////// Type definitions ///////
+typedef std::vector<std::string> QueryList_T;
+
+
+// //////// Constants //////
+/**
+ * Default name and location for the log file.
+ */
+const std::string K_OPENTREP_DEFAULT_LOG_FILENAME ("opentrep-bench.log");
+
+/**
+ * Default file-path of the POR (points of reference), i.e., the small
+ * file bundled with OpenTREP, so that the benchmark may be run offline,
+ * and its results compared from one version to another.
+ */
+const std::string K_OPENTREP_DEFAULT_POR_FILEPATH (OPENTREP_POR_DATA_DIR
+                                                   "/test_ori_por_public.csv");
+
+/**
+ * Default file-path of the Xapian index built for the benchmark.
+ */
+const std::string K_OPENTREP_DEFAULT_XAPIAN_DB_FILEPATH ("/tmp/opentrep/bench_traveldb");
+
+/**
+ * Default number of travel queries to be synthesised, when no query file
+ * is given.
+ */
+const unsigned int K_OPENTREP_DEFAULT_NB_OF_QUERIES = 1000;
+
+/**
+ * Default percentage of the synthesised travel queries having got
+ * a misspelling.
+ */
+const unsigned short K_OPENTREP_DEFAULT_MISSPELLING_PCT = 30;
+
+/**
+ * Default seed of the random generator of the misspellings.
+ */
+const unsigned int K_OPENTREP_DEFAULT_SEED = 42;
+
+/**
+ * Default number of threads replaying the travel queries.
+ */
+const unsigned short K_OPENTREP_DEFAULT_NB_OF_THREADS = 4;
+
+/**
+ * Default durations (in seconds) of the warm-up and of the measure.
+ */
+const unsigned int K_OPENTREP_DEFAULT_WARMUP_DURATION = 2;
+const unsigned int K_OPENTREP_DEFAULT_DURATION = 10;
+
+
+// ///////// Parsing of Options & Configuration /////////
+/** Early return status (so that it can be differentiated from an error). */
+const int K_OPENTREP_EARLY_RETURN_STATUS = 99;
+
+/** Read and parse the command line options. */
+int readConfiguration (int argc, char* argv[],
+                       std::string& ioPORFilepath,
+                       std::string& ioXapianDBFilepath,
+                       bool& ioShouldReuseIndex,
+                       std::string& ioQueryFilepath,
+                       std::string& ioSavedQueryFilepath,
+                       unsigned int& ioNbOfQueries,
+                       unsigned short& ioMisspellingPct,
+                       unsigned int& ioSeed,
+                       unsigned short& ioNbOfThreads,
+                       unsigned short& ioNbOfSearchThreads,
+                       unsigned int& ioWarmUpDuration,
+                       unsigned int& ioDuration,
+                       std::string& ioLogFilename,
+                       unsigned short& ioLogLevel) {
+
+  // Declare a group of options that will be allowed only on command line
+  boost::program_options::options_description generic ("Generic options");
+  generic.add_options()
+    ("prefix", "print installation prefix")
+    ("version,v", "print version string")
+    ("help,h", "produce help message");
+
+  // Declare a group of options that will be allowed both on command
+  // line and in config file
+  boost::program_options::options_description config ("Configuration");
+  config.add_options()
+    ("porfile,p",
+     boost::program_options::value< std::string >(&ioPORFilepath)->default_value(K_OPENTREP_DEFAULT_POR_FILEPATH),
+     "POR file-path, from which the Xapian index is built (e.g., test_ori_por_public.csv)")
+    ("xapiandb,d",
+     boost::program_options::value< std::string >(&ioXapianDBFilepath)->default_value(K_OPENTREP_DEFAULT_XAPIAN_DB_FILEPATH),
+     "Xapian database filepath (e.g., /tmp/opentrep/bench_traveldb)")
+    ("reuseindex,r",
+     boost::program_options::bool_switch(&ioShouldReuseIndex),
+     "Re-use the Xapian index, rather than building it from the POR file")
+    ("queryfile,f",
+     boost::program_options::value< std::string >(&ioQueryFilepath),
+     "File of travel queries, one by line (when not given, the travel queries are synthesised from POR randomly drawn from the Xapian index)")
+    ("savequeries,o",
+     boost::program_options::value< std::string >(&ioSavedQueryFilepath),
+     "File into which the synthesised travel queries are saved, so that they may be replayed (with the queryfile option) against other versions")
+    ("nbqueries,n",
+     boost::program_options::value< unsigned int >(&ioNbOfQueries)->default_value(K_OPENTREP_DEFAULT_NB_OF_QUERIES),
+     "Number of travel queries to be synthesised")
+    ("misspellings,m",
+     boost::program_options::value< unsigned short >(&ioMisspellingPct)->default_value(K_OPENTREP_DEFAULT_MISSPELLING_PCT),
+     "Percentage of the synthesised travel queries having got a misspelling")
+    ("seed,s",
+     boost::program_options::value< unsigned int >(&ioSeed)->default_value(K_OPENTREP_DEFAULT_SEED),
+     "Seed of the random generator of the misspellings")
+    ("threads,t",
+     boost::program_options::value< unsigned short >(&ioNbOfThreads)->default_value(K_OPENTREP_DEFAULT_NB_OF_THREADS),
+     "Number of threads replaying the travel queries")
+    ("searchthreads,j",
+     boost::program_options::value< unsigned short >(&ioNbOfSearchThreads)->default_value(OPENTREP::DEFAULT_OPENTREP_NB_OF_SEARCH_THREADS),
+     "Number of threads of the pool on which the slices of every travel query are searched for (0 = within the replaying thread)")
+    ("warmup,w",
+     boost::program_options::value< unsigned int >(&ioWarmUpDuration)->default_value(K_OPENTREP_DEFAULT_WARMUP_DURATION),
+     "Duration of the warm-up, in seconds, during which nothing is measured")
+    ("duration,u",
+     boost::program_options::value< unsigned int >(&ioDuration)->default_value(K_OPENTREP_DEFAULT_DURATION),
+     "Duration of the measure, in seconds")
+    ("log,l",
+     boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_OPENTREP_DEFAULT_LOG_FILENAME),
+     "Filepath for the logs")
+    ("loglevel,g",
+     boost::program_options::value< unsigned short >(&ioLogLevel)->default_value(OPENTREP::DEFAULT_OPENTREP_LOG_LEVEL),
+     "Level of the logs (0 = critical, 1 = error, 2 = notification, 3 = warning, 4 = debug, 5 = verbose)")
+    ;
+
+  // Hidden options, will be allowed both on command line and
+  // in config file, but will not be shown to the user.
+  boost::program_options::options_description hidden ("Hidden options");
+  hidden.add_options()
+    ("copyright",
+     boost::program_options::value< std::vector<std::string> >(),
+     "Show the copyright (license)");
+
+  boost::program_options::options_description cmdline_options;
+  cmdline_options.add(generic).add(config).add(hidden);
+
+  boost::program_options::options_description config_file_options;
+  config_file_options.add(config).add(hidden);
+
+  boost::program_options::options_description visible ("Allowed options");
+  visible.add(generic).add(config);
+
+  boost::program_options::positional_options_description p;
+  p.add ("copyright", -1);
+
+  boost::program_options::variables_map vm;
+  boost::program_options::
+    store (boost::program_options::command_line_parser (argc, argv).
+           options (cmdline_options).positional(p).run(), vm);
+
+  std::ifstream ifs ("opentrep-bench.cfg");
+  boost::program_options::store (parse_config_file (ifs, config_file_options),
+                                 vm);
+  boost::program_options::notify (vm);
+
+  if (vm.count ("help")) {
+    std::cout << visible << std::endl;
+    return K_OPENTREP_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("version")) {
+    std::cout << PACKAGE_NAME << ", version " << PACKAGE_VERSION << std::endl;
+    return K_OPENTREP_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("prefix")) {
+    std::cout << "Installation prefix: " << PREFIXDIR << std::endl;
+    return K_OPENTREP_EARLY_RETURN_STATUS;
+  }
+
+  std::cout << "Xapian database filepath is: " << ioXapianDBFilepath
+            << std::endl;
+  if (ioShouldReuseIndex == false) {
+    std::cout << "POR file-path is: " << ioPORFilepath << std::endl;
+  }
+
+  if (ioQueryFilepath.empty() == false) {
+    std::cout << "Travel query file-path is: " << ioQueryFilepath << std::endl;
+  } else {
+    std::cout << ioNbOfQueries << " travel queries will be synthesised, "
+              << ioMisspellingPct << "% of which misspelled (seed: " << ioSeed
+              << ")" << std::endl;
+  }
+
+  if (ioMisspellingPct > 100) {
+    ioMisspellingPct = 100;
+  }
+
+  if (ioNbOfThreads == 0) {
+    ioNbOfThreads = 1;
+  }
+  std::cout << "Number of threads: " << ioNbOfThreads
+            << "; number of search threads: " << ioNbOfSearchThreads
+            << std::endl;
+
+  std::cout << "Warm-up: " << ioWarmUpDuration << "s; measure: "
+            << ioDuration << "s" << std::endl;
+
+  std::cout << "Log filename is: " << ioLogFilename << std::endl;
+
+  if (ioLogLevel > OPENTREP::LOG::VERBOSE) {
+    ioLogLevel = OPENTREP::LOG::VERBOSE;
+  }
+  std::cout << "Log level is: " << ioLogLevel << std::endl;
+
+  return 0;
+}
+
+
+// //////// Travel queries //////
+/**
+ * Read the travel queries from the given file, one by line. The empty
+ * lines are skipped.
+ */
+bool readQueryFile (const std::string& iQueryFilepath,
+                    QueryList_T& ioQueryList) {
+  std::ifstream lQueryFile (iQueryFilepath.c_str());
+  if (lQueryFile.is_open() == false) {
+    std::cerr << "The travel query file ('" << iQueryFilepath
+              << "') cannot be opened" << std::endl;
+    return false;
+  }
+
+  std::string lQuery;
+  while (std::getline (lQueryFile, lQuery)) {
+    if (lQuery.empty() == false) {
+      ioQueryList.push_back (lQuery);
+    }
+  }
+  return true;
+}
+
+/**
+ * Introduce a misspelling within the given word: a letter is substituted,
+ * deleted, inserted, or swapped with the next one. The words of less than
+ * four letters are left untouched.
+ */
+void misspell (std::string& ioWord, boost::random::mt19937& ioGenerator) {
+  if (ioWord.size() < 4) {
+    return;
+  }
+
+  boost::random::uniform_int_distribution<> lPositionDistrib (1, ioWord.size()
+                                                              - 2);
+  boost::random::uniform_int_distribution<> lLetterDistrib ('a', 'z');
+  boost::random::uniform_int_distribution<> lTypeDistrib (0, 3);
+  const std::size_t lPosition = lPositionDistrib (ioGenerator);
+  const char lLetter = static_cast<char> (lLetterDistrib (ioGenerator));
+
+  switch (lTypeDistrib (ioGenerator)) {
+  case 0: ioWord[lPosition] = lLetter; break;
+  case 1: ioWord.erase (lPosition, 1); break;
+  case 2: ioWord.insert (lPosition, 1, lLetter); break;
+  default: std::swap (ioWord[lPosition], ioWord[lPosition + 1]); break;
+  }
+}
+
+/**
+ * Synthesise travel queries from POR randomly drawn from the Xapian index:
+ * one in four of them is the IATA code of the POR, and the other ones are
+ * its name, possibly misspelled.
+ */
+void synthesiseQueries (OPENTREP::OPENTREP_Service& ioOpentrepService,
+                        const unsigned int iNbOfQueries,
+                        const unsigned short iMisspellingPct,
+                        const unsigned int iSeed,
+                        QueryList_T& ioQueryList) {
+  boost::random::mt19937 lGenerator (iSeed);
+  boost::random::uniform_int_distribution<> lPctDistrib (1, 100);
+  boost::random::uniform_int_distribution<> lQueryTypeDistrib (0, 3);
+
+  // The number of draws is bounded by the type of the number of matches
+  while (ioQueryList.size() < iNbOfQueries) {
+    const unsigned int lNbOfMissingQueries = iNbOfQueries - ioQueryList.size();
+    const OPENTREP::NbOfMatches_T lNbOfDraws =
+      (lNbOfMissingQueries < 10000) ? lNbOfMissingQueries : 10000;
+    OPENTREP::LocationList_T lLocationList;
+    const OPENTREP::NbOfMatches_T lNbOfMatches =
+      ioOpentrepService.drawRandomLocations (lNbOfDraws, lLocationList);
+    const std::size_t lNbOfQueriesBefore = ioQueryList.size();
+
+    for (OPENTREP::LocationList_T::const_iterator itLocation =
+           lLocationList.begin(); itLocation != lLocationList.end()
+           && ioQueryList.size() < iNbOfQueries; ++itLocation) {
+      const OPENTREP::Location& lLocation = *itLocation;
+      const std::string& lIataCode = lLocation.getIataCode();
+      std::string lName = lLocation.getAsciiName();
+      boost::algorithm::to_lower (lName);
+
+      if (lName.empty() == true
+          || (lIataCode.empty() == false
+              && lQueryTypeDistrib (lGenerator) == 0)) {
+        std::string lCode (lIataCode);
+        boost::algorithm::to_lower (lCode);
+        if (lCode.empty() == false) {
+          ioQueryList.push_back (lCode);
+        }
+        continue;
+      }
+
+      if (lPctDistrib (lGenerator) <= iMisspellingPct) {
+        misspell (lName, lGenerator);
+      }
+      ioQueryList.push_back (lName);
+    }
+
+    // Nothing can be drawn from the Xapian index
+    if (lNbOfMatches == 0 || ioQueryList.size() == lNbOfQueriesBefore) {
+      break;
+    }
+  }
+}
+
+/**
+ * Save the travel queries into the given file, one by line.
+ */
+void saveQueryFile (const std::string& iQueryFilepath,
+                    const QueryList_T& iQueryList) {
+  std::ofstream lQueryFile (iQueryFilepath.c_str());
+  for (QueryList_T::const_iterator itQuery = iQueryList.begin();
+       itQuery != iQueryList.end(); ++itQuery) {
+    lQueryFile << *itQuery << std::endl;
+  }
+}
+
+
+// //////// Replay of the travel queries //////
+/**
+ * State shared by the threads replaying the travel queries.
+ */
+struct ReplayState {
+  /** Constructor. */
+  ReplayState() : _isMeasuring (false), _shouldStop (false), _nbOfQueries (0),
+                  _nbOfFailures (0) {
+  }
+
+  /** Whether the latencies should be recorded (i.e., after the warm-up). */
+  boost::atomic<bool> _isMeasuring;
+  /** Whether the threads should stop. */
+  boost::atomic<bool> _shouldStop;
+  /** Number of travel queries replayed while measuring. */
+  boost::atomic<unsigned long> _nbOfQueries;
+  /** Number of travel queries having thrown an exception. */
+  boost::atomic<unsigned long> _nbOfFailures;
+  /** Latencies of the travel queries, in microseconds. */
+  OPENTREP::BasLatencyHistogram _histogram;
+};
+
+/**
+ * Thread entry point: the travel queries are replayed in a loop, every
+ * thread starting at its own offset, until it is asked to stop.
+ */
+void replayQueries (OPENTREP::OPENTREP_Service* ioOpentrepService_ptr,
+                    const QueryList_T* iQueryList_ptr,
+                    const std::size_t iOffset, ReplayState* ioState_ptr) {
+  assert (ioOpentrepService_ptr != NULL && iQueryList_ptr != NULL
+          && ioState_ptr != NULL);
+  const QueryList_T& lQueryList = *iQueryList_ptr;
+  ReplayState& lState = *ioState_ptr;
+
+  for (std::size_t idx = iOffset;
+       lState._shouldStop.load (boost::memory_order_relaxed) == false;
+       ++idx) {
+    const std::string& lQuery = lQueryList[idx % lQueryList.size()];
+
+    const bool isMeasuring = lState._isMeasuring.load();
+    const boost::posix_time::ptime lStartTime =
+      boost::posix_time::microsec_clock::universal_time();
+    try {
+      OPENTREP::WordList_T lNonMatchedWordList;
+      OPENTREP::LocationList_T lLocationList;
+      ioOpentrepService_ptr->interpretTravelRequest (lQuery, lLocationList,
+                                                     lNonMatchedWordList);
+
+    } catch (const std::exception& lException) {
+      lState._nbOfFailures.fetch_add (1, boost::memory_order_relaxed);
+    }
+    const boost::posix_time::time_duration lElapsedTime =
+      boost::posix_time::microsec_clock::universal_time() - lStartTime;
+
+    if (isMeasuring == true) {
+      const long lLatency = lElapsedTime.total_microseconds();
+      lState._histogram.record ((lLatency > 0) ? lLatency : 0);
+      lState._nbOfQueries.fetch_add (1, boost::memory_order_relaxed);
+    }
+  }
+}
+
+
+// /////////////// M A I N /////////////////
+int main (int argc, char* argv[]) {
+
+  // Output log File
+  std::string lLogFilename;
+
+  // Level of the logs
+  unsigned short lLogLevel;
+
+  // File-path of POR (points of reference)
+  std::string lPORFilepathStr;
+
+  // Xapian database name (directory of the index)
+  std::string lXapianDBNameStr;
+
+  // Whether the Xapian index should be re-used
+  bool lShouldReuseIndex = false;
+
+  // Travel queries: file-path of the travel queries to be replayed, or
+  // synthesis parameters
+  std::string lQueryFilepath;
+  std::string lSavedQueryFilepath;
+  unsigned int lNbOfQueries;
+  unsigned short lMisspellingPct;
+  unsigned int lSeed;
+
+  // Replay parameters
+  unsigned short lNbOfThreads;
+  unsigned short lNbOfSearchThreads;
+  unsigned int lWarmUpDuration;
+  unsigned int lDuration;
+
+  // Call the command-line option parser
+  const int lOptionParserStatus =
+    readConfiguration (argc, argv, lPORFilepathStr, lXapianDBNameStr,
+                       lShouldReuseIndex, lQueryFilepath, lSavedQueryFilepath,
+                       lNbOfQueries, lMisspellingPct, lSeed, lNbOfThreads,
+                       lNbOfSearchThreads, lWarmUpDuration, lDuration,
+                       lLogFilename, lLogLevel);
+
+  if (lOptionParserStatus == K_OPENTREP_EARLY_RETURN_STATUS) {
+    return 0;
+  }
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the context. No SQL database is used, so that the benchmark
+  // measures only the search itself.
+  const OPENTREP::PORFilePath_T lPORFilepath (lPORFilepathStr);
+  const OPENTREP::TravelDBFilePath_T lXapianDBName (lXapianDBNameStr);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::NODB);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr ("");
+  const OPENTREP::LOG::EN_LogLevel lLogLevelEnum =
+    static_cast<OPENTREP::LOG::EN_LogLevel> (lLogLevel);
+  OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lPORFilepath,
+                                              lXapianDBName, lDBType,
+                                              lSQLDBConnStr, lLogLevelEnum);
+
+  // Build the Xapian index, unless it is to be re-used
+  if (lShouldReuseIndex == false) {
+    const OPENTREP::NbOfDBEntries_T lNbOfEntries =
+      opentrepService.buildSearchIndex();
+    std::cout << lNbOfEntries << " POR have been indexed" << std::endl;
+  }
+
+  // The results of the travel queries are not to be cached, as only the
+  // first replay of every travel query would be measured otherwise
+  opentrepService.setResultCacheSize (0);
+  opentrepService.setNbOfSearchThreads (lNbOfSearchThreads);
+
+  // Load or synthesise the travel queries
+  QueryList_T lQueryList;
+  if (lQueryFilepath.empty() == false) {
+    if (readQueryFile (lQueryFilepath, lQueryList) == false) {
+      return -1;
+    }
+  } else {
+    synthesiseQueries (opentrepService, lNbOfQueries, lMisspellingPct, lSeed,
+                       lQueryList);
+  }
+  if (lQueryList.empty() == true) {
+    std::cerr << "There is no travel query to be replayed" << std::endl;
+    return -1;
+  }
+  std::cout << lQueryList.size() << " travel queries will be replayed"
+            << std::endl;
+
+  if (lSavedQueryFilepath.empty() == false) {
+    saveQueryFile (lSavedQueryFilepath, lQueryList);
+    std::cout << "The travel queries have been saved into '"
+              << lSavedQueryFilepath << "'" << std::endl;
+  }
+
+  // Replay the travel queries: warm-up first, and then measure
+  ReplayState lState;
+  boost::thread_group lThreadGroup;
+  for (unsigned short idx = 0; idx != lNbOfThreads; ++idx) {
+    const std::size_t lOffset = idx * lQueryList.size() / lNbOfThreads;
+    lThreadGroup.create_thread (boost::bind (&replayQueries, &opentrepService,
+                                             &lQueryList, lOffset, &lState));
+  }
+
+  boost::this_thread::sleep (boost::posix_time::seconds (lWarmUpDuration));
+  opentrepService.resetStatistics();
+  const unsigned long lNbOfAllocationsBefore = gNbOfAllocations.load();
+  const boost::posix_time::ptime lStartTime =
+    boost::posix_time::microsec_clock::universal_time();
+  lState._isMeasuring.store (true);
+
+  boost::this_thread::sleep (boost::posix_time::seconds (lDuration));
+
+  lState._isMeasuring.store (false);
+  const boost::posix_time::ptime lEndTime =
+    boost::posix_time::microsec_clock::universal_time();
+  const unsigned long lNbOfAllocations =
+    gNbOfAllocations.load() - lNbOfAllocationsBefore;
+  lState._shouldStop.store (true);
+  lThreadGroup.join_all();
+
+  // Report
+  const double lElapsedSeconds =
+    (lEndTime - lStartTime).total_microseconds() / 1e6;
+  const unsigned long lNbOfReplayedQueries = lState._nbOfQueries.load();
+  const OPENTREP::BasLatencyHistogram& lHistogram = lState._histogram;
+  std::cout << std::fixed << std::setprecision (1);
+  std::cout << "Travel queries: " << lNbOfReplayedQueries << " in "
+            << lElapsedSeconds << "s, with " << lNbOfThreads << " thread(s) ("
+            << lState._nbOfFailures.load() << " failure(s))" << std::endl;
+  std::cout << "QPS: " << ((lElapsedSeconds > 0.0) ?
+                           lNbOfReplayedQueries / lElapsedSeconds : 0.0)
+            << std::endl;
+  std::cout << "Latency (us): p50: " << lHistogram.getPercentile (50.0)
+            << "; p90: " << lHistogram.getPercentile (90.0)
+            << "; p99: " << lHistogram.getPercentile (99.0)
+            << "; p99.9: " << lHistogram.getPercentile (99.9)
+            << "; max: " << lHistogram.getMax() << std::endl;
+  std::cout << "Allocations per query: " << ((lNbOfReplayedQueries != 0) ?
+    static_cast<double> (lNbOfAllocations) / lNbOfReplayedQueries : 0.0)
+            << std::endl;
+
+  // Latencies of the stages of the search, as recorded by the service
+  // (the warm-up excepted)
+  const OPENTREP::SearchStatistics& lStatistics =
+    opentrepService.getStatistics();
+  std::cout << "Stages of the search:" << std::endl << lStatistics;
+
+  // Close the Log outputFile
+  logOutputFile.close();
+
+  return 0;
+}
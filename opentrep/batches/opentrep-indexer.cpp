@@ -36,7 +36,8 @@ int readConfiguration (int argc, char* argv[],
                        std::string& ioXapianDBFilepath,
                        std::string& ioSQLDBTypeString,
                        std::string& ioSQLDBConnectionString,
-                       std::string& ioLogFilename) {
+                       std::string& ioLogFilename,
+                       unsigned short& ioLogLevel) {
 
   // Declare a group of options that will be allowed only on command line
   boost::program_options::options_description generic ("Generic options");
@@ -64,6 +65,9 @@ int readConfiguration (int argc, char* argv[],
     ("log,l",
      boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_OPENTREP_DEFAULT_LOG_FILENAME),
      "Filepath for the logs")
+    ("loglevel,g",
+     boost::program_options::value< unsigned short >(&ioLogLevel)->default_value(OPENTREP::DEFAULT_OPENTREP_LOG_LEVEL),
+     "Level of the logs (0 = critical, 1 = error, 2 = notification, 3 = warning, 4 = debug, 5 = verbose)")
     ;
 
   // Hidden options, will be allowed both on command line and
@@ -139,6 +143,11 @@ int readConfiguration (int argc, char* argv[],
     std::cout << "Log filename is: " << ioLogFilename << std::endl;
   }
 
+  if (ioLogLevel > OPENTREP::LOG::VERBOSE) {
+    ioLogLevel = OPENTREP::LOG::VERBOSE;
+  }
+  std::cout << "Log level is: " << ioLogLevel << std::endl;
+
   return 0;
 }
 
@@ -149,6 +158,9 @@ int main (int argc, char* argv[]) {
   // Output log File
   std::string lLogFilename;
 
+  // Level of the logs
+  unsigned short lLogLevel;
+
   // File-path of POR (points of reference)
   std::string lPORFilepathStr;
 
@@ -164,7 +176,8 @@ int main (int argc, char* argv[]) {
   // Call the command-line option parser
   const int lOptionParserStatus =
     readConfiguration (argc, argv, lPORFilepathStr, lXapianDBNameStr,
-                       lSQLDBTypeStr, lSQLDBConnectionStr, lLogFilename);
+                       lSQLDBTypeStr, lSQLDBConnectionStr, lLogFilename,
+                       lLogLevel);
 
   if (lOptionParserStatus == K_OPENTREP_EARLY_RETURN_STATUS) {
     return 0;
@@ -186,9 +199,11 @@ int main (int argc, char* argv[]) {
   const OPENTREP::TravelDBFilePath_T lXapianDBName (lXapianDBNameStr);
   const OPENTREP::DBType lDBType (lSQLDBTypeStr);
   const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (lSQLDBConnectionStr);
+  const OPENTREP::LOG::EN_LogLevel lLogLevelEnum =
+    static_cast<OPENTREP::LOG::EN_LogLevel> (lLogLevel);
   OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lPORFilepath,
                                               lXapianDBName, lDBType,
-                                              lSQLDBConnStr);
+                                              lSQLDBConnStr, lLogLevelEnum);
 
   // Launch the indexation
   const OPENTREP::NbOfDBEntries_T lNbOfEntries =
@@ -0,0 +1,485 @@
+// STL
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+// Boost (Extended STL)
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/program_options.hpp>
+// OpenTREP
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/LocationList.hpp>
+#include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/basic/OTransliterator.hpp>
+#include <opentrep/bom/WordHolder.hpp>
+#include <opentrep/bom/StringPartition.hpp>
+#include <opentrep/bom/WordCombinationHolder.hpp>
+#include <opentrep/bom/Levenshtein.hpp>
+#include <opentrep/bom/PORParserHelper.hpp>
+#include <opentrep/bom/BomJSONExport.hpp>
+#include <opentrep/bom/LocationExchange.hpp>
+#include <opentrep/service/Logger.hpp>
+#include <opentrep/config/opentrep-paths.hpp>
+#include <opentrep/batches/AllocationCounter.hpp>
+
+
+// //////// Constants //////
+/**
+ * Default name and location for the log file.
+ */
+const std::string K_OPENTREP_DEFAULT_LOG_FILENAME ("opentrep-microbench.log");
+
+/**
+ * Default minimal duration (in milliseconds) of the measure of every kernel.
+ */
+const unsigned int K_OPENTREP_DEFAULT_MIN_DURATION = 500;
+
+/**
+ * Travel query, with misspellings, tokenised and partitioned by the kernels.
+ * Its first words are taken, for the string partitions of 2 to 12 words.
+ */
+const std::string K_OPENTREP_TRAVEL_QUERY ("sna francicso rio de janero lso "
+                                           "angles reykyavki nice paris "
+                                           "london berlin");
+
+/**
+ * Minimal and maximal numbers of words of the string partitions.
+ */
+const unsigned short K_OPENTREP_MIN_NB_OF_PARTITION_WORDS = 2;
+const unsigned short K_OPENTREP_MAX_NB_OF_PARTITION_WORDS = 12;
+
+/**
+ * Strings compared by the Levenshtein distance.
+ */
+const std::string K_OPENTREP_LEVENSHTEIN_SOURCE ("rio de janero");
+const std::string K_OPENTREP_LEVENSHTEIN_TARGET ("rio de janeiro");
+
+/**
+ * ASCII, Latin-1 and Cyrillic strings (UTF-8 encoded) given to
+ * the transliterator.
+ */
+const std::string K_OPENTREP_ASCII_STRING ("San Francisco International "
+                                           "Airport");
+const std::string K_OPENTREP_LATIN1_STRING ("Aéroport de Nice Côte d'Azur");
+const std::string K_OPENTREP_CYRILLIC_STRING ("Аэропорт Ницца Лазурный "
+                                              "Берег");
+
+/**
+ * POR (point of reference) record, as in the POR file, parsed by
+ * the kernels (Nice Côte d'Azur airport).
+ */
+const std::string K_OPENTREP_POR_RECORD ("NCE^LFMN^^Y^6299418^^Nice Côte d'Azur International Airport^Nice Cote d'Azur International Airport^43.658411^7.215872^S^AIRP^0.132951159716^^^^FR^^France^Europe^B8^Provence-Alpes-Côte d'Azur^Provence-Alpes-Cote d'Azur^06^Département des Alpes-Maritimes^Departement des Alpes-Maritimes^062^06088^0^3^5^Europe/Paris^1.0^2.0^1.0^2013-11-28^NCE^Nice^NCE|2990440|Nice|Nice^^^A^http://en.wikipedia.org/wiki/Nice_C%C3%B4te_d%27Azur_Airport^de|Flughafen Nizza|=en|Nice Côte d'Azur International Airport|=es|Niza Aeropuerto|ps=fr|Aéroport de Nice Côte d'Azur|=en|Nice Airport|s=ru|Аэропорт Ницца Лазурный Берег|");
+
+/**
+ * Number of locations exported (in JSON and Protobuf) by the kernels.
+ */
+const unsigned short K_OPENTREP_NB_OF_EXPORTED_LOCATIONS = 10;
+
+
+// ///////// Parsing of Options & Configuration /////////
+/** Early return status (so that it can be differentiated from an error). */
+const int K_OPENTREP_EARLY_RETURN_STATUS = 99;
+
+/** Read and parse the command line options. */
+int readConfiguration (int argc, char* argv[],
+                       unsigned int& ioMinDuration,
+                       std::string& ioKernelFilter,
+                       std::string& ioLogFilename,
+                       unsigned short& ioLogLevel) {
+
+  // Declare a group of options that will be allowed only on command line
+  boost::program_options::options_description generic ("Generic options");
+  generic.add_options()
+    ("prefix", "print installation prefix")
+    ("version,v", "print version string")
+    ("help,h", "produce help message");
+
+  // Declare a group of options that will be allowed both on command
+  // line and in config file
+  boost::program_options::options_description config ("Configuration");
+  config.add_options()
+    ("mintime,t",
+     boost::program_options::value< unsigned int >(&ioMinDuration)->default_value(K_OPENTREP_DEFAULT_MIN_DURATION),
+     "Minimal duration of the measure of every kernel, in milliseconds")
+    ("filter,f",
+     boost::program_options::value< std::string >(&ioKernelFilter),
+     "Only the kernels the name of which contains that string are run (e.g., transliterate)")
+    ("log,l",
+     boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_OPENTREP_DEFAULT_LOG_FILENAME),
+     "Filepath for the logs")
+    ("loglevel,g",
+     boost::program_options::value< unsigned short >(&ioLogLevel)->default_value(OPENTREP::DEFAULT_OPENTREP_LOG_LEVEL),
+     "Level of the logs (0 = critical, 1 = error, 2 = notification, 3 = warning, 4 = debug, 5 = verbose)")
+    ;
+
+  // Hidden options, will be allowed both on command line and
+  // in config file, but will not be shown to the user.
+  boost::program_options::options_description hidden ("Hidden options");
+  hidden.add_options()
+    ("copyright",
+     boost::program_options::value< std::vector<std::string> >(),
+     "Show the copyright (license)");
+
+  boost::program_options::options_description cmdline_options;
+  cmdline_options.add(generic).add(config).add(hidden);
+
+  boost::program_options::options_description config_file_options;
+  config_file_options.add(config).add(hidden);
+
+  boost::program_options::options_description visible ("Allowed options");
+  visible.add(generic).add(config);
+
+  boost::program_options::positional_options_description p;
+  p.add ("copyright", -1);
+
+  boost::program_options::variables_map vm;
+  boost::program_options::
+    store (boost::program_options::command_line_parser (argc, argv).
+           options (cmdline_options).positional(p).run(), vm);
+
+  std::ifstream ifs ("opentrep-microbench.cfg");
+  boost::program_options::store (parse_config_file (ifs, config_file_options),
+                                 vm);
+  boost::program_options::notify (vm);
+
+  if (vm.count ("help")) {
+    std::cout << visible << std::endl;
+    return K_OPENTREP_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("version")) {
+    std::cout << PACKAGE_NAME << ", version " << PACKAGE_VERSION << std::endl;
+    return K_OPENTREP_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("prefix")) {
+    std::cout << "Installation prefix: " << PREFIXDIR << std::endl;
+    return K_OPENTREP_EARLY_RETURN_STATUS;
+  }
+
+  if (ioMinDuration == 0) {
+    ioMinDuration = 1;
+  }
+  std::cout << "Minimal duration of the measure of every kernel: "
+            << ioMinDuration << "ms" << std::endl;
+
+  if (ioKernelFilter.empty() == false) {
+    std::cout << "Kernel filter: '" << ioKernelFilter << "'" << std::endl;
+  }
+
+  std::cout << "Log filename is: " << ioLogFilename << std::endl;
+
+  if (ioLogLevel > OPENTREP::LOG::VERBOSE) {
+    ioLogLevel = OPENTREP::LOG::VERBOSE;
+  }
+  std::cout << "Log level is: " << ioLogLevel << std::endl;
+
+  return 0;
+}
+
+
+// //////// Kernels //////
+/**
+ * Inputs of the kernels, prepared once for all.
+ */
+struct KernelInput {
+  /** Word list of the travel query. */
+  OPENTREP::WordList_T _wordList;
+  /** Transliterator (the construction of which is not measured). */
+  OPENTREP::OTransliterator _transliterator;
+  /** Locations to be exported. */
+  OPENTREP::LocationList_T _locationList;
+  /** (Empty) list of the non-matched words, to be exported. */
+  OPENTREP::WordList_T _nonMatchedWordList;
+};
+
+/**
+ * Sink of the results of the kernels, so that the compiler cannot discard
+ * the calls to them.
+ */
+static volatile std::size_t gSink = 0;
+
+/**
+ * A kernel runs once on the given string, and on the prepared inputs.
+ */
+typedef void (*Kernel_T) (const KernelInput&, const std::string&);
+
+// //////////////////////////////////////////////////////////////////////
+void runTokenise (const KernelInput& iInput, const std::string& iString) {
+  OPENTREP::WordList_T lWordList;
+  OPENTREP::WordHolder::tokeniseStringIntoWordList (iString, lWordList);
+  gSink += lWordList.size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runCreateString (const KernelInput& iInput, const std::string& iString) {
+  const std::string& lString =
+    OPENTREP::WordHolder::createStringFromWordList (iInput._wordList);
+  gSink += lString.size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runStringPartition (const KernelInput& iInput,
+                         const std::string& iString) {
+  const OPENTREP::StringPartition lStringPartition (iString);
+  gSink += lStringPartition._partition.size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runWordCombination (const KernelInput& iInput,
+                         const std::string& iString) {
+  const OPENTREP::WordCombinationHolder lWordCombinationHolder (iString);
+  gSink += lWordCombinationHolder._list.size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runLevenshtein (const KernelInput& iInput, const std::string& iString) {
+  gSink += OPENTREP::Levenshtein::getDistance (iString,
+                                               K_OPENTREP_LEVENSHTEIN_TARGET);
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runNormalise (const KernelInput& iInput, const std::string& iString) {
+  gSink += iInput._transliterator.normalise (iString).size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runUnaccent (const KernelInput& iInput, const std::string& iString) {
+  gSink += iInput._transliterator.unaccent (iString).size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runTransliterate (const KernelInput& iInput,
+                       const std::string& iString) {
+  gSink += iInput._transliterator.transliterate (iString).size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runPORParser (const KernelInput& iInput, const std::string& iString) {
+  OPENTREP::PORStringParser lStringParser (iString);
+  const OPENTREP::Location& lLocation = lStringParser.generateLocation();
+  gSink += lLocation.getIataCode().size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runJSONExport (const KernelInput& iInput, const std::string& iString) {
+  std::ostringstream lJSONStr;
+  OPENTREP::BomJSONExport::jsonExportLocationList (lJSONStr,
+                                                   iInput._locationList);
+  gSink += lJSONStr.str().size();
+}
+
+// //////////////////////////////////////////////////////////////////////
+void runProtobufExport (const KernelInput& iInput,
+                        const std::string& iString) {
+  std::ostringstream lProtobufStr;
+  OPENTREP::LocationExchange::exportLocationList (lProtobufStr,
+                                                  iInput._locationList,
+                                                  iInput._nonMatchedWordList);
+  gSink += lProtobufStr.str().size();
+}
+
+/**
+ * Kernel to be measured, along with its name and the string it runs on.
+ */
+struct KernelSpec {
+  /** Constructor. */
+  KernelSpec (const std::string& iName, const Kernel_T iKernel,
+              const std::string& iString)
+    : _name (iName), _kernel (iKernel), _string (iString) {
+  }
+
+  std::string _name;
+  Kernel_T _kernel;
+  std::string _string;
+};
+
+/**
+ * (STL) List of kernels.
+ */
+typedef std::vector<KernelSpec> KernelSpecList_T;
+
+/**
+ * Build the list of the kernels to be measured.
+ */
+void buildKernelList (KernelSpecList_T& ioKernelList) {
+  ioKernelList.push_back (KernelSpec ("tokeniseStringIntoWordList",
+                                      &runTokenise, K_OPENTREP_TRAVEL_QUERY));
+  ioKernelList.push_back (KernelSpec ("createStringFromWordList",
+                                      &runCreateString,
+                                      K_OPENTREP_TRAVEL_QUERY));
+
+  // String partitions of the first words of the travel query
+  OPENTREP::WordList_T lWordList;
+  OPENTREP::WordHolder::tokeniseStringIntoWordList (K_OPENTREP_TRAVEL_QUERY,
+                                                    lWordList);
+  OPENTREP::WordList_T lPartitionWordList;
+  for (OPENTREP::WordList_T::const_iterator itWord = lWordList.begin();
+       itWord != lWordList.end()
+         && lPartitionWordList.size() < K_OPENTREP_MAX_NB_OF_PARTITION_WORDS;
+       ++itWord) {
+    lPartitionWordList.push_back (*itWord);
+    if (lPartitionWordList.size() < K_OPENTREP_MIN_NB_OF_PARTITION_WORDS) {
+      continue;
+    }
+
+    const std::string& lPartitionString =
+      OPENTREP::WordHolder::createStringFromWordList (lPartitionWordList);
+    std::ostringstream lNameStr;
+    lNameStr << "StringPartition/" << lPartitionWordList.size();
+    ioKernelList.push_back (KernelSpec (lNameStr.str(), &runStringPartition,
+                                        lPartitionString));
+  }
+
+  ioKernelList.push_back (KernelSpec ("WordCombinationHolder",
+                                      &runWordCombination,
+                                      K_OPENTREP_TRAVEL_QUERY));
+  ioKernelList.push_back (KernelSpec ("Levenshtein::getDistance",
+                                      &runLevenshtein,
+                                      K_OPENTREP_LEVENSHTEIN_SOURCE));
+
+  // Transliteration of ASCII, Latin-1 and Cyrillic strings
+  const std::string lScriptArray[3] = { "ascii", "latin1", "cyrillic" };
+  const std::string lStringArray[3] = { K_OPENTREP_ASCII_STRING,
+                                        K_OPENTREP_LATIN1_STRING,
+                                        K_OPENTREP_CYRILLIC_STRING };
+  for (unsigned short idx = 0; idx != 3; ++idx) {
+    ioKernelList.push_back (KernelSpec ("normalise/" + lScriptArray[idx],
+                                        &runNormalise, lStringArray[idx]));
+    ioKernelList.push_back (KernelSpec ("unaccent/" + lScriptArray[idx],
+                                        &runUnaccent, lStringArray[idx]));
+    ioKernelList.push_back (KernelSpec ("transliterate/" + lScriptArray[idx],
+                                        &runTransliterate,
+                                        lStringArray[idx]));
+  }
+
+  ioKernelList.push_back (KernelSpec ("PORStringParser::generateLocation",
+                                      &runPORParser, K_OPENTREP_POR_RECORD));
+  ioKernelList.push_back (KernelSpec ("jsonExportLocationList",
+                                      &runJSONExport, ""));
+  ioKernelList.push_back (KernelSpec ("exportLocationList",
+                                      &runProtobufExport, ""));
+}
+
+/**
+ * Measure the given kernel: the number of iterations is doubled until
+ * the measure lasts at least the given duration. The duration and
+ * the memory allocations of the last measure are reported, per iteration.
+ */
+void measureKernel (const KernelSpec& iKernelSpec, const KernelInput& iInput,
+                    const unsigned int iMinDuration) {
+  // Warm-up (e.g., for the ICU transliterators to initialise their caches)
+  iKernelSpec._kernel (iInput, iKernelSpec._string);
+
+  unsigned long lNbOfIterations = 1;
+  long lElapsedTime = 0;
+  unsigned long lNbOfAllocations = 0;
+  unsigned long lNbOfAllocatedBytes = 0;
+  while (true) {
+    const unsigned long lNbOfAllocationsBefore = gNbOfAllocations.load();
+    const unsigned long lNbOfAllocatedBytesBefore =
+      gNbOfAllocatedBytes.load();
+    const boost::posix_time::ptime lStartTime =
+      boost::posix_time::microsec_clock::universal_time();
+
+    for (unsigned long idx = 0; idx != lNbOfIterations; ++idx) {
+      iKernelSpec._kernel (iInput, iKernelSpec._string);
+    }
+
+    const boost::posix_time::ptime lEndTime =
+      boost::posix_time::microsec_clock::universal_time();
+    lElapsedTime = (lEndTime - lStartTime).total_microseconds();
+    lNbOfAllocations = gNbOfAllocations.load() - lNbOfAllocationsBefore;
+    lNbOfAllocatedBytes =
+      gNbOfAllocatedBytes.load() - lNbOfAllocatedBytesBefore;
+
+    if (lElapsedTime >= static_cast<long> (iMinDuration) * 1000) {
+      break;
+    }
+    lNbOfIterations *= 2;
+  }
+
+  const double lNbOfIterationsDouble = static_cast<double> (lNbOfIterations);
+  std::cout << std::left << std::setw (36) << iKernelSpec._name << std::right
+            << std::setw (12) << lNbOfIterations
+            << std::fixed << std::setprecision (1)
+            << std::setw (14) << lElapsedTime * 1e3 / lNbOfIterationsDouble
+            << std::setw (12) << lNbOfAllocations / lNbOfIterationsDouble
+            << std::setw (14) << lNbOfAllocatedBytes / lNbOfIterationsDouble
+            << std::endl;
+}
+
+
+// /////////////// M A I N /////////////////
+int main (int argc, char* argv[]) {
+
+  // Output log File
+  std::string lLogFilename;
+
+  // Level of the logs
+  unsigned short lLogLevel;
+
+  // Minimal duration of the measure of every kernel (in milliseconds)
+  unsigned int lMinDuration;
+
+  // Filter on the names of the kernels
+  std::string lKernelFilter;
+
+  // Call the command-line option parser
+  const int lOptionParserStatus =
+    readConfiguration (argc, argv, lMinDuration, lKernelFilter,
+                       lLogFilename, lLogLevel);
+
+  if (lOptionParserStatus == K_OPENTREP_EARLY_RETURN_STATUS) {
+    return 0;
+  }
+
+  // Set the log parameters. No OpenTREP service is needed by the kernels,
+  // so that the logger is directly set up.
+  std::ofstream logOutputFile;
+  // open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+  const OPENTREP::LOG::EN_LogLevel lLogLevelEnum =
+    static_cast<OPENTREP::LOG::EN_LogLevel> (lLogLevel);
+  OPENTREP::Logger::instance().setLogParameters (lLogLevelEnum, logOutputFile);
+
+  // Prepare the inputs of the kernels
+  KernelInput lInput;
+  OPENTREP::WordHolder::tokeniseStringIntoWordList (K_OPENTREP_TRAVEL_QUERY,
+                                                    lInput._wordList);
+  OPENTREP::PORStringParser lStringParser (K_OPENTREP_POR_RECORD);
+  const OPENTREP::Location& lLocation = lStringParser.generateLocation();
+  for (unsigned short idx = 0; idx != K_OPENTREP_NB_OF_EXPORTED_LOCATIONS;
+       ++idx) {
+    lInput._locationList.push_back (lLocation);
+  }
+
+  KernelSpecList_T lKernelList;
+  buildKernelList (lKernelList);
+
+  // Measure the kernels
+  std::cout << std::left << std::setw (36) << "Kernel" << std::right
+            << std::setw (12) << "Iterations" << std::setw (14) << "ns/op"
+            << std::setw (12) << "allocs/op" << std::setw (14) << "bytes/op"
+            << std::endl;
+  for (KernelSpecList_T::const_iterator itKernel = lKernelList.begin();
+       itKernel != lKernelList.end(); ++itKernel) {
+    const KernelSpec& lKernelSpec = *itKernel;
+    if (lKernelFilter.empty() == false
+        && lKernelSpec._name.find (lKernelFilter) == std::string::npos) {
+      continue;
+    }
+    measureKernel (lKernelSpec, lInput, lMinDuration);
+  }
+
+  // Close the Log outputFile
+  logOutputFile.close();
+
+  return 0;
+}
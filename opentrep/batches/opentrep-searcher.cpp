@@ -106,7 +106,9 @@ int readConfiguration (int argc, char* argv[],
                        std::string& ioSQLDBTypeString,
                        std::string& ioSQLDBConnectionString,
                        std::string& ioLogFilename,
-                       unsigned short& ioSearchType) {
+                       unsigned short& ioLogLevel,
+                       unsigned short& ioSearchType,
+                       bool& ioExplain) {
 
   // Initialise the travel query string, if that one is empty
   if (ioQueryString.empty() == true) {
@@ -143,9 +145,15 @@ int readConfiguration (int argc, char* argv[],
     ("log,l",
      boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_OPENTREP_DEFAULT_LOG_FILENAME),
      "Filepath for the logs")
+    ("loglevel,g",
+     boost::program_options::value< unsigned short >(&ioLogLevel)->default_value(OPENTREP::DEFAULT_OPENTREP_LOG_LEVEL),
+     "Level of the logs (0 = critical, 1 = error, 2 = notification, 3 = warning, 4 = debug, 5 = verbose)")
     ("type,y",
      boost::program_options::value<unsigned short>(&ioSearchType)->default_value(K_OPENTREP_DEFAULT_SEARCH_TYPE), 
      "Type of search request (0 = full text, 1 = coordinates)")
+    ("explain,x",
+     boost::program_options::bool_switch(&ioExplain),
+     "Dump, in JSON, the explanation of the search (slices, string partitions, full-text matches and scores)")
     ("query,q",
      boost::program_options::value< WordList_T >(&lWordList)->multitoken(),
      "Travel query word list (e.g. sna francicso rio de janero lso anglese reykyavki), which sould be located at the end of the command line (otherwise, the other options would be interpreted as part of that travel query word list)")
@@ -219,7 +227,16 @@ int readConfiguration (int argc, char* argv[],
     std::cout << "Log filename is: " << ioLogFilename << std::endl;
   }
 
+  if (ioLogLevel > OPENTREP::LOG::VERBOSE) {
+    ioLogLevel = OPENTREP::LOG::VERBOSE;
+  }
+  std::cout << "Log level is: " << ioLogLevel << std::endl;
+
   std::cout << "The type of search is: " << ioSearchType << std::endl;
+
+  if (ioExplain == true) {
+    std::cout << "The search will be explained" << std::endl;
+  }
   
   std::cout << "The spelling error distance is: " << ioSpellingErrorDistance
             << std::endl;
@@ -234,15 +251,20 @@ int readConfiguration (int argc, char* argv[],
  * Helper function
  */
 std::string parseQuery (OPENTREP::OPENTREP_Service& ioOpentrepService,
-                        const OPENTREP::TravelQuery_T& iTravelQuery) {
+                        const OPENTREP::TravelQuery_T& iTravelQuery,
+                        const bool iExplain) {
   std::ostringstream oStr;
 
-  // Query the Xapian database (index)
+  // Query the Xapian database (index), tracing the search if needed
   OPENTREP::WordList_T lNonMatchedWordList;
   OPENTREP::LocationList_T lLocationList;
-  const OPENTREP::NbOfMatches_T nbOfMatches =
+  OPENTREP::SearchExplanation lExplanation;
+  const OPENTREP::NbOfMatches_T nbOfMatches = (iExplain == true) ?
     ioOpentrepService.interpretTravelRequest (iTravelQuery, lLocationList,
-                                              lNonMatchedWordList);
+                                              lNonMatchedWordList,
+                                              lExplanation)
+    : ioOpentrepService.interpretTravelRequest (iTravelQuery, lLocationList,
+                                                lNonMatchedWordList);
 
   oStr << nbOfMatches << " (geographical) location(s) have been found "
        << "matching your query (`" << iTravelQuery << "'). "
@@ -271,6 +293,11 @@ std::string parseQuery (OPENTREP::OPENTREP_Service& ioOpentrepService,
     }
   }
 
+  if (iExplain == true) {
+    oStr << "Explanation of the search:" << std::endl
+         << lExplanation.toJSONString();
+  }
+
   return oStr.str();
 }
 
@@ -303,6 +330,9 @@ int main (int argc, char* argv[]) {
   // Output log File
   std::string lLogFilename;
 
+  // Level of the logs
+  unsigned short lLogLevel;
+
   // Xapian database name (directory of the index)
   std::string lXapianDBNameStr;
 
@@ -318,11 +348,14 @@ int main (int argc, char* argv[]) {
   // SQL database connection string
   std::string lSQLDBConnectionStr;
 
+  // Whether the search should be explained
+  bool lExplain = false;
+
   // Call the command-line option parser
   const int lOptionParserStatus = 
     readConfiguration (argc, argv, lSpellingErrorDistance, lTravelQuery,
                        lXapianDBNameStr, lSQLDBTypeStr, lSQLDBConnectionStr,
-                       lLogFilename, lSearchType);
+                       lLogFilename, lLogLevel, lSearchType, lExplain);
 
   if (lOptionParserStatus == K_OPENTREP_EARLY_RETURN_STATUS) {
     return 0;
@@ -339,11 +372,15 @@ int main (int argc, char* argv[]) {
     const OPENTREP::TravelDBFilePath_T lXapianDBName (lXapianDBNameStr);
     const OPENTREP::DBType lDBType (lSQLDBTypeStr);
     const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (lSQLDBConnectionStr);
+    const OPENTREP::LOG::EN_LogLevel lLogLevelEnum =
+      static_cast<OPENTREP::LOG::EN_LogLevel> (lLogLevel);
     OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lXapianDBName,
-                                                lDBType, lSQLDBConnStr);
+                                                lDBType, lSQLDBConnStr,
+                                                lLogLevelEnum);
 
     // Parse the query and retrieve the places from Xapian only
-    const std::string& lOutput = parseQuery (opentrepService, lTravelQuery);
+    const std::string& lOutput = parseQuery (opentrepService, lTravelQuery,
+                                             lExplain);
     std::cout << lOutput;
 
   } else {
@@ -16,6 +16,7 @@ namespace OPENTREP {
    */
   class BomAbstract {
     friend class FacBomAbstract;
+    friend class FacQueryScope;
   public:
     // /////////// Display support methods /////////
     /**
@@ -9,6 +9,7 @@
 // OpenTREP
 #include <opentrep/Location.hpp>
 #include <opentrep/bom/BomJSONExport.hpp>
+#include <opentrep/service/StatisticsRecorder.hpp>
 
 namespace OPENTREP { 
 
@@ -16,6 +17,7 @@ namespace OPENTREP {
   void BomJSONExport::
   jsonExportLocationList (std::ostream& oStream,
                           const LocationList_T& iLocationList) {
+    const SearchStageTimer lExportTimer (SearchStage::EXPORT);
 
     // Create empty Boost.Property_Tree objects
     bpt::ptree lPT;
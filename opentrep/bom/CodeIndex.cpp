@@ -0,0 +1,144 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// Boost
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+// OpenTrep
+#include <opentrep/bom/CodeIndex.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  const unsigned int CodeIndex::NO_LOCATION_IDX = static_cast<unsigned int>(-1);
+
+  // //////////////////////////////////////////////////////////////////////
+  CodeIndex::CodeIndex() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  CodeIndex::~CodeIndex() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CodeIndex::addLocation (const Location& iLocation) {
+    const unsigned int lLocationIdx = _locationArray.size();
+    _locationArray.push_back (iLocation);
+
+    // IATA code
+    const std::string lIataCode (iLocation.getIataCode());
+    if (lIataCode.empty() == false) {
+      const std::string& lIataCodeUpper =
+        boost::algorithm::to_upper_copy (lIataCode);
+      _iataCodeMap[lIataCodeUpper]._locationIdxList.push_back (lLocationIdx);
+    }
+
+    // ICAO code
+    const std::string lIcaoCode (iLocation.getIcaoCode());
+    if (lIcaoCode.empty() == false) {
+      const std::string& lIcaoCodeUpper =
+        boost::algorithm::to_upper_copy (lIcaoCode);
+      _icaoCodeMap[lIcaoCodeUpper]._locationIdxList.push_back (lLocationIdx);
+    }
+
+    // Geonames ID (the POR not referenced by Geonames have got a null ID)
+    const GeonamesID_T& lGeonamesID = iLocation.getGeonamesID();
+    if (lGeonamesID != 0) {
+      _geonamesIDMap[lGeonamesID]._locationIdxList.push_back (lLocationIdx);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CodeIndex::finalise() {
+    for (CodeMap_T::iterator itEntry = _iataCodeMap.begin();
+         itEntry != _iataCodeMap.end(); ++itEntry) {
+      CodeEntry& lCodeEntry = itEntry->second;
+
+      // Same selection as when the POR are retrieved from the SQL database
+      // (see DBManager::getPORByIATACode())
+      lCodeEntry._bestLocationIdx = NO_LOCATION_IDX;
+      PageRank_T lHighestPRValue = 0.0;
+      for (LocationIdxList_T::const_iterator itIdx =
+             lCodeEntry._locationIdxList.begin();
+           itIdx != lCodeEntry._locationIdxList.end(); ++itIdx) {
+        const unsigned int lLocationIdx = *itIdx;
+        const Location& lLocation = _locationArray[lLocationIdx];
+        const PageRank_T& lPRValue = lLocation.getPageRank();
+        if (lPRValue > lHighestPRValue) {
+          lCodeEntry._bestLocationIdx = lLocationIdx;
+          lHighestPRValue = lPRValue;
+        }
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T CodeIndex::addLocations (const CodeEntry& iCodeEntry,
+                                         const std::string& iCode,
+                                         LocationList_T& ioLocationList) const {
+    for (LocationIdxList_T::const_iterator itIdx =
+           iCodeEntry._locationIdxList.begin();
+         itIdx != iCodeEntry._locationIdxList.end(); ++itIdx) {
+      const unsigned int lLocationIdx = *itIdx;
+      ioLocationList.push_back (_locationArray[lLocationIdx]);
+      ioLocationList.back().setCorrectedKeywords (iCode);
+    }
+    return iCodeEntry._locationIdxList.size();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T CodeIndex::getPORByIATACode (const std::string& iIataCode,
+                                             LocationList_T& ioLocationList) const {
+    const std::string& lIataCodeUpper =
+      boost::algorithm::to_upper_copy (iIataCode);
+    CodeMap_T::const_iterator itEntry = _iataCodeMap.find (lIataCodeUpper);
+    if (itEntry == _iataCodeMap.end()) {
+      return 0;
+    }
+
+    // Add only the location with the highest PageRank value
+    const CodeEntry& lCodeEntry = itEntry->second;
+    if (lCodeEntry._bestLocationIdx != NO_LOCATION_IDX) {
+      ioLocationList.push_back (_locationArray[lCodeEntry._bestLocationIdx]);
+      ioLocationList.back().setCorrectedKeywords (iIataCode);
+    }
+    return lCodeEntry._locationIdxList.size();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T CodeIndex::getPORByICAOCode (const std::string& iIcaoCode,
+                                             LocationList_T& ioLocationList) const {
+    const std::string& lIcaoCodeUpper =
+      boost::algorithm::to_upper_copy (iIcaoCode);
+    CodeMap_T::const_iterator itEntry = _icaoCodeMap.find (lIcaoCodeUpper);
+    if (itEntry == _icaoCodeMap.end()) {
+      return 0;
+    }
+    return addLocations (itEntry->second, iIcaoCode, ioLocationList);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T CodeIndex::getPORByGeonameID (const GeonamesID_T& iGeonameID,
+                                              LocationList_T& ioLocationList) const {
+    GeonamesIDMap_T::const_iterator itEntry = _geonamesIDMap.find (iGeonameID);
+    if (itEntry == _geonamesIDMap.end()) {
+      return 0;
+    }
+    const std::string lGeonamesIDStr =
+      boost::lexical_cast<std::string> (iGeonameID);
+    return addLocations (itEntry->second, lGeonamesIDStr, ioLocationList);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string CodeIndex::describe() const {
+    std::ostringstream oStr;
+    oStr << "Index of " << _locationArray.size() << " locations, by "
+         << _iataCodeMap.size() << " IATA codes, " << _icaoCodeMap.size()
+         << " ICAO codes and " << _geonamesIDMap.size() << " Geonames IDs";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,183 @@
+#ifndef __OPENTREP_BOM_CODEINDEX_HPP
+#define __OPENTREP_BOM_CODEINDEX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// Boost
+#include <boost/unordered_map.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/Location.hpp>
+#include <opentrep/LocationList.hpp>
+#include <opentrep/basic/StructAbstract.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief In-memory index of the POR (points of reference) by code.
+   *
+   * When a travel query is made only of IATA/ICAO codes and Geonames IDs
+   * (e.g., "sfo jfk lhr"), the corresponding locations are looked up
+   * within that index, rather than within the SQL database or the Xapian
+   * index. The locations are decoded once for all, when the index is
+   * built, and the location with the highest PageRank value is
+   * pre-selected for every IATA code.
+   */
+  struct CodeIndex : public StructAbstract {
+  public:
+    // //////////////// Business Methods //////////////////
+    /**
+     * Add the given location to the index.
+     *
+     * \note The index must be finalised (see finalise()) before being
+     *       looked up.
+     */
+    void addLocation (const Location&);
+
+    /**
+     * Select, for every IATA code, the location with the highest PageRank
+     * value.
+     */
+    void finalise();
+
+    /**
+     * Add to the given list the location, having the highest PageRank
+     * value, corresponding to the given IATA code.
+     *
+     * @param const std::string& IATA code (e.g., "sfo"), in any case.
+     * @param LocationList_T& List to which the location is added.
+     * @return NbOfMatches_T Number of locations having that IATA code.
+     */
+    NbOfMatches_T getPORByIATACode (const std::string&, LocationList_T&) const;
+
+    /**
+     * Add to the given list the locations corresponding to the given
+     * ICAO code.
+     *
+     * @param const std::string& ICAO code (e.g., "lfmn"), in any case.
+     * @param LocationList_T& List to which the locations are added.
+     * @return NbOfMatches_T Number of added locations.
+     */
+    NbOfMatches_T getPORByICAOCode (const std::string&, LocationList_T&) const;
+
+    /**
+     * Add to the given list the locations corresponding to the given
+     * Geonames ID.
+     *
+     * @param const GeonamesID_T& Geonames ID (e.g., 5391989).
+     * @param LocationList_T& List to which the locations are added.
+     * @return NbOfMatches_T Number of added locations.
+     */
+    NbOfMatches_T getPORByGeonameID (const GeonamesID_T&,
+                                     LocationList_T&) const;
+
+    /**
+     * Return the number of indexed locations.
+     */
+    size_t size() const {
+      return _locationArray.size();
+    }
+
+  public:
+    // /////////// Display support methods /////////
+    /**
+     * Get the serialised version of the structure.
+     */
+    std::string describe() const;
+
+  public:
+    // //////////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    CodeIndex();
+
+    /**
+     * Default destructor.
+     */
+    ~CodeIndex();
+
+  private:
+    // //////////////// Type definitions //////////////////
+    /**
+     * List of the indices (within the array of locations) of the locations
+     * sharing the same code.
+     */
+    typedef std::vector<unsigned int> LocationIdxList_T;
+
+    /**
+     * Locations sharing the same code.
+     */
+    struct CodeEntry {
+      /**
+       * Constructor.
+       */
+      CodeEntry() : _bestLocationIdx (NO_LOCATION_IDX) {
+      }
+
+      /**
+       * Indices of the locations.
+       */
+      LocationIdxList_T _locationIdxList;
+
+      /**
+       * Index of the location with the highest PageRank value, if any
+       * (i.e., with a PageRank value strictly positive).
+       */
+      unsigned int _bestLocationIdx;
+    };
+
+    /**
+     * Index of the locations by (upper case) code.
+     */
+    typedef boost::unordered_map<std::string, CodeEntry> CodeMap_T;
+
+    /**
+     * Index of the locations by Geonames ID.
+     */
+    typedef boost::unordered_map<GeonamesID_T, CodeEntry> GeonamesIDMap_T;
+
+    /**
+     * Marker of the absence of location with a (strictly) positive
+     * PageRank value.
+     */
+    static const unsigned int NO_LOCATION_IDX;
+
+  private:
+    // //////////////// Helper Methods //////////////////
+    /**
+     * Add to the given list copies of the locations of the given entry,
+     * with the code as corrected keywords.
+     */
+    NbOfMatches_T addLocations (const CodeEntry&, const std::string& iCode,
+                                LocationList_T&) const;
+
+  private:
+    // //////////////// Attributes ///////////////
+    /**
+     * Array of the (decoded) locations.
+     */
+    std::vector<Location> _locationArray;
+
+    /**
+     * Index by IATA code.
+     */
+    CodeMap_T _iataCodeMap;
+
+    /**
+     * Index by ICAO code.
+     */
+    CodeMap_T _icaoCodeMap;
+
+    /**
+     * Index by Geonames ID.
+     */
+    GeonamesIDMap_T _geonamesIDMap;
+  };
+
+}
+#endif // __OPENTREP_BOM_CODEINDEX_HPP
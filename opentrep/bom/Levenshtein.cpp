@@ -2,32 +2,66 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <cassert>
 #include <string>
 #include <vector>
+// Boost
+#include <boost/cstdint.hpp>
 // OpenTREP
 #include <opentrep/bom/Levenshtein.hpp>
 
 namespace OPENTREP {
 
-  // //////////////////////////////////////////////////////////////////
-  int Levenshtein::getDistance (const std::string& iSource,
-                                const std::string& iTarget) {
+  /**
+   * Bit-vector, encoding 64 rows of a column of the dynamic programming
+   * matrix.
+   */
+  typedef boost::uint64_t BitVector_T;
+
+  /**
+   * Unicode code point (or byte).
+   */
+  typedef boost::uint32_t Symbol_T;
 
+  /**
+   * Maximal number of bit-vectors (blocks) per column.
+   */
+  static const unsigned short K_LEVENSHTEIN_MAX_NB_OF_BLOCKS = 8;
+
+  /**
+   * Maximal length of the strings processed by the bit-parallel algorithm.
+   */
+  static const unsigned short K_LEVENSHTEIN_MAX_LENGTH =
+    64 * K_LEVENSHTEIN_MAX_NB_OF_BLOCKS;
+
+  /**
+   * The transpositions involving one of the first two characters are not
+   * taken into account (see the class documentation): the corresponding
+   * bits are masked out for the first block.
+   */
+  static const BitVector_T K_LEVENSHTEIN_TRANSPOSITION_MASK =
+    ~static_cast<BitVector_T> (3);
+
+  /**
+   * Calculate the edit distance by dynamic programming, on any kind of
+   * character (e.g., bytes or Unicode code points).
+   */
+  // //////////////////////////////////////////////////////////////////
+  template <typename SOURCE, typename TARGET>
+  int getDistanceByMatrix (const SOURCE& iSource, const int n,
+                           const TARGET& iTarget, const int m) {
     // Step 1
 
-    const int n = iSource.length();
-    const int m = iTarget.length();
-    
     if (n == 0) {
       return m;
     }
-    
+
     if (m == 0) {
       return n;
     }
 
     // Definition of Matrix Type
-    typedef std::vector<std::vector<int> > Matrix_T; 
+    typedef std::vector<std::vector<int> > Matrix_T;
 
     Matrix_T matrix (n+1);
 
@@ -52,20 +86,20 @@ namespace OPENTREP {
 
     for (int i = 1; i <= n; i++) {
 
-      const char s_i = iSource[i-1];
+      const Symbol_T s_i = iSource[i-1];
 
       // Step 4
 
       for (int j = 1; j <= m; j++) {
 
-        const char t_j = iTarget[j-1];
+        const Symbol_T t_j = iTarget[j-1];
 
         // Step 5
 
         int cost;
         if (s_i == t_j) {
           cost = 0;
-          
+
         } else {
           cost = 1;
         }
@@ -79,21 +113,21 @@ namespace OPENTREP {
 
         // Step 6A: Cover transposition, in addition to deletion,
         // insertion and substitution. This step is taken from:
-        // Berghel, Hal ; Roach, David : "An Extension of Ukkonen's 
+        // Berghel, Hal ; Roach, David : "An Extension of Ukkonen's
         // Enhanced Dynamic Programming ASM Algorithm"
         // (http://www.acm.org/~hlb/publications/asm/asm.html)
 
         if (i>2 && j>2) {
           int trans = matrix[i-2][j-2] + 1;
 
-          if (iSource[i-2] != t_j) {
+          if (static_cast<Symbol_T> (iSource[i-2]) != t_j) {
             trans++;
           }
-          
-          if (s_i != iTarget[j-2]) {
+
+          if (s_i != static_cast<Symbol_T> (iTarget[j-2])) {
             trans++;
           }
-          
+
           if (cell > trans) {
             cell = trans;
           }
@@ -108,4 +142,443 @@ namespace OPENTREP {
     return matrix[n][m];
   }
 
+  /**
+   * Calculate the edit distance with the bit-parallel algorithm, when the
+   * pattern (the string encoded within the bit-vectors) is not longer than
+   * 64 characters.
+   *
+   * For every character of the text, iPeq(j) gives the bit-vector of the
+   * positions, within the pattern, of that character.
+   */
+  // //////////////////////////////////////////////////////////////////
+  template <typename PEQ>
+  int getDistanceOnSingleBlock (const unsigned int iPatternLength,
+                                const unsigned int iTextLength,
+                                const PEQ& iPeq) {
+    assert (iPatternLength >= 1 && iPatternLength <= 64);
+    const BitVector_T lLastBit =
+      static_cast<BitVector_T> (1) << (iPatternLength - 1);
+
+    // First column: D[i][0] = i, i.e., all the vertical deltas are +1
+    BitVector_T VP = lLastBit | (lLastBit - 1);
+    BitVector_T VN = 0;
+    BitVector_T D0Prev = 0;
+    BitVector_T PMPrev = 0;
+    int oScore = iPatternLength;
+
+    for (unsigned int j = 0; j != iTextLength; ++j) {
+      const BitVector_T PM = iPeq (j)[0];
+
+      // Diagonal zero deltas, including the transpositions (Hyyrö)
+      BitVector_T D0 = (((PM & VP) + VP) ^ VP) | PM | VN;
+      if (j >= 2) {
+        const BitVector_T TR = (((~D0Prev) & PM) << 1) & PMPrev
+          & K_LEVENSHTEIN_TRANSPOSITION_MASK;
+        D0 |= TR;
+      }
+
+      // Horizontal deltas
+      BitVector_T HP = VN | ~(D0 | VP);
+      BitVector_T HN = VP & D0;
+      if (HP & lLastBit) {
+        ++oScore;
+      } else if (HN & lLastBit) {
+        --oScore;
+      }
+
+      // Vertical deltas (the first row, D[0][j] = j, always increases)
+      HP = (HP << 1) | 1;
+      HN = HN << 1;
+      VP = HN | ~(D0 | HP);
+      VN = HP & D0;
+
+      D0Prev = D0;
+      PMPrev = PM;
+    }
+
+    return oScore;
+  }
+
+  /**
+   * Calculate the edit distance with the bit-parallel algorithm, when the
+   * pattern is longer than 64 characters. The columns are then made of
+   * several bit-vectors (blocks), processed as a single big integer.
+   */
+  // //////////////////////////////////////////////////////////////////
+  template <typename PEQ>
+  int getDistanceOnBlocks (const unsigned int iPatternLength,
+                           const unsigned int iTextLength,
+                           const PEQ& iPeq) {
+    const unsigned int lNbOfBlocks = (iPatternLength + 63) / 64;
+    assert (lNbOfBlocks >= 1 && lNbOfBlocks <= K_LEVENSHTEIN_MAX_NB_OF_BLOCKS);
+    const unsigned int lLastBlock = lNbOfBlocks - 1;
+    const BitVector_T lLastBit =
+      static_cast<BitVector_T> (1) << ((iPatternLength - 1) % 64);
+
+    BitVector_T VP[K_LEVENSHTEIN_MAX_NB_OF_BLOCKS];
+    BitVector_T VN[K_LEVENSHTEIN_MAX_NB_OF_BLOCKS];
+    BitVector_T D0[K_LEVENSHTEIN_MAX_NB_OF_BLOCKS];
+    BitVector_T D0Prev[K_LEVENSHTEIN_MAX_NB_OF_BLOCKS];
+    for (unsigned int b = 0; b != lNbOfBlocks; ++b) {
+      VP[b] = ~static_cast<BitVector_T> (0);
+      VN[b] = 0;
+      D0Prev[b] = 0;
+    }
+    const BitVector_T* PMPrev = NULL;
+    int oScore = iPatternLength;
+
+    for (unsigned int j = 0; j != iTextLength; ++j) {
+      const BitVector_T* PM = iPeq (j);
+
+      // Diagonal zero deltas, the carry of the addition going through
+      // the blocks
+      BitVector_T lCarry = 0;
+      for (unsigned int b = 0; b != lNbOfBlocks; ++b) {
+        const BitVector_T X = PM[b] & VP[b];
+        const BitVector_T lSum = X + VP[b];
+        const BitVector_T lSumWithCarry = lSum + lCarry;
+        lCarry = (lSum < X || lSumWithCarry < lSum) ? 1 : 0;
+        D0[b] = (lSumWithCarry ^ VP[b]) | PM[b] | VN[b];
+      }
+
+      // Transpositions (Hyyrö)
+      if (j >= 2) {
+        BitVector_T lShiftCarry = 0;
+        for (unsigned int b = 0; b != lNbOfBlocks; ++b) {
+          const BitVector_T X = (~D0Prev[b]) & PM[b];
+          BitVector_T TR = ((X << 1) | lShiftCarry) & PMPrev[b];
+          lShiftCarry = X >> 63;
+          if (b == 0) {
+            TR &= K_LEVENSHTEIN_TRANSPOSITION_MASK;
+          }
+          D0[b] |= TR;
+        }
+      }
+
+      // Horizontal, then vertical, deltas
+      BitVector_T lHPCarry = 1;
+      BitVector_T lHNCarry = 0;
+      for (unsigned int b = 0; b != lNbOfBlocks; ++b) {
+        const BitVector_T HP = VN[b] | ~(D0[b] | VP[b]);
+        const BitVector_T HN = VP[b] & D0[b];
+        if (b == lLastBlock) {
+          if (HP & lLastBit) {
+            ++oScore;
+          } else if (HN & lLastBit) {
+            --oScore;
+          }
+        }
+
+        const BitVector_T lShiftedHP = (HP << 1) | lHPCarry;
+        const BitVector_T lShiftedHN = (HN << 1) | lHNCarry;
+        lHPCarry = HP >> 63;
+        lHNCarry = HN >> 63;
+        VP[b] = lShiftedHN | ~(D0[b] | lShiftedHP);
+        VN[b] = lShiftedHP & D0[b];
+        D0Prev[b] = D0[b];
+      }
+
+      PMPrev = PM;
+    }
+
+    return oScore;
+  }
+
+  /**
+   * Bit-vectors of the positions of the bytes within a pattern.
+   */
+  template <unsigned int NB_OF_BLOCKS>
+  struct BytePeq {
+    /**
+     * Bit-vectors, by byte value.
+     */
+    BitVector_T _peq[256][NB_OF_BLOCKS];
+
+    /**
+     * Bytes of the text.
+     */
+    const unsigned char* _text;
+
+    /**
+     * Get the bit-vectors of the j-th byte of the text.
+     */
+    const BitVector_T* operator() (const unsigned int j) const {
+      return _peq[_text[j]];
+    }
+
+    /**
+     * Set the text.
+     */
+    void setText (const std::string& iText) {
+      _text = reinterpret_cast<const unsigned char*> (iText.data());
+    }
+
+    /**
+     * Reset the bit-vectors of the bytes of the given string.
+     */
+    void reset (const std::string& iString, const unsigned int iNbOfBlocks) {
+      for (std::string::const_iterator itChar = iString.begin();
+           itChar != iString.end(); ++itChar) {
+        const unsigned char lChar = *itChar;
+        for (unsigned int b = 0; b != iNbOfBlocks; ++b) {
+          _peq[lChar][b] = 0;
+        }
+      }
+    }
+
+    /**
+     * Reset the bit-vectors of all the bytes.
+     */
+    void resetAll (const unsigned int iNbOfBlocks) {
+      for (unsigned int lChar = 0; lChar != 256; ++lChar) {
+        for (unsigned int b = 0; b != iNbOfBlocks; ++b) {
+          _peq[lChar][b] = 0;
+        }
+      }
+    }
+
+    /**
+     * Set the bit-vectors of the pattern, once reset.
+     */
+    void set (const std::string& iPattern) {
+      for (unsigned int i = 0; i != iPattern.size(); ++i) {
+        const unsigned char lChar = iPattern[i];
+        _peq[lChar][i / 64] |= static_cast<BitVector_T> (1) << (i % 64);
+      }
+    }
+  };
+
+  /**
+   * Bit-vectors of the positions of the Unicode code points within
+   * a pattern.
+   */
+  struct SymbolPeq {
+    /**
+     * Bit-vectors, by index of code point within the alphabet of the
+     * pattern. The last (extra) row, for the code points not appearing
+     * within the pattern, is null.
+     */
+    BitVector_T _peq[K_LEVENSHTEIN_MAX_LENGTH + 1][K_LEVENSHTEIN_MAX_NB_OF_BLOCKS];
+
+    /**
+     * Index, within the alphabet of the pattern, of the code points
+     * of the text.
+     */
+    unsigned short _textIdx[K_LEVENSHTEIN_MAX_LENGTH];
+
+    /**
+     * Get the bit-vectors of the j-th code point of the text.
+     */
+    const BitVector_T* operator() (const unsigned int j) const {
+      return _peq[_textIdx[j]];
+    }
+  };
+
+  /**
+   * Decode a UTF-8 encoded string into Unicode code points. The invalid
+   * bytes are taken as they are.
+   *
+   * @return unsigned int Number of code points, or more than the given
+   *         maximal number when the string is too long.
+   */
+  // //////////////////////////////////////////////////////////////////
+  unsigned int decodeUTF8 (const std::string& iString, Symbol_T* ioSymbolArray,
+                           const unsigned int iMaxNbOfSymbols) {
+    unsigned int oNbOfSymbols = 0;
+    const unsigned int lLength = iString.size();
+    unsigned int idx = 0;
+    while (idx < lLength) {
+      const unsigned char lLead = iString[idx];
+      unsigned int lNbOfTrailingBytes = 0;
+      Symbol_T lSymbol = lLead;
+      if (lLead >= 0xF0 && lLead < 0xF8) {
+        lNbOfTrailingBytes = 3; lSymbol = lLead & 0x07;
+      } else if (lLead >= 0xE0 && lLead < 0xF0) {
+        lNbOfTrailingBytes = 2; lSymbol = lLead & 0x0F;
+      } else if (lLead >= 0xC0 && lLead < 0xE0) {
+        lNbOfTrailingBytes = 1; lSymbol = lLead & 0x1F;
+      }
+
+      // Check the trailing bytes
+      bool isValid = (idx + lNbOfTrailingBytes < lLength);
+      for (unsigned int k = 1; isValid && k <= lNbOfTrailingBytes; ++k) {
+        const unsigned char lTrail = iString[idx + k];
+        isValid = ((lTrail & 0xC0) == 0x80);
+        lSymbol = (lSymbol << 6) | (lTrail & 0x3F);
+      }
+      if (isValid == false) {
+        lNbOfTrailingBytes = 0;
+        lSymbol = lLead;
+      }
+
+      if (oNbOfSymbols < iMaxNbOfSymbols) {
+        ioSymbolArray[oNbOfSymbols] = lSymbol;
+      }
+      ++oNbOfSymbols;
+      idx += 1 + lNbOfTrailingBytes;
+    }
+    return oNbOfSymbols;
+  }
+
+  /**
+   * Calculate the edit distance between two strings, once the bit-vectors
+   * of the pattern have been set.
+   */
+  // //////////////////////////////////////////////////////////////////
+  template <typename PEQ>
+  int getDistanceWithPeq (const unsigned int iPatternLength,
+                          const unsigned int iTextLength, const PEQ& iPeq) {
+    if (iPatternLength == 0) {
+      return iTextLength;
+    }
+    if (iPatternLength <= 64) {
+      return getDistanceOnSingleBlock (iPatternLength, iTextLength, iPeq);
+    }
+    return getDistanceOnBlocks (iPatternLength, iTextLength, iPeq);
+  }
+
+  // //////////////////////////////////////////////////////////////////
+  int Levenshtein::getDistance (const std::string& iSource,
+                                const std::string& iTarget) {
+    // The distance is symmetric: the shortest string is encoded within
+    // the bit-vectors, so that there are as few blocks as possible
+    const bool isSourceShorter = (iSource.size() <= iTarget.size());
+    const std::string& lPattern = isSourceShorter ? iSource : iTarget;
+    const std::string& lText = isSourceShorter ? iTarget : iSource;
+    const unsigned int lPatternLength = lPattern.size();
+
+    if (lPatternLength > K_LEVENSHTEIN_MAX_LENGTH) {
+      return getDistanceByDynamicProgramming (iSource, iTarget);
+    }
+
+    // Only the bit-vectors of the bytes appearing in either string are
+    // reset, rather than the whole table
+    const unsigned int lNbOfBlocks = (lPatternLength + 63) / 64;
+    if (lNbOfBlocks <= 1) {
+      // Most common case: a single bit-vector per character
+      BytePeq<1> lPeq;
+      lPeq.setText (lText);
+      lPeq.reset (lPattern, lNbOfBlocks);
+      lPeq.reset (lText, lNbOfBlocks);
+      lPeq.set (lPattern);
+      return getDistanceWithPeq (lPatternLength, lText.size(), lPeq);
+    }
+
+    BytePeq<K_LEVENSHTEIN_MAX_NB_OF_BLOCKS> lPeq;
+    lPeq.setText (lText);
+    lPeq.reset (lPattern, lNbOfBlocks);
+    lPeq.reset (lText, lNbOfBlocks);
+    lPeq.set (lPattern);
+    return getDistanceWithPeq (lPatternLength, lText.size(), lPeq);
+  }
+
+  // //////////////////////////////////////////////////////////////////
+  int Levenshtein::getUTF8Distance (const std::string& iSource,
+                                    const std::string& iTarget) {
+    Symbol_T lSourceArray[K_LEVENSHTEIN_MAX_LENGTH];
+    Symbol_T lTargetArray[K_LEVENSHTEIN_MAX_LENGTH];
+    const unsigned int lSourceLength =
+      decodeUTF8 (iSource, lSourceArray, K_LEVENSHTEIN_MAX_LENGTH);
+    const unsigned int lTargetLength =
+      decodeUTF8 (iTarget, lTargetArray, K_LEVENSHTEIN_MAX_LENGTH);
+
+    // The strings are too long for the arrays: dynamic programming
+    if (lSourceLength > K_LEVENSHTEIN_MAX_LENGTH
+        || lTargetLength > K_LEVENSHTEIN_MAX_LENGTH) {
+      std::vector<Symbol_T> lSourceList (lSourceLength);
+      std::vector<Symbol_T> lTargetList (lTargetLength);
+      decodeUTF8 (iSource, &lSourceList[0], lSourceLength);
+      decodeUTF8 (iTarget, &lTargetList[0], lTargetLength);
+      return getDistanceByMatrix (lSourceList, lSourceLength,
+                                  lTargetList, lTargetLength);
+    }
+
+    // The shortest string is encoded within the bit-vectors
+    const bool isSourceShorter = (lSourceLength <= lTargetLength);
+    const Symbol_T* lPattern = isSourceShorter ? lSourceArray : lTargetArray;
+    const Symbol_T* lText = isSourceShorter ? lTargetArray : lSourceArray;
+    const unsigned int lPatternLength =
+      isSourceShorter ? lSourceLength : lTargetLength;
+    const unsigned int lTextLength =
+      isSourceShorter ? lTargetLength : lSourceLength;
+    const unsigned int lNbOfBlocks = (lPatternLength + 63) / 64;
+
+    // Alphabet of the pattern, and corresponding bit-vectors
+    SymbolPeq lPeq;
+    Symbol_T lAlphabet[K_LEVENSHTEIN_MAX_LENGTH];
+    unsigned int lAlphabetSize = 0;
+    for (unsigned int i = 0; i != lPatternLength; ++i) {
+      const Symbol_T lSymbol = lPattern[i];
+      unsigned int lSymbolIdx = 0;
+      while (lSymbolIdx != lAlphabetSize && lAlphabet[lSymbolIdx] != lSymbol) {
+        ++lSymbolIdx;
+      }
+      if (lSymbolIdx == lAlphabetSize) {
+        lAlphabet[lAlphabetSize] = lSymbol;
+        for (unsigned int b = 0; b != lNbOfBlocks; ++b) {
+          lPeq._peq[lAlphabetSize][b] = 0;
+        }
+        ++lAlphabetSize;
+      }
+      lPeq._peq[lSymbolIdx][i / 64] |= static_cast<BitVector_T> (1) << (i % 64);
+    }
+
+    // Null bit-vectors for the code points not appearing within the pattern
+    for (unsigned int b = 0; b != lNbOfBlocks; ++b) {
+      lPeq._peq[lAlphabetSize][b] = 0;
+    }
+
+    // Index of the code points of the text within the alphabet
+    for (unsigned int j = 0; j != lTextLength; ++j) {
+      const Symbol_T lSymbol = lText[j];
+      unsigned int lSymbolIdx = 0;
+      while (lSymbolIdx != lAlphabetSize && lAlphabet[lSymbolIdx] != lSymbol) {
+        ++lSymbolIdx;
+      }
+      lPeq._textIdx[j] = lSymbolIdx;
+    }
+
+    return getDistanceWithPeq (lPatternLength, lTextLength, lPeq);
+  }
+
+  // //////////////////////////////////////////////////////////////////
+  void Levenshtein::getDistanceList (const std::string& iQuery,
+                                     const StringList_T& iCandidateList,
+                                     DistanceList_T& ioDistanceList) {
+    ioDistanceList.reserve (ioDistanceList.size() + iCandidateList.size());
+
+    // The query string is too long for the bit-vectors
+    const unsigned int lQueryLength = iQuery.size();
+    if (lQueryLength > K_LEVENSHTEIN_MAX_LENGTH) {
+      for (StringList_T::const_iterator itCandidate = iCandidateList.begin();
+           itCandidate != iCandidateList.end(); ++itCandidate) {
+        const std::string& lCandidate = *itCandidate;
+        ioDistanceList.push_back (getDistance (iQuery, lCandidate));
+      }
+      return;
+    }
+
+    // The bit-vectors of the query string are set once for all
+    const unsigned int lNbOfBlocks = (lQueryLength + 63) / 64;
+    BytePeq<K_LEVENSHTEIN_MAX_NB_OF_BLOCKS> lPeq;
+    lPeq.resetAll (lNbOfBlocks);
+    lPeq.set (iQuery);
+
+    for (StringList_T::const_iterator itCandidate = iCandidateList.begin();
+         itCandidate != iCandidateList.end(); ++itCandidate) {
+      const std::string& lCandidate = *itCandidate;
+      lPeq.setText (lCandidate);
+      ioDistanceList.push_back (getDistanceWithPeq (lQueryLength,
+                                                    lCandidate.size(), lPeq));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////
+  int Levenshtein::
+  getDistanceByDynamicProgramming (const std::string& iSource,
+                                   const std::string& iTarget) {
+    return getDistanceByMatrix (iSource, iSource.length(),
+                                iTarget, iTarget.length());
+  }
+
 }
@@ -9,20 +9,79 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <string>
+#include <vector>
 // OpenTREP
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/bom/BomAbstract.hpp>
 
 namespace OPENTREP {
 
-  /** Class aggregating utilities around the Levenshtein edit
-      distance/error. */
+  /**
+   * @brief Class aggregating utilities around the Levenshtein edit
+   *        distance/error.
+   *
+   * The edit distance counts the insertions, deletions, substitutions and
+   * transpositions of adjacent characters (restricted, i.e., "optimal string
+   * alignment", Damerau-Levenshtein distance). As with the original
+   * implementation, the transpositions involving one of the first two
+   * characters of either string are not taken into account.
+   *
+   * The distance is calculated with the bit-parallel algorithm of Myers,
+   * extended to the transpositions by Hyyrö: the columns of the dynamic
+   * programming matrix are encoded as bit-vectors, processed 64 characters
+   * at a time. The strings of up to 512 characters are processed without
+   * any heap allocation; longer ones fall back on the dynamic programming
+   * (matrix-based) implementation.
+   */
   class Levenshtein : public BomAbstract {
   public:
-    /** Calculate the edit distance between two strings. */
+    /**
+     * List of candidate strings.
+     */
+    typedef std::vector<std::string> StringList_T;
+
+    /**
+     * List of edit distances.
+     */
+    typedef std::vector<int> DistanceList_T;
+
+  public:
+    /**
+     * Calculate the edit distance between two strings, character (byte)
+     * by character.
+     */
     static int getDistance (const std::string& iSource,
                             const std::string& iTarget);
+
+    /**
+     * Calculate the edit distance between two UTF-8 encoded strings, Unicode
+     * code point by code point (e.g., "é" counts as a single character).
+     */
+    static int getUTF8Distance (const std::string& iSource,
+                                const std::string& iTarget);
+
+    /**
+     * Calculate the edit distances between a query string and a list of
+     * candidate strings, character (byte) by character. The bit-vectors
+     * of the query string are calculated only once for all the candidates.
+     *
+     * @param const std::string& Query string.
+     * @param const StringList_T& List of candidate strings.
+     * @param DistanceList_T& List to which the edit distances are added,
+     *        in the order of the candidate strings.
+     */
+    static void getDistanceList (const std::string& iQuery,
+                                 const StringList_T& iCandidateList,
+                                 DistanceList_T& ioDistanceList);
+
+    /**
+     * Calculate the edit distance between two strings with the dynamic
+     * programming (matrix-based) algorithm. That is the reference
+     * implementation, slower than getDistance().
+     */
+    static int getDistanceByDynamicProgramming (const std::string& iSource,
+                                                const std::string& iTarget);
   };
-  
+
 }
 #endif // __OPENTREP_BOM_LEVENSHTEIN_HPP
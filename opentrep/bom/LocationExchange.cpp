@@ -11,6 +11,7 @@
 // OpenTrep
 #include <opentrep/Location.hpp>
 #include <opentrep/bom/LocationExchange.hpp>
+#include <opentrep/service/StatisticsRecorder.hpp>
 
 namespace OPENTREP {
   
@@ -19,6 +20,8 @@ namespace OPENTREP {
   exportLocationList (std::ostream& oStream,
                       const LocationList_T& iLocationList,
                       const WordList_T& iNonMatchedWordList) {
+    const SearchStageTimer lExportTimer (SearchStage::EXPORT);
+
     // Protobuf structure
     treppb::QueryAnswer oQueryAnswer;
     
@@ -291,10 +291,8 @@ namespace OPENTREP {
     // //////////////////////////////////////////////////////////////////
     void storeDateFrom::operator() (bsq::unused_type,
                                     bsq::unused_type, bsq::unused_type) const {
-      /*
       const OPENTREP::Date_T& lDateFrom = _location.calculateDate();
       _location.setDateFrom (lDateFrom);
-      */
 
       // DEBUG
       //OPENTREP_LOG_DEBUG ("Date from: " << _location.getDateFrom());
@@ -308,10 +306,8 @@ namespace OPENTREP {
     // //////////////////////////////////////////////////////////////////
     void storeDateUntil::operator() (bsq::unused_type,
                                      bsq::unused_type, bsq::unused_type) const {
-      /*
       const OPENTREP::Date_T& lDateUntil = _location.calculateDate();
-      _location.setDateUntil (lDateUntil);
-      */
+      _location.setDateEnd (lDateUntil);
 
       // DEBUG
       //OPENTREP_LOG_DEBUG ("Date until: " << _location.getDateUntil());
@@ -0,0 +1,92 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// OpenTrep
+#include <opentrep/Location.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/bom/PORValidityDecider.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  PORValidityDecider::
+  PORValidityDecider (const ExpiredPORFiltering_T& iExpiredPORFiltering,
+                      const Date_T& iValidityDate)
+    : _expiredPORFiltering (iExpiredPORFiltering),
+      _validityDate (iValidityDate),
+      _serialisedValidityDate (iValidityDate.is_special() ? ""
+                               : serialiseDate (iValidityDate)) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  PORValidityDecider::~PORValidityDecider() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string PORValidityDecider::serialiseDate (const Date_T& iDate) {
+    assert (iDate.is_special() == false);
+    const double lDayNumber = static_cast<const double> (iDate.day_number());
+    return Xapian::sortable_serialise (lDayNumber);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool PORValidityDecider::isActive() const {
+    return (_expiredPORFiltering == true
+            || _serialisedValidityDate.empty() == false);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool PORValidityDecider::
+  operator() (const Xapian::Document& iDocument) const {
+    // Filter out the POR having a non-null envelope ID
+    if (_expiredPORFiltering == true) {
+      const std::string& lEnvelopeIDStr =
+        iDocument.get_value (K_XAPIAN_VALUE_SLOT_ENVELOPE_ID);
+      if (lEnvelopeIDStr.empty() == false
+          && Xapian::sortable_unserialise (lEnvelopeIDStr) != 0.0) {
+        return false;
+      }
+    }
+
+    // Filter out the POR not valid at the validity date. As the dates
+    // are serialised so as to be sortable, they may be compared as is.
+    if (_serialisedValidityDate.empty() == false) {
+      const std::string& lDateFromStr =
+        iDocument.get_value (K_XAPIAN_VALUE_SLOT_DATE_FROM);
+      if (lDateFromStr.empty() == false
+          && lDateFromStr > _serialisedValidityDate) {
+        return false;
+      }
+
+      const std::string& lDateEndStr =
+        iDocument.get_value (K_XAPIAN_VALUE_SLOT_DATE_END);
+      if (lDateEndStr.empty() == false
+          && lDateEndStr < _serialisedValidityDate) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool PORValidityDecider::isValid (const Location& iLocation) const {
+    // Filter out the POR having a non-null envelope ID
+    if (_expiredPORFiltering == true && iLocation.getEnvelopeID() != 0) {
+      return false;
+    }
+
+    // Filter out the POR not valid at the validity date
+    if (_serialisedValidityDate.empty() == false) {
+      if (iLocation.getDateFrom() > _validityDate
+          || iLocation.getDateEnd() < _validityDate) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+}
@@ -0,0 +1,99 @@
+#ifndef __OPENTREP_BOM_PORVALIDITYDECIDER_HPP
+#define __OPENTREP_BOM_PORVALIDITYDECIDER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+namespace OPENTREP {
+
+  // Forward declarations
+  struct Location;
+
+  /**
+   * @brief Xapian match decider, filtering out the POR (points of reference)
+   *        which are not valid.
+   *
+   * Two filters may be applied, independently one from the other:
+   * <ul>
+   *   <li>the expired POR, i.e., the POR having a non-null envelope ID,
+   *       are filtered out;</li>
+   *   <li>when a validity date ("as of date") is given, the POR the
+   *       validity period of which (from date_from to date_until) does
+   *       not contain that date are filtered out. That allows to look up
+   *       the POR as they were at some point in the past.</li>
+   * </ul>
+   *
+   * The filters are applied by Xapian, within the matcher, from the value
+   * slots of the documents: the invalid POR do not take any room within
+   * the matching sets. The same filters may be applied on already decoded
+   * Location structures (e.g., the ones of the in-memory code index).
+   *
+   * \note For older indexes, without value slots, the POR are considered
+   *       as valid.
+   */
+  class PORValidityDecider : public Xapian::MatchDecider {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param const ExpiredPORFiltering_T& Whether to filter out the
+     *        expired POR.
+     * @param const Date_T& Validity date. When not a date (the default
+     *        value of Date_T), the POR are not filtered on their
+     *        validity period.
+     */
+    PORValidityDecider (const ExpiredPORFiltering_T&, const Date_T&);
+
+    /**
+     * Destructor.
+     */
+    ~PORValidityDecider();
+
+    /**
+     * State whether any filter is to be applied. When not, there is no
+     * need to give that decider to Xapian.
+     */
+    bool isActive() const;
+
+    /**
+     * State whether the POR of the given Xapian document is valid.
+     */
+    bool operator() (const Xapian::Document&) const;
+
+    /**
+     * State whether the POR of the given Location structure is valid.
+     */
+    bool isValid (const Location&) const;
+
+    /**
+     * Convert the given date into a value, as stored within the value
+     * slots of the Xapian documents.
+     */
+    static std::string serialiseDate (const Date_T&);
+
+  private:
+    /**
+     * Whether to filter out the expired POR.
+     */
+    const ExpiredPORFiltering_T _expiredPORFiltering;
+
+    /**
+     * Validity date, if any.
+     */
+    const Date_T _validityDate;
+
+    /**
+     * Validity date, as stored within the value slots.
+     */
+    const std::string _serialisedValidityDate;
+  };
+
+}
+#endif // __OPENTREP_BOM_PORVALIDITYDECIDER_HPP
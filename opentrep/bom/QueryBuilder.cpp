@@ -0,0 +1,93 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// OpenTREP
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/bom/WordHolder.hpp>
+#include <opentrep/bom/QueryBuilder.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  void QueryBuilder::buildTermList (const WordList_T& iWordList,
+                                    WordList_T& ioTermList) {
+    for (WordList_T::const_iterator itWord = iWordList.begin();
+         itWord != iWordList.end(); ++itWord) {
+      const std::string& lWord = *itWord;
+
+      /**
+       * Most of the words are made only of word characters, and give
+       * a single term. Some of them, however, may still hold non-word
+       * characters (e.g., non-ASCII punctuation), on which Xapian splits
+       * them when indexing.
+       */
+      std::string lTerm;
+      const Xapian::Utf8Iterator itEnd;
+      for (Xapian::Utf8Iterator itChar (lWord); itChar != itEnd; ++itChar) {
+        const unsigned lChar = *itChar;
+        if (Xapian::Unicode::is_wordchar (lChar) == true) {
+          Xapian::Unicode::append_utf8 (lTerm,
+                                        Xapian::Unicode::tolower (lChar));
+
+        } else if (lTerm.empty() == false) {
+          ioTermList.push_back (lTerm);
+          lTerm.clear();
+        }
+      }
+
+      if (lTerm.empty() == false) {
+        ioTermList.push_back (lTerm);
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::Query QueryBuilder::buildQuery (const WordList_T& iWordList) {
+    WordList_T lTermList;
+    buildTermList (iWordList, lTermList);
+
+    const Xapian::termcount lNbOfTerms = lTermList.size();
+    if (lNbOfTerms == 0) {
+      return Xapian::Query();
+    }
+
+    if (lNbOfTerms == 1) {
+      return Xapian::Query (lTermList.front());
+    }
+
+    // The terms must be contiguous, and in the same order as the words
+    return Xapian::Query (Xapian::Query::OP_PHRASE,
+                          lTermList.begin(), lTermList.end(), lNbOfTerms);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::Query QueryBuilder::buildQuery (const TravelQuery_T& iQueryString) {
+    WordList_T lWordList;
+    WordHolder::tokeniseStringIntoWordList (iQueryString, lWordList);
+    return buildQuery (lWordList);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::Query QueryBuilder::addPrior (const Xapian::Query& iQuery,
+                                        Xapian::PostingSource& ioPriorSource) {
+    const Xapian::Query lPriorQuery (Xapian::Query::OP_SCALE_WEIGHT,
+                                     Xapian::Query (&ioPriorSource),
+                                     K_DEFAULT_XAPIAN_PRIOR_WEIGHT_FACTOR);
+    return Xapian::Query (Xapian::Query::OP_AND_MAYBE, iQuery, lPriorQuery);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::weight QueryBuilder::
+  getPriorWeight (const Xapian::Document& iDocument) {
+    const std::string& lPriorStr =
+      iDocument.get_value (K_XAPIAN_VALUE_SLOT_PRIOR);
+    if (lPriorStr.empty() == true) {
+      return 0.0;
+    }
+    const Xapian::weight lPrior = Xapian::sortable_unserialise (lPriorStr);
+    return K_DEFAULT_XAPIAN_PRIOR_WEIGHT_FACTOR * lPrior;
+  }
+
+}
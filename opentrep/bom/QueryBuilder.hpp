@@ -0,0 +1,98 @@
+#ifndef __OPENTREP_BOM_QUERYBUILDER_HPP
+#define __OPENTREP_BOM_QUERYBUILDER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// Xapian
+#include <xapian.h>
+// OpenTREP
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/bom/BomAbstract.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Class wrapping utility functions to build Xapian queries
+   *        directly from lists of words.
+   *
+   * The query strings searched for by OpenTREP have already been
+   * normalised and tokenised (see WordHolder::tokeniseStringIntoWordList()).
+   * There is therefore no need for a Xapian::QueryParser object, which
+   * would parse the strings once again. The words are simply converted
+   * into terms, the same way as Xapian::TermGenerator does when the
+   * index is built (i.e., lower case, split on the non-word characters),
+   * and the terms are combined with the "PHRASE" operator. For instance,
+   * the ('sna', 'francicso') word list yields "sna PHRASE 2 francicso",
+   * just as the query parser did.
+   */
+  class QueryBuilder : public BomAbstract {
+  public:
+    // /////////////// Business Methods ////////////////
+    /**
+     * Convert a list of words into the list of the corresponding Xapian
+     * terms.
+     *
+     * @param const WordList_T& List of words.
+     * @param WordList_T& List to which the terms are added.
+     */
+    static void buildTermList (const WordList_T&, WordList_T& ioTermList);
+
+    /**
+     * Build the Xapian phrase query corresponding to a list of words.
+     *
+     * When the list is made of a single term, the query is a simple
+     * term query. When it is empty, the query is empty, and matches
+     * nothing.
+     */
+    static Xapian::Query buildQuery (const WordList_T&);
+
+    /**
+     * Build the Xapian phrase query corresponding to a string, tokenised
+     * into words beforehand.
+     */
+    static Xapian::Query buildQuery (const TravelQuery_T&);
+
+    /**
+     * Add the prior of the POR (see K_XAPIAN_VALUE_SLOT_PRIOR) to the
+     * weights of the documents matching the given full-text query.
+     *
+     * The prior is given by a Xapian::ValueWeightPostingSource, under the
+     * "AND_MAYBE" operator: it does not change which documents match,
+     * but the matcher ranks them on the sum of their full-text relevance
+     * and of their prior (scaled by K_DEFAULT_XAPIAN_PRIOR_WEIGHT_FACTOR).
+     * Hence, the top documents are the right ones, while the matcher
+     * still terminates early.
+     *
+     * @param const Xapian::Query& Full-text query.
+     * @param Xapian::PostingSource& Posting source of the prior, which
+     *        must outlive the calls to Xapian::Enquire::get_mset().
+     */
+    static Xapian::Query addPrior (const Xapian::Query&,
+                                   Xapian::PostingSource& ioPriorSource);
+
+    /**
+     * Get the weight which the prior of the POR added to the given
+     * document (see addPrior()), so that it may be taken out of the weight
+     * of that document, in order to get back its full-text relevance.
+     */
+    static Xapian::weight getPriorWeight (const Xapian::Document&);
+
+  private:
+    // ////////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    QueryBuilder();
+    /**
+     * Default copy constructor.
+     */
+    QueryBuilder (const QueryBuilder&);
+    /**
+     * Destructor.
+     */
+    ~QueryBuilder();
+  };
+
+}
+#endif // __OPENTREP_BOM_QUERYBUILDER_HPP
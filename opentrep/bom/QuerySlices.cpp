@@ -12,7 +12,11 @@
 #include <opentrep/bom/Levenshtein.hpp>
 #include <opentrep/bom/Filter.hpp>
 #include <opentrep/bom/QuerySlices.hpp>
+#include <opentrep/bom/QueryBuilder.hpp>
+#include <opentrep/bom/WordPairTable.hpp>
+#include <opentrep/bom/SpellingDictionary.hpp>
 #include <opentrep/service/Logger.hpp>
+#include <opentrep/service/StatisticsRecorder.hpp>
 
 namespace OPENTREP {
 
@@ -20,7 +24,21 @@ namespace OPENTREP {
   QuerySlices::QuerySlices (const Xapian::Database& iDatabase,
                             const TravelQuery_T& iQueryString,
                             const OTransliterator& iTransliterator)
-    : _database (iDatabase), _queryString (iQueryString) {
+    : _database (iDatabase), _enquire (iDatabase), _wordPairTable (NULL),
+      _spellingDictionary (NULL), _queryString (iQueryString) {
+    init (iTransliterator);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  QuerySlices::QuerySlices (const Xapian::Database& iDatabase,
+                            const TravelQuery_T& iQueryString,
+                            const OTransliterator& iTransliterator,
+                            const WordPairTable* iWordPairTable_ptr,
+                            const SpellingDictionary* iSpellingDictionary_ptr)
+    : _database (iDatabase), _enquire (iDatabase),
+      _wordPairTable (iWordPairTable_ptr),
+      _spellingDictionary (iSpellingDictionary_ptr),
+      _queryString (iQueryString) {
     init (iTransliterator);
   }
 
@@ -29,9 +47,9 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  void QuerySlices::push_back (const StringPartition& iStringPartition) {
-    if (iStringPartition.empty() == false) {
-      _slices.push_back (iStringPartition);
+  void QuerySlices::push_back (const std::string& iSlice) {
+    if (iSlice.empty() == false) {
+      _slices.push_back (iSlice);
     }
   }
   
@@ -50,6 +68,17 @@ namespace OPENTREP {
     _slices.clear();
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  TravelQuery_T QuerySlices::
+  normalise (const TravelQuery_T& iQueryString,
+             const OTransliterator& iTransliterator) {
+    const TravelQuery_T lUnpunctuatedString =
+      iTransliterator.unpunctuate (iQueryString);
+    const TravelQuery_T oNormalisedString =
+      iTransliterator.unquote (lUnpunctuatedString);
+    return oNormalisedString;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   std::string QuerySlices::describeKey() const {
     std::ostringstream oStr;
@@ -66,18 +95,19 @@ namespace OPENTREP {
     oStr << "[ ";
 
     short idx_sublist = 0;
-    for (StringPartitionList_T::const_iterator itSlice = _slices.begin();
-         itSlice != _slices.end(); ++itSlice, ++idx_sublist) {
+    for (StringSet::StringSet_T::const_iterator itSlice =
+           _slices._set.begin();
+         itSlice != _slices._set.end(); ++itSlice, ++idx_sublist) {
       //
       if (idx_sublist != 0) {
         oStr << "; ";
       }
       
       //
-      const StringPartition& lStringPartition = *itSlice;
+      const std::string& lSlice = *itSlice;
 
       //
-      oStr << idx_sublist << ". " << lStringPartition;
+      oStr << idx_sublist << ". " << lSlice;
     }
 
     //
@@ -115,65 +145,75 @@ namespace OPENTREP {
     oEditDistance = lQueryStringSize / K_DEFAULT_SIZE_FOR_SPELLING_ERROR_UNIT;
     return oEditDistance;
   }
+
+  /**
+   * @brief Helper function
+   *
+   * Get the spelling correction of the given phrase, if any, along with
+   * the allowed edit distance. When available, the in-memory spelling
+   * dictionary is looked up, with the edit distance allowed by its
+   * distance error rule. Otherwise, the Xapian spelling table is browsed,
+   * with the edit distance given by calculateEditDistance().
+   */
+  // //////////////////////////////////////////////////////////////////////
+  static std::string
+  getSpellingSuggestion (const Xapian::Database& iDatabase,
+                         const SpellingDictionary* iSpellingDictionary_ptr,
+                         const TravelQuery_T& iPhrase,
+                         NbOfErrors_T& oAllowableEditDistance) {
+    const SearchStageTimer lSpellingTimer (SearchStage::SPELLING);
+    StatisticsRecorder::increment (SearchCounter::SPELLING_CALLS);
+
+    if (iSpellingDictionary_ptr != NULL) {
+      oAllowableEditDistance =
+        iSpellingDictionary_ptr->getAllowedDistanceError (iPhrase);
+      NbOfErrors_T lEditDistance = 0;
+      return iSpellingDictionary_ptr->getSuggestion (iPhrase, lEditDistance);
+    }
+
+    oAllowableEditDistance = calculateEditDistance (iPhrase);
+    return iDatabase.get_spelling_suggestion (iPhrase, oAllowableEditDistance);
+  }
   
   /**
    * @brief Helper function to query for a Xapian-based full text match
+   *
+   * The given enquire session, on the given Xapian database, is re-used
+   * from one pair of words to the next one.
    */
   // //////////////////////////////////////////////////////////////////////
-  bool doesMatch (const Xapian::Database& iDatabase,
+  bool doesMatch (Xapian::Enquire& ioEnquire,
+                  const Xapian::Database& iDatabase,
+                  const SpellingDictionary* iSpellingDictionary_ptr,
                   const std::string& iWord1, const std::string& iWord2) {
     bool oDoesMatch = false;
 
     //
-    std::ostringstream oStr;
-    oStr << iWord1 << " " << iWord2;
-    const std::string lQueryString (oStr.str());
+    WordList_T lWordList;
+    lWordList.push_back (iWord1);
+    lWordList.push_back (iWord2);
+    const std::string lQueryString (iWord1 + " " + iWord2);
 
     // Catch any Xapian::Error exceptions thrown
     Xapian::MSet lMatchingSet;
     try {
       
-      // Build the query object
-      Xapian::QueryParser lQueryParser;
-      lQueryParser.set_database (iDatabase);
-
-      /**
-       * As explained in http://www.xapian.org/docs/queryparser.html,
-       * Xapian::Query::OP_NEAR may be better than Xapian::Query::OP_PHRASE,
-       * but only available from version 1.0.13 of Xapian.
-       */
-      // lQueryParser.set_default_op (Xapian::Query::OP_ADJ);
-      lQueryParser.set_default_op (Xapian::Query::OP_PHRASE);
-
-      // DEBUG
-      /*
-        OPENTREP_LOG_DEBUG ("Query parser `" << lQueryParser.get_description()
-        << "'");
-      */
-
       // DEBUG
       // OPENTREP_LOG_DEBUG ("        --------");
         
-      // Start an enquire session
-      Xapian::Enquire enquire (iDatabase);
-
       /**
-       * The Xapian::QueryParser::parse_query() method aggregates all
-       * the words with operators inbetween them (here, the "PHRASE"
-       * operator).  With the above example ('sna francicso'), it
-       * yields "sna PHRASE 2 francicso".
+       * Build the query object directly from the two words, aggregated
+       * with the "PHRASE" operator. With the above example
+       * ('sna francicso'), it yields "sna PHRASE 2 francicso".
        */
-      const Xapian::Query& lXapianQuery =
-        lQueryParser.parse_query (lQueryString,
-                                  Xapian::QueryParser::FLAG_BOOLEAN
-                                  | Xapian::QueryParser::FLAG_PHRASE
-                                  | Xapian::QueryParser::FLAG_LOVEHATE);
+      const Xapian::Query& lXapianQuery = QueryBuilder::buildQuery (lWordList);
 
       // Give the query object to the enquire session
-      enquire.set_query (lXapianQuery);
+      ioEnquire.set_query (lXapianQuery);
 
       // Get the top 20 results of the query
-      lMatchingSet = enquire.get_mset (0, 20);
+      StatisticsRecorder::increment (SearchCounter::XAPIAN_QUERIES);
+      lMatchingSet = ioEnquire.get_mset (0, 20);
 
       // Display the results
       int nbMatches = lMatchingSet.size();
@@ -204,12 +244,10 @@ namespace OPENTREP {
        * With the above example, 'sna francisco' yields the suggestion
        * 'san francisco'.
        */
-      const NbOfErrors_T& lAllowableEditDistance =
-        calculateEditDistance (lQueryString);
-      
-      // Let Xapian find a spelling correction (if any)
+      NbOfErrors_T lAllowableEditDistance = 0;
       const std::string& lCorrectedString =
-        iDatabase.get_spelling_suggestion (lQueryString, lAllowableEditDistance);
+        getSpellingSuggestion (iDatabase, iSpellingDictionary_ptr,
+                               lQueryString, lAllowableEditDistance);
 
       // If the correction is no better than the original string, there is
       // no need to go further: there is no match.
@@ -240,14 +278,12 @@ namespace OPENTREP {
        * 'san francisco', it yields the query "san PHRASE 2 francisco",
        * which should provide matches.
        */
-      const Xapian::Query& lCorrectedXapianQuery = 
-        lQueryParser.parse_query (lCorrectedString,
-                                  Xapian::QueryParser::FLAG_BOOLEAN
-                                  | Xapian::QueryParser::FLAG_PHRASE
-                                  | Xapian::QueryParser::FLAG_LOVEHATE);
+      const Xapian::Query& lCorrectedXapianQuery =
+        QueryBuilder::buildQuery (lCorrectedString);
 
-      enquire.set_query (lCorrectedXapianQuery);
-      lMatchingSet = enquire.get_mset (0, 20);
+      ioEnquire.set_query (lCorrectedXapianQuery);
+      StatisticsRecorder::increment (SearchCounter::XAPIAN_QUERIES);
+      lMatchingSet = ioEnquire.get_mset (0, 20);
 
       // Display the results
       nbMatches = lMatchingSet.size();
@@ -299,12 +335,73 @@ namespace OPENTREP {
     return oDoesMatch;
   }
 
+  /**
+   * @brief Helper function to check, thanks to the table of the adjacent
+   *        word pairs, whether two words match
+   *
+   * When the pair is not in the table, a spelling correction is sought
+   * within the Xapian index, and the corrected pair is checked in turn.
+   * When the correction is made of another number of words, the Xapian
+   * index is used for the whole check.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  bool doesMatch (const WordPairTable& iWordPairTable,
+                  Xapian::Enquire& ioEnquire,
+                  const Xapian::Database& iDatabase,
+                  const SpellingDictionary* iSpellingDictionary_ptr,
+                  const std::string& iWord1, const std::string& iWord2) {
+    // Exact match
+    if (iWordPairTable.contains (iWord1, iWord2) == true) {
+      return true;
+    }
+
+    //
+    std::ostringstream oStr;
+    oStr << iWord1 << " " << iWord2;
+    const std::string lQueryString (oStr.str());
+
+    // Find a spelling correction (if any)
+    std::string lCorrectedString;
+    try {
+      NbOfErrors_T lAllowableEditDistance = 0;
+      lCorrectedString =
+        getSpellingSuggestion (iDatabase, iSpellingDictionary_ptr,
+                               lQueryString, lAllowableEditDistance);
+
+    } catch (const Xapian::Error& error) {
+      // Error
+      OPENTREP_LOG_ERROR ("Exception: "  << error.get_msg());
+      throw XapianException (error.get_msg());
+    }
+
+    // If the correction is no better than the original string, there is
+    // no match
+    if (lCorrectedString.empty() == true || lCorrectedString == lQueryString) {
+      return false;
+    }
+
+    // Check the corrected pair of words
+    WordList_T lCorrectedWordList;
+    tokeniseStringIntoWordList (lCorrectedString, lCorrectedWordList);
+    if (lCorrectedWordList.size() == 2) {
+      const std::string& lCorrectedWord1 = lCorrectedWordList.front();
+      const std::string& lCorrectedWord2 = lCorrectedWordList.back();
+      return iWordPairTable.contains (lCorrectedWord1, lCorrectedWord2);
+    }
+
+    // The correction does not give a pair of words: let Xapian decide
+    return OPENTREP::doesMatch (ioEnquire, iDatabase, iSpellingDictionary_ptr,
+                                iWord1, iWord2);
+  }
+
   // //////////////////////////////////////////////////////////////////////
   void QuerySlices::init (const OTransliterator& iTransliterator) {
     // 0. Initialisation
     // 0.1. Stripping of the punctuation and quotation characters
-    _queryString = iTransliterator.unpunctuate (_queryString);
-    _queryString = iTransliterator.unquote (_queryString);
+    SearchStageTimer lNormalisationTimer (SearchStage::NORMALISATION);
+    _queryString = normalise (_queryString, iTransliterator);
+    lNormalisationTimer.stop();
+    const SearchStageTimer lSlicingTimer (SearchStage::SLICING);
 
     // 0.2. Initialisation of the tokenizer
     WordList_T lWordList;
@@ -313,7 +410,7 @@ namespace OPENTREP {
 
     // When the query has a single word, stop here, as there is a single slice
     if (nbOfWords <= 1) {
-      _slices.push_back (_queryString);
+      push_back (_queryString);
       return;
     }
 
@@ -335,9 +432,13 @@ namespace OPENTREP {
       }
       _itLeftWords += leftWord;
 
-      // Check whether the juxtaposition of the two contiguous words matches
-      const bool lDoesMatch =
-        OPENTREP::doesMatch (_database, leftWord, rightWord);
+      // Check whether the juxtaposition of the two contiguous words matches,
+      // in memory when the table of the adjacent word pairs is available
+      const bool lDoesMatch = (_wordPairTable != NULL) ?
+        OPENTREP::doesMatch (*_wordPairTable, _enquire, _database,
+                             _spellingDictionary, leftWord, rightWord)
+        : OPENTREP::doesMatch (_enquire, _database, _spellingDictionary,
+                               leftWord, rightWord);
 
       if (lDoesMatch == true) {
         // When the two words give a match, do nothing now, as at the next turn,
@@ -361,7 +462,7 @@ namespace OPENTREP {
 
         // When the two words give no match, add the content of the staging
         // list to the list of slices. Then, empty the staging string.
-        _slices.push_back (_itLeftWords);
+        push_back (_itLeftWords);
         _itLeftWords = "";
         idx_rel = 0;
       }
@@ -373,7 +474,7 @@ namespace OPENTREP {
       _itLeftWords += " ";
     }
     _itLeftWords += leftWord;
-    _slices.push_back (_itLeftWords);
+    push_back (_itLeftWords);
 
     // DEBUG
     // OPENTREP_LOG_DEBUG ("Last staging string: '" << _itLeftWords << "'");
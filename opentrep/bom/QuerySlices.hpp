@@ -12,17 +12,19 @@
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/basic/StructAbstract.hpp>
-#include <opentrep/bom/StringPartition.hpp>
+#include <opentrep/bom/StringSet.hpp>
 
 namespace OPENTREP {
 
   // Forward declarations
   class OTransliterator;
+  struct WordPairTable;
+  struct SpellingDictionary;
 
   /**
    * Class allowing to slice a query string into multiple slices.
-   * Each of those slices will then give birth to the corresponding
-   * string partitions.
+   * Each of those slices will then be searched for independently
+   * (\see StringPartition for the partitions of a slice).
    *
    * The initial query string is sliced in the interstices, which split apart
    * any two consecutive words yielding no full text match.
@@ -31,9 +33,9 @@ namespace OPENTREP {
    * <ul>
    *   <li>[</li>
    *   <li><ul>
-   *     <li>0. { {"san francisco"} }</li>
-   *     <li>1. { {"nce"} }</li>
-   *     <li>2. { {"rio de janeiro"} }</li>
+   *     <li>0. "san francisco"</li>
+   *     <li>1. "nce"</li>
+   *     <li>2. "rio de janeiro"</li>
    *   </ul></li>
    *   <li>]</li>
    * </ul>
@@ -57,19 +59,19 @@ namespace OPENTREP {
     }
 
     /**
-     * Get the underlying list of string partitions.
+     * Get the underlying list of query slices.
      */
-    const StringPartitionList_T& getStringPartitionList() const {
+    const StringSet& getSlices() const {
       return _slices;
     }
 
     /**
-     * Add an item (StringPartition) into the list.
+     * Add an item (query slice) into the list.
      *
-     * \note When the given string set is empty (zero-length),
+     * \note When the given string is empty (zero-length),
      *       it is (obviously) not added to the list
      */
-    void push_back (const StringPartition& iStringPartition);
+    void push_back (const std::string& iSlice);
   
     /**
      * Return the size of the list.
@@ -86,6 +88,18 @@ namespace OPENTREP {
      */
     void clear();
 
+    /**
+     * Normalise the given travel query, the same way as the main
+     * constructor does (i.e., strip the punctuation and quotation
+     * characters), without cutting it in slices.
+     *
+     * @param const TravelQuery_T& The travel query.
+     * @param const OTransliterator& Unicode transliterator
+     * @return TravelQuery_T The normalised travel query.
+     */
+    static TravelQuery_T normalise (const TravelQuery_T&,
+                                    const OTransliterator&);
+
 
   private:
     /**
@@ -139,6 +153,26 @@ namespace OPENTREP {
     QuerySlices (const Xapian::Database&, const TravelQuery_T&,
                  const OTransliterator&);
 
+    /**
+     * Main constructor, with the table of the adjacent word pairs and the
+     * spelling dictionary of the index. The pairs of contiguous words are
+     * then checked in memory, the Xapian index being queried only for the
+     * pairs which are not in the table, in search of a spelling correction.
+     *
+     * @param const Xapian::Database& Xapian database (index)
+     * @param const TravelQuery_T& The string for which the partitions are sought
+     * @param const OTransliterator& Unicode transliterator
+     * @param const WordPairTable* Table of the adjacent word pairs (NULL
+     *        when not available, in which case the Xapian index is queried
+     *        for every pair of contiguous words)
+     * @param const SpellingDictionary* Spelling dictionary (NULL when not
+     *        available, in which case the spelling corrections are sought
+     *        within the Xapian index)
+     */
+    QuerySlices (const Xapian::Database&, const TravelQuery_T&,
+                 const OTransliterator&, const WordPairTable*,
+                 const SpellingDictionary*);
+
     /**
      * Default destructor.
      */
@@ -152,15 +186,31 @@ namespace OPENTREP {
      */
     const Xapian::Database& _database;
 
+    /**
+     * Xapian enquire session, re-used by all the full-text matches of
+     * the pairs of contiguous words.
+     */
+    Xapian::Enquire _enquire;
+
+    /**
+     * Table of the adjacent word pairs of the index (NULL when not available).
+     */
+    const WordPairTable* _wordPairTable;
+
+    /**
+     * Spelling dictionary of the index (NULL when not available).
+     */
+    const SpellingDictionary* _spellingDictionary;
+
     /**
      * Query string having generated the set of documents.
      */
     TravelQuery_T _queryString;
 
     /**
-     * Partition, i.e., a list containing sub-lists of strings
+     * List of query slices
      */
-    StringPartitionList_T _slices;
+    StringSet _slices;
 
     /**
      * Staging string holding the left part of the query
@@ -5,6 +5,7 @@
 #include <cassert>
 #include <sstream>
 #include <algorithm>
+#include <vector>
 // Boost
 #include <boost/tokenizer.hpp>
 // OpenTREP
@@ -16,8 +17,14 @@
 #include <opentrep/bom/Levenshtein.hpp>
 #include <opentrep/bom/Place.hpp>
 #include <opentrep/bom/Result.hpp>
+#include <opentrep/bom/ScoreMatrix.hpp>
+#include <opentrep/bom/QueryBuilder.hpp>
+#include <opentrep/bom/SpellingDictionary.hpp>
+#include <opentrep/bom/TermVocabulary.hpp>
+#include <opentrep/bom/PORValidityDecider.hpp>
 #include <opentrep/bom/PORParserHelper.hpp>
 #include <opentrep/service/Logger.hpp>
+#include <opentrep/service/StatisticsRecorder.hpp>
 
 namespace OPENTREP {
 
@@ -26,7 +33,7 @@ namespace OPENTREP {
                   const Xapian::Database& iDatabase)
     : _resultHolder (NULL), _database (iDatabase),
       _queryString (iQueryString), _hasFullTextMatched (false),
-      _bestDocData (RawDataString_T ("")) {
+      _bestDocID (0) {
     init();
   }
   
@@ -77,17 +84,20 @@ namespace OPENTREP {
          itDoc != _documentList.end(); ++itDoc, ++idx) {
       const XapianDocumentPair_T& lDocumentPair = *itDoc;
 
-      const Xapian::Document& lXapianDoc = lDocumentPair.first;
-      const Xapian::docid& lDocID = lXapianDoc.get_docid();
+      const Xapian::docid& lDocID = lDocumentPair.first;
 
       const ScoreBoard& lScoreBoard = lDocumentPair.second;
 
+      // The document data are not loaded: only the key, retrieved from
+      // the value slots, is displayed
+      const Location& lLocation = getLocation (lDocID);
+
       if (idx != 0) {
         oStr << ", ";
       }
       oStr << "Doc ID: " << lDocID << ", matching with ("
-           << lScoreBoard.describe() << "), containing: '"
-           << lXapianDoc.get_data() << "'";
+           << lScoreBoard.describe() << "), for: '"
+           << lLocation.getKey() << "'";
     }
 
     return oStr.str();
@@ -105,8 +115,8 @@ namespace OPENTREP {
   // //////////////////////////////////////////////////////////////////////
   const XapianDocumentPair_T& Result::
   getDocumentPair (const Xapian::docid& iDocID) const {
-    // Retrieve the Xapian document and associated ScoreBoard structure
-    // corresponding to the doc ID of the best matching document
+    // Retrieve the position of the Xapian document ID and associated
+    // ScoreBoard structure corresponding to the given doc ID
     DocumentMap_T::const_iterator itDoc = _documentMap.find (iDocID);
 
     if (itDoc == _documentMap.end()) {
@@ -117,24 +127,78 @@ namespace OPENTREP {
     assert (itDoc != _documentMap.end());
 
     //
-    const XapianDocumentPair_T& oDocumentPair = itDoc->second;
+    const size_t& lDocIdx = itDoc->second;
+    assert (lDocIdx < _documentList.size());
+    const XapianDocumentPair_T& oDocumentPair = _documentList[lDocIdx];
 
     //
     return oDocumentPair;
   }
 
   // //////////////////////////////////////////////////////////////////////
-  const Xapian::Document& Result::
-  getDocument (const Xapian::docid& iDocID) const {
-    // First, retrieve the pair made of Xapian document and associated
-    // ScoreBoard structure
-    const XapianDocumentPair_T& lDocumentPair = getDocumentPair (iDocID);
+  Xapian::Document Result::getDocument (const Xapian::docid& iDocID) const {
+    // Retrieve the position of the document within the list, which is
+    // also its position within the Xapian matching set
+    DocumentMap_T::const_iterator itDoc = _documentMap.find (iDocID);
+
+    if (itDoc == _documentMap.end()) {
+      OPENTREP_LOG_ERROR ("The Xapian document (ID = " << iDocID
+                          << ") can not be found in the Result object "
+                          << describeKey());
+    }
+    assert (itDoc != _documentMap.end());
+    const size_t& lDocIdx = itDoc->second;
+
+    // When the document has been added from the Xapian matching set,
+    // let Xapian pre-fetch it from there. Otherwise, load it directly
+    // from the Xapian database.
+    if (lDocIdx < _matchingSet.size()) {
+      const Xapian::MSetIterator itMatchingDoc = _matchingSet[lDocIdx];
+      if (*itMatchingDoc == iDocID) {
+        _matchingSet.fetch (itMatchingDoc);
+        return itMatchingDoc.get_document();
+      }
+    }
+    return _database.get_document (iDocID);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  RawDataString_T Result::fetchBestDocData() const {
+    RawDataString_T oDocData ("");
+    if (_bestDocID == 0) {
+      return oDocData;
+    }
+
+    // Catch any Xapian::Error exceptions thrown
+    try {
+      const Xapian::Document& lBestXapianDoc = getDocument (_bestDocID);
+      oDocData = RawDataString_T (lBestXapianDoc.get_data());
+
+    } catch (const Xapian::Error& error) {
+      OPENTREP_LOG_ERROR ("Xapian-related error: "  << error.get_msg());
+      throw XapianException (error.get_msg());
+    }
+
+    return oDocData;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const Location& Result::getLocation (const Xapian::docid& iDocID) const {
+    // Retrieve the Location structure corresponding to the given doc ID
+    LocationMap_T::const_iterator itLocation = _locationMap.find (iDocID);
 
-    // Then, take the Xapian document (and leave the ScoreBoard out)
-    const Xapian::Document& oXapianDocument = lDocumentPair.first;
+    if (itLocation == _locationMap.end()) {
+      OPENTREP_LOG_ERROR ("The Location structure for the Xapian document (ID = "
+                          << iDocID << ") can not be found in the Result object "
+                          << describeKey());
+    }
+    assert (itLocation != _locationMap.end());
 
     //
-    return oXapianDocument;
+    const Location& oLocation = itLocation->second;
+
+    //
+    return oLocation;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -172,19 +236,35 @@ namespace OPENTREP {
                         << "% (corrected into " << lCorrectedScore << "%)");
     */
 
-    // Create a (Xapian document, score board) pair, so as to store
-    // the document along with its corresponding score board
-    const XapianDocumentPair_T lDocumentPair (iDocument, lScoreBoard);
+    // Create a (Xapian document ID, score board) pair, so as to store
+    // the document ID along with its corresponding score board
+    const XapianDocumentPair_T lDocumentPair (lDocID, lScoreBoard);
 
     // Insert the just created pair into the dedicated (STL) list
+    const size_t lDocIdx = _documentList.size();
     _documentList.push_back (lDocumentPair);
 
-    // Insert the just created pair into the dedicated (STL) map
+    // Register the position of the pair into the dedicated (STL) map
     const bool hasInsertBeenSuccessful =
       _documentMap.insert (DocumentMap_T::value_type (lDocID,
-                                                      lDocumentPair)).second;
+                                                      lDocIdx)).second;
     // Sanity check
     assert (hasInsertBeenSuccessful == true);
+
+    // Retrieve the scoring details held by the value slots of the Xapian
+    // document. For older indexes, parse the POR (point of reference)
+    // details held by the document data. In both cases, that is done
+    // once for all, and the resulting Location structure is stored.
+    Location lLocation;
+    const bool hasValues = retrieveScoringValues (iDocument, lLocation);
+    if (hasValues == false) {
+      lLocation = retrieveLocation (iDocument);
+    }
+    const bool hasLocationInsertBeenSuccessful =
+      _locationMap.insert (LocationMap_T::value_type (lDocID,
+                                                      lLocation)).second;
+    // Sanity check
+    assert (hasLocationInsertBeenSuccessful == true);
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -192,12 +272,43 @@ namespace OPENTREP {
     /**
      * Retrieve the best matching documents, each with its own
      * (Xapian-based) full-text score / weighting percentage.
+     * Only the IDs and the value slots of the documents are retrieved;
+     * the matching set is kept, so that the data of the best matching
+     * document may later be loaded from it.
      */
+    _matchingSet = iMatchingSet;
+    _documentList.reserve (iMatchingSet.size());
+
+    /**
+     * The weight of a document is the sum of its full-text relevance and
+     * of its prior (see fullTextMatch()). As the PageRank and envelope
+     * weights are already taken into account by the combined weight,
+     * the prior is taken out, and the matching percentage is calculated
+     * on the full-text relevance only, the best one giving 100%.
+     */
+    std::vector<Xapian::Document> lDocumentList;
+    std::vector<Xapian::weight> lRelevanceList;
+    lDocumentList.reserve (iMatchingSet.size());
+    lRelevanceList.reserve (iMatchingSet.size());
+    Xapian::weight lMaxRelevance = 0.0;
     for (Xapian::MSetIterator itDoc = iMatchingSet.begin();
          itDoc != iMatchingSet.end(); ++itDoc) {
-      const Xapian::percent& lXapianPercentage = itDoc.get_percent();
       const Xapian::Document& lDocument = itDoc.get_document();
-      addDocument (lDocument, lXapianPercentage);
+      const Xapian::weight lRelevance =
+        itDoc.get_weight() - QueryBuilder::getPriorWeight (lDocument);
+      lMaxRelevance = std::max (lMaxRelevance, lRelevance);
+      lDocumentList.push_back (lDocument);
+      lRelevanceList.push_back (lRelevance);
+    }
+
+    for (size_t idx = 0; idx != lDocumentList.size(); ++idx) {
+      Xapian::percent lXapianPercentage = 100;
+      if (lMaxRelevance > 0.0) {
+        lXapianPercentage = static_cast<Xapian::percent>
+          (100.0 * lRelevanceList[idx] / lMaxRelevance + 0.5);
+        lXapianPercentage = std::max (lXapianPercentage, 1);
+      }
+      addDocument (lDocumentList[idx], lXapianPercentage);
     }
   }
 
@@ -223,8 +334,7 @@ namespace OPENTREP {
 
     // DEBUG
     OPENTREP_LOG_DEBUG ("Place key: " << lKey << " - Xapian ID " << _bestDocID
-                        << ", " << _bestCombinedWeight << "% [" << _bestDocData
-                        << "]");
+                        << ", " << _bestCombinedWeight << "%");
   }
 
   /**
@@ -247,6 +357,35 @@ namespace OPENTREP {
     oEditDistance = lQueryStringSize / K_DEFAULT_SIZE_FOR_SPELLING_ERROR_UNIT;
     return oEditDistance;
   }
+
+  /**
+   * @brief Helper function
+   *
+   * Get the spelling correction of the given phrase, if any, along with
+   * the allowed edit distance. When available, the in-memory spelling
+   * dictionary is looked up, with the edit distance allowed by its
+   * distance error rule. Otherwise, the Xapian spelling table is browsed,
+   * with the edit distance given by calculateEditDistance().
+   */
+  // //////////////////////////////////////////////////////////////////////
+  static std::string
+  getSpellingSuggestion (const Xapian::Database& iDatabase,
+                         const SpellingDictionary* iSpellingDictionary_ptr,
+                         const TravelQuery_T& iPhrase,
+                         NbOfErrors_T& oAllowableEditDistance) {
+    const SearchStageTimer lSpellingTimer (SearchStage::SPELLING);
+    StatisticsRecorder::increment (SearchCounter::SPELLING_CALLS);
+
+    if (iSpellingDictionary_ptr != NULL) {
+      oAllowableEditDistance =
+        iSpellingDictionary_ptr->getAllowedDistanceError (iPhrase);
+      NbOfErrors_T lEditDistance = 0;
+      return iSpellingDictionary_ptr->getSuggestion (iPhrase, lEditDistance);
+    }
+
+    oAllowableEditDistance = calculateEditDistance (iPhrase);
+    return iDatabase.get_spelling_suggestion (iPhrase, oAllowableEditDistance);
+  }
   
   // //////////////////////////////////////////////////////////////////////
   Location Result::retrieveLocation (const RawDataString_T& iRawDataString) {
@@ -274,6 +413,50 @@ namespace OPENTREP {
     return oLocation;
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  bool Result::retrieveScoringValues (const Xapian::Document& iDocument,
+                                      Location& ioLocation) {
+    // Retrieve the PageRank. When that value slot is empty, the index
+    // has been generated by an older version, not storing value slots.
+    const std::string& lPageRankStr =
+      iDocument.get_value (K_XAPIAN_VALUE_SLOT_PAGE_RANK);
+    if (lPageRankStr.empty() == true) {
+      return false;
+    }
+    const PageRank_T lPageRank = Xapian::sortable_unserialise (lPageRankStr);
+    ioLocation.setPageRank (lPageRank);
+
+    // Retrieve the envelope ID
+    const std::string& lEnvelopeIDStr =
+      iDocument.get_value (K_XAPIAN_VALUE_SLOT_ENVELOPE_ID);
+    const EnvelopeID_T lEnvelopeID = static_cast<const EnvelopeID_T>
+      (Xapian::sortable_unserialise (lEnvelopeIDStr));
+    ioLocation.setEnvelopeID (lEnvelopeID);
+
+    // Retrieve the primary key (IATA code and type, Geonames ID)
+    const std::string& lIataCode =
+      iDocument.get_value (K_XAPIAN_VALUE_SLOT_IATA_CODE);
+    ioLocation.setIataCode (lIataCode);
+
+    const std::string& lIataTypeStr =
+      iDocument.get_value (K_XAPIAN_VALUE_SLOT_IATA_TYPE);
+    const IATAType lIataType (lIataTypeStr);
+    ioLocation.setIataType (lIataType);
+
+    const std::string& lGeonamesIDStr =
+      iDocument.get_value (K_XAPIAN_VALUE_SLOT_GEONAMES_ID);
+    const GeonamesID_T lGeonamesID = static_cast<const GeonamesID_T>
+      (Xapian::sortable_unserialise (lGeonamesIDStr));
+    ioLocation.setGeonamesID (lGeonamesID);
+
+    // Retrieve the feature code
+    const std::string& lFeatureCode =
+      iDocument.get_value (K_XAPIAN_VALUE_SLOT_FEATURE_CODE);
+    ioLocation.setFeatureCode (lFeatureCode);
+
+    return true;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   LocationKey Result::getPrimaryKey (const Xapian::Document& iDocument) {
     // Parse the POR (point of reference) details held by the Xapian document
@@ -311,64 +494,104 @@ namespace OPENTREP {
   }
   
   // //////////////////////////////////////////////////////////////////////
-  std::string Result::fullTextMatch (const Xapian::Database& iDatabase,
-                                     const TravelQuery_T& iQueryString,
-                                     Xapian::MSet& ioMatchingSet) {
+  std::string Result::
+  fullTextMatch (const Xapian::Database& iDatabase,
+                 const TravelQuery_T& iQueryString,
+                 const PORValidityDecider* iPORValidityDecider_ptr,
+                 const SpellingDictionary* iSpellingDictionary_ptr,
+                 const TermVocabulary* iTermVocabulary_ptr,
+                 Xapian::Enquire& ioEnquire,
+                 Xapian::MSet& ioMatchingSet) {
     std::string oMatchedString;
 
     // Catch any Xapian::Error exceptions thrown
     try {
       
-      // Build the query object
-      Xapian::QueryParser lQueryParser;
-      lQueryParser.set_database (iDatabase);
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("        --------");
 
       /**
-       * As explained in http://www.xapian.org/docs/queryparser.html,
-       * Xapian::Query::OP_NEAR may be better than Xapian::Query::OP_PHRASE,
-       * but only available from version 1.0.13 of Xapian.
+       * Rank the matching documents on the sum of their full-text
+       * relevance and of their prior (i.e., the logarithm of the weights
+       * not depending on the full-text matching, namely the PageRank and
+       * the envelope), within the Xapian matcher itself (see
+       * QueryBuilder::addPrior()). Hence, the matching set is made of the
+       * true top documents, and a big airport is not missed because of
+       * a lower relevance.
+       * Note that the posting source of the prior must outlive the calls
+       * to Xapian::Enquire::get_mset().
        */
-      // lQueryParser.set_default_op (Xapian::Query::OP_ADJ);
-      lQueryParser.set_default_op (Xapian::Query::OP_PHRASE);
+      Xapian::ValueWeightPostingSource lPriorSource (K_XAPIAN_VALUE_SLOT_PRIOR);
 
-      // DEBUG
-      /*
-        OPENTREP_LOG_DEBUG ("Query parser `" << lQueryParser.get_description()
-        << "'");
-      */
+      /**
+       * When some POR (points of reference) are to be filtered out (e.g.,
+       * the expired ones), that is done by Xapian, within the matcher,
+       * so that the invalid POR do not take any room within the matching
+       * set.
+       */
+      const Xapian::MatchDecider* lMatchDecider_ptr = NULL;
+      if (iPORValidityDecider_ptr != NULL
+          && iPORValidityDecider_ptr->isActive() == true) {
+        lMatchDecider_ptr = iPORValidityDecider_ptr;
+      }
 
-      // DEBUG
-      OPENTREP_LOG_DEBUG ("        --------");
-        
-      // Start an enquire session
-      Xapian::Enquire enquire (iDatabase);
+      /**
+       * Convert the words of the query string into Xapian terms. With the
+       * above example ('sna francicso'), the terms are 'sna' and
+       * 'francicso'.
+       */
+      WordList_T lWordList;
+      WordHolder::tokeniseStringIntoWordList (iQueryString, lWordList);
+      WordList_T lTermList;
+      QueryBuilder::buildTermList (lWordList, lTermList);
 
       /**
-       * The Xapian::QueryParser::parse_query() method aggregates all
-       * the words with operators inbetween them (here, the "PHRASE"
-       * operator).  With the above example ('sna francicso'), it
-       * yields "sna PHRASE 2 francicso".
+       * When one of the terms is not known by the index at all, the exact
+       * (phrase) match cannot give anything, and only the spelling
+       * correction is searched for. That is decided in memory, thanks to
+       * the vocabulary of the index, when available.
        */
-      const Xapian::Query& lXapianQuery =
-        lQueryParser.parse_query (iQueryString,
-                                  Xapian::QueryParser::FLAG_BOOLEAN
-                                  | Xapian::QueryParser::FLAG_PHRASE
-                                  | Xapian::QueryParser::FLAG_LOVEHATE);
+      std::string lUnknownTerm;
+      const bool hasOnlyKnownTerms = (iTermVocabulary_ptr == NULL
+                                      || iTermVocabulary_ptr->
+                                      containsAll (lTermList, lUnknownTerm));
 
-      // Give the query object to the enquire session
-      enquire.set_query (lXapianQuery);
+      int nbMatches = 0;
+      if (hasOnlyKnownTerms == true) {
+        /**
+         * Build the query object directly from the terms, aggregated with
+         * the "PHRASE" operator. With the above example, it yields
+         * "sna PHRASE 2 francicso".
+         */
+        const Xapian::Query& lXapianQuery =
+          QueryBuilder::buildQuery (lWordList);
 
-      // Get the top K_DEFAULT_XAPIAN_MATCHING_SET_SIZE (normally, 30)
-      // results of the query
-      ioMatchingSet = enquire.get_mset (0, K_DEFAULT_XAPIAN_MATCHING_SET_SIZE);
+        // Give the query object, along with the prior, to the enquire
+        // session
+        ioEnquire.set_query (QueryBuilder::addPrior (lXapianQuery,
+                                                     lPriorSource));
 
-      // Display the results
-      int nbMatches = ioMatchingSet.size();
+        // Get the top K_DEFAULT_XAPIAN_MATCHING_SET_SIZE (normally, 30)
+        // results of the query
+        StatisticsRecorder::increment (SearchCounter::XAPIAN_QUERIES);
+        ioMatchingSet =
+          ioEnquire.get_mset (0, K_DEFAULT_XAPIAN_MATCHING_SET_SIZE,
+                              0, NULL, lMatchDecider_ptr);
 
-      // DEBUG
-      OPENTREP_LOG_DEBUG ("      Query string: `" << iQueryString
-                          << "', i.e.: `" << lXapianQuery.get_description()
-                          << "' => " << nbMatches << " result(s) found");
+        // Display the results
+        nbMatches = ioMatchingSet.size();
+
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("      Query string: `" << iQueryString
+                            << "', i.e.: `" << lXapianQuery.get_description()
+                            << "' => " << nbMatches << " result(s) found");
+
+      } else {
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("      Query string: `" << iQueryString
+                            << "' => the `" << lUnknownTerm
+                            << "' term is unknown by the index");
+      }
 
       if (nbMatches != 0) {
         // Store the effective (Levenshtein) edit distance/error
@@ -401,12 +624,10 @@ namespace OPENTREP {
        * With the above example, 'sna francisco' yields the suggestion
        * 'san francisco'.
        */
-      const NbOfErrors_T& lAllowableEditDistance =
-        calculateEditDistance (iQueryString);
-      
-      // Let Xapian find a spelling correction (if any)
+      NbOfErrors_T lAllowableEditDistance = 0;
       const std::string& lCorrectedString =
-        iDatabase.get_spelling_suggestion (iQueryString, lAllowableEditDistance);
+        getSpellingSuggestion (iDatabase, iSpellingDictionary_ptr,
+                               iQueryString, lAllowableEditDistance);
 
       // If the correction is no better than the original string, there is
       // no need to go further: there is no match.
@@ -438,16 +659,16 @@ namespace OPENTREP {
        * 'san francisco', it yields the query "san PHRASE 2 francisco",
        * which should provide matches.
        */
-      const Xapian::Query& lCorrectedXapianQuery = 
-        lQueryParser.parse_query (lCorrectedString,
-                                  Xapian::QueryParser::FLAG_BOOLEAN
-                                  | Xapian::QueryParser::FLAG_PHRASE
-                                  | Xapian::QueryParser::FLAG_LOVEHATE);
+      const Xapian::Query& lCorrectedXapianQuery =
+        QueryBuilder::buildQuery (lCorrectedString);
 
       // Retrieve a maximum of K_DEFAULT_XAPIAN_MATCHING_SET_SIZE (normally,
       // 30) entries
-      enquire.set_query (lCorrectedXapianQuery);
-      ioMatchingSet = enquire.get_mset (0, K_DEFAULT_XAPIAN_MATCHING_SET_SIZE);
+      ioEnquire.set_query (QueryBuilder::addPrior (lCorrectedXapianQuery,
+                                                   lPriorSource));
+      StatisticsRecorder::increment (SearchCounter::XAPIAN_QUERIES);
+      ioMatchingSet = ioEnquire.get_mset (0, K_DEFAULT_XAPIAN_MATCHING_SET_SIZE,
+                                          0, NULL, lMatchDecider_ptr);
 
       // Display the results
       nbMatches = ioMatchingSet.size();
@@ -488,6 +709,22 @@ namespace OPENTREP {
         return oMatchedString;
       }
 
+      // When some POR are filtered out, the documents matching the
+      // corrected string may all have been filtered out
+      if (lMatchDecider_ptr != NULL) {
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("        Query string: `"
+                            << iQueryString << "', spelling suggestion: `"
+                            << lCorrectedString << "', provides no match "
+                            << "among the valid POR");
+
+        // Store the fact that there has not been any full-text match
+        setHasFullTextMatched (false);
+
+        // Leave the string empty
+        return oMatchedString;
+      }
+
       // Error
       OPENTREP_LOG_ERROR ("        Query string: `"
                           << iQueryString << "', spelling suggestion: `"
@@ -512,8 +749,13 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  std::string Result::fullTextMatch (const Xapian::Database& iDatabase,
-                                     const TravelQuery_T& iQueryString) {
+  std::string Result::
+  fullTextMatch (const Xapian::Database& iDatabase,
+                 const TravelQuery_T& iQueryString,
+                 const PORValidityDecider* iPORValidityDecider_ptr,
+                 const SpellingDictionary* iSpellingDictionary_ptr,
+                 const TermVocabulary* iTermVocabulary_ptr,
+                 Xapian::Enquire& ioEnquire) {
     std::string oMatchedString;
 
     // Catch any Xapian::Error exceptions thrown
@@ -529,7 +771,11 @@ namespace OPENTREP {
 
       Xapian::MSet lMatchingSet;
       if (isToBeAdded == true) {
-        oMatchedString = fullTextMatch (iDatabase, iQueryString, lMatchingSet);
+        oMatchedString = fullTextMatch (iDatabase, iQueryString,
+                                        iPORValidityDecider_ptr,
+                                        iSpellingDictionary_ptr,
+                                        iTermVocabulary_ptr, ioEnquire,
+                                        lMatchingSet);
       }
 
       // Create the corresponding documents (from the Xapian MSet object)
@@ -559,14 +805,12 @@ namespace OPENTREP {
          itDoc != _documentList.end(); ++itDoc) {
       const XapianDocumentPair_T& lDocumentPair = *itDoc;
 
-      // Retrieve the Xapian document
-      const Xapian::Document& lXapianDoc = lDocumentPair.first;
-
-      // Extract the Xapian document ID
-      const Xapian::docid& lDocID = lXapianDoc.get_docid();
+      // Retrieve the Xapian document ID
+      const Xapian::docid& lDocID = lDocumentPair.first;
 
-      // Extract the envelope ID from the document data
-      const LocationKey& lLocationKey = getPrimaryKey (lXapianDoc);
+      // Retrieve the primary key from the (already decoded) document data
+      const Location& lLocation = getLocation (lDocID);
+      const LocationKey& lLocationKey = lLocation.getKey();
 
       // Retrieve the score board for that Xapian document
       const ScoreBoard& lScoreBoard = lDocumentPair.second;
@@ -575,35 +819,13 @@ namespace OPENTREP {
       const Score_T& lXapianPct = lScoreBoard.getScore (ScoreType::XAPIAN_PCT);
 
       // DEBUG
-      OPENTREP_LOG_NOTIFICATION ("        [xapian] '" << describeShortKey()
-                                 << "' with (" << lLocationKey << ", doc ID = "
-                                 << lDocID << ") matches at " << lXapianPct
-                                 << "%");
+      OPENTREP_LOG_DEBUG ("        [xapian] '" << describeShortKey()
+                          << "' with (" << lLocationKey << ", doc ID = "
+                          << lDocID << ") matches at " << lXapianPct
+                          << "%");
     }
   }
 
-  // //////////////////////////////////////////////////////////////////////
-  void Result::setScoreOnDocMap (const Xapian::docid& iDocID,
-                                 const ScoreType& iType, const Score_T& iScore) {
-    // Retrieve the Xapian document and associated ScoreBoard structure
-    // corresponding to the given doc ID
-    DocumentMap_T::iterator itDoc = _documentMap.find (iDocID);
-
-    if (itDoc == _documentMap.end()) {
-      OPENTREP_LOG_ERROR ("The Xapian document (ID = " << iDocID
-                          << ") can not be found in the Result object "
-                          << describeKey());
-    }
-    assert (itDoc != _documentMap.end());
-
-    // Retrieve the associated ScoreBoard structure
-    XapianDocumentPair_T& lXapianDocPair = itDoc->second;
-    ScoreBoard& lScoreBoard = lXapianDocPair.second;
-
-    // Update the score/weight
-    lScoreBoard.setScore (iType, iScore);
-  }
-
   // //////////////////////////////////////////////////////////////////////
   void Result::calculateEnvelopeWeights() {
     // Browse the list of Xapian documents
@@ -611,24 +833,22 @@ namespace OPENTREP {
          itDoc != _documentList.end(); ++itDoc) {
       XapianDocumentPair_T& lDocumentPair = *itDoc;
 
-      // Retrieve the Xapian document
-      const Xapian::Document& lXapianDoc = lDocumentPair.first;
-
-      // Extract the Xapian document ID
-      const Xapian::docid& lDocID = lXapianDoc.get_docid();
+      // Retrieve the Xapian document ID
+      const Xapian::docid& lDocID = lDocumentPair.first;
 
-      // Extract the envelope ID from the document data
-      const LocationKey& lLocationKey = getPrimaryKey (lXapianDoc);
+      // Retrieve the primary key from the (already decoded) document data
+      const Location& lLocation = getLocation (lDocID);
+      const LocationKey& lLocationKey = lLocation.getKey();
 
-      // Extract the envelope ID from the document data
-      const EnvelopeID_T& lEnvelopeIDInt = getEnvelopeID (lXapianDoc);
+      // Retrieve the envelope ID from the (already decoded) document data
+      const EnvelopeID_T& lEnvelopeIDInt = lLocation.getEnvelopeID();
 
       // DEBUG
       if (lEnvelopeIDInt != 0) {
-        OPENTREP_LOG_NOTIFICATION ("        [env][" << describeShortKey()
-                                   << "] (" << lLocationKey << ", doc ID = "
-                                   << lDocID << ") has a non-null envelope ID ("
-                                   << lEnvelopeIDInt << ") => match of 0.10%");
+        OPENTREP_LOG_DEBUG ("        [env][" << describeShortKey()
+                            << "] (" << lLocationKey << ", doc ID = "
+                            << lDocID << ") has a non-null envelope ID ("
+                            << lEnvelopeIDInt << ") => match of 0.10%");
       }
 
       // Convert the envelope ID value, from an integer to a floating point one
@@ -639,63 +859,77 @@ namespace OPENTREP {
 
       // Store the envelope-related weight
       lScoreBoard.setScore (ScoreType::ENV_ID, lEnvelopeID);
-      setScoreOnDocMap (lDocID, ScoreType::ENV_ID, lEnvelopeID);
     }
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  std::string Result::getQueryCode (const TravelQuery_T& iQueryString) {
+    std::string oUpperQueryWord;
+
+    // Filter out "standard" words such as "airport", "international",
+    // "city", as well as words having a length strictly less than
+    // 3 letters.
+    std::string lFilteredString (iQueryString);
+    const NbOfLetters_T kMinWordLength = 3;
+    Filter::trim (lFilteredString, kMinWordLength);
+
+    // Check whether or not the filtered query string is made of
+    // a single word
+    WordList_T lFilteredQueryWordList;
+    WordHolder::tokeniseStringIntoWordList (lFilteredString,
+                                            lFilteredQueryWordList);
+    const NbOfWords_T nbOfFilteredQueryWords = lFilteredQueryWordList.size();
+
+    // Check whether that single word is made of 3 or 4 letters
+    const size_t lNbOfLetters = lFilteredString.size();
+    const bool isQueryACode = (nbOfFilteredQueryWords == 1
+                               && lNbOfLetters >= 3 && lNbOfLetters <= 4);
+
+    // Convert the query string (made of one word of 3 or 4 letters)
+    // to uppercase letters
+    if (isQueryACode == true) {
+      oUpperQueryWord.resize (lNbOfLetters);
+      std::transform (lFilteredString.begin(), lFilteredString.end(),
+                      oUpperQueryWord.begin(), ::toupper);
+    }
+
+    return oUpperQueryWord;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   void Result::calculateCodeMatches() {
+    /**
+     * Check whether the query string, when some standard words (e.g.,
+     * "airport", "international", "city") have been filtered out,
+     * is made of a single IATA, ICAO or FAA code. Also, there should
+     * have been no correction. As that does not depend on the documents,
+     * it is done once for all, before browsing them.
+     */
+    std::string lUpperQueryWord;
+    if (_correctedQueryString == _queryString) {
+      lUpperQueryWord = getQueryCode (_queryString);
+    }
+    const bool isQueryACode = (lUpperQueryWord.empty() == false);
+
     // Browse the list of Xapian documents
     for (DocumentList_T::iterator itDoc = _documentList.begin();
          itDoc != _documentList.end(); ++itDoc) {
       XapianDocumentPair_T& lDocumentPair = *itDoc;
 
-      // Retrieve the Xapian document
-      const Xapian::Document& lXapianDoc = lDocumentPair.first;
-
-      // Extract the Xapian document ID
-      const Xapian::docid& lDocID = lXapianDoc.get_docid();
+      // Retrieve the Xapian document ID
+      const Xapian::docid& lDocID = lDocumentPair.first;
 
-      // Extract the envelope ID from the document data
-      const LocationKey& lLocationKey = getPrimaryKey (lXapianDoc);
+      // Retrieve the primary key from the (already decoded) document data
+      const Location& lLocation = getLocation (lDocID);
+      const LocationKey& lLocationKey = lLocation.getKey();
 
       // Initialisation of the IATA/ICAO code full matching percentage
       Score_T lCodeMatchPct = 0.0;
       bool hasCodeFullyMatched = false;
 
-      // Filter out "standard" words such as "airport", "international",
-      // "city", as well as words having a length strictly less than
-      // 3 letters.
-      std::string lFilteredString (_queryString);
-      const NbOfLetters_T kMinWordLength = 3;
-      Filter::trim (lFilteredString, kMinWordLength);
-
-      // Check whether or not the filtered query string is made of
-      // a single word
-      WordList_T lFilteredQueryWordList;
-      WordHolder::tokeniseStringIntoWordList (lFilteredString,
-                                              lFilteredQueryWordList);
-      const NbOfWords_T nbOfFilteredQueryWords = lFilteredQueryWordList.size();
-
       //
       if (_hasFullTextMatched == true) {
-        /**
-         * Check whether the query string, when some standard words (e.g.,
-         * "airport", "international", "city") have been filtered out,
-         * is made of a single IATA, ICAO or FAA code. Also, there should
-         * have been no correction.
-         */
-        const size_t lNbOfLetters = lFilteredString.size();
-        if (nbOfFilteredQueryWords == 1
-            && lNbOfLetters >= 3 && lNbOfLetters <= 4
-            && _correctedQueryString == _queryString) {
-          // Convert the query string (made of one word of 3 or 4 letters)
-          // to uppercase letters
-          std::string lUpperQueryWord;
-          lUpperQueryWord.resize (lNbOfLetters);
-          std::transform (lFilteredString.begin(), lFilteredString.end(),
-                          lUpperQueryWord.begin(), ::toupper);
-
+        if (isQueryACode == true) {
           // Retrieve with the IATA code
           const IATACode_T& lIataCode = lLocationKey.getIataCode();
 
@@ -712,18 +946,18 @@ namespace OPENTREP {
 
         if (hasCodeFullyMatched == true) {
           // DEBUG
-          OPENTREP_LOG_NOTIFICATION ("        [code] '" << describeShortKey()
-                                     << "' matches the IATA/ICAO code ("
-                                     << lLocationKey << ", doc ID = "
-                                     << lDocID << ") => match of "
-                                     << K_DEFAULT_FULL_CODE_MATCH_PCT << "%");
+          OPENTREP_LOG_DEBUG ("        [code] '" << describeShortKey()
+                              << "' matches the IATA/ICAO code ("
+                              << lLocationKey << ", doc ID = "
+                              << lDocID << ") => match of "
+                              << K_DEFAULT_FULL_CODE_MATCH_PCT << "%");
         } else {
           // DEBUG
-          OPENTREP_LOG_NOTIFICATION ("        [code] '" << describeShortKey()
-                                     << "' does not match with the IATA/ICAO "
-                                     << "code (" << lLocationKey << ", doc ID = "
-                                     << lDocID << ") => match of "
-                                     << K_DEFAULT_MODIFIED_MATCHING_PCT << "%");
+          OPENTREP_LOG_DEBUG ("        [code] '" << describeShortKey()
+                              << "' does not match with the IATA/ICAO "
+                              << "code (" << lLocationKey << ", doc ID = "
+                              << lDocID << ") => match of "
+                              << K_DEFAULT_MODIFIED_MATCHING_PCT << "%");
         }
       }
 
@@ -732,7 +966,6 @@ namespace OPENTREP {
 
       // Store the IATA/ICAO code match percentage/weight
       lScoreBoard.setScore (ScoreType::CODE_FULL_MATCH, lCodeMatchPct);
-      setScoreOnDocMap (lDocID, ScoreType::CODE_FULL_MATCH, lCodeMatchPct);
     }
   }
 
@@ -743,30 +976,27 @@ namespace OPENTREP {
          itDoc != _documentList.end(); ++itDoc) {
       XapianDocumentPair_T& lDocumentPair = *itDoc;
 
-      // Retrieve the Xapian document
-      const Xapian::Document& lXapianDoc = lDocumentPair.first;
-
-      // Extract the Xapian document ID
-      const Xapian::docid& lDocID = lXapianDoc.get_docid();
+      // Retrieve the Xapian document ID
+      const Xapian::docid& lDocID = lDocumentPair.first;
 
-      // Extract the envelope ID from the document data
-      const LocationKey& lLocationKey = getPrimaryKey (lXapianDoc);
+      // Retrieve the primary key from the (already decoded) document data
+      const Location& lLocation = getLocation (lDocID);
+      const LocationKey& lLocationKey = lLocation.getKey();
 
-      // Extract the PageRank from the document data
-      const Score_T& lPageRank = getPageRank (lXapianDoc);
+      // Retrieve the PageRank from the (already decoded) document data
+      const Score_T& lPageRank = lLocation.getPageRank();
 
       // DEBUG
-      OPENTREP_LOG_NOTIFICATION ("        [pr][" << describeShortKey()
-                                 << "] (" << lLocationKey << ", doc ID = "
-                                 << lDocID << ") has a PageRank of "
-                                 << lPageRank << "%");
+      OPENTREP_LOG_DEBUG ("        [pr][" << describeShortKey()
+                          << "] (" << lLocationKey << ", doc ID = "
+                          << lDocID << ") has a PageRank of "
+                          << lPageRank << "%");
 
       // Retrieve the score board for that Xapian document
       ScoreBoard& lScoreBoard = lDocumentPair.second;
 
       // Store the PageRank weight
       lScoreBoard.setScore (ScoreType::PAGE_RANK, lPageRank);
-      setScoreOnDocMap (lDocID, ScoreType::PAGE_RANK, lPageRank);
     }
   }
 
@@ -779,32 +1009,66 @@ namespace OPENTREP {
      */
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void Result::calculateAllWeights() {
+    // Display a summary of the Xapian matching results
+    displayXapianPercentages();
+
+    // Calculate/set the envelope weights
+    calculateEnvelopeWeights();
+
+    // Calculate/set the IATA/ICAO code matching weights
+    calculateCodeMatches();
+
+    // Calculate/set the PageRanks
+    calculatePageRanks();
+
+    // Calculate/set the heuristic weights
+    calculateHeuristicWeights();
+
+    // Calculate/set the combined weights
+    calculateCombinedWeights();
+  }
+
   // //////////////////////////////////////////////////////////////////////
   void Result::calculateCombinedWeights() {
     Percentage_T lMaxPercentage = 0.0;
-    std::string lBestDocData; 
+
+    /**
+     * Gather the scores of all the documents within a structure of
+     * arrays, and calculate the combined weights, resulting from all
+     * the rules (e.g., full-text matching, PageRank, user input),
+     * in a single pass.
+     */
+    ScoreMatrix lScoreMatrix (_documentList.size());
+    size_t lDocIdx = 0;
+    for (DocumentList_T::const_iterator itDoc = _documentList.begin();
+         itDoc != _documentList.end(); ++itDoc, ++lDocIdx) {
+      const XapianDocumentPair_T& lDocumentPair = *itDoc;
+      const ScoreBoard& lScoreBoard = lDocumentPair.second;
+      lScoreMatrix.setScoreBoard (lDocIdx, lScoreBoard);
+    }
+    lScoreMatrix.calculateCombinedWeights();
 
     // Browse the list of Xapian documents
     Xapian::docid lBestDocID = 0;
+    lDocIdx = 0;
     for (DocumentList_T::iterator itDoc = _documentList.begin();
-         itDoc != _documentList.end(); ++itDoc) {
+         itDoc != _documentList.end(); ++itDoc, ++lDocIdx) {
       XapianDocumentPair_T& lDocumentPair = *itDoc;
 
       // Retrieve the Xapian document ID
-      const Xapian::Document& lXapianDoc = lDocumentPair.first;
-      const Xapian::docid& lDocID = lXapianDoc.get_docid();
-      const std::string& lDocData = lXapianDoc.get_data();
+      const Xapian::docid& lDocID = lDocumentPair.first;
 
-      /**
-       * Calculate the combined weight, resulting from all the rules
-       * (e.g., full-text matching, PageRank, user input).
-       */
+      // Register the combined weight within the score board
       ScoreBoard& lScoreBoard = lDocumentPair.second;
-      const Percentage_T& lPercentage = lScoreBoard.calculateCombinedWeight();
+      const Percentage_T& lPercentage =
+        lScoreMatrix.getCombinedWeight (lDocIdx);
+      lScoreBoard.setCombinedWeight (lPercentage);
 
       /**
       // DEBUG
-      const LocationKey& lLocationKey = getPrimaryKey (lXapianDoc);
+      const LocationKey& lLocationKey = getLocation (lDocID).getKey();
       OPENTREP_LOG_DEBUG ("        [pct] '" << describeShortKey()
                           << "', " << lLocationKey << " (doc ID = " << lDocID
                           << ") having the following weight: " << lPercentage
@@ -815,7 +1079,6 @@ namespace OPENTREP {
       if (lPercentage > lMaxPercentage) {
         lMaxPercentage = lPercentage;
         lBestDocID = lDocID;
-        lBestDocData = lDocData;
       }
     }
 
@@ -830,9 +1093,9 @@ namespace OPENTREP {
       // Retrieve the primary key (IATA, location type, Geonames ID) of
       // the place corresponding to the document
       const XapianDocumentPair_T& lXapianDocPair = getDocumentPair (lBestDocID);
-      const Xapian::Document& lXapianDoc = lXapianDocPair.first;
       const ScoreBoard& lScoreBoard = lXapianDocPair.second;
-      const LocationKey& lLocationKey = getPrimaryKey (lXapianDoc);
+      const Location& lLocation = getLocation (lBestDocID);
+      const LocationKey& lLocationKey = lLocation.getKey();
 
       // DEBUG
       OPENTREP_LOG_DEBUG ("        [pct] '" << describeShortKey()
@@ -886,9 +1149,6 @@ namespace OPENTREP {
 
     // Store the best weight
     setBestCombinedWeight (lMaxPercentage);
-
-    // Store all the details of the Xapian document
-    setBestDocData (lBestDocData);
   }
 
 }
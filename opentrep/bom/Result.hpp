@@ -5,12 +5,13 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
-#include <list>
+#include <vector>
 #include <map>
 // Xapian
 #include <xapian.h>
 // OpenTREP
 #include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/Location.hpp>
 #include <opentrep/bom/BomAbstract.hpp>
 #include <opentrep/bom/ScoreBoard.hpp>
 
@@ -18,26 +19,35 @@ namespace OPENTREP {
 
   // Forward declarations
   class ResultHolder;
-  struct LocationKey;
-  struct Location;
   class Place;
+  class PORValidityDecider;
+  struct SpellingDictionary;
+  struct TermVocabulary;
 
 
   // //////////////////// Type definitions /////////////////////
   /**
-   * Pair of a Xapian document and its associated score board.
+   * Pair of a Xapian document ID and its associated score board.
    */
-  typedef std::pair<Xapian::Document, ScoreBoard> XapianDocumentPair_T;
+  typedef std::pair<Xapian::docid, ScoreBoard> XapianDocumentPair_T;
 
   /**
-   * (STL) List of Xapian documents and their associated score board.
+   * (STL) List of Xapian document IDs and their associated score board,
+   * in the order of the Xapian matching set.
    */
-  typedef std::list<XapianDocumentPair_T> DocumentList_T;
+  typedef std::vector<XapianDocumentPair_T> DocumentList_T;
   
   /**
-   * (STL) Map of Xapian documents and their associated score board.
+   * (STL) Map of the positions, within the list of documents, of the
+   * Xapian document IDs.
    */
-  typedef std::map<Xapian::docid, XapianDocumentPair_T> DocumentMap_T;
+  typedef std::map<Xapian::docid, size_t> DocumentMap_T;
+  
+  /**
+   * (STL) Map of the Location structures, as decoded from the data of
+   * the Xapian documents.
+   */
+  typedef std::map<Xapian::docid, Location> LocationMap_T;
   
 
   // //////////////////////// Main Class /////////////////////////
@@ -95,22 +105,33 @@ namespace OPENTREP {
     }
 
     /**
-     * Get the map of documents.
+     * Get the map of the positions of the documents.
      */
     const DocumentMap_T& getDocumentMap() const {
      return _documentMap;
     }
 
     /**
-     * Get the Xapian document and associated score-board corresponding
+     * Get the Xapian document ID and associated score-board corresponding
      * to the given document ID.
      */
     const XapianDocumentPair_T& getDocumentPair (const Xapian::docid&) const;
 
     /**
      * Get the Xapian document corresponding to the given document ID.
+     *
+     * The documents are not kept by the Result object: the document is
+     * (lazily) loaded from the Xapian matching set, or, when the document
+     * has not been added from that latter, from the Xapian database.
      */
-    const Xapian::Document& getDocument (const Xapian::docid&) const;
+    Xapian::Document getDocument (const Xapian::docid&) const;
+
+    /**
+     * Get the Location structure, decoded (once for all, when the
+     * document has been added) from the data of the Xapian document
+     * corresponding to the given document ID.
+     */
+    const Location& getLocation (const Xapian::docid&) const;
 
     /**
      * Get the Xapian ID of the best matching document.
@@ -127,18 +148,24 @@ namespace OPENTREP {
     }
 
     /**
-     * Get the details of the best matching document.
+     * Get the best matching Xapian document.
      */
-    const RawDataString_T& getBestDocData() const {
-      return _bestDocData;
+    Xapian::Document getBestXapianDocument() const {
+      return getDocument (_bestDocID);
     }
 
     /**
-     * Get the best matching Xapian document.
+     * Load the details (data) of the best matching document.
+     *
+     * The data of the Xapian documents are not loaded during the matching
+     * and scoring steps, which rely only on the value slots. The data are
+     * loaded on demand, normally only for the best matching documents
+     * of the best matching ResultHolder object (see createPlaces()).
+     *
+     * @return RawDataString_T The data of the best matching document
+     *         (empty when there is no such document).
      */
-    const Xapian::Document& getBestXapianDocument() const {
-      return getDocument (_bestDocID);
-    }
+    RawDataString_T fetchBestDocData() const;
 
 
   public:
@@ -188,7 +215,15 @@ namespace OPENTREP {
      */
 
     /**
-     * Add a Xapian document to the dedicated (STL) list and (STL) map.
+     * Add the ID of a Xapian document to the dedicated (STL) list and
+     * (STL) map. The Xapian document itself is not kept.
+     *
+     * The scoring details are retrieved once for all here, from the
+     * value slots of the Xapian document (or, for older indexes, by
+     * parsing the document data), and the resulting Location structure
+     * is stored in a dedicated (STL) map, so that the subsequent scoring
+     * steps (envelope, code match, PageRank) do not have to retrieve
+     * them again.
      *
      * \note The score type is not specified, as it is corresponding,
      *       by construction, to the (Xapian-based) full-text matching.
@@ -217,14 +252,9 @@ namespace OPENTREP {
     }
     
     /**
-     * Set the details of the best matching document.
-     */
-    void setBestDocData (const std::string& iDocData) {
-      _bestDocData = RawDataString_T (iDocData);
-    }
-
-    /**
-     * Extract the best matching Xapian document.
+     * Extract the best matching Xapian documents. The matching set is
+     * kept, so that the data of the best matching document may later be
+     * loaded from it (see fetchBestDocData()).
      *
      * @param Xapian::MSet& The Xapian matching set. It can be empty.
      * @param Result& The holder for the Xapian documents
@@ -252,8 +282,23 @@ namespace OPENTREP {
      *
      * @param const Xapian::Database& The Xapian index/database.
      * @param const TravelQuery_T& The query string.
+     * @param const PORValidityDecider* Filter of the invalid POR (points
+     *        of reference), applied by Xapian within the matcher (NULL
+     *        when the POR are not filtered).
+     * @param const SpellingDictionary* In-memory spelling dictionary, with
+     *        which the spelling corrections are sought (NULL when not
+     *        available, in which case the Xapian spelling table is used).
+     * @param const TermVocabulary* Vocabulary of the index, with which the
+     *        query strings holding unknown terms are spared the exact
+     *        full-text match (NULL when not available).
+     * @param Xapian::Enquire& Enquire session on the Xapian index/database,
+     *        re-used from one full-text match to the next one. It must be
+     *        used by a single thread at a time.
      */
-    std::string fullTextMatch (const Xapian::Database&, const TravelQuery_T&);
+    std::string fullTextMatch (const Xapian::Database&, const TravelQuery_T&,
+                               const PORValidityDecider*,
+                               const SpellingDictionary*,
+                               const TermVocabulary*, Xapian::Enquire&);
 
     /**
      * Parse the raw data, as stored by the given Xapian document, and
@@ -275,6 +320,21 @@ namespace OPENTREP {
      */
     static Location retrieveLocation (const RawDataString_T&);
 
+    /**
+     * Retrieve the details needed by the scoring steps (primary key,
+     * envelope ID, PageRank, feature code) from the value slots of the
+     * given Xapian document, without parsing the document data.
+     *
+     * Only the Xapian indexes generated with a format version of at least
+     * 1 store those value slots. With older indexes, nothing is done and
+     * false is returned; the retrieveLocation() method should then be used.
+     *
+     * @param const Xapian::Document& The Xapian document.
+     * @param Location& The Location structure to be filled.
+     * @return bool Whether the value slots were present.
+     */
+    static bool retrieveScoringValues (const Xapian::Document&, Location&);
+
     /**
      * Extract the primary key from the data of the given Xapian document.
      *
@@ -317,17 +377,6 @@ namespace OPENTREP {
      */
     void displayXapianPercentages() const;
 
-    /**
-     * Update the ScoreBoard structure, itself associated to the Xapian document
-     * corresponding to the given document ID, with the given score.
-     *
-     * @param const Xapian::docid& Document ID for the Xapian document
-     * @param const ScoreType& Score type
-     * @param const Score_T& Score/weight value
-     */
-    void setScoreOnDocMap (const Xapian::docid&,
-                           const ScoreType&, const Score_T&);
-
     /**
      * Calculate/set the envelope weights for all the matching documents.
      *
@@ -344,6 +393,18 @@ namespace OPENTREP {
      */
     void calculateCodeMatches();
 
+    /**
+     * Get the IATA code which the given query string stands for, if any.
+     *
+     * The query string stands for a code when, once some standard words
+     * (e.g., "airport", "international", "city") have been filtered out,
+     * it is made of a single word of 3 or 4 letters.
+     *
+     * @param const TravelQuery_T& Query string.
+     * @return std::string The code, in upper case, or an empty string.
+     */
+    static std::string getQueryCode (const TravelQuery_T&);
+
     /**
      * Calculate/set the PageRanks for all the matching documents
      */
@@ -360,6 +421,15 @@ namespace OPENTREP {
      */
     void calculateCombinedWeights();
 
+    /**
+     * Combine all of the above methods.
+     *
+     * As all the weights of a Result object depend only on its own
+     * query string, they may be calculated independently of the string
+     * partitions the query string belongs to.
+     */
+    void calculateAllWeights();
+
   private:
     /**
      * For all the elements (strings) of the travel query (string set),
@@ -370,9 +440,17 @@ namespace OPENTREP {
      *
      * @param const Xapian::Database& The Xapian index/database.
      * @param TravelQuery_T& The query string.
+     * @param const PORValidityDecider* Filter of the invalid POR (may be
+     *        NULL).
+     * @param const SpellingDictionary* Spelling dictionary (may be NULL).
+     * @param const TermVocabulary* Vocabulary of the index (may be NULL).
+     * @param Xapian::Enquire& Enquire session on the Xapian index/database.
      * @param Xapian::MSet& The resulting matching set of Xapian documents
      */
     std::string fullTextMatch (const Xapian::Database&, const TravelQuery_T&,
+                               const PORValidityDecider*,
+                               const SpellingDictionary*,
+                               const TermVocabulary*, Xapian::Enquire&,
                                Xapian::MSet&);
 
 
@@ -493,19 +571,25 @@ namespace OPENTREP {
     Percentage_T _bestCombinedWeight;
 
     /**
-     * Details of the best matching document.
+     * Xapian matching set, from which the documents have been added.
      */
-    RawDataString_T _bestDocData;
+    Xapian::MSet _matchingSet;
 
-      /**
-     * (STL) List of Xapian documents and their associated score board.
+    /**
+     * (STL) List of Xapian document IDs and their associated score board.
      */
     DocumentList_T _documentList;
   
     /**
-     * (STL) Map of Xapian documents and their associated score board.
+     * (STL) Map of the positions of the Xapian document IDs within the list.
      */
     DocumentMap_T _documentMap;
+
+    /**
+     * (STL) Map of the Location structures, decoded from the data of
+     * the Xapian documents.
+     */
+    LocationMap_T _locationMap;
   };
 
 }
@@ -3,6 +3,7 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <algorithm>
 #include <sstream>
 // OpenTrep
 #include <opentrep/basic/BasConst_General.hpp>
@@ -15,39 +16,28 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   ScoreBoard::ScoreBoard (const TravelQuery_T& iQueryString)
-    : _queryString (iQueryString) {
+    : _queryString (&iQueryString), _scoreTypeMask (0) {
+    std::fill (_scoreArray, _scoreArray + ScoreType::LAST_VALUE, 0.0);
   }
 
   // //////////////////////////////////////////////////////////////////////
   ScoreBoard::ScoreBoard (const ScoreBoard& iScoreBoard)
     : _queryString (iScoreBoard._queryString),
-      _scoreMap (iScoreBoard._scoreMap) {
+      _scoreTypeMask (iScoreBoard._scoreTypeMask) {
+    std::copy (iScoreBoard._scoreArray,
+               iScoreBoard._scoreArray + ScoreType::LAST_VALUE, _scoreArray);
   }
 
   // //////////////////////////////////////////////////////////////////////
   ScoreBoard::ScoreBoard (const TravelQuery_T& iQueryString,
                           const ScoreType& iType, const Score_T& iScore)
-    : _queryString (iQueryString) {
+    : _queryString (&iQueryString), _scoreTypeMask (0) {
+    std::fill (_scoreArray, _scoreArray + ScoreType::LAST_VALUE, 0.0);
     setScore (iType, iScore);
   }
 
   // //////////////////////////////////////////////////////////////////////
   ScoreBoard::~ScoreBoard() {
-    _scoreMap.clear();
-  }
-
-  // //////////////////////////////////////////////////////////////////////
-  Score_T ScoreBoard::getScore (const ScoreType& iScoreType) const {
-    Score_T oScore = 0.0;
-
-    // Check whether a score value already exists for that type
-    const ScoreType::EN_ScoreType& lScoreTypeEnum = iScoreType.getType();
-    ScoreMap_T::const_iterator itScore = _scoreMap.find (lScoreTypeEnum);
-    if (itScore != _scoreMap.end()) {
-      oScore = itScore->second;
-    }
-
-    return oScore;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -121,35 +111,19 @@ namespace OPENTREP {
       }
     }
 
-    // Check whether a score value already exists for that type
+    // Store (or replace) the score value for that type
     const ScoreType::EN_ScoreType& lScoreTypeEnum = iScoreType.getType();
-    ScoreMap_T::iterator itScore = _scoreMap.find (lScoreTypeEnum);
-
-    if (itScore != _scoreMap.end()) {
-      // Just replace the score value
-      Score_T& lScore = itScore->second;
-      lScore = oScore;
-
-    } else {
-      // Insert the score value for that new type
-      const bool insertSucceeded =
-        _scoreMap.insert (ScoreMap_T::value_type (lScoreTypeEnum,
-                                                  oScore)).second;
-
-      // Sanity check
-      if (insertSucceeded == false) {
-        OPENTREP_LOG_ERROR ("The " << iScore << " score value can not be "
-                            << "inserted in the dedicated list for the "
-                            << iScoreType.describe() << " score type");
-      }
-      assert (insertSucceeded == true);
-    }
+    assert (lScoreTypeEnum < ScoreType::LAST_VALUE);
+    _scoreArray[lScoreTypeEnum] = oScore;
+    _scoreTypeMask |= (1U << lScoreTypeEnum);
   }
 
   // //////////////////////////////////////////////////////////////////////
   std::string ScoreBoard::describeKey() const {
     std::ostringstream oStr;
-    oStr << _queryString;
+    if (_queryString != NULL) {
+      oStr << *_queryString;
+    }
     return oStr.str();
   }
 
@@ -158,16 +132,24 @@ namespace OPENTREP {
     std::ostringstream oStr;
     oStr << describeKey() << " - ";
 
+    // Browse the score types in the order of the enumeration, and display
+    // only the ones having been set
     unsigned short idx = 0;
-    for (ScoreMap_T::const_iterator itScore = _scoreMap.begin();
-         itScore != _scoreMap.end(); ++itScore, ++idx) {
+    for (unsigned short lTypeIdx = 0; lTypeIdx != ScoreType::LAST_VALUE;
+         ++lTypeIdx) {
+      const ScoreType::EN_ScoreType lScoreType =
+        static_cast<const ScoreType::EN_ScoreType> (lTypeIdx);
+      const bool isSet = ((_scoreTypeMask & (1U << lTypeIdx)) != 0);
+      if (isSet == false) {
+        continue;
+      }
       if (idx != 0) {
         oStr << ", ";
       }
-      const ScoreType::EN_ScoreType& lScoreType = itScore->first;
-      const Score_T& lScore = itScore->second;
+      const Score_T& lScore = _scoreArray[lTypeIdx];
       oStr << ScoreType::getTypeLabelAsString (lScoreType) << ": "
            << lScore << "%";
+      ++idx;
     }
 
     return oStr.str();
@@ -186,11 +168,11 @@ namespace OPENTREP {
   Percentage_T ScoreBoard::calculateCombinedWeight() {
     Percentage_T oPercentage = 100.0;
 
-    // Browse the registered scores
-    for (ScoreMap_T::iterator itScore = _scoreMap.begin();
-         itScore != _scoreMap.end(); ++itScore) {
-      const ScoreType::EN_ScoreType& lScoreType = itScore->first;
-      Score_T& lScore = itScore->second;
+    // Browse the registered scores, in the order of the enumeration
+    for (unsigned short lTypeIdx = 0; lTypeIdx != ScoreType::LAST_VALUE;
+         ++lTypeIdx) {
+      const ScoreType::EN_ScoreType lScoreType =
+        static_cast<const ScoreType::EN_ScoreType> (lTypeIdx);
 
       /**
        * Take into account the score only when it is valid and does
@@ -198,17 +180,11 @@ namespace OPENTREP {
        * combined score).
        */
       const bool isIndividual = ScoreType::isIndividualScore (lScoreType);
-      if (isIndividual == true) {
+      const bool isSet = ((_scoreTypeMask & (1U << lTypeIdx)) != 0);
+      if (isIndividual == true && isSet == true) {
+        const Score_T& lScore = _scoreArray[lTypeIdx];
         oPercentage *= lScore / 100.0;
       }
-
-      /**
-      // DEBUG
-      OPENTREP_LOG_DEBUG ("        [pct] '" << describeKey() << "' - "
-                          << ScoreType::getTypeLabelAsString (lScoreType)
-                          << ": " << lScore << "%, combined: "
-                          << oPercentage << "%");
-      */
     }
 
     // Register the combined score
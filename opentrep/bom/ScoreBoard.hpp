@@ -5,7 +5,7 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
-#include <map>
+#include <cassert>
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/basic/ScoreType.hpp>
@@ -18,14 +18,23 @@ namespace OPENTREP {
   /**
    * @brief Structure holding a board for all the types of
    *        score/matching having been performed.
+   *
+   * The scores are stored within a fixed-size array, indexed by the
+   * score type, along with a bit-mask recording the score types having
+   * been set. Hence, a score board never allocates memory, and copying it
+   * is a mere copy of a few bytes.
+   *
+   * \note The query string is not copied: the score board refers to
+   *       the query string of its owner (normally, a Result object),
+   *       which must therefore outlive it.
    */
   struct ScoreBoard : public StructAbstract {
   public:
     // //////////////// Type definitions /////////////////
     /**
-     * (STL) map of scores.
+     * Bit-mask of the score types (one bit per score type).
      */
-    typedef std::map<ScoreType::EN_ScoreType, Score_T> ScoreMap_T;
+    typedef unsigned int ScoreTypeMask_T;
 
 
   public:
@@ -34,21 +43,28 @@ namespace OPENTREP {
      * Get the query string.
      */
     const TravelQuery_T& getQueryString() const {
-      return _queryString;
+      assert (_queryString != NULL);
+      return *_queryString;
     }
 
     /**
-     * Get the map of scores.
+     * Get the score for the given type. If no score value has
+     * already been stored for that type, return 0.
      */
-    const ScoreMap_T& getScoreMap() const {
-     return _scoreMap;
+    Score_T getScore (const ScoreType& iScoreType) const {
+      const ScoreType::EN_ScoreType& lScoreTypeEnum = iScoreType.getType();
+      assert (lScoreTypeEnum < ScoreType::LAST_VALUE);
+      return _scoreArray[lScoreTypeEnum];
     }
 
     /**
-     * Get the score for the given type. If no score value has
-     * already been stored for that type, return 0.
+     * State whether a score value has already been stored for the given
+     * type.
      */
-    Score_T getScore (const ScoreType&) const;
+    bool hasScore (const ScoreType& iScoreType) const {
+      const ScoreType::EN_ScoreType& lScoreTypeEnum = iScoreType.getType();
+      return ((_scoreTypeMask & (1U << lScoreTypeEnum)) != 0);
+    }
 
     /**
      * Get the combined weight, if existing (0 otherwise).
@@ -64,7 +80,7 @@ namespace OPENTREP {
      * Set the query string.
      */
     void setQueryString (const TravelQuery_T& iQueryString) {
-      _queryString = iQueryString;
+      _queryString = &iQueryString;
     }
 
     /**
@@ -175,12 +191,18 @@ namespace OPENTREP {
     /**
      * Query string having generated the set of documents.
      */
-    TravelQuery_T _queryString;
+    const TravelQuery_T* _queryString;
+
+    /**
+     * Bit-mask of the score types having been set.
+     */
+    ScoreTypeMask_T _scoreTypeMask;
 
     /**
-     * Map of scores.
+     * Array of scores, indexed by score type. The score types not having
+     * been set have a null score.
      */
-    ScoreMap_T _scoreMap;
+    Score_T _scoreArray[ScoreType::LAST_VALUE];
   };
 
 }
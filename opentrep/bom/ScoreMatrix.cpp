@@ -0,0 +1,99 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <algorithm>
+#include <sstream>
+// OpenTrep
+#include <opentrep/bom/ScoreBoard.hpp>
+#include <opentrep/bom/ScoreMatrix.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  ScoreMatrix::ScoreMatrix (const size_t iNbOfDocuments)
+    : _nbOfDocuments (iNbOfDocuments),
+      _scoreArray (ScoreType::LAST_VALUE * iNbOfDocuments, 100.0) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ScoreMatrix::~ScoreMatrix() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ScoreMatrix::setScoreBoard (const size_t iDocIdx,
+                                   const ScoreBoard& iScoreBoard) {
+    assert (iDocIdx < _nbOfDocuments);
+
+    for (unsigned short lTypeIdx = 0; lTypeIdx != ScoreType::LAST_VALUE;
+         ++lTypeIdx) {
+      const ScoreType lScoreType (static_cast<const ScoreType::EN_ScoreType>
+                                  (lTypeIdx));
+      if (iScoreBoard.hasScore (lScoreType) == true) {
+        _scoreArray[lTypeIdx * _nbOfDocuments + iDocIdx] =
+          iScoreBoard.getScore (lScoreType);
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ScoreMatrix::calculateCombinedWeights() {
+    if (_nbOfDocuments == 0) {
+      return;
+    }
+
+    // Row of the combined weights
+    Score_T* lCombinedRow = &_scoreArray[ScoreType::COMBINATION
+                                         * _nbOfDocuments];
+    std::fill (lCombinedRow, lCombinedRow + _nbOfDocuments, 100.0);
+
+    /**
+     * Multiply the combined weights by the individual scores, row after
+     * row, in the order of the enumeration (so that the result is exactly
+     * the same as the one of ScoreBoard::calculateCombinedWeight()).
+     */
+    for (unsigned short lTypeIdx = 0; lTypeIdx != ScoreType::LAST_VALUE;
+         ++lTypeIdx) {
+      const ScoreType::EN_ScoreType lScoreType =
+        static_cast<const ScoreType::EN_ScoreType> (lTypeIdx);
+      const bool isIndividual = ScoreType::isIndividualScore (lScoreType);
+      if (isIndividual == false) {
+        continue;
+      }
+
+      const Score_T* lScoreRow = &_scoreArray[lTypeIdx * _nbOfDocuments];
+      for (size_t lDocIdx = 0; lDocIdx != _nbOfDocuments; ++lDocIdx) {
+        lCombinedRow[lDocIdx] *= lScoreRow[lDocIdx] / 100.0;
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string ScoreMatrix::describe() const {
+    std::ostringstream oStr;
+    oStr << "Scores of " << _nbOfDocuments << " documents";
+    for (unsigned short lTypeIdx = 0; lTypeIdx != ScoreType::LAST_VALUE;
+         ++lTypeIdx) {
+      const ScoreType::EN_ScoreType lScoreType =
+        static_cast<const ScoreType::EN_ScoreType> (lTypeIdx);
+      oStr << std::endl << ScoreType::getTypeLabelAsString (lScoreType)
+           << ":";
+      for (size_t lDocIdx = 0; lDocIdx != _nbOfDocuments; ++lDocIdx) {
+        oStr << " " << _scoreArray[lTypeIdx * _nbOfDocuments + lDocIdx]
+             << "%";
+      }
+    }
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ScoreMatrix::toStream (std::ostream& ioOut) const {
+    ioOut << describe();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ScoreMatrix::fromStream (std::istream& ioIn) {
+  }
+
+}
@@ -0,0 +1,144 @@
+#ifndef __OPENTREP_BOM_SCOREMATRIX_HPP
+#define __OPENTREP_BOM_SCOREMATRIX_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/basic/ScoreType.hpp>
+#include <opentrep/basic/StructAbstract.hpp>
+
+namespace OPENTREP {
+
+  // Forward declarations
+  struct ScoreBoard;
+
+  /**
+   * @brief Structure holding the scores of all the documents of a Result
+   *        object, laid out as a structure of arrays.
+   *
+   * The matrix has one row per score type, and one column per document:
+   * the scores of a given type, for all the documents, are contiguous.
+   * Hence, the combined weights of all the documents are calculated in
+   * a single pass over the rows, which the compiler is able to vectorise.
+   *
+   * The scores not having been set within the score board of a document
+   * are stored as 100%, i.e., as neutral elements of the combination,
+   * so that the calculation is free of any branch.
+   */
+  struct ScoreMatrix : public StructAbstract {
+  public:
+    // //////////////// Type definitions /////////////////
+    /**
+     * Array of scores, row after row.
+     */
+    typedef std::vector<Score_T> ScoreArray_T;
+
+
+  public:
+    // ////////////////// Getters ////////////////
+    /**
+     * Get the number of documents (i.e., of columns).
+     */
+    size_t getNbOfDocuments() const {
+      return _nbOfDocuments;
+    }
+
+    /**
+     * Get the combined weight of the document having the given index.
+     *
+     * \note The combined weights must have been calculated beforehand
+     *       (see calculateCombinedWeights()).
+     */
+    const Percentage_T& getCombinedWeight (const size_t iDocIdx) const {
+      return _scoreArray[ScoreType::COMBINATION * _nbOfDocuments + iDocIdx];
+    }
+
+
+  public:
+    // //////////////////// Setters //////////////////
+    /**
+     * Copy the scores of the given score board into the column of the
+     * document having the given index.
+     */
+    void setScoreBoard (const size_t iDocIdx, const ScoreBoard&);
+
+
+  public:
+    // //////////////// Business methods ////////////////
+    /**
+     * Calculate the combination of the weights of all the documents,
+     * i.e., for every document, the product of its individual scores.
+     */
+    void calculateCombinedWeights();
+
+
+  public:
+    // /////////// Display support methods /////////
+    /**
+     * Dump the structure into an output stream.
+     *
+     * @param ostream& the output stream.
+     */
+    void toStream (std::ostream&) const;
+
+    /**
+     * Read a structure from an input stream.
+     *
+     * @param istream& the input stream.
+     */
+    void fromStream (std::istream&);
+
+    /**
+     * Display of the structure.
+     *
+     * @return std::string Dump of the structure.
+     */
+    std::string describe() const;
+
+
+  public:
+    // //////////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor.
+     *
+     * @param const size_t Number of documents.
+     */
+    ScoreMatrix (const size_t iNbOfDocuments);
+
+    /**
+     * Default destructor.
+     */
+    ~ScoreMatrix();
+
+  private:
+    /**
+     * Default constructor.
+     */
+    ScoreMatrix();
+
+    /**
+     * Copy constructor.
+     */
+    ScoreMatrix (const ScoreMatrix&);
+
+
+  private:
+    // ///////////////// Attributes //////////////////
+    /**
+     * Number of documents.
+     */
+    size_t _nbOfDocuments;
+
+    /**
+     * Scores, as ScoreType::LAST_VALUE rows of _nbOfDocuments scores.
+     */
+    ScoreArray_T _scoreArray;
+  };
+
+}
+#endif // __OPENTREP_BOM_SCOREMATRIX_HPP
@@ -0,0 +1,385 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/bom/Levenshtein.hpp>
+#include <opentrep/bom/SpellingDictionary.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * Comparison of the deletions by hash value only, for the look-ups.
+   */
+  struct DeletionHashLess {
+    typedef std::pair<boost::uint32_t, unsigned int> Deletion_T;
+
+    bool operator() (const Deletion_T& iDeletion,
+                     const boost::uint32_t& iHash) const {
+      return iDeletion.first < iHash;
+    }
+
+    bool operator() (const boost::uint32_t& iHash,
+                     const Deletion_T& iDeletion) const {
+      return iHash < iDeletion.first;
+    }
+  };
+
+  /**
+   * Fold the given UTF-8 encoded string in lower case, by the Unicode rules
+   * of Xapian (e.g., "Île" gives "île", and "МОСКВА" gives "москва").
+   */
+  static std::string foldCase (const std::string& iString) {
+    std::string oString;
+    oString.reserve (iString.size());
+    const Xapian::Utf8Iterator itEnd;
+    for (Xapian::Utf8Iterator itChar (iString); itChar != itEnd; ++itChar) {
+      const unsigned lChar = *itChar;
+      Xapian::Unicode::append_utf8 (oString,
+                                    Xapian::Unicode::tolower (lChar));
+    }
+    return oString;
+  }
+
+  /**
+   * Number of bytes of the UTF-8 encoded character starting at the given
+   * position.
+   */
+  static size_t getCharacterSize (const std::string& iString,
+                                  const size_t iPosition) {
+    // The continuation bytes are of the 10xxxxxx form
+    size_t oSize = 1;
+    while (iPosition + oSize < iString.size()) {
+      const unsigned char lByte = iString[iPosition + oSize];
+      if ((lByte & 0xC0) != 0x80) {
+        break;
+      }
+      ++oSize;
+    }
+    return oSize;
+  }
+
+  /**
+   * Number of (Unicode) characters of the given UTF-8 encoded string.
+   */
+  static NbOfLetters_T getNbOfCharacters (const std::string& iString) {
+    NbOfLetters_T oNbOfCharacters = 0;
+    for (size_t idxChar = 0; idxChar < iString.size();
+         idxChar += getCharacterSize (iString, idxChar)) {
+      ++oNbOfCharacters;
+    }
+    return oNbOfCharacters;
+  }
+
+  /**
+   * State whether the given string is made only of ASCII characters.
+   */
+  static bool isASCII (const std::string& iString) {
+    for (std::string::const_iterator itChar = iString.begin();
+         itChar != iString.end(); ++itChar) {
+      if ((static_cast<unsigned char> (*itChar) & 0x80) != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SpellingDictionary::SpellingDictionary()
+    : _distanceErrorRule (K_DEFAULT_ERROR_SCALE) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SpellingDictionary::
+  SpellingDictionary (const DistanceErrorScaleArray_T& iScaleArray)
+    : _distanceErrorRule (iScaleArray) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SpellingDictionary::~SpellingDictionary() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SpellingDictionary::addTerm (const std::string& iTerm,
+                                    const PageRank_T& iPageRank) {
+    const std::string& lTerm = foldCase (iTerm);
+    if (lTerm.empty() == true) {
+      return;
+    }
+
+    unsigned int lTermIdx = _termList.size();
+    TermIdxMap_T::const_iterator itTermIdx = _termIdxMap.find (lTerm);
+    if (itTermIdx != _termIdxMap.end()) {
+      lTermIdx = itTermIdx->second;
+
+    } else {
+      _termList.push_back (TermEntry (lTerm));
+      _termIdxMap.insert (TermIdxMap_T::value_type (lTerm, lTermIdx));
+    }
+
+    assert (lTermIdx < _termList.size());
+    TermEntry& lTermEntry = _termList[lTermIdx];
+    lTermEntry._pageRank += iPageRank;
+    ++lTermEntry._nbOfPlaces;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SpellingDictionary::DeletionHash_T SpellingDictionary::
+  hashDeletion (const std::string& iDeletion) {
+    DeletionHash_T oHash = 2166136261U;
+    for (std::string::const_iterator itChar = iDeletion.begin();
+         itChar != iDeletion.end(); ++itChar) {
+      oHash ^= static_cast<unsigned char> (*itChar);
+      oHash *= 16777619U;
+    }
+    return oHash;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SpellingDictionary::generateDeletions (const std::string& iString,
+                                              DeletionList_T& ioDeletionList) {
+    // The prefix is made of (Unicode) characters, not of bytes
+    size_t lPrefixSize = 0;
+    for (NbOfLetters_T idxChar = 0; idxChar != K_DEFAULT_SPELLING_PREFIX_LENGTH
+           && lPrefixSize < iString.size(); ++idxChar) {
+      lPrefixSize += getCharacterSize (iString, lPrefixSize);
+    }
+    const std::string lPrefix = iString.substr (0, lPrefixSize);
+    std::set<std::string> lDeletionSet;
+    lDeletionSet.insert (lPrefix);
+    ioDeletionList.push_back (lPrefix);
+
+    // Derive the deletions of one more character from the ones of the
+    // former level
+    size_t idxLevelStart = ioDeletionList.size() - 1;
+    for (NbOfErrors_T lNbOfErrors = 1;
+         lNbOfErrors <= K_DEFAULT_SPELLING_MAX_PREFIX_ERRORS; ++lNbOfErrors) {
+      const size_t idxLevelEnd = ioDeletionList.size();
+      for (size_t idx = idxLevelStart; idx != idxLevelEnd; ++idx) {
+        const std::string lString = ioDeletionList[idx];
+        size_t lCharSize = 0;
+        for (size_t idxChar = 0; idxChar < lString.size();
+             idxChar += lCharSize) {
+          lCharSize = getCharacterSize (lString, idxChar);
+          std::string lDeletion (lString);
+          lDeletion.erase (idxChar, lCharSize);
+          if (lDeletionSet.insert (lDeletion).second == true) {
+            ioDeletionList.push_back (lDeletion);
+          }
+        }
+      }
+      idxLevelStart = idxLevelEnd;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SpellingDictionary::finalise() {
+    _deletionArray.clear();
+
+    DeletionList_T lDeletionList;
+    for (unsigned int lTermIdx = 0; lTermIdx != _termList.size(); ++lTermIdx) {
+      const TermEntry& lTermEntry = _termList[lTermIdx];
+      lDeletionList.clear();
+      generateDeletions (lTermEntry._term, lDeletionList);
+
+      for (DeletionList_T::const_iterator itDeletion = lDeletionList.begin();
+           itDeletion != lDeletionList.end(); ++itDeletion) {
+        const std::string& lDeletion = *itDeletion;
+        _deletionArray.push_back (Deletion_T (hashDeletion (lDeletion),
+                                              lTermIdx));
+      }
+    }
+
+    std::sort (_deletionArray.begin(), _deletionArray.end());
+    _deletionArray.erase (std::unique (_deletionArray.begin(),
+                                       _deletionArray.end()),
+                          _deletionArray.end());
+
+    // The index of the terms is no longer needed
+    TermIdxMap_T().swap (_termIdxMap);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfErrors_T SpellingDictionary::
+  getAllowedDistanceError (const std::string& iString) const {
+    const NbOfLetters_T lNbOfLetters = getNbOfCharacters (iString);
+    return _distanceErrorRule.getAllowedDistanceError (lNbOfLetters);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool SpellingDictionary::isBetter (const TermEntry& iTermEntry,
+                                     const TermEntry& iOtherTermEntry) {
+    if (iTermEntry._pageRank != iOtherTermEntry._pageRank) {
+      return (iTermEntry._pageRank > iOtherTermEntry._pageRank);
+    }
+    if (iTermEntry._nbOfPlaces != iOtherTermEntry._nbOfPlaces) {
+      return (iTermEntry._nbOfPlaces > iOtherTermEntry._nbOfPlaces);
+    }
+    return (iTermEntry._term < iOtherTermEntry._term);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SpellingDictionary::
+  getSuggestion (const std::string& iString,
+                 NbOfErrors_T& oEditDistance) const {
+    std::string oSuggestion;
+
+    const std::string& lString = foldCase (iString);
+    const NbOfErrors_T lAllowedDistance = getAllowedDistanceError (lString);
+    if (lString.empty() == true || lAllowedDistance == 0) {
+      return oSuggestion;
+    }
+
+    // Retrieve the indices of the terms sharing a deletion with the string
+    DeletionList_T lDeletionList;
+    generateDeletions (lString, lDeletionList);
+    std::vector<unsigned int> lTermIdxList;
+    for (DeletionList_T::const_iterator itDeletion = lDeletionList.begin();
+         itDeletion != lDeletionList.end(); ++itDeletion) {
+      const DeletionHash_T lHash = hashDeletion (*itDeletion);
+      std::pair<DeletionArray_T::const_iterator,
+                DeletionArray_T::const_iterator> lRange =
+        std::equal_range (_deletionArray.begin(), _deletionArray.end(),
+                          lHash, DeletionHashLess());
+      for ( ; lRange.first != lRange.second; ++lRange.first) {
+        lTermIdxList.push_back (lRange.first->second);
+      }
+    }
+    std::sort (lTermIdxList.begin(), lTermIdxList.end());
+    lTermIdxList.erase (std::unique (lTermIdxList.begin(), lTermIdxList.end()),
+                        lTermIdxList.end());
+
+    // Keep the candidates, the length (in characters) of which is close
+    // enough
+    const NbOfLetters_T lStringLength = getNbOfCharacters (lString);
+    bool areAllASCII = isASCII (lString);
+    std::vector<unsigned int> lCandidateIdxList;
+    Levenshtein::StringList_T lCandidateList;
+    for (std::vector<unsigned int>::const_iterator itTermIdx =
+           lTermIdxList.begin(); itTermIdx != lTermIdxList.end(); ++itTermIdx) {
+      const TermEntry& lTermEntry = _termList[*itTermIdx];
+      const std::string& lTerm = lTermEntry._term;
+      const NbOfLetters_T lTermLength = getNbOfCharacters (lTerm);
+      const NbOfLetters_T lLengthDiff = (lTermLength > lStringLength) ?
+        lTermLength - lStringLength : lStringLength - lTermLength;
+      if (lLengthDiff > lAllowedDistance || lTerm == lString) {
+        continue;
+      }
+      lCandidateIdxList.push_back (*itTermIdx);
+      lCandidateList.push_back (lTerm);
+      if (areAllASCII == true && isASCII (lTerm) == false) {
+        areAllASCII = false;
+      }
+    }
+
+    // Calculate the edit distances, and select the best candidate. The
+    // (faster) batch calculation counts bytes: as soon as a non-ASCII
+    // character is involved, the distances are counted in characters
+    Levenshtein::DistanceList_T lDistanceList;
+    if (areAllASCII == true) {
+      Levenshtein::getDistanceList (lString, lCandidateList, lDistanceList);
+
+    } else {
+      for (Levenshtein::StringList_T::const_iterator itCandidate =
+             lCandidateList.begin(); itCandidate != lCandidateList.end();
+           ++itCandidate) {
+        const std::string& lCandidate = *itCandidate;
+        lDistanceList.push_back (Levenshtein::getUTF8Distance (lString,
+                                                               lCandidate));
+      }
+    }
+    assert (lDistanceList.size() == lCandidateList.size());
+
+    const TermEntry* lBestTermEntry_ptr = NULL;
+    int lBestDistance = lAllowedDistance + 1;
+    for (size_t idx = 0; idx != lCandidateIdxList.size(); ++idx) {
+      const int lDistance = lDistanceList[idx];
+      const TermEntry& lTermEntry = _termList[lCandidateIdxList[idx]];
+      if (lDistance < lBestDistance
+          || (lDistance == lBestDistance && lBestTermEntry_ptr != NULL
+              && isBetter (lTermEntry, *lBestTermEntry_ptr) == true)) {
+        lBestDistance = lDistance;
+        lBestTermEntry_ptr = &lTermEntry;
+      }
+    }
+
+    if (lBestTermEntry_ptr != NULL) {
+      oSuggestion = lBestTermEntry_ptr->_term;
+      oEditDistance = lBestDistance;
+    }
+
+    return oSuggestion;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SpellingDictionary::save (const std::string& iFilePath) const {
+    std::ofstream lFile (iFilePath.c_str());
+    if (lFile.is_open() == false) {
+      std::ostringstream oStr;
+      oStr << "The spelling dictionary cannot be saved into '"
+           << iFilePath << "'";
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw FileNotFoundException (oStr.str());
+    }
+
+    // One term per line: term, sum of the PageRank values, number of POR
+    lFile << std::setprecision (12);
+    for (TermList_T::const_iterator itTerm = _termList.begin();
+         itTerm != _termList.end(); ++itTerm) {
+      const TermEntry& lTermEntry = *itTerm;
+      lFile << lTermEntry._term << "\t" << lTermEntry._pageRank
+            << "\t" << lTermEntry._nbOfPlaces << "\n";
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool SpellingDictionary::load (const std::string& iFilePath) {
+    std::ifstream lFile (iFilePath.c_str());
+    if (lFile.is_open() == false) {
+      return false;
+    }
+    fromStream (lFile);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SpellingDictionary::fromStream (std::istream& ioIn) {
+    _termList.clear();
+    _termIdxMap.clear();
+
+    std::string lLine;
+    while (std::getline (ioIn, lLine)) {
+      const size_t lPageRankPos = lLine.find ('\t');
+      if (lPageRankPos == std::string::npos || lPageRankPos == 0) {
+        continue;
+      }
+
+      TermEntry lTermEntry (lLine.substr (0, lPageRankPos));
+      std::istringstream lWeightStr (lLine.substr (lPageRankPos + 1));
+      lWeightStr >> lTermEntry._pageRank >> lTermEntry._nbOfPlaces;
+      _termList.push_back (lTermEntry);
+    }
+
+    finalise();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SpellingDictionary::describe() const {
+    std::ostringstream oStr;
+    oStr << "Spelling dictionary of " << _termList.size() << " terms ("
+         << _deletionArray.size() << " deletions; allowed errors: "
+         << _distanceErrorRule.toShortString() << ")";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,252 @@
+#ifndef __OPENTREP_BOM_SPELLINGDICTIONARY_HPP
+#define __OPENTREP_BOM_SPELLINGDICTIONARY_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+#include <utility>
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/DistanceErrorRule.hpp>
+#include <opentrep/basic/StructAbstract.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief In-memory spelling dictionary, based on symmetric deletions
+   *        (SymSpell-like).
+   *
+   * The dictionary is made of the terms collected for the Xapian spelling
+   * dictionary when indexing (see Place::buildIndexSets()), i.e., mainly
+   * the names and codes of the POR (points of reference). Every term is
+   * weighted by the sum of the PageRank values of its POR.
+   *
+   * For every term, all the strings obtained by deleting up to
+   * K_DEFAULT_SPELLING_MAX_PREFIX_ERRORS characters from its first
+   * K_DEFAULT_SPELLING_PREFIX_LENGTH characters are recorded, by hash
+   * value, within a sorted array. A string is corrected by deriving
+   * the same deletions from its own prefix: the terms sharing at least
+   * one of them are the candidates, the Levenshtein edit distance of which
+   * is then checked against the distance allowed by a DistanceErrorRule
+   * for the length of the string. Hence, a spelling correction is a few
+   * look-ups, rather than a browsing of the Xapian spelling table.
+   *
+   * \note The errors beyond the prefix are not limited by the deletions:
+   *       only the allowed edit distance applies to them.
+   *
+   * The terms and the strings to be corrected are folded in lower case by
+   * the Unicode rules of Xapian. The prefixes, the deletions, the lengths
+   * and the edit distances are all counted in (Unicode) characters, e.g.,
+   * "é" is a single letter, not two bytes.
+   *
+   * The terms and their weights are saved as a text file, within the
+   * directory of the Xapian index. The deletions are derived again when
+   * the dictionary is loaded.
+   */
+  struct SpellingDictionary : public StructAbstract {
+  public:
+    // //////////////// Business Methods //////////////////
+    /**
+     * Record the given term (e.g., "san francisco"), for a POR having
+     * the given PageRank value. The term may be added several times,
+     * for several POR.
+     *
+     * \note The dictionary must be finalised (see finalise()) before being
+     *       looked up.
+     */
+    void addTerm (const std::string&, const PageRank_T&);
+
+    /**
+     * Derive the deletions of all the recorded terms.
+     */
+    void finalise();
+
+    /**
+     * Get the best spelling correction of the given string, i.e., the
+     * term with the smallest edit distance and, for the same edit distance,
+     * with the highest weight. The string itself is never given back,
+     * even when it is part of the dictionary.
+     *
+     * @param const std::string& String to be corrected (e.g., "sna
+     *        francicso").
+     * @param NbOfErrors_T& Edit distance between the string and its
+     *        correction, if any.
+     * @return std::string Spelling correction (e.g., "san francisco"),
+     *         empty when there is no term close enough.
+     */
+    std::string getSuggestion (const std::string&,
+                               NbOfErrors_T& oEditDistance) const;
+
+    /**
+     * Get the edit distance allowed, for the given string, by the
+     * distance error rule.
+     */
+    NbOfErrors_T getAllowedDistanceError (const std::string&) const;
+
+    /**
+     * Return the number of terms.
+     */
+    size_t size() const {
+      return _termList.size();
+    }
+
+    /**
+     * Save the dictionary into the given file.
+     *
+     * @param const std::string& File-path of the dictionary.
+     */
+    void save (const std::string&) const;
+
+    /**
+     * Load (and finalise) the dictionary from the given file.
+     *
+     * @param const std::string& File-path of the dictionary.
+     * @return bool Whether the file could be read.
+     */
+    bool load (const std::string&);
+
+  public:
+    // /////////// Display support methods /////////
+    /**
+     * Read a structure from an input stream.
+     *
+     * @param istream& the input stream.
+     */
+    void fromStream (std::istream& ioIn);
+
+    /**
+     * Get the serialised version of the structure.
+     */
+    std::string describe() const;
+
+  public:
+    // //////////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor. The edit distances are allowed according to
+     * the default scale (K_DEFAULT_ERROR_SCALE).
+     */
+    SpellingDictionary();
+
+    /**
+     * Constructor.
+     *
+     * @param const DistanceErrorScaleArray_T& Scale of the edit distances
+     *        allowed according to the length of the strings.
+     */
+    SpellingDictionary (const DistanceErrorScaleArray_T&);
+
+    /**
+     * Default destructor.
+     */
+    ~SpellingDictionary();
+
+  private:
+    // //////////////// Type definitions //////////////////
+    /**
+     * Hash value of a deletion.
+     */
+    typedef boost::uint32_t DeletionHash_T;
+
+    /**
+     * Term, with its weight.
+     */
+    struct TermEntry {
+      /**
+       * Constructor.
+       */
+      TermEntry (const std::string& iTerm)
+        : _term (iTerm), _pageRank (0.0), _nbOfPlaces (0) {
+      }
+
+      /**
+       * Term (in lower case).
+       */
+      std::string _term;
+
+      /**
+       * Sum of the PageRank values of the POR having that term.
+       */
+      PageRank_T _pageRank;
+
+      /**
+       * Number of POR having that term.
+       */
+      unsigned int _nbOfPlaces;
+    };
+
+    /**
+     * List of terms.
+     */
+    typedef std::vector<TermEntry> TermList_T;
+
+    /**
+     * Index of the terms, within the list, by term.
+     */
+    typedef boost::unordered_map<std::string, unsigned int> TermIdxMap_T;
+
+    /**
+     * Deletion (hash value), along with the index of its term.
+     */
+    typedef std::pair<DeletionHash_T, unsigned int> Deletion_T;
+
+    /**
+     * Sorted array of deletions.
+     */
+    typedef std::vector<Deletion_T> DeletionArray_T;
+
+    /**
+     * List of (distinct) deletions of a string.
+     */
+    typedef std::vector<std::string> DeletionList_T;
+
+  private:
+    // //////////////// Helper Methods //////////////////
+    /**
+     * Add to the given list the distinct strings obtained by deleting
+     * up to K_DEFAULT_SPELLING_MAX_PREFIX_ERRORS characters from the
+     * prefix of the given string (including the prefix itself).
+     */
+    static void generateDeletions (const std::string&, DeletionList_T&);
+
+    /**
+     * Calculate the hash value of a deletion (FNV-1a).
+     */
+    static DeletionHash_T hashDeletion (const std::string&);
+
+    /**
+     * State whether the first term entry is a better correction than the
+     * second one, at the same edit distance.
+     */
+    static bool isBetter (const TermEntry&, const TermEntry&);
+
+  private:
+    // //////////////// Attributes ///////////////
+    /**
+     * Rule giving the allowed edit distance for a given string length.
+     */
+    const DistanceErrorRule _distanceErrorRule;
+
+    /**
+     * List of the terms.
+     */
+    TermList_T _termList;
+
+    /**
+     * Index of the terms, used only while they are recorded.
+     */
+    TermIdxMap_T _termIdxMap;
+
+    /**
+     * Sorted array of the deletions of all the terms.
+     */
+    DeletionArray_T _deletionArray;
+  };
+
+}
+#endif // __OPENTREP_BOM_SPELLINGDICTIONARY_HPP
@@ -0,0 +1,405 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+// Boost
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/exceptions.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_exceptions.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/bom/TermVocabulary.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * Magic number ("OTRV") and version of the format of the serialised
+   * image of the vocabulary.
+   */
+  static const boost::uint32_t K_TERM_VOCABULARY_MAGIC = 0x4F545256;
+  static const boost::uint32_t K_TERM_VOCABULARY_FORMAT_VERSION = 1;
+
+  /**
+   * Number of 32-bit integers of the header of the image.
+   */
+  static const size_t K_TERM_VOCABULARY_HEADER_SIZE = 5;
+
+  // //////////////////////////////////////////////////////////////////////
+  static boost::uint32_t readUInt32 (const char* iPosition) {
+    boost::uint32_t oValue = 0;
+    std::memcpy (&oValue, iPosition, sizeof (oValue));
+    return oValue;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static void writeUInt32 (std::string& ioImage, const boost::uint32_t iValue) {
+    ioImage.append (reinterpret_cast<const char*> (&iValue), sizeof (iValue));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static void writeVarUInt (std::string& ioImage, boost::uint32_t iValue) {
+    while (iValue >= 0x80) {
+      ioImage.push_back (static_cast<char> ((iValue & 0x7F) | 0x80));
+      iValue >>= 7;
+    }
+    ioImage.push_back (static_cast<char> (iValue));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static boost::uint32_t readVarUInt (const unsigned char*& ioPosition) {
+    boost::uint32_t oValue = 0;
+    unsigned short lShift = 0;
+    while (*ioPosition & 0x80) {
+      oValue |= static_cast<boost::uint32_t> (*ioPosition & 0x7F) << lShift;
+      lShift += 7;
+      ++ioPosition;
+    }
+    oValue |= static_cast<boost::uint32_t> (*ioPosition) << lShift;
+    ++ioPosition;
+    return oValue;
+  }
+
+  /**
+   * Decode the term starting at the given position, on top of the former
+   * term, and move the position to the next term.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  static TermVocabulary::DocFrequency_T
+  readTerm (const unsigned char*& ioPosition, std::string& ioTerm) {
+    const boost::uint32_t lSharedLength = readVarUInt (ioPosition);
+    const boost::uint32_t lSuffixLength = readVarUInt (ioPosition);
+    ioTerm.resize (lSharedLength);
+    ioTerm.append (reinterpret_cast<const char*> (ioPosition), lSuffixLength);
+    ioPosition += lSuffixLength;
+    return readVarUInt (ioPosition);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  TermVocabulary::TermVocabulary()
+    : _imageBegin (NULL), _imageSize (0), _nbOfTerms (0), _nbOfBlocks (0) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  TermVocabulary::~TermVocabulary() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TermVocabulary::addTerm (const std::string& iTerm,
+                                const DocFrequency_T& iDocFrequency) {
+    if (iTerm.empty() == true) {
+      return;
+    }
+    _termList.push_back (TermFrequency_T (iTerm, iDocFrequency));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TermVocabulary::finalise() {
+    // Sort the terms, and merge the duplicates (if any)
+    std::sort (_termList.begin(), _termList.end());
+    TermFrequencyList_T lTermList;
+    for (TermFrequencyList_T::const_iterator itTerm = _termList.begin();
+         itTerm != _termList.end(); ++itTerm) {
+      if (lTermList.empty() == false
+          && lTermList.back().first == itTerm->first) {
+        lTermList.back().second += itTerm->second;
+      } else {
+        lTermList.push_back (*itTerm);
+      }
+    }
+    TermFrequencyList_T().swap (_termList);
+
+    // Encode the blocks of terms
+    const boost::uint32_t lNbOfTerms = lTermList.size();
+    const boost::uint32_t lBlockSize = K_TERM_VOCABULARY_BLOCK_SIZE;
+    const boost::uint32_t lNbOfBlocks = (lNbOfTerms + lBlockSize - 1)
+      / lBlockSize;
+    std::vector<boost::uint32_t> lBlockOffsetList;
+    lBlockOffsetList.reserve (lNbOfBlocks);
+    std::string lData;
+    std::string lFormerTerm;
+    for (boost::uint32_t idx = 0; idx != lNbOfTerms; ++idx) {
+      const std::string& lTerm = lTermList[idx].first;
+
+      // The first term of a block is stored in full
+      boost::uint32_t lSharedLength = 0;
+      if (idx % lBlockSize == 0) {
+        lBlockOffsetList.push_back (lData.size());
+
+      } else {
+        const size_t lMaxLength = std::min (lTerm.size(), lFormerTerm.size());
+        while (lSharedLength != lMaxLength
+               && lTerm[lSharedLength] == lFormerTerm[lSharedLength]) {
+          ++lSharedLength;
+        }
+      }
+
+      writeVarUInt (lData, lSharedLength);
+      writeVarUInt (lData, lTerm.size() - lSharedLength);
+      lData.append (lTerm, lSharedLength, std::string::npos);
+      writeVarUInt (lData, lTermList[idx].second);
+      lFormerTerm = lTerm;
+    }
+    assert (lBlockOffsetList.size() == lNbOfBlocks);
+
+    // Assemble the image: header, offsets of the blocks, and data
+    std::string lImage;
+    lImage.reserve ((K_TERM_VOCABULARY_HEADER_SIZE + lNbOfBlocks)
+                    * sizeof (boost::uint32_t) + lData.size());
+    writeUInt32 (lImage, K_TERM_VOCABULARY_MAGIC);
+    writeUInt32 (lImage, K_TERM_VOCABULARY_FORMAT_VERSION);
+    writeUInt32 (lImage, lNbOfTerms);
+    writeUInt32 (lImage, lNbOfBlocks);
+    writeUInt32 (lImage, lBlockSize);
+    for (std::vector<boost::uint32_t>::const_iterator itOffset =
+           lBlockOffsetList.begin(); itOffset != lBlockOffsetList.end();
+         ++itOffset) {
+      writeUInt32 (lImage, *itOffset);
+    }
+    lImage.append (lData);
+
+    _mappedRegion.reset();
+    _image.swap (lImage);
+    const bool isValid = attach (_image.data(), _image.size());
+    assert (isValid == true);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool TermVocabulary::attach (const char* iImage, const size_t iImageSize) {
+    _imageBegin = NULL;
+    _imageSize = 0;
+    _nbOfTerms = 0;
+    _nbOfBlocks = 0;
+
+    // Check the header. As the integers are stored in the byte order of
+    // the host, an image built on a host of another byte order is rejected.
+    const size_t lHeaderSize =
+      K_TERM_VOCABULARY_HEADER_SIZE * sizeof (boost::uint32_t);
+    if (iImage == NULL || iImageSize < lHeaderSize
+        || readUInt32 (iImage) != K_TERM_VOCABULARY_MAGIC
+        || readUInt32 (iImage + 4) != K_TERM_VOCABULARY_FORMAT_VERSION) {
+      return false;
+    }
+    const boost::uint32_t lNbOfTerms = readUInt32 (iImage + 8);
+    const boost::uint32_t lNbOfBlocks = readUInt32 (iImage + 12);
+    const boost::uint32_t lBlockSize = readUInt32 (iImage + 16);
+    if (lBlockSize == 0
+        || lNbOfBlocks != (lNbOfTerms + lBlockSize - 1) / lBlockSize) {
+      return false;
+    }
+
+    // Check the offsets of the blocks
+    const size_t lDataBegin = lHeaderSize
+      + lNbOfBlocks * sizeof (boost::uint32_t);
+    if (iImageSize < lDataBegin) {
+      return false;
+    }
+    const size_t lDataSize = iImageSize - lDataBegin;
+    boost::uint32_t lFormerOffset = 0;
+    for (boost::uint32_t idx = 0; idx != lNbOfBlocks; ++idx) {
+      const boost::uint32_t lOffset =
+        readUInt32 (iImage + lHeaderSize + idx * sizeof (boost::uint32_t));
+      if (lOffset >= lDataSize || (idx != 0 && lOffset <= lFormerOffset)) {
+        return false;
+      }
+      lFormerOffset = lOffset;
+    }
+
+    _imageBegin = iImage;
+    _imageSize = iImageSize;
+    _nbOfTerms = lNbOfTerms;
+    _nbOfBlocks = lNbOfBlocks;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const unsigned char* TermVocabulary::
+  getBlockData (const boost::uint32_t iBlockIdx) const {
+    assert (iBlockIdx < _nbOfBlocks);
+    const size_t lHeaderSize =
+      K_TERM_VOCABULARY_HEADER_SIZE * sizeof (boost::uint32_t);
+    const boost::uint32_t lOffset =
+      readUInt32 (_imageBegin + lHeaderSize
+                  + iBlockIdx * sizeof (boost::uint32_t));
+    const char* lDataBegin = _imageBegin + lHeaderSize
+      + _nbOfBlocks * sizeof (boost::uint32_t);
+    return reinterpret_cast<const unsigned char*> (lDataBegin + lOffset);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const unsigned char* TermVocabulary::getDataEnd() const {
+    return reinterpret_cast<const unsigned char*> (_imageBegin + _imageSize);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  boost::uint32_t TermVocabulary::findBlock (const std::string& iTerm) const {
+    // Binary search of the last block, the first term of which is lower
+    // than or equal to the given term
+    boost::uint32_t lLowerIdx = 0;
+    boost::uint32_t lUpperIdx = _nbOfBlocks;
+    while (lUpperIdx - lLowerIdx > 1) {
+      const boost::uint32_t lMiddleIdx =
+        lLowerIdx + (lUpperIdx - lLowerIdx) / 2;
+
+      // The first term of a block is stored in full
+      const unsigned char* lPosition = getBlockData (lMiddleIdx);
+      const boost::uint32_t lSharedLength = readVarUInt (lPosition);
+      assert (lSharedLength == 0);
+      const boost::uint32_t lLength = readVarUInt (lPosition);
+      const int lComparison =
+        iTerm.compare (0, std::string::npos,
+                       reinterpret_cast<const char*> (lPosition), lLength);
+      if (lComparison < 0) {
+        lUpperIdx = lMiddleIdx;
+      } else {
+        lLowerIdx = lMiddleIdx;
+      }
+    }
+    return lLowerIdx;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  TermVocabulary::DocFrequency_T TermVocabulary::
+  getDocFrequency (const std::string& iTerm) const {
+    if (_nbOfBlocks == 0) {
+      return 0;
+    }
+
+    // Scan the block which may hold the term
+    const boost::uint32_t lBlockIdx = findBlock (iTerm);
+    const unsigned char* lPosition = getBlockData (lBlockIdx);
+    const unsigned char* lBlockEnd =
+      (lBlockIdx + 1 == _nbOfBlocks) ? getDataEnd()
+      : getBlockData (lBlockIdx + 1);
+    std::string lTerm;
+    while (lPosition < lBlockEnd) {
+      const DocFrequency_T lDocFrequency = readTerm (lPosition, lTerm);
+      const int lComparison = lTerm.compare (iTerm);
+      if (lComparison == 0) {
+        return lDocFrequency;
+      }
+      if (lComparison > 0) {
+        break;
+      }
+    }
+    return 0;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool TermVocabulary::containsAll (const WordList_T& iTermList,
+                                    std::string& oUnknownTerm) const {
+    for (WordList_T::const_iterator itTerm = iTermList.begin();
+         itTerm != iTermList.end(); ++itTerm) {
+      const std::string& lTerm = *itTerm;
+      if (contains (lTerm) == false) {
+        oUnknownTerm = lTerm;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TermVocabulary::getTermsByPrefix (const std::string& iPrefix,
+                                         TermFrequencyList_T& ioTermList,
+                                         const size_t iMaxNbOfTerms) const {
+    if (_nbOfBlocks == 0) {
+      return;
+    }
+
+    // The terms starting with the prefix are contiguous, from the block
+    // which may hold the prefix itself
+    size_t lNbOfTerms = 0;
+    const unsigned char* lPosition = getBlockData (findBlock (iPrefix));
+    const unsigned char* lDataEnd = getDataEnd();
+    std::string lTerm;
+    while (lPosition < lDataEnd) {
+      const DocFrequency_T lDocFrequency = readTerm (lPosition, lTerm);
+      if (lTerm.compare (0, iPrefix.size(), iPrefix) == 0) {
+        ioTermList.push_back (TermFrequency_T (lTerm, lDocFrequency));
+        ++lNbOfTerms;
+        if (lNbOfTerms == iMaxNbOfTerms) {
+          break;
+        }
+
+      } else if (lTerm > iPrefix) {
+        break;
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TermVocabulary::save (const std::string& iFilePath) const {
+    std::ofstream lFile (iFilePath.c_str(), std::ios::binary);
+    if (lFile.is_open() == false) {
+      std::ostringstream oStr;
+      oStr << "The vocabulary cannot be saved into '" << iFilePath << "'";
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw FileNotFoundException (oStr.str());
+    }
+
+    if (_imageBegin != NULL) {
+      lFile.write (_imageBegin, _imageSize);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool TermVocabulary::load (const std::string& iFilePath) {
+    namespace bip = boost::interprocess;
+
+    boost::shared_ptr<bip::mapped_region> lMappedRegion_ptr;
+    try {
+      // The file may be unmapped once the region is mapped
+      const bip::file_mapping lFileMapping (iFilePath.c_str(), bip::read_only);
+      lMappedRegion_ptr.reset (new bip::mapped_region (lFileMapping,
+                                                       bip::read_only));
+
+    } catch (const bip::interprocess_exception& error) {
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("The vocabulary ('" << iFilePath
+                          << "') cannot be mapped: " << error.what());
+      return false;
+    }
+    assert (lMappedRegion_ptr != NULL);
+
+    const char* lImage =
+      static_cast<const char*> (lMappedRegion_ptr->get_address());
+    const bool isValid = attach (lImage, lMappedRegion_ptr->get_size());
+    if (isValid == false) {
+      return false;
+    }
+
+    std::string().swap (_image);
+    _mappedRegion = lMappedRegion_ptr;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TermVocabulary::fromStream (std::istream& ioIn) {
+    _mappedRegion.reset();
+    std::string lImage ((std::istreambuf_iterator<char> (ioIn)),
+                        std::istreambuf_iterator<char>());
+    _image.swap (lImage);
+    attach (_image.data(), _image.size());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string TermVocabulary::describe() const {
+    std::ostringstream oStr;
+    oStr << "Vocabulary of " << _nbOfTerms << " terms (" << _nbOfBlocks
+         << " blocks, " << _imageSize << " bytes";
+    if (_mappedRegion != NULL) {
+      oStr << ", memory-mapped";
+    }
+    oStr << ")";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,258 @@
+#ifndef __OPENTREP_BOM_TERMVOCABULARY_HPP
+#define __OPENTREP_BOM_TERMVOCABULARY_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/basic/StructAbstract.hpp>
+
+// Forward declarations
+namespace boost {
+  namespace interprocess {
+    class mapped_region;
+  }
+}
+
+namespace OPENTREP {
+
+  /**
+   * @brief Compact vocabulary of all the terms of the Xapian index, along
+   *        with their document frequencies.
+   *
+   * The vocabulary is made of the terms generated, at index time, from
+   * the sets of strings of the POR (see Place::buildIndexSets()). It allows
+   * to know, without any Xapian call, whether a word is known by the index
+   * at all and, if so, by how many documents; it also allows to enumerate
+   * the terms starting with a given prefix.
+   *
+   * The terms are sorted and front-coded, by blocks of
+   * K_TERM_VOCABULARY_BLOCK_SIZE terms: the first term of a block is
+   * stored in full, and every following term only by the length of the
+   * prefix it shares with the former term and by its remaining characters.
+   * A term is looked up by a binary search on the first terms of the
+   * blocks, followed by a scan of a single block.
+   *
+   * The serialised image is self-contained (it does not hold any pointer),
+   * so that the file saved within the directory of the Xapian index may
+   * be memory-mapped as is, in read-only mode: all the processes searching
+   * the same index then share the same physical pages.
+   *
+   * The image is made of:
+   * <ul>
+   *  <li>a header of 32-bit integers (magic number, format version,
+   *      number of terms, number of blocks, size of the blocks),</li>
+   *  <li>the offsets (32-bit integers) of the blocks, from the beginning
+   *      of the data,</li>
+   *  <li>the data of the blocks, where every term is encoded as the
+   *      length of its shared prefix, the length of its suffix, its suffix
+   *      and its document frequency (lengths and frequency being encoded
+   *      as variable-length integers, 7 bits per byte).</li>
+   * </ul>
+   */
+  struct TermVocabulary : public StructAbstract {
+  public:
+    // //////////////// Type definitions //////////////////
+    /**
+     * Number of documents in which a term appears.
+     */
+    typedef boost::uint32_t DocFrequency_T;
+
+    /**
+     * Term, along with its document frequency.
+     */
+    typedef std::pair<std::string, DocFrequency_T> TermFrequency_T;
+
+    /**
+     * List of terms, along with their document frequencies.
+     */
+    typedef std::vector<TermFrequency_T> TermFrequencyList_T;
+
+  public:
+    // //////////////// Business Methods //////////////////
+    /**
+     * Record the given term, along with its document frequency.
+     *
+     * \note The vocabulary must be finalised (see finalise()) before being
+     *       looked up.
+     */
+    void addTerm (const std::string&, const DocFrequency_T&);
+
+    /**
+     * Sort the recorded terms, and build the serialised (front-coded)
+     * image of the vocabulary.
+     */
+    void finalise();
+
+    /**
+     * Get the document frequency of the given term.
+     *
+     * @param const std::string& Term, in lower case (e.g., "francisco").
+     * @return DocFrequency_T Number of documents in which the term appears,
+     *         0 when it is not known by the index.
+     */
+    DocFrequency_T getDocFrequency (const std::string&) const;
+
+    /**
+     * State whether the given term is known by the index.
+     */
+    bool contains (const std::string& iTerm) const {
+      return (getDocFrequency (iTerm) != 0);
+    }
+
+    /**
+     * State whether all the given terms are known by the index.
+     *
+     * @param const WordList_T& List of terms (e.g., as given by
+     *        QueryBuilder::buildTermList()).
+     * @param std::string& The first unknown term, if any.
+     */
+    bool containsAll (const WordList_T&, std::string& oUnknownTerm) const;
+
+    /**
+     * Get the terms starting with the given prefix, in the lexicographical
+     * order, along with their document frequencies.
+     *
+     * @param const std::string& Prefix, in lower case (e.g., "fran").
+     * @param TermFrequencyList_T& List to which the terms are added.
+     * @param const size_t Maximal number of terms to be added (0 for
+     *        all of them).
+     */
+    void getTermsByPrefix (const std::string&, TermFrequencyList_T&,
+                           const size_t iMaxNbOfTerms = 0) const;
+
+    /**
+     * Return the number of terms.
+     */
+    size_t size() const {
+      return _nbOfTerms;
+    }
+
+    /**
+     * Return the size, in bytes, of the serialised image.
+     */
+    size_t getImageSize() const {
+      return _imageSize;
+    }
+
+    /**
+     * Save the (finalised) vocabulary into the given file.
+     *
+     * @param const std::string& File-path of the vocabulary.
+     */
+    void save (const std::string&) const;
+
+    /**
+     * Memory-map the given file, in read-only mode.
+     *
+     * @param const std::string& File-path of the vocabulary.
+     * @return bool Whether the file could be mapped, and holds a valid
+     *         vocabulary.
+     */
+    bool load (const std::string&);
+
+  public:
+    // /////////// Display support methods /////////
+    /**
+     * Read a structure from an input stream.
+     *
+     * @param istream& the input stream.
+     */
+    void fromStream (std::istream& ioIn);
+
+    /**
+     * Get the serialised version of the structure.
+     */
+    std::string describe() const;
+
+  public:
+    // //////////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    TermVocabulary();
+
+    /**
+     * Default destructor.
+     */
+    ~TermVocabulary();
+
+  private:
+    /**
+     * Copy constructor (the image may point to the vocabulary itself).
+     */
+    TermVocabulary (const TermVocabulary&);
+
+  private:
+    // //////////////// Helper Methods //////////////////
+    /**
+     * Attach the vocabulary to the given serialised image, after having
+     * checked its header.
+     *
+     * @return bool Whether the image holds a valid vocabulary.
+     */
+    bool attach (const char* iImage, const size_t iImageSize);
+
+    /**
+     * Get the index of the last block, the first term of which is lower
+     * than or equal to the given string (0 when there is none).
+     */
+    boost::uint32_t findBlock (const std::string&) const;
+
+    /**
+     * Get the beginning of the data of the given block.
+     */
+    const unsigned char* getBlockData (const boost::uint32_t iBlockIdx) const;
+
+    /**
+     * Get the beginning of the data following the last block.
+     */
+    const unsigned char* getDataEnd() const;
+
+  private:
+    // //////////////// Attributes ///////////////
+    /**
+     * Terms recorded, before the vocabulary is finalised.
+     */
+    TermFrequencyList_T _termList;
+
+    /**
+     * Serialised image, when the vocabulary is built in memory.
+     */
+    std::string _image;
+
+    /**
+     * Memory-mapped region, when the vocabulary is loaded from a file.
+     */
+    boost::shared_ptr<boost::interprocess::mapped_region> _mappedRegion;
+
+    /**
+     * Beginning of the serialised image (either of the above ones).
+     */
+    const char* _imageBegin;
+
+    /**
+     * Size, in bytes, of the serialised image.
+     */
+    size_t _imageSize;
+
+    /**
+     * Number of terms.
+     */
+    boost::uint32_t _nbOfTerms;
+
+    /**
+     * Number of blocks.
+     */
+    boost::uint32_t _nbOfBlocks;
+  };
+
+}
+#endif // __OPENTREP_BOM_TERMVOCABULARY_HPP
@@ -0,0 +1,138 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+// OpenTrep
+#include <opentrep/bom/WordPairTable.hpp>
+#include <opentrep/bom/QueryBuilder.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  WordPairTable::WordPairTable() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  WordPairTable::~WordPairTable() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string WordPairTable::buildKey (const Word_T& iTerm1,
+                                       const Word_T& iTerm2) {
+    std::string oKey;
+    oKey.reserve (iTerm1.size() + 1 + iTerm2.size());
+    oKey += iTerm1;
+    oKey += " ";
+    oKey += iTerm2;
+    return oKey;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void WordPairTable::addWordList (const WordList_T& iWordList) {
+    // The pairs are made of the Xapian terms, i.e., of the words folded
+    // in lower case (including the non-ASCII letters)
+    WordList_T lTermList;
+    QueryBuilder::buildTermList (iWordList, lTermList);
+    if (lTermList.empty() == true) {
+      return;
+    }
+
+    WordList_T::const_iterator itTerm = lTermList.begin();
+    WordList_T::const_iterator itNextTerm = itTerm; ++itNextTerm;
+    for ( ; itNextTerm != lTermList.end(); ++itTerm, ++itNextTerm) {
+      const Word_T& lTerm = *itTerm;
+      const Word_T& lNextTerm = *itNextTerm;
+      _wordPairArray.push_back (buildKey (lTerm, lNextTerm));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void WordPairTable::sort() {
+    std::sort (_wordPairArray.begin(), _wordPairArray.end());
+    _wordPairArray.erase (std::unique (_wordPairArray.begin(),
+                                       _wordPairArray.end()),
+                          _wordPairArray.end());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool WordPairTable::contains (const Word_T& iWord1,
+                                const Word_T& iWord2) const {
+    // The words of the query are converted into terms just as the indexed
+    // ones were. As for a Xapian phrase query, all the contiguous terms
+    // must then be adjacent.
+    WordList_T lWordList;
+    lWordList.push_back (iWord1);
+    lWordList.push_back (iWord2);
+    WordList_T lTermList;
+    QueryBuilder::buildTermList (lWordList, lTermList);
+    if (lTermList.size() < 2) {
+      return false;
+    }
+
+    WordList_T::const_iterator itTerm = lTermList.begin();
+    WordList_T::const_iterator itNextTerm = itTerm; ++itNextTerm;
+    for ( ; itNextTerm != lTermList.end(); ++itTerm, ++itNextTerm) {
+      const std::string& lKey = buildKey (*itTerm, *itNextTerm);
+      if (std::binary_search (_wordPairArray.begin(), _wordPairArray.end(),
+                              lKey) == false) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void WordPairTable::save (const std::string& iFilePath) const {
+    std::ofstream lFile (iFilePath.c_str());
+    if (lFile.is_open() == false) {
+      std::ostringstream oStr;
+      oStr << "The table of the word pairs cannot be saved into '"
+           << iFilePath << "'";
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw FileNotFoundException (oStr.str());
+    }
+
+    for (WordPairArray_T::const_iterator itPair = _wordPairArray.begin();
+         itPair != _wordPairArray.end(); ++itPair) {
+      const std::string& lWordPair = *itPair;
+      lFile << lWordPair << "\n";
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool WordPairTable::load (const std::string& iFilePath) {
+    std::ifstream lFile (iFilePath.c_str());
+    if (lFile.is_open() == false) {
+      return false;
+    }
+    fromStream (lFile);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void WordPairTable::fromStream (std::istream& ioIn) {
+    _wordPairArray.clear();
+    std::string lWordPair;
+    while (std::getline (ioIn, lWordPair)) {
+      if (lWordPair.empty() == false) {
+        _wordPairArray.push_back (lWordPair);
+      }
+    }
+
+    // The file is normally already sorted; that is just a safety net
+    sort();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string WordPairTable::describe() const {
+    std::ostringstream oStr;
+    oStr << "Table of " << _wordPairArray.size() << " word pairs";
+    return oStr.str();
+  }
+
+}
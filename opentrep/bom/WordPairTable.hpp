@@ -0,0 +1,126 @@
+#ifndef __OPENTREP_BOM_WORDPAIRTABLE_HPP
+#define __OPENTREP_BOM_WORDPAIRTABLE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/basic/StructAbstract.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Table of the adjacent word pairs of the indexed names.
+   *
+   * When a travel query is cut in slices (see QuerySlices), every pair of
+   * contiguous words is checked for a match. A (Xapian) phrase query on a
+   * pair of words matches when those words are adjacent within the terms
+   * of at least one indexed document. The table records all those pairs
+   * at index time, so that the check becomes an in-memory look up.
+   *
+   * The pairs are made of the Xapian terms of the words, i.e., of the
+   * words folded in lower case by the Unicode rules of Xapian (see
+   * QueryBuilder::buildTermList()), so that "Île de France" and "ÎLE DE
+   * FRANCE" give the same pairs. They are stored as "term1 term2" strings
+   * within a sorted array, looked up by binary search. The table is saved as a
+   * text file, one pair per line, within the directory of the Xapian index.
+   */
+  struct WordPairTable : public StructAbstract {
+  public:
+    // //////////////// Type definitions //////////////////
+    /**
+     * Sorted array of word pairs.
+     */
+    typedef std::vector<std::string> WordPairArray_T;
+
+  public:
+    // //////////////// Business Methods //////////////////
+    /**
+     * Record all the pairs of contiguous words of the given list.
+     *
+     * \note The table must be sorted (see sort()) before being looked up.
+     *
+     * @param const WordList_T& List of words, in the order of the index.
+     */
+    void addWordList (const WordList_T&);
+
+    /**
+     * Sort the recorded pairs, and remove the duplicates.
+     */
+    void sort();
+
+    /**
+     * State whether the given pair of words is adjacent within at least
+     * one indexed document, whatever the case of their letters.
+     */
+    bool contains (const Word_T&, const Word_T&) const;
+
+    /**
+     * Return the number of pairs.
+     */
+    size_t size() const {
+      return _wordPairArray.size();
+    }
+
+    /**
+     * Save the table into the given file.
+     *
+     * @param const std::string& File-path of the table.
+     */
+    void save (const std::string&) const;
+
+    /**
+     * Load the table from the given file.
+     *
+     * @param const std::string& File-path of the table.
+     * @return bool Whether the file could be read.
+     */
+    bool load (const std::string&);
+
+  public:
+    // /////////// Display support methods /////////
+    /**
+     * Read a structure from an input stream.
+     *
+     * @param istream& the input stream.
+     */
+    void fromStream (std::istream& ioIn);
+
+    /**
+     * Get the serialised version of the structure.
+     */
+    std::string describe() const;
+
+  public:
+    // //////////////// Constructors and Destructors /////////////
+    /**
+     * Default constructor.
+     */
+    WordPairTable();
+
+    /**
+     * Default destructor.
+     */
+    ~WordPairTable();
+
+  private:
+    // //////////////// Helper Methods //////////////////
+    /**
+     * Build the key of the given pair of (Xapian) terms.
+     */
+    static std::string buildKey (const Word_T&, const Word_T&);
+
+  private:
+    // //////////////// Attributes ///////////////
+    /**
+     * Sorted array of word pairs.
+     */
+    WordPairArray_T _wordPairArray;
+  };
+
+}
+#endif // __OPENTREP_BOM_WORDPAIRTABLE_HPP
@@ -27,16 +27,12 @@
 namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
-  soci::session* DBManager::
-  initSQLDBSession (const DBType& iDBType,
+  void DBManager::
+  openSQLDBSession (soci::session& ioSociSession, const DBType& iDBType,
                     const SQLDBConnectionString_T& iSQLDBConnStr) {
-    soci::session* oSociSession_ptr = NULL;
-
     // DEBUG
-    if (!(iDBType == DBType::NODB)) {
-      OPENTREP_LOG_DEBUG ("Connecting to the " << iDBType.describe()
-                          << " SQL database/file ('" << iSQLDBConnStr << "')");
-    }
+    OPENTREP_LOG_DEBUG ("Connecting to the " << iDBType.describe()
+                        << " SQL database/file ('" << iSQLDBConnStr << "')");
 
     if (iDBType == DBType::SQLITE3) {
 
@@ -61,10 +57,7 @@ namespace OPENTREP {
       try {
 
         // Connect to the SQL database.
-        oSociSession_ptr = new soci::session();
-        assert (oSociSession_ptr != NULL);
-        soci::session& lSociSession = *oSociSession_ptr;
-        lSociSession.open (soci::sqlite3, iSQLDBConnStr);
+        ioSociSession.open (soci::sqlite3, iSQLDBConnStr);
 
         // DEBUG
         OPENTREP_LOG_DEBUG ("The SQLite3 database/file ('" << iSQLDBConnStr
@@ -78,18 +71,12 @@ namespace OPENTREP {
         throw SQLDatabaseImpossibleConnectionException (errorStr.str());
       }
 
-      // The SQLite3 connection is assumed to have been successful
-      assert (oSociSession_ptr != NULL);
-
     } else if (iDBType == DBType::MYSQL) {
 
       try {
 
         // Connect to the SQL database.
-        oSociSession_ptr = new soci::session();
-        assert (oSociSession_ptr != NULL);
-        soci::session& lSociSession = *oSociSession_ptr;
-        lSociSession.open (soci::mysql, iSQLDBConnStr);
+        ioSociSession.open (soci::mysql, iSQLDBConnStr);
 
         // DEBUG
         OPENTREP_LOG_DEBUG ("The " << iDBType.describe() << " database ("
@@ -103,12 +90,6 @@ namespace OPENTREP {
         throw SQLDatabaseImpossibleConnectionException (errorStr.str());
       }
 
-      // The MySQL/MariaDB connection is assumed to have been successful
-      assert (oSociSession_ptr != NULL);
-
-    } else if (iDBType == DBType::NODB) {
-      // Do nothing
-
     } else {
       std::ostringstream errorStr;
       errorStr << "Error: the '" << iDBType.describe()
@@ -116,10 +97,91 @@ namespace OPENTREP {
       OPENTREP_LOG_ERROR (errorStr.str());
       throw SQLDatabaseTableCreationException (errorStr.str());
     }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  soci::session* DBManager::
+  initSQLDBSession (const DBType& iDBType,
+                    const SQLDBConnectionString_T& iSQLDBConnStr) {
+    soci::session* oSociSession_ptr = NULL;
+
+    // Nothing to connect to when there is no SQL database
+    if (iDBType == DBType::NODB) {
+      return oSociSession_ptr;
+    }
+
+    // Connect to the SQL database.
+    oSociSession_ptr = new soci::session();
+    assert (oSociSession_ptr != NULL);
+    try {
+      openSQLDBSession (*oSociSession_ptr, iDBType, iSQLDBConnStr);
+
+    } catch (...) {
+      delete oSociSession_ptr; oSociSession_ptr = NULL;
+      throw;
+    }
 
+    // The connection is assumed to have been successful
+    assert (oSociSession_ptr != NULL);
     return oSociSession_ptr;
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void DBManager::terminateSQLDBSession (soci::session* ioSociSession_ptr) {
+    if (ioSociSession_ptr == NULL) {
+      return;
+    }
+
+    try {
+      // Close the connection to the SQL database
+      ioSociSession_ptr->close();
+
+    } catch (std::exception const& lException) {
+      OPENTREP_LOG_ERROR ("Error when trying to close the connection to "
+                          << "the SQL database: " << lException.what());
+    }
+
+    delete ioSociSession_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  soci::connection_pool* DBManager::
+  initSQLDBConnectionPool (const DBType& iDBType,
+                           const SQLDBConnectionString_T& iSQLDBConnStr,
+                           const NbOfDBConnections_T& iPoolSize) {
+    soci::connection_pool* oSociConnectionPool_ptr = NULL;
+
+    // Nothing to connect to when there is no SQL database
+    if (iDBType == DBType::NODB) {
+      return oSociConnectionPool_ptr;
+    }
+
+    // A pool cannot be empty
+    const NbOfDBConnections_T lPoolSize = (iPoolSize == 0) ? 1 : iPoolSize;
+
+    // Open, once for all, all the connections of the pool. They will then
+    // be leased (and given back) by the SQL database look ups.
+    oSociConnectionPool_ptr = new soci::connection_pool (lPoolSize);
+    assert (oSociConnectionPool_ptr != NULL);
+    try {
+      for (NbOfDBConnections_T idx = 0; idx != lPoolSize; ++idx) {
+        soci::session& lSociSession = oSociConnectionPool_ptr->at (idx);
+        openSQLDBSession (lSociSession, iDBType, iSQLDBConnStr);
+      }
+
+    } catch (...) {
+      delete oSociConnectionPool_ptr; oSociConnectionPool_ptr = NULL;
+      throw;
+    }
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("A pool of " << lPoolSize << " connections to the "
+                        << iDBType.describe() << " SQL database/file ('"
+                        << iSQLDBConnStr << "') has been opened");
+
+    return oSociConnectionPool_ptr;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   bool DBManager::
   createSQLDBUser (const DBType& iDBType,
@@ -868,6 +930,9 @@ namespace OPENTREP {
       }
     }
 
+    // Close the connection to the SQL database/file
+    terminateSQLDBSession (lSociSession_ptr);
+
     return oNbOfEntries;
   }
 
@@ -14,6 +14,7 @@
 namespace soci {
   class session;
   class statement;
+  class connection_pool;
 }
 
 namespace OPENTREP {
@@ -55,6 +56,35 @@ namespace OPENTREP {
     static soci::session* initSQLDBSession (const DBType&,
                                             const SQLDBConnectionString_T&);
 
+    /**
+     * Close the given SQL database connection, and release it from memory.
+     *
+     * @param soci::session* A pointer on the SQL database connection,
+     *                       as created by initSQLDBSession(). It may be NULL.
+     */
+    static void terminateSQLDBSession (soci::session*);
+
+    /**
+     * Create a pool of connections to the SQL database.
+     *
+     * All the connections of the pool are opened straight away, so that
+     * the connection cost is paid only once. The SQL database look ups
+     * then lease a connection from the pool, thanks to a soci::session
+     * constructed on that pool. Such a session gives the connection back
+     * to the pool when it goes out of scope.
+     *
+     * @param const DBType& The SQL database type (e.g., SQLite3, MySQL).
+     * @param const SQLDBConnectionString_T& Connection string for the SQL
+     *                                       database.
+     * @param const NbOfDBConnections_T& Number of connections of the pool.
+     * @return soci::connection_pool* A pointer on the just created pool of
+     *                                SQL database connections (NULL when
+     *                                there is no SQL database).
+     */
+    static soci::connection_pool*
+    initSQLDBConnectionPool (const DBType&, const SQLDBConnectionString_T&,
+                             const NbOfDBConnections_T&);
+
     /**
      * On MySQL, create the 'trep' database user and 'trep_trep' database.
      * On other database types (e.g., nosql, sqlite), that method has no effect.
@@ -230,6 +260,17 @@ namespace OPENTREP {
 
     
   private:
+    /**
+     * Open a connection to the SQL database, on the given SOCI session.
+     *
+     * @param soci::session& SOCI session handler.
+     * @param const DBType& The SQL database type (e.g., SQLite3, MySQL).
+     * @param const SQLDBConnectionString_T& Connection string for the SQL
+     *                                       database.
+     */
+    static void openSQLDBSession (soci::session&, const DBType&,
+                                  const SQLDBConnectionString_T&);
+
     /**
      * Prepare (parse and put in cache) the SQL statement.
      *
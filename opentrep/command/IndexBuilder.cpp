@@ -3,6 +3,8 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <cmath>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <exception>
@@ -17,14 +19,21 @@
 // SOCI
 #include <soci/soci.h>
 // OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
 #include <opentrep/basic/OTransliterator.hpp>
 #include <opentrep/basic/Utilities.hpp>
 #include <opentrep/bom/StringPartition.hpp>
 #include <opentrep/bom/WordCombinationHolder.hpp>
+#include <opentrep/bom/WordHolder.hpp>
+#include <opentrep/bom/WordPairTable.hpp>
+#include <opentrep/bom/SpellingDictionary.hpp>
+#include <opentrep/bom/TermVocabulary.hpp>
 #include <opentrep/bom/World.hpp>
 #include <opentrep/bom/Place.hpp>
+#include <opentrep/bom/ScoreBoard.hpp>
 #include <opentrep/bom/PORFileHelper.hpp>
 #include <opentrep/bom/PORParserHelper.hpp>
+#include <opentrep/bom/PORValidityDecider.hpp>
 #include <opentrep/factory/FacPlace.hpp>
 #include <opentrep/command/DBManager.hpp>
 #include <opentrep/command/IndexBuilder.hpp>
@@ -36,7 +45,9 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   void addToXapian (const Place& iPlace, Xapian::Document& ioDocument,
-                    Xapian::WritableDatabase& ioDatabase) {
+                    Xapian::WritableDatabase& ioDatabase,
+                    WordPairTable& ioWordPairTable,
+                    SpellingDictionary& ioSpellingDictionary) {
     /**
      * Build a Xapian TermGenerator:
      * http://xapian.org/docs/apidoc/html/classXapian_1_1TermGenerator.html
@@ -50,6 +61,11 @@ namespace OPENTREP {
     // DEBUG
     // OPENTREP_LOG_DEBUG ("Indexing for " << iPlace.describeKey());
 
+    // Words of the document, in the order in which they are indexed. As
+    // the term positions go on from one string to the next, a phrase query
+    // matches any pair of contiguous words of that list.
+    WordList_T lDocWordList;
+
     const Place::TermSetMap_T& lTermSetMap = iPlace.getTermSetMap();
     for (Place::TermSetMap_T::const_iterator itStringSet = lTermSetMap.begin();
          itStringSet != lTermSetMap.end(); ++itStringSet) {
@@ -64,18 +80,25 @@ namespace OPENTREP {
            itString != lTermSet.end(); ++itString) {
         const std::string& lString = *itString;
         lTermGenerator.index_text (lString, lWDFInc);
+        WordHolder::tokeniseStringIntoWordList (lString, lDocWordList);
 
         // DEBUG
         //OPENTREP_LOG_DEBUG("[" << lWeight << "/" << lWDFInc << "] "<< lString);
       }
     }
 
-    // Spelling terms
+    // Record the adjacent word pairs of the document
+    ioWordPairTable.addWordList (lDocWordList);
+
+    // Spelling terms, weighted by the PageRank value of the POR within
+    // the in-memory spelling dictionary
+    const PageRank_T& lPageRank = iPlace.getPageRank();
     const Place::StringSet_T& lSpellingSet = iPlace.getSpellingSet();
     for (Place::StringSet_T::const_iterator itTerm = lSpellingSet.begin();
          itTerm != lSpellingSet.end(); ++itTerm) {
       const std::string& lTerm = *itTerm;
       ioDatabase.add_spelling (lTerm);
+      ioSpellingDictionary.addTerm (lTerm, lPageRank);
     }
 
     // DEBUG
@@ -84,10 +107,78 @@ namespace OPENTREP {
                         << " into " << ioDocument.get_description());
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void addValuesToXapian (const Place& iPlace, Xapian::Document& ioDocument) {
+    /**
+     * Store the fields needed by the scoring steps (PageRank, envelope ID,
+     * prior, IATA code and type, Geonames ID, feature code) and by the
+     * filtering of the invalid POR (envelope ID, validity period) within
+     * dedicated Xapian value slots, so that the search process does not
+     * have to parse the document data. The numerical values are serialised
+     * so as to be sortable (e.g., by Xapian::Enquire).
+     */
+    const PageRank_T& lPageRank = iPlace.getPageRank();
+    ioDocument.add_value (K_XAPIAN_VALUE_SLOT_PAGE_RANK,
+                          Xapian::sortable_serialise (lPageRank));
+
+    const EnvelopeID_T& lEnvelopeID = iPlace.getEnvelopeID();
+    ioDocument.add_value (K_XAPIAN_VALUE_SLOT_ENVELOPE_ID,
+                          Xapian::sortable_serialise (lEnvelopeID));
+
+    /**
+     * The prior of the POR is the logarithm of its weights not depending
+     * on the full-text matching (PageRank and envelope), combined the
+     * same way as by the Result object. It is added by the Xapian matcher
+     * to the full-text relevance (see Result::fullTextMatch()), so that
+     * a big airport is not missed because of a lower relevance. The
+     * logarithm keeps it non-negative, and of the same order of magnitude
+     * as the relevance.
+     */
+    const TravelQuery_T lNoQueryString;
+    ScoreBoard lScoreBoard (lNoQueryString);
+    lScoreBoard.setScore (ScoreType::ENV_ID, lEnvelopeID);
+    lScoreBoard.setScore (ScoreType::PAGE_RANK, lPageRank);
+    const Percentage_T& lPriorPct = lScoreBoard.calculateCombinedWeight();
+    const Score_T lPrior = std::log10 (1.0 + lPriorPct / K_DEFAULT_PAGE_RANK);
+    ioDocument.add_value (K_XAPIAN_VALUE_SLOT_PRIOR,
+                          Xapian::sortable_serialise (lPrior));
+
+    const LocationKey& lLocationKey = iPlace.getKey();
+    const IATACode_T& lIataCode = lLocationKey.getIataCode();
+    ioDocument.add_value (K_XAPIAN_VALUE_SLOT_IATA_CODE, lIataCode);
+
+    const IATAType& lIataType = lLocationKey.getIataType();
+    ioDocument.add_value (K_XAPIAN_VALUE_SLOT_IATA_TYPE,
+                          lIataType.getTypeAsString());
+
+    const GeonamesID_T& lGeonamesID = lLocationKey.getGeonamesID();
+    ioDocument.add_value (K_XAPIAN_VALUE_SLOT_GEONAMES_ID,
+                          Xapian::sortable_serialise (lGeonamesID));
+
+    const FeatureCode_T& lFeatureCode = iPlace.getFeatureCode();
+    ioDocument.add_value (K_XAPIAN_VALUE_SLOT_FEATURE_CODE, lFeatureCode);
+
+    // The validity period allows to filter the POR within the matcher
+    // (see PORValidityDecider)
+    const Date_T& lDateFrom = iPlace.getDateFrom();
+    if (lDateFrom.is_special() == false) {
+      ioDocument.add_value (K_XAPIAN_VALUE_SLOT_DATE_FROM,
+                            PORValidityDecider::serialiseDate (lDateFrom));
+    }
+
+    const Date_T& lDateEnd = iPlace.getDateEnd();
+    if (lDateEnd.is_special() == false) {
+      ioDocument.add_value (K_XAPIAN_VALUE_SLOT_DATE_END,
+                            PORValidityDecider::serialiseDate (lDateEnd));
+    }
+  }
+
   // //////////////////////////////////////////////////////////////////////
   void IndexBuilder::addDocumentToIndex(Xapian::WritableDatabase& ioDatabase,
                                         Place& ioPlace,
-                                        const OTransliterator& iTransliterator) {
+                                        const OTransliterator& iTransliterator,
+                                        WordPairTable& ioWordPairTable,
+                                        SpellingDictionary& ioSpellingDict) {
 
     // Create an empty Xapian document
     Xapian::Document lDocument;
@@ -100,13 +191,17 @@ namespace OPENTREP {
     // ORI-maintained list of POR (points of reference), allowing the search
     // process to use exactly the same parser as the indexation process
     lDocument.set_data (lRawDataString);
+
+    // Store the scoring fields within the Xapian value slots
+    addValuesToXapian (ioPlace, lDocument);
       
     // Build the (STL) sets of terms to be added to the Xapian index and
     // spelling dictionary
     ioPlace.buildIndexSets (iTransliterator);
 
     // Add the (STL) sets of terms to the Xapian index and spelling dictionary
-    addToXapian (ioPlace, lDocument, ioDatabase);
+    addToXapian (ioPlace, lDocument, ioDatabase, ioWordPairTable,
+                 ioSpellingDict);
 
     // Add the document to the database
     const Xapian::docid& lDocID = ioDatabase.add_document (lDocument);
@@ -121,7 +216,9 @@ namespace OPENTREP {
   buildSearchIndex (Xapian::WritableDatabase& ioDatabase,
                     const DBType& iSQLDBType, soci::session* ioSociSessionPtr,
                     std::istream& iPORFileStream,
-                    const OTransliterator& iTransliterator) {
+                    const OTransliterator& iTransliterator,
+                    WordPairTable& ioWordPairTable,
+                    SpellingDictionary& ioSpellingDictionary) {
     NbOfDBEntries_T oNbOfEntries = 0;
 
     // Open the file to be parsed
@@ -145,7 +242,9 @@ namespace OPENTREP {
         lPlace.setLocation (lLocation);
 
         // Add the document, associated to the Place object, to the Xapian index
-        IndexBuilder::addDocumentToIndex (ioDatabase, lPlace, iTransliterator);
+        IndexBuilder::addDocumentToIndex (ioDatabase, lPlace, iTransliterator,
+                                          ioWordPairTable,
+                                          ioSpellingDictionary);
 
         // Add the document to the SQL database, if required
         if (ioSociSessionPtr != NULL) {
@@ -256,13 +355,66 @@ namespace OPENTREP {
     // Browse the input POR (point of reference) data file,
     // parse every of its rows, and put the result in the Xapian database/index
     // and, if needed, within the SQL database.
+    WordPairTable lWordPairTable;
+    SpellingDictionary lSpellingDictionary;
     oNbOfEntries = buildSearchIndex (lXapianDatabase, iSQLDBType,
                                      lSociSession_ptr,
-                                     lPORFileStream, iTransliterator);
+                                     lPORFileStream, iTransliterator,
+                                     lWordPairTable, lSpellingDictionary);
+
+    // Record the version of the format of the Xapian database (index),
+    // so that the search process can check it is able to read it
+    std::ostringstream lFormatVersionStr;
+    lFormatVersionStr << K_XAPIAN_INDEX_FORMAT_VERSION;
+    lXapianDatabase.set_metadata (K_XAPIAN_INDEX_FORMAT_VERSION_KEY,
+                                  lFormatVersionStr.str());
 
     // Commit the pending modifications on the Xapian database (index)
     lXapianDatabase.commit_transaction();
 
+    // Save the table of the adjacent word pairs beside the Xapian index
+    lWordPairTable.sort();
+    const boost::filesystem::path lWordPairTableFilePath =
+      lTravelDBFilePath / K_WORD_PAIR_TABLE_FILENAME;
+    lWordPairTable.save (lWordPairTableFilePath.string());
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The table of the word pairs (" << lWordPairTable.size()
+                        << " pairs) has been saved into "
+                        << lWordPairTableFilePath.string());
+
+    // Save the spelling dictionary beside the Xapian index. Only the terms
+    // are saved: the deletions are derived when the dictionary is loaded.
+    const boost::filesystem::path lSpellingDictionaryFilePath =
+      lTravelDBFilePath / K_SPELLING_DICTIONARY_FILENAME;
+    lSpellingDictionary.save (lSpellingDictionaryFilePath.string());
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The spelling dictionary ("
+                        << lSpellingDictionary.size()
+                        << " terms) has been saved into "
+                        << lSpellingDictionaryFilePath.string());
+
+    // Save the vocabulary of the Xapian index beside that latter. All the
+    // terms of the index, i.e., the ones generated from the sets of strings
+    // of the POR, are browsed in order, along with their document frequency.
+    TermVocabulary lTermVocabulary;
+    for (Xapian::TermIterator itTerm = lXapianDatabase.allterms_begin();
+         itTerm != lXapianDatabase.allterms_end(); ++itTerm) {
+      lTermVocabulary.addTerm (*itTerm, itTerm.get_termfreq());
+    }
+    lTermVocabulary.finalise();
+    const boost::filesystem::path lTermVocabularyFilePath =
+      lTravelDBFilePath / K_TERM_VOCABULARY_FILENAME;
+    lTermVocabulary.save (lTermVocabularyFilePath.string());
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG (lTermVocabulary.describe() << " has been saved into "
+                        << lTermVocabularyFilePath.string());
+
+    // Close the connection to the SQL database/file, if any
+    DBManager::terminateSQLDBSession (lSociSession_ptr);
+
     // DEBUG
     OPENTREP_LOG_DEBUG ("Xapian has indexed " << oNbOfEntries << " entries.");
 
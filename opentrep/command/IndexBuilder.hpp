@@ -26,6 +26,8 @@ namespace OPENTREP {
   // Forward declarations
   class Place;
   struct OTransliterator;
+  struct WordPairTable;
+  struct SpellingDictionary;
 
   /**
    * @brief Command wrapping the travel request process.
@@ -40,9 +42,14 @@ namespace OPENTREP {
      * @param Xapian::WritableDatabase& Xapian database.
      * @param Place& Place object instance.
      * @param const OTransliterator& Unicode transliterator.
+     * @param WordPairTable& Table, to which the adjacent word pairs of the
+     *        document are added.
+     * @param SpellingDictionary& Dictionary, to which the spelling terms
+     *        of the document are added.
      */
     static void addDocumentToIndex (Xapian::WritableDatabase&,
-                                    Place&, const OTransliterator&);
+                                    Place&, const OTransliterator&,
+                                    WordPairTable&, SpellingDictionary&);
 
     /**
      * Build Xapian database.
@@ -52,11 +59,17 @@ namespace OPENTREP {
      * @param soci::session* SOCI session handler (can be NULL; see above).
      * @param std::ifstream& File stream for the POR data file.
      * @param const OTransliterator& Unicode transliterator.
+     * @param WordPairTable& Table, to which the adjacent word pairs of the
+     *        indexed documents are added.
+     * @param SpellingDictionary& Dictionary, to which the spelling terms
+     *        of the indexed documents are added.
      */
     static NbOfDBEntries_T buildSearchIndex (Xapian::WritableDatabase&,
                                              const DBType&, soci::session*,
                                              std::istream& iPORFileStream,
-                                             const OTransliterator&);
+                                             const OTransliterator&,
+                                             WordPairTable&,
+                                             SpellingDictionary&);
 
     /**
      * Build Xapian database.
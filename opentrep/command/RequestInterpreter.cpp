@@ -6,14 +6,22 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <map>
 #include <exception>
 // Boost
-#include <boost/filesystem.hpp>
-#include <boost/regex.hpp>
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+// Xapian
+#include <xapian.h>
 // SOCI
 #include <soci/soci.h>
 // OpenTrep
 #include <opentrep/DBType.hpp>
+#include <opentrep/SearchExplanation.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/basic/BasThreadPool.hpp>
+#include <opentrep/basic/Utilities.hpp>
 #include <opentrep/basic/OTransliterator.hpp>
 #include <opentrep/bom/Filter.hpp>
 #include <opentrep/bom/WordHolder.hpp>
@@ -23,15 +31,23 @@
 #include <opentrep/bom/Result.hpp>
 #include <opentrep/bom/PlaceHolder.hpp>
 #include <opentrep/bom/QuerySlices.hpp>
+#include <opentrep/bom/CodeIndex.hpp>
+#include <opentrep/bom/PORValidityDecider.hpp>
+#include <opentrep/bom/SpellingDictionary.hpp>
+#include <opentrep/bom/TermVocabulary.hpp>
 #include <opentrep/bom/StringPartition.hpp>
 #include <opentrep/factory/FacPlaceHolder.hpp>
 #include <opentrep/factory/FacPlace.hpp>
 #include <opentrep/factory/FacResultCombination.hpp>
 #include <opentrep/factory/FacResultHolder.hpp>
 #include <opentrep/factory/FacResult.hpp>
+#include <opentrep/factory/FacQueryScope.hpp>
 #include <opentrep/command/DBManager.hpp>
+#include <opentrep/command/XapianDatabasePool.hpp>
+#include <opentrep/command/XapianIndexManager.hpp>
 #include <opentrep/command/RequestInterpreter.hpp>
 #include <opentrep/service/Logger.hpp>
+#include <opentrep/service/StatisticsRecorder.hpp>
 
 namespace OPENTREP {
 
@@ -93,9 +109,10 @@ namespace OPENTREP {
       }
       assert (hasFullTextMatched == true);
 
-      // Retrieve the Xapian document data (string)
-      const std::string& lDocDataStr = lResult_ptr->getBestDocData();
-      const RawDataString_T& lDocData = RawDataString_T (lDocDataStr);
+      // Load the Xapian document data (string). That is done only here,
+      // i.e., only for the best matching documents of the best matching
+      // ResultHolder object.
+      const RawDataString_T& lDocData = lResult_ptr->fetchBestDocData();
 
       // Parse the POR details and create the corresponding Location structure
       const Location& lLocation = Result::retrieveLocation (lDocData);
@@ -114,6 +131,521 @@ namespace OPENTREP {
       OPENTREP_LOG_DEBUG ("Retrieved Document: " << lPlace.toString());
     }
   }
+
+  /**
+   * Record, within the given explanation structure, the full-text match
+   * of a word combination, i.e., its spelling correction and the scores
+   * of its matching documents.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  void explainResult (const Result& iResult,
+                      WordCombinationExplanation& ioExplanation) {
+    ioExplanation._queryString = iResult.getQueryString();
+    const TravelQuery_T& lCorrectedQueryString =
+      iResult.getCorrectedTravelQuery();
+    if (lCorrectedQueryString != iResult.getQueryString()) {
+      ioExplanation._correctedQueryString = lCorrectedQueryString;
+    }
+    ioExplanation._hasFullTextMatched = iResult.hasFullTextMatched();
+    ioExplanation._editDistance = iResult.getEditDistance();
+    ioExplanation._allowableEditDistance = iResult.getAllowableEditDistance();
+    ioExplanation._weight = iResult.getBestCombinedWeight();
+
+    const DocumentList_T& lDocumentList = iResult.getDocumentList();
+    for (DocumentList_T::const_iterator itDoc = lDocumentList.begin();
+         itDoc != lDocumentList.end(); ++itDoc) {
+      const Xapian::docid& lDocID = itDoc->first;
+      const ScoreBoard& lScoreBoard = itDoc->second;
+
+      DocumentExplanation lDocument;
+      lDocument._key = iResult.getLocation (lDocID).getKey().toString();
+      for (unsigned short idx = 0; idx != ScoreType::LAST_VALUE; ++idx) {
+        const ScoreType::EN_ScoreType lScoreType =
+          static_cast<ScoreType::EN_ScoreType> (idx);
+        if (lScoreBoard.hasScore (lScoreType) == true) {
+          const Score_T& lScore = lScoreBoard.getScore (lScoreType);
+          lDocument._scoreList.
+            push_back (ScoreExplanation_T (ScoreType::getTypeLabel (lScoreType),
+                                           lScore));
+        }
+      }
+      ioExplanation._documentList.push_back (lDocument);
+    }
+  }
+
+  /**
+   * Record, within the given explanation structure, the string partitions
+   * of the given ResultCombination object, as well as the chosen one.
+   *
+   * @param const ResultCombination& List of ResultHolder objects.
+   * @param const bool Whether the string partitions, and their word
+   *        combinations, should be recorded (they are already recorded
+   *        by searchString() with the default search).
+   * @param SliceExplanation& Explanation of the search of the query slice.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  void explainResultCombination (const ResultCombination& iResultCombination,
+                                 const bool iShouldRecordPartitions,
+                                 SliceExplanation& ioExplanation) {
+    if (iShouldRecordPartitions == true) {
+      WordSet_T lExplainedStringSet;
+      const ResultHolderList_T& lResultHolderList =
+        iResultCombination.getResultHolderList();
+      for (ResultHolderList_T::const_iterator itResultHolder =
+             lResultHolderList.begin();
+           itResultHolder != lResultHolderList.end(); ++itResultHolder) {
+        const ResultHolder* lResultHolder_ptr = *itResultHolder;
+        assert (lResultHolder_ptr != NULL);
+
+        PartitionExplanation lPartition;
+        lPartition._weight = lResultHolder_ptr->getCombinedWeight();
+        const ResultList_T& lResultList = lResultHolder_ptr->getResultList();
+        for (ResultList_T::const_iterator itResult = lResultList.begin();
+             itResult != lResultList.end(); ++itResult) {
+          const Result* lResult_ptr = *itResult;
+          assert (lResult_ptr != NULL);
+          const TravelQuery_T& lQueryString = lResult_ptr->getQueryString();
+          lPartition._wordCombinationList.push_back (lQueryString);
+
+          // The same word combination may appear within several string
+          // partitions, and is described only once
+          if (lExplainedStringSet.insert (lQueryString).second == true) {
+            WordCombinationExplanation lString;
+            explainResult (*lResult_ptr, lString);
+            ioExplanation._wordCombinationList.push_back (lString);
+          }
+        }
+        ioExplanation._partitionList.push_back (lPartition);
+      }
+    }
+
+    if (iResultCombination.hasFullTextMatched() == false) {
+      return;
+    }
+    const ResultHolder& lBestResultHolder =
+      iResultCombination.getBestMatchingResultHolder();
+    PartitionExplanation& lChosenPartition = ioExplanation._chosenPartition;
+    lChosenPartition._weight = lBestResultHolder.getCombinedWeight();
+    const ResultList_T& lResultList = lBestResultHolder.getResultList();
+    for (ResultList_T::const_iterator itResult = lResultList.begin();
+         itResult != lResultList.end(); ++itResult) {
+      const Result* lResult_ptr = *itResult;
+      assert (lResult_ptr != NULL);
+      lChosenPartition._wordCombinationList.
+        push_back (lResult_ptr->getQueryString());
+    }
+    ioExplanation._hasChosenPartition = true;
+  }
+
+  /**
+   * @brief Xapian database handles used by the searches of a travel query.
+   *
+   * When a pool of handles is given, a handle is leased from that pool
+   * for every full-text match of a query slice. Once that full-text match
+   * is over, the handle is kept aside, and may be re-used only by the
+   * full-text matches of the same query slice: the Xapian matching sets kept
+   * by the Result objects refer to their handle, which must therefore not
+   * be used concurrently by the searches of other query slices (or of
+   * other travel queries), until those Result objects are released.
+   *
+   * The handles are given back to the pool only when that object is
+   * destroyed, which must happen after the end of the query scope
+   * (see FacQueryScope).
+   *
+   * Without any pool, the given default handle is used by all the
+   * (sequential) searches.
+   *
+   * Every handle comes with its own Xapian enquire session, re-used by
+   * all the full-text matches performed on that handle. As a handle is
+   * used by a single thread at a time, so is its enquire session.
+   */
+  class QueryDatabaseSet {
+  public:
+    /**
+     * Constructor.
+     *
+     * The revision of the index is read from the default handle, by
+     * the calling thread, as that handle must not be used by the threads
+     * leasing handles from the pool.
+     *
+     * @param XapianDatabasePool* Pool of handles (may be NULL).
+     * @param const Xapian::Database& Default handle, used without any pool.
+     */
+    QueryDatabaseSet (XapianDatabasePool* ioXapianDatabasePool_ptr,
+                      const Xapian::Database& iDefaultDatabase)
+      : _xapianDatabasePool (ioXapianDatabasePool_ptr),
+        _defaultDatabase (iDefaultDatabase) {
+      if (_xapianDatabasePool != NULL) {
+        _indexRevision = XapianIndexManager::getRevision (_defaultDatabase);
+      }
+    }
+
+    /**
+     * Destructor. All the leased handles are given back to the pool.
+     */
+    ~QueryDatabaseSet() {
+      for (EnquireMap_T::iterator itEnquire = _enquireMap.begin();
+           itEnquire != _enquireMap.end(); ++itEnquire) {
+        Xapian::Enquire* lEnquire_ptr = itEnquire->second;
+        delete lEnquire_ptr; lEnquire_ptr = NULL;
+      }
+
+      if (_xapianDatabasePool == NULL) {
+        return;
+      }
+      for (std::vector<Xapian::Database*>::iterator itDatabase =
+             _leasedList.begin(); itDatabase != _leasedList.end();
+           ++itDatabase) {
+        Xapian::Database* lXapianDatabase_ptr = *itDatabase;
+        assert (lXapianDatabase_ptr != NULL);
+        _xapianDatabasePool->giveBack (*lXapianDatabase_ptr);
+      }
+    }
+
+    /**
+     * Lease a handle for a search of the given query slice.
+     */
+    const Xapian::Database& lease (const unsigned short iSliceIdx) {
+      if (_xapianDatabasePool == NULL) {
+        return _defaultDatabase;
+      }
+
+      // Re-use a handle already leased for the same query slice, if any
+      {
+        boost::mutex::scoped_lock lGuard (_mutex);
+        if (iSliceIdx >= _freeListArray.size()) {
+          _freeListArray.resize (iSliceIdx + 1);
+        }
+        std::vector<Xapian::Database*>& lFreeList = _freeListArray[iSliceIdx];
+        if (lFreeList.empty() == false) {
+          Xapian::Database* oXapianDatabase_ptr = lFreeList.back();
+          lFreeList.pop_back();
+          return *oXapianDatabase_ptr;
+        }
+      }
+
+      // Otherwise, lease a new handle from the pool, seeing the same
+      // revision of the index as the default handle
+      Xapian::Database& oXapianDatabase =
+        _xapianDatabasePool->lease (_indexRevision);
+      boost::mutex::scoped_lock lGuard (_mutex);
+      _leasedList.push_back (&oXapianDatabase);
+      return oXapianDatabase;
+    }
+
+    /**
+     * Give back a handle, once the search of the given query slice is over.
+     */
+    void giveBack (const unsigned short iSliceIdx,
+                   const Xapian::Database& iXapianDatabase) {
+      if (_xapianDatabasePool == NULL) {
+        return;
+      }
+
+      boost::mutex::scoped_lock lGuard (_mutex);
+      for (std::vector<Xapian::Database*>::iterator itDatabase =
+             _leasedList.begin(); itDatabase != _leasedList.end();
+           ++itDatabase) {
+        Xapian::Database* lXapianDatabase_ptr = *itDatabase;
+        if (lXapianDatabase_ptr == &iXapianDatabase) {
+          assert (iSliceIdx < _freeListArray.size());
+          _freeListArray[iSliceIdx].push_back (lXapianDatabase_ptr);
+          return;
+        }
+      }
+      assert (false);
+    }
+
+    /**
+     * Get the enquire session of the given (leased) handle. It is created
+     * when first needed, and then kept until the end of the travel query.
+     */
+    Xapian::Enquire& getEnquire (const Xapian::Database& iXapianDatabase) {
+      boost::mutex::scoped_lock lGuard (_mutex);
+      EnquireMap_T::iterator itEnquire = _enquireMap.find (&iXapianDatabase);
+      if (itEnquire != _enquireMap.end()) {
+        Xapian::Enquire* oEnquire_ptr = itEnquire->second;
+        assert (oEnquire_ptr != NULL);
+        return *oEnquire_ptr;
+      }
+
+      Xapian::Enquire* oEnquire_ptr = new Xapian::Enquire (iXapianDatabase);
+      _enquireMap.insert (EnquireMap_T::value_type (&iXapianDatabase,
+                                                    oEnquire_ptr));
+      return *oEnquire_ptr;
+    }
+
+  private:
+    /**
+     * Enquire sessions, by handle.
+     */
+    typedef std::map<const Xapian::Database*, Xapian::Enquire*> EnquireMap_T;
+
+    /**
+     * Pool of handles (NULL when the searches are sequential).
+     */
+    XapianDatabasePool* _xapianDatabasePool;
+
+    /**
+     * Default handle, used when there is no pool.
+     */
+    const Xapian::Database& _defaultDatabase;
+
+    /**
+     * Revision of the index seen by the default handle, and expected from
+     * the handles leased from the pool.
+     */
+    IndexRevision_T _indexRevision;
+
+    /**
+     * For every query slice, handles leased for that query slice, and not
+     * used at the moment.
+     */
+    std::vector<std::vector<Xapian::Database*> > _freeListArray;
+
+    /**
+     * All the handles leased from the pool.
+     */
+    std::vector<Xapian::Database*> _leasedList;
+
+    /**
+     * Enquire sessions of the handles.
+     */
+    EnquireMap_T _enquireMap;
+
+    /**
+     * Mutex protecting the lists of handles.
+     */
+    boost::mutex _mutex;
+  };
+
+  /**
+   * @brief Resources and parameters shared by the searches of all the
+   *        slices of a travel query.
+   */
+  struct QuerySearchContext {
+    /**
+     * Memory scope of the travel query.
+     */
+    FacQueryScope* _queryScope;
+
+    /**
+     * Pool of threads (NULL when the searches are sequential).
+     */
+    BasThreadPool* _threadPool;
+
+    /**
+     * Xapian database handles.
+     */
+    QueryDatabaseSet* _databaseSet;
+
+    /**
+     * SQL database type (can be no database at all).
+     */
+    const DBType* _sqlDBType;
+
+    /**
+     * SQL database connection string.
+     */
+    const SQLDBConnectionString_T* _sqlDBConnStr;
+
+    /**
+     * Pool of SQL database connections (may be NULL).
+     */
+    soci::connection_pool* _sqlDBConnPool;
+
+    /**
+     * In-memory index of the POR by code (may be NULL).
+     */
+    const CodeIndex* _codeIndex;
+
+    /**
+     * Whether all the partitions of the query slices should be searched for.
+     */
+    ExhaustiveSearch_T _exhaustiveSearch;
+
+    /**
+     * Filter of the invalid POR (may be NULL).
+     */
+    const PORValidityDecider* _porValidityDecider;
+
+    /**
+     * In-memory spelling dictionary (may be NULL).
+     */
+    const SpellingDictionary* _spellingDictionary;
+
+    /**
+     * Vocabulary of the Xapian index (may be NULL).
+     */
+    const TermVocabulary* _termVocabulary;
+  };
+
+  /**
+   * @brief Search of a single travel query slice.
+   *
+   * The searches of the query slices are independent from one another:
+   * each of them fills its own lists of locations and of unmatched words,
+   * which are merged afterwards, in the order of the query slices.
+   */
+  struct SliceSearch {
+    /**
+     * Constructor.
+     */
+    SliceSearch (const QuerySearchContext& iContext,
+                 const unsigned short iSliceIdx,
+                 const TravelQuery_T& iQuerySlice,
+                 SliceExplanation* ioExplanation_ptr)
+      : _context (&iContext), _sliceIdx (iSliceIdx),
+        _querySlice (iQuerySlice), _explanation (ioExplanation_ptr) {
+    }
+
+    /**
+     * Resources and parameters shared with the other query slices.
+     */
+    const QuerySearchContext* _context;
+
+    /**
+     * Index of the query slice.
+     */
+    unsigned short _sliceIdx;
+
+    /**
+     * Query slice.
+     */
+    TravelQuery_T _querySlice;
+
+    /**
+     * List of (geographical) locations matching the query slice.
+     */
+    LocationList_T _locationList;
+
+    /**
+     * List of non-matched words of the query slice.
+     */
+    WordList_T _wordList;
+
+    /**
+     * Explanation of the search of the query slice (NULL when the search
+     * is not to be explained).
+     */
+    SliceExplanation* _explanation;
+  };
+
+  /**
+   * Run the given tasks on the given pool of threads or, when there is
+   * no pool (or a single task), sequentially within the calling thread.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  void runTasks (BasThreadPool* ioThreadPool_ptr,
+                 const BasThreadPool::TaskList_T& iTaskList) {
+    if (ioThreadPool_ptr != NULL && iTaskList.size() > 1) {
+      ioThreadPool_ptr->run (iTaskList);
+      return;
+    }
+
+    for (BasThreadPool::TaskList_T::const_iterator itTask = iTaskList.begin();
+         itTask != iTaskList.end(); ++itTask) {
+      const BasThreadPool::Task_T& lTask = *itTask;
+      lTask();
+    }
+  }
+
+  /**
+   * @brief Full-text match of a word combination of a query slice.
+   */
+  struct WordCombinationMatch {
+    /**
+     * Constructor.
+     */
+    WordCombinationMatch() : _result (NULL), _hasFailed (false) {
+    }
+
+    /**
+     * Word combination to be matched.
+     */
+    TravelQuery_T _queryString;
+
+    /**
+     * Result object, holding the matching documents.
+     */
+    Result* _result;
+
+    /**
+     * Matched string (empty when the word combination is unknown by Xapian).
+     */
+    std::string _matchedString;
+
+    /**
+     * Whether the full-text match has failed, and the corresponding
+     * Xapian error message.
+     */
+    bool _hasFailed;
+    std::string _errorMessage;
+
+    /**
+     * Any other exception thrown by the full-text match, to be re-thrown
+     * by the calling thread.
+     */
+    boost::exception_ptr _exception;
+  };
+
+  /**
+   * Perform the Xapian-based full-text match of the given word combination,
+   * and calculate the weights of the matching documents.
+   *
+   * That function may be run by any thread: the Result object is owned
+   * by the memory scope of the travel query, and the full-text match
+   * is performed on a Xapian database handle leased for that purpose.
+   * The Xapian errors, as well as any other exception (e.g.,
+   * std::bad_alloc), are recorded within the given WordCombinationMatch
+   * structure, so that they be reported by the calling thread. The leased
+   * handle is given back in any case.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  void matchWordCombination (const QuerySearchContext* iContext_ptr,
+                             const unsigned short iSliceIdx,
+                             WordCombinationMatch* ioMatch_ptr) {
+    assert (iContext_ptr != NULL && ioMatch_ptr != NULL);
+    const FacQueryScope lTaskScope (iContext_ptr->_queryScope);
+    QueryDatabaseSet& lDatabaseSet = *iContext_ptr->_databaseSet;
+    const TravelQuery_T& lQueryString = ioMatch_ptr->_queryString;
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("    --------");
+    OPENTREP_LOG_DEBUG ("    Query string: '" << lQueryString << "'");
+
+    const Xapian::Database& lDatabase = lDatabaseSet.lease (iSliceIdx);
+    try {
+      // Enquire session of the leased handle
+      Xapian::Enquire& lEnquire = lDatabaseSet.getEnquire (lDatabase);
+
+      // Create an empty Result object
+      Result& lResult = FacResult::instance().create (lQueryString, lDatabase);
+      ioMatch_ptr->_result = &lResult;
+
+      // Perform the Xapian-based full-text match: the set of
+      // matching documents is filled.
+      SearchStageTimer lMatchingTimer (SearchStage::FULL_TEXT_MATCHING);
+      ioMatch_ptr->_matchedString =
+        lResult.fullTextMatch (lDatabase, lQueryString,
+                               iContext_ptr->_porValidityDecider,
+                               iContext_ptr->_spellingDictionary,
+                               iContext_ptr->_termVocabulary, lEnquire);
+      lMatchingTimer.stop();
+
+      // Calculate/set all the weights for the matching documents
+      const SearchStageTimer lWeightTimer (SearchStage::WEIGHT_CALCULATION);
+      lResult.calculateAllWeights();
+
+    } catch (const Xapian::Error& error) {
+      ioMatch_ptr->_hasFailed = true;
+      ioMatch_ptr->_errorMessage = error.get_msg();
+
+    } catch (...) {
+      ioMatch_ptr->_exception = boost::current_exception();
+    }
+    lDatabaseSet.giveBack (iSliceIdx, lDatabase);
+  }
   
   /**
    * For all the elements (StringSet) of the string partitions, derived
@@ -122,16 +654,26 @@ namespace OPENTREP {
    * matches, some with the highest matching percentage and some with a
    * lower percentage.
    *
-   * @param TravelQuery_T& The query string.
+   * \note As there are 2^(n-1) string partitions for a n-word query slice,
+   *       that exhaustive search is used only for comparison purposes.
+   *       \see searchString() for the default search.
+   *
+   * @param const StringPartition& The string partitions of the query string.
    * @param const Xapian::Database& The Xapian index/database.
+   * @param const PORValidityDecider* Filter of the invalid POR (may be NULL).
+   * @param const SpellingDictionary* Spelling dictionary (may be NULL).
+   * @param const TermVocabulary* Vocabulary of the index (may be NULL).
    * @param ResultCombination& List of ResultHolder objects.
    * @param WordList_T& List of non-matched words of the query string.
    */
   // //////////////////////////////////////////////////////////////////////
-  void searchString (const StringPartition& iStringPartition,
-                     const Xapian::Database& iDatabase,
-                     ResultCombination& ioResultCombination,
-                     WordList_T& ioWordList) {
+  void searchStringExhaustively (const StringPartition& iStringPartition,
+                                 const Xapian::Database& iDatabase,
+                                 const PORValidityDecider* iValidityDecider_ptr,
+                                 const SpellingDictionary* iDictionary_ptr,
+                                 const TermVocabulary* iVocabulary_ptr,
+                                 ResultCombination& ioResultCombination,
+                                 WordList_T& ioWordList) {
 
     // Catch any thrown Xapian::Error exceptions
     try {
@@ -139,6 +681,9 @@ namespace OPENTREP {
       // Set of unknown words (just to eliminate the duplicates)
       WordSet_T lWordSet;
 
+      // Enquire session, re-used by all the full-text matches
+      Xapian::Enquire lEnquire (iDatabase);
+
       // Browse the partitions
       for (StringPartition::StringPartition_T::const_iterator itSet =
              iStringPartition._partition.begin();
@@ -177,8 +722,12 @@ namespace OPENTREP {
 
           // Perform the Xapian-based full-text match: the set of
           // matching documents is filled.
+          SearchStageTimer lMatchingTimer (SearchStage::FULL_TEXT_MATCHING);
           const std::string& lMatchedString =
-            lResult.fullTextMatch (iDatabase, lQueryString);
+            lResult.fullTextMatch (iDatabase, lQueryString,
+                                   iValidityDecider_ptr, iDictionary_ptr,
+                                   iVocabulary_ptr, lEnquire);
+          lMatchingTimer.stop();
 
           // When a single-word string is unmatched/unknown by/from Xapian,
           // add it to the dedicated list (i.e., ioWordList).
@@ -206,6 +755,259 @@ namespace OPENTREP {
     }
   }
 
+  /**
+   * For all the distinct word combinations (i.e., contiguous sub-strings)
+   * of the given travel query slice, perform a Xapian-based full-text
+   * match, and calculate the corresponding weights. Each distinct word
+   * combination is searched for only once.
+   *
+   * The weight of a string partition, as calculated by
+   * ResultHolder::calculateCombinedWeights(), is the product of the
+   * weights of its word combinations, each of them being attenuated by
+   * K_DEFAULT_ATTENUATION_FCTR when there are several of them. The best
+   * string partition is therefore found by dynamic programming, in
+   * O(n^2) steps for a n-word query slice, rather than by going through
+   * the 2^(n-1) string partitions.
+   *
+   * Only the ResultHolder object corresponding to that best string
+   * partition is created and added to the given ResultCombination object.
+   * When several string partitions have the same weight, the first one,
+   * in the order of StringPartition, is selected, as with the exhaustive
+   * search.
+   *
+   * The full-text matches of the word combinations are independent from
+   * one another: they are run in parallel, when a pool of threads is given.
+   *
+   * @param const TravelQuery_T& The query slice.
+   * @param const QuerySearchContext& Resources of the travel query.
+   * @param const unsigned short Index of the query slice.
+   * @param ResultCombination& List of ResultHolder objects.
+   * @param WordList_T& List of non-matched words of the query string.
+   * @param SliceExplanation* Explanation of the search of the query slice,
+   *        in which the word combinations and the string partitions
+   *        evaluated are recorded (NULL when not to be explained).
+   */
+  // //////////////////////////////////////////////////////////////////////
+  void searchString (const TravelQuery_T& iQuerySlice,
+                     const QuerySearchContext& iContext,
+                     const unsigned short iSliceIdx,
+                     ResultCombination& ioResultCombination,
+                     WordList_T& ioWordList,
+                     SliceExplanation* ioExplanation_ptr) {
+
+    // Catch any thrown Xapian::Error exceptions
+    try {
+      
+      // Set of unknown words (just to eliminate the duplicates)
+      WordSet_T lWordSet;
+
+      // Token-ise the query slice
+      WordList_T lWordList;
+      WordHolder::tokeniseStringIntoWordList (iQuerySlice, lWordList);
+      const std::vector<std::string> lWordArray (lWordList.begin(),
+                                                 lWordList.end());
+      const unsigned short nbOfWords = lWordArray.size();
+      if (nbOfWords == 0) {
+        return;
+      }
+
+      /**
+       * 1. Full-text match of all the distinct word combinations.
+       *
+       * The word combination made of the words [idx_start, idx_end[ is
+       * stored at the (idx_start * nbOfWords + idx_end - 1) index.
+       */
+      std::vector<WordCombinationMatch> lMatchArray (nbOfWords * nbOfWords);
+      BasThreadPool::TaskList_T lTaskList;
+      for (unsigned short idx_start = 0; idx_start != nbOfWords; ++idx_start) {
+        std::string lQueryString;
+        for (unsigned short idx_end = idx_start + 1; idx_end <= nbOfWords;
+             ++idx_end) {
+          // Extend the word combination with the next word
+          if (idx_end > idx_start + 1) {
+            lQueryString += " ";
+          }
+          lQueryString += lWordArray[idx_end - 1];
+
+          const unsigned int lIdx = idx_start * nbOfWords + idx_end - 1;
+          WordCombinationMatch& lMatch = lMatchArray[lIdx];
+          lMatch._queryString = lQueryString;
+          lTaskList.push_back (boost::bind (&matchWordCombination, &iContext,
+                                            iSliceIdx, &lMatch));
+        }
+      }
+      runTasks (iContext._threadPool, lTaskList);
+
+      // Collect the results, in the order of the word combinations
+      std::vector<Result*> lResultArray (nbOfWords * nbOfWords, NULL);
+      std::vector<Percentage_T> lWeightArray (nbOfWords * nbOfWords, 0.0);
+      for (unsigned short idx_start = 0; idx_start != nbOfWords; ++idx_start) {
+        for (unsigned short idx_end = idx_start + 1; idx_end <= nbOfWords;
+             ++idx_end) {
+          const unsigned int lIdx = idx_start * nbOfWords + idx_end - 1;
+          const WordCombinationMatch& lMatch = lMatchArray[lIdx];
+          if (lMatch._hasFailed == true) {
+            OPENTREP_LOG_ERROR ("Exception: "  << lMatch._errorMessage);
+            throw XapianException (lMatch._errorMessage);
+          }
+          if (lMatch._exception) {
+            boost::rethrow_exception (lMatch._exception);
+          }
+
+          // When a single-word string is unmatched/unknown by/from Xapian,
+          // add it to the dedicated list (i.e., ioWordList).
+          if (lMatch._matchedString.empty() == true) {
+            OPENTREP::addUnmatchedWord (lMatch._queryString, ioWordList,
+                                        lWordSet);
+          }
+
+          Result* lResult_ptr = lMatch._result;
+          assert (lResult_ptr != NULL);
+          lResultArray[lIdx] = lResult_ptr;
+          lWeightArray[lIdx] = lResult_ptr->getBestCombinedWeight() / 100.0;
+
+          if (ioExplanation_ptr != NULL) {
+            WordCombinationExplanation lString;
+            explainResult (*lResult_ptr, lString);
+            ioExplanation_ptr->_wordCombinationList.push_back (lString);
+          }
+        }
+      }
+
+      // The best string partition is found by dynamic programming: every
+      // word combination is evaluated as the first one of a suffix
+      const SearchStageTimer lPartitioningTimer (SearchStage::PARTITIONING);
+      StatisticsRecorder::increment (SearchCounter::PARTITIONS,
+                                     nbOfWords * (nbOfWords + 1) / 2);
+
+      /**
+       * 2. Best partition of every suffix [idx_start, nbOfWords[ of the
+       *    query slice, when that latter is made of several word
+       *    combinations (each of them being attenuated).
+       *
+       * The suffixes are browsed backwards and, for a given suffix, the
+       * first word combination is browsed by increasing length, so that
+       * the first best string partition, in the order of StringPartition,
+       * be selected.
+       */
+      std::vector<Percentage_T> lSuffixWeightArray (nbOfWords + 1, 0.0);
+      std::vector<unsigned short> lSuffixSplitArray (nbOfWords + 1, nbOfWords);
+      lSuffixWeightArray[nbOfWords] = 1.0;
+      for (short idx_start = nbOfWords - 1; idx_start >= 0; --idx_start) {
+        for (unsigned short idx_end = idx_start + 1; idx_end <= nbOfWords;
+             ++idx_end) {
+          const unsigned int lIdx = idx_start * nbOfWords + idx_end - 1;
+          const Percentage_T lWeight = lWeightArray[lIdx]
+            / K_DEFAULT_ATTENUATION_FCTR * lSuffixWeightArray[idx_end];
+          if (lWeight > lSuffixWeightArray[idx_start]) {
+            lSuffixWeightArray[idx_start] = lWeight;
+            lSuffixSplitArray[idx_start] = idx_end;
+          }
+        }
+      }
+
+      /**
+       * 3. Best partition of the whole query slice. The query slice as
+       *    a whole comes last (it is not attenuated).
+       */
+      unsigned short lFirstSplit = 0;
+      Percentage_T lBestWeight = 0.0;
+      for (unsigned short idx_end = 1; idx_end < nbOfWords; ++idx_end) {
+        const unsigned int lIdx = idx_end - 1;
+        const Percentage_T lWeight = lWeightArray[lIdx]
+          / K_DEFAULT_ATTENUATION_FCTR * lSuffixWeightArray[idx_end];
+        if (lWeight > lBestWeight) {
+          lBestWeight = lWeight;
+          lFirstSplit = idx_end;
+        }
+      }
+      const Percentage_T& lWholeWeight = lWeightArray[nbOfWords - 1];
+      if (lFirstSplit == 0 || lWholeWeight > lBestWeight) {
+        lFirstSplit = nbOfWords;
+      }
+
+      // Record the candidates compared above, i.e., for every length of
+      // the first word combination, the best string partition starting
+      // with it
+      if (ioExplanation_ptr != NULL) {
+        for (unsigned short idx_split = 1; idx_split <= nbOfWords;
+             ++idx_split) {
+          PartitionExplanation lPartition;
+          for (unsigned short idx_start = 0, idx_end = idx_split;
+               idx_start != nbOfWords;
+               idx_start = idx_end, idx_end = lSuffixSplitArray[idx_end]) {
+            const unsigned int lIdx = idx_start * nbOfWords + idx_end - 1;
+            lPartition._wordCombinationList.
+              push_back (lMatchArray[lIdx]._queryString);
+          }
+          lPartition._weight = lWeightArray[idx_split - 1]
+            * lSuffixWeightArray[idx_split] * 100.0;
+          if (idx_split != nbOfWords) {
+            lPartition._weight /= K_DEFAULT_ATTENUATION_FCTR;
+          }
+          ioExplanation_ptr->_partitionList.push_back (lPartition);
+        }
+      }
+
+      /**
+       * 4. Create the ResultHolder object corresponding to the best
+       *    string partition.
+       */
+      std::vector<Result*> lBestResultList;
+      StringSet lBestStringSet;
+      for (unsigned short idx_start = 0, idx_end = lFirstSplit;
+           idx_start != nbOfWords;
+           idx_start = idx_end, idx_end = lSuffixSplitArray[idx_end]) {
+        const unsigned int lIdx = idx_start * nbOfWords + idx_end - 1;
+        Result* lResult_ptr = lResultArray[lIdx];
+        assert (lResult_ptr != NULL);
+        lBestResultList.push_back (lResult_ptr);
+        lBestStringSet.push_back (lResult_ptr->getQueryString());
+      }
+
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("  ==========");
+      OPENTREP_LOG_DEBUG ("  String set: " << lBestStringSet);
+
+      // Create a ResultHolder object.
+      const Xapian::Database& lDatabase =
+        iContext._databaseSet->lease (iSliceIdx);
+      ResultHolder& lResultHolder =
+        FacResultHolder::instance().create (lBestStringSet.describe(),
+                                            lDatabase);
+      iContext._databaseSet->giveBack (iSliceIdx, lDatabase);
+
+      // Add the ResultHolder object to the dedicated list.
+      FacResultCombination::initLinkWithResultHolder (ioResultCombination,
+                                                      lResultHolder);
+
+      // Add the Result objects of the best string partition
+      for (std::vector<Result*>::const_iterator itResult =
+             lBestResultList.begin();
+           itResult != lBestResultList.end(); ++itResult) {
+        Result* lResult_ptr = *itResult;
+        assert (lResult_ptr != NULL);
+        FacResultHolder::initLinkWithResult (lResultHolder, *lResult_ptr);
+      }
+
+      // Calculate the weight of the string partition
+      lResultHolder.calculateCombinedWeights();
+
+      // DEBUG
+      OPENTREP_LOG_DEBUG (std::endl
+                          << "========================================="
+                          << std::endl << "Result holder: "
+                          << lResultHolder.toString() << std::endl
+                          << "========================================="
+                          << std::endl << std::endl);
+
+    } catch (const Xapian::Error& error) {
+      // Error
+      OPENTREP_LOG_ERROR ("Exception: "  << error.get_msg());
+      throw XapianException (error.get_msg());
+    }
+  }
+
   /**
    * Select the best matching string partition, based on the results of
    * several rules, that are all materialised by weighting percentages:
@@ -263,16 +1065,13 @@ namespace OPENTREP {
       const std::string& lWord = *itWord;
 
       // IATA code: alpha{3}
-      const boost::regex lIATACodeExp ("^[[:alpha:]]{3}$");
-      const bool lMatchesWithIATACode = regex_match (lWord, lIATACodeExp);
+      const bool lMatchesWithIATACode = isIATACode (lWord);
 
       // ICAO code: (alpha|digit){4}
-      const boost::regex lICAOCodeExp ("^([[:alpha:]]|[[:digit:]]){4}$");
-      const bool lMatchesWithICAOCode = regex_match (lWord, lICAOCodeExp);
+      const bool lMatchesWithICAOCode = isICAOCode (lWord);
 
       // Geonames ID: digit{1,11}
-      const boost::regex lGeoIDCodeExp ("^[[:digit:]]{1,11}$");
-      const bool lMatchesWithGeoID = regex_match (lWord, lGeoIDCodeExp);
+      const bool lMatchesWithGeoID = isGeonamesID (lWord);
 
       // If the word is neither a IATA/ICAO code or a Geonames ID,
       // there is nothing more to be done at that stage. The query string
@@ -294,6 +1093,7 @@ namespace OPENTREP {
    *
    * @param const DBType& SQL database type (can be no database at all).
    * @param const SQLDBConnectionString_T& SQL DB connection string.
+   * @param soci::connection_pool* Pool of SQL database connections.
    * @param const WordList_T& List of IATA/ICAO codes or Geonames ID (e.g.,
    *        "sna 5391989 6299418 los chi par rio lso rek lfmn iev mow").
    * @param LocationList_T& The matching (geographical) locations, if any,
@@ -304,15 +1104,14 @@ namespace OPENTREP {
   // //////////////////////////////////////////////////////////////////////
   NbOfMatches_T getLocationList (const DBType& iSQLDBType,
                                  const SQLDBConnectionString_T& iSQLDBConnStr,
+                                 soci::connection_pool* ioSQLDBConnPool_ptr,
                                  const WordList_T& iCodeList,
                                  LocationList_T& ioLocationList,
                                  WordList_T& ioWordList) {
     NbOfMatches_T oNbOfMatches = 0;
 
-    // Connect to the SQL database/file
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (iSQLDBType, iSQLDBConnStr);
-    if (lSociSession_ptr == NULL) {
+    // Check that the SQL database/file is accessible
+    if (ioSQLDBConnPool_ptr == NULL) {
       std::ostringstream oStr;
       oStr << "The " << iSQLDBType.describe()
            << " database is not accessible. Connection string: "
@@ -322,7 +1121,12 @@ namespace OPENTREP {
       OPENTREP_LOG_ERROR (oStr.str());
       throw SQLDatabaseImpossibleConnectionException (oStr.str());
     }
-    assert (lSociSession_ptr != NULL);
+    assert (ioSQLDBConnPool_ptr != NULL);
+
+    // Lease a connection from the pool. It is given back to the pool
+    // when the session goes out of scope.
+    const SearchStageTimer lSQLLookupTimer (SearchStage::SQL_LOOKUP);
+    soci::session lSociSession (*ioSQLDBConnPool_ptr);
 
     // Browse the list of words/items
     for (WordList_T::const_iterator itWord = iCodeList.begin();
@@ -330,35 +1134,34 @@ namespace OPENTREP {
       const std::string& lWord = *itWord;
 
       // Check for IATA code: alpha{3}
-      const boost::regex lIATACodeExp ("^[[:alpha:]]{3}$");
-      const bool lMatchesWithIATACode = regex_match (lWord, lIATACodeExp);
+      const bool lMatchesWithIATACode = isIATACode (lWord);
       if (lMatchesWithIATACode == true) {
         // Perform the select statement on the underlying SQL database
         const IATACode_T lIATACode (lWord);
         const bool lUniqueEntry = true;
+        StatisticsRecorder::increment (SearchCounter::SQL_LOOKUPS);
         const NbOfDBEntries_T& lNbOfEntries =
-          DBManager::getPORByIATACode (*lSociSession_ptr, lIATACode,
+          DBManager::getPORByIATACode (lSociSession, lIATACode,
                                        ioLocationList, lUniqueEntry);
         oNbOfMatches += lNbOfEntries;
         continue;
       }
 
       // Check for ICAO code: (alpha|digit){4}
-      const boost::regex lICAOCodeExp ("^([[:alpha:]]|[[:digit:]]){4}$");
-      const bool lMatchesWithICAOCode = regex_match (lWord, lICAOCodeExp);
+      const bool lMatchesWithICAOCode = isICAOCode (lWord);
       if (lMatchesWithICAOCode == true) {
         // Perform the select statement on the underlying SQL database
         const ICAOCode_T lICAOCode (lWord);
+        StatisticsRecorder::increment (SearchCounter::SQL_LOOKUPS);
         const NbOfDBEntries_T& lNbOfEntries =
-          DBManager::getPORByICAOCode (*lSociSession_ptr, lICAOCode,
+          DBManager::getPORByICAOCode (lSociSession, lICAOCode,
                                        ioLocationList);
         oNbOfMatches += lNbOfEntries;
         continue;
       }
 
       // Check for Geonames ID: digit{1,11}
-      const boost::regex lGeoIDCodeExp ("^[[:digit:]]{1,11}$");
-      const bool lMatchesWithGeoID = regex_match (lWord, lGeoIDCodeExp);
+      const bool lMatchesWithGeoID = isGeonamesID (lWord);
       if (lMatchesWithGeoID == true) {
         try {
           // Convert the character string into a number
@@ -366,8 +1169,9 @@ namespace OPENTREP {
             boost::lexical_cast<GeonamesID_T> (lWord);
           
           // Perform the select statement on the underlying SQL database
+          StatisticsRecorder::increment (SearchCounter::SQL_LOOKUPS);
           const NbOfDBEntries_T& lNbOfEntries =
-            DBManager::getPORByGeonameID (*lSociSession_ptr, lGeonamesID,
+            DBManager::getPORByGeonameID (lSociSession, lGeonamesID,
                                           ioLocationList);
           oNbOfMatches += lNbOfEntries;
 
@@ -381,43 +1185,325 @@ namespace OPENTREP {
     return oNbOfMatches;
   }
 
+  /**
+   * Return the list of locations/places corresponding to the given
+   * IATA/ICAO codes or Geonames IDs, as found within the in-memory index
+   * of the POR by code.
+   *
+   * The locations are added only when every code has been found. Otherwise,
+   * the travel query is left to the full-text search (e.g., "lviv" has got
+   * the shape of a ICAO code, but is the name of a city).
+   *
+   * The locations are added only when they are all valid, as well.
+   * Otherwise, the travel query is left to the full-text search, which
+   * filters out the invalid POR.
+   *
+   * @param const CodeIndex& In-memory index of the POR by code.
+   * @param const PORValidityDecider* Filter of the invalid POR (may be NULL).
+   * @param const WordList_T& List of IATA/ICAO codes or Geonames ID (e.g.,
+   *        "sna 5391989 6299418 los chi par rio lso rek lfmn iev mow").
+   * @param LocationList_T& The matching (geographical) locations, if any,
+   *                        are added to that list.
+   * @return NbOfMatches_T Number of matches (0 when some code is unknown).
+   */
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T getLocationList (const CodeIndex& iCodeIndex,
+                                 const PORValidityDecider* iValidityDecider_ptr,
+                                 const WordList_T& iCodeList,
+                                 LocationList_T& ioLocationList) {
+    NbOfMatches_T oNbOfMatches = 0;
+    LocationList_T lLocationList;
+
+    // Browse the list of words/items
+    for (WordList_T::const_iterator itWord = iCodeList.begin();
+         itWord != iCodeList.end(); ++itWord) {
+      const std::string& lWord = *itWord;
+      NbOfMatches_T lNbOfEntries = 0;
+
+      if (isIATACode (lWord) == true) {
+        // IATA code: alpha{3}
+        lNbOfEntries = iCodeIndex.getPORByIATACode (lWord, lLocationList);
+
+      } else if (isICAOCode (lWord) == true) {
+        // ICAO code: (alpha|digit){4}
+        lNbOfEntries = iCodeIndex.getPORByICAOCode (lWord, lLocationList);
+
+      } else if (isGeonamesID (lWord) == true) {
+        // Geonames ID: digit{1,11}
+        try {
+          const GeonamesID_T lGeonamesID =
+            boost::lexical_cast<GeonamesID_T> (lWord);
+          lNbOfEntries = iCodeIndex.getPORByGeonameID (lGeonamesID,
+                                                       lLocationList);
+
+        } catch (boost::bad_lexical_cast& eCast) {
+          OPENTREP_LOG_ERROR ("The Geoname ID ('" << lWord
+                              << "') cannot be understood.");
+        }
+      }
+
+      // The code is unknown: the full-text search has to be performed
+      if (lNbOfEntries == 0) {
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("'" << lWord << "' is not a known code");
+        return 0;
+      }
+      oNbOfMatches += lNbOfEntries;
+    }
+
+    // Some location is not valid: the full-text search has to be performed
+    if (iValidityDecider_ptr != NULL
+        && iValidityDecider_ptr->isActive() == true) {
+      for (LocationList_T::const_iterator itLocation = lLocationList.begin();
+           itLocation != lLocationList.end(); ++itLocation) {
+        const Location& lLocation = *itLocation;
+        if (iValidityDecider_ptr->isValid (lLocation) == false) {
+          // DEBUG
+          OPENTREP_LOG_DEBUG ("'" << lLocation.getKey() << "' is not valid");
+          return 0;
+        }
+      }
+    }
+
+    ioLocationList.insert (ioLocationList.end(), lLocationList.begin(),
+                           lLocationList.end());
+    return oNbOfMatches;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestInterpreter::interpretTravelQuerySlice (SliceSearch* ioSlice_ptr) {
+    assert (ioSlice_ptr != NULL);
+    SliceSearch& lSlice = *ioSlice_ptr;
+    const QuerySearchContext& lContext = *lSlice._context;
+    const DBType& lSQLDBType = *lContext._sqlDBType;
+    const SQLDBConnectionString_T& lSQLDBConnStr = *lContext._sqlDBConnStr;
+    const std::string& lTravelQuerySlice = lSlice._querySlice;
+    LocationList_T& ioLocationList = lSlice._locationList;
+    WordList_T& ioWordList = lSlice._wordList;
+    SliceExplanation* lExplanation_ptr = lSlice._explanation;
+
+    // The BOM objects instantiated by the thread, which searches for that
+    // query slice, are owned by the memory scope of the travel query
+    const FacQueryScope lSliceScope (lContext._queryScope);
+
+    /**
+     * 0. Initialisation
+     *
+     * Create a ResultCombination BOM instance.
+     */
+    ResultCombination& lResultCombination =
+      FacResultCombination::instance().create (lTravelQuerySlice);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("+++++++++++++++++++++");
+    OPENTREP_LOG_DEBUG ("Travel query slice: `" << lTravelQuerySlice << "'");
+
+
+    /**
+     * 1.0. Check whether the travel query is made only of IATA/ICAO codes
+     *      and Geonames ID.
+     */
+    WordList_T lCodeList;
+    const bool areAllWordsCodes =
+      areAllCodeOrGeoID (lTravelQuerySlice, lCodeList);
+
+    NbOfMatches_T lNbOfMatches = 0;
+    if (areAllWordsCodes == true && lContext._codeIndex != NULL) {
+      /**
+       * All the words/items of the travel query are either IATA/ICAO codes
+       * or Geonames ID. The corresponding details are retrieved from the
+       * in-memory index of the POR by code. Neither the SQL database nor
+       * the Xapian database/index is used.
+       */
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("The travel query string (" << lTravelQuerySlice
+                          << ") is made only of IATA/ICAO codes "
+                          << "or Geonames ID. The in-memory index of the POR "
+                          << "by code will be used");
+
+      lNbOfMatches = OPENTREP::getLocationList (*lContext._codeIndex,
+                                                lContext._porValidityDecider,
+                                                lCodeList, ioLocationList);
+      if (lExplanation_ptr != NULL && lNbOfMatches != 0) {
+        lExplanation_ptr->_searchMethod = SearchMethod::CODE_INDEX;
+      }
+
+    } else if (areAllWordsCodes == true && !(lSQLDBType == DBType::NODB)
+               && lContext._porValidityDecider->isActive() == false) {
+      /**
+       * All the words/items of the travel query are either IATA/ICAO codes
+       * or Geonames ID. The corresponding details will be retrieved directly
+       * from the underlying database, if existing.
+       * The Xapian database/index is not used. When some POR are to be
+       * filtered out, the Xapian database/index is used instead.
+       */
+      // DEBUG
+      OPENTREP_LOG_DEBUG ("The travel query string (" << lTravelQuerySlice
+                          << ") is made only of IATA/ICAO codes "
+                          << "or Geonames ID. The " << lSQLDBType.describe()
+                          << " SQL database (" << lSQLDBConnStr
+                          << ") will be used. "
+                          << "The Xapian database will not be used");
+
+      lNbOfMatches = OPENTREP::getLocationList (lSQLDBType, lSQLDBConnStr,
+                                                lContext._sqlDBConnPool,
+                                                lCodeList,
+                                                ioLocationList, ioWordList);
+      if (lExplanation_ptr != NULL && lNbOfMatches != 0) {
+        lExplanation_ptr->_searchMethod = SearchMethod::SQL_DATABASE;
+      }
+    }
+
+    if (lNbOfMatches == 0) {
+      /**
+       * <ul>
+       *   <li>Some of the words/items of the travel query are neither
+       *        IATA/ICAO codes nor Geonames ID;</li>
+       *   <li>or there is no underlying SQL database;</li>
+       *   <li>or the word/item is 3/4-character long but is not
+       *       a IATA/ICAO code (e.g., lviv)</li>
+       * </ul>
+       * The Xapian database/index must therefore be used.
+       */
+      // DEBUG
+      if (lSQLDBType == DBType::NODB) {
+        OPENTREP_LOG_DEBUG ("No SQL database may be used. "
+                            << "The Xapian database will be used instead");
+      } else {
+        OPENTREP_LOG_DEBUG ("The travel query string (" << lTravelQuerySlice
+                            << ") has got items/words, which are neither "
+                            << "IATA/ICAO codes nor Geonames ID. "
+                            << "The Xapian database/index will be used");
+      }
+
+      if (lContext._exhaustiveSearch == true) {
+        // Calculate all the partitions of the query slice
+        SearchStageTimer lPartitioningTimer (SearchStage::PARTITIONING);
+        const StringPartition lStringPartition (lTravelQuerySlice);
+        lPartitioningTimer.stop();
+        StatisticsRecorder::increment (SearchCounter::PARTITIONS,
+                                       lStringPartition._partition.size());
+
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("Partitions: " << lStringPartition);
+
+        /**
+         * 1.1. Perform all the full-text matches, and fill accordingly
+         *      the list of Result instances.
+         */
+        QueryDatabaseSet& lDatabaseSet = *lContext._databaseSet;
+        const Xapian::Database& lDatabase = lDatabaseSet.lease (lSlice._sliceIdx);
+        OPENTREP::searchStringExhaustively (lStringPartition, lDatabase,
+                                            lContext._porValidityDecider,
+                                            lContext._spellingDictionary,
+                                            lContext._termVocabulary,
+                                            lResultCombination, ioWordList);
+        lDatabaseSet.giveBack (lSlice._sliceIdx, lDatabase);
+
+        /**
+         * 1.2. Calculate/set all the weights for all the matching
+         *      documents
+         */
+        const SearchStageTimer lWeightTimer (SearchStage::WEIGHT_CALCULATION);
+        lResultCombination.calculateAllWeights();
+
+        if (lExplanation_ptr != NULL) {
+          lExplanation_ptr->_searchMethod = SearchMethod::EXHAUSTIVE_FULL_TEXT;
+        }
+
+      } else {
+        /**
+         * 1. Perform the full-text matches of all the distinct word
+         *    combinations, calculate their weights, and keep only
+         *    the best string partition.
+         */
+        OPENTREP::searchString (lTravelQuerySlice, lContext, lSlice._sliceIdx,
+                                lResultCombination, ioWordList,
+                                lExplanation_ptr);
+      }
+
+      /**
+       * 2. Calculate the best matching scores / weighting percentages.
+       */
+      OPENTREP::chooseBestMatchingResultHolder (lResultCombination);
+
+      if (lExplanation_ptr != NULL) {
+        const bool shouldRecordPartitions = lContext._exhaustiveSearch;
+        explainResultCombination (lResultCombination, shouldRecordPartitions,
+                                  *lExplanation_ptr);
+      }
+
+      /**
+       * 3. Create the list of Place objects, for each of which a
+       *    look-up is made in the SQL database (e.g., MySQL or Oracle)
+       *    to retrieve complementary data.
+       */
+      // Create a PlaceHolder object, to collect the matching Place objects
+      const SearchStageTimer lPlaceTimer (SearchStage::PLACE_CREATION);
+      PlaceHolder& lPlaceHolder = FacPlaceHolder::instance().create();
+      createPlaces (lResultCombination, lPlaceHolder);
+      
+      // DEBUG
+      OPENTREP_LOG_DEBUG (std::endl
+                          << "========================================="
+                          << std::endl << "Summary:" << std::endl
+                          << lPlaceHolder.toShortString() << std::endl
+                          << "========================================="
+                          << std::endl);
+
+      /**
+       * 4. Create a list of Location structures, which are light copies
+       *    of the Place objects, and add them to the given list.
+       */
+      lPlaceHolder.createLocations (ioLocationList);
+    }
+  }
+
   // //////////////////////////////////////////////////////////////////////
   NbOfMatches_T RequestInterpreter::
-  interpretTravelRequest (const TravelDBFilePath_T& iTravelDBFilePath,
+  interpretTravelRequest (const Xapian::Database& iXapianDatabase,
                           const DBType& iSQLDBType,
                           const SQLDBConnectionString_T& iSQLDBConnStr,
+                          soci::connection_pool* ioSQLDBConnPool_ptr,
+                          BasThreadPool* ioThreadPool_ptr,
+                          XapianDatabasePool* ioXapianDatabasePool_ptr,
+                          const WordPairTable* iWordPairTable_ptr,
+                          const SpellingDictionary* iSpellingDictionary_ptr,
+                          const TermVocabulary* iTermVocabulary_ptr,
+                          const CodeIndex* iCodeIndex_ptr,
                           const TravelQuery_T& iTravelQuery,
                           LocationList_T& ioLocationList,
                           WordList_T& ioWordList,
-                          const OTransliterator& iTransliterator) {
+                          const OTransliterator& iTransliterator,
+                          const ExhaustiveSearch_T& iExhaustiveSearch,
+                          const ExpiredPORFiltering_T& iExpiredPORFiltering,
+                          const Date_T& iValidityDate,
+                          SearchExplanation* ioExplanation_ptr) {
     NbOfMatches_T oNbOfMatches = 0;
 
     // Sanity check
     assert (iTravelQuery.empty() == false);
 
-    // Check whether the file-path to the Xapian database/index exists
-    // and is a directory.
-    boost::filesystem::path lTravelDBFilePath (iTravelDBFilePath.begin(),
-                                               iTravelDBFilePath.end());
-    if (!(boost::filesystem::exists (lTravelDBFilePath)
-          && boost::filesystem::is_directory (lTravelDBFilePath))) {
-      std::ostringstream oStr;
-      oStr << "The file-path to the Xapian database/index ('"
-           << iTravelDBFilePath << "') does not exist or is not a directory.";
-      OPENTREP_LOG_ERROR (oStr.str());
-      throw FileNotFoundException (oStr.str());
-    }
+    // The Xapian database handles used by the searches must outlive the
+    // BOM objects (e.g., Result), which refer to them. Hence, they are
+    // given back only once the query scope below has ended.
+    QueryDatabaseSet lDatabaseSet (ioXapianDatabasePool_ptr, iXapianDatabase);
 
-    // Open the Xapian database
-    Xapian::Database lXapianDatabase (iTravelDBFilePath);
+    // All the BOM objects (e.g., Result, ResultHolder, Place) instantiated
+    // for the interpretation of that travel query are released in one shot
+    // when the scope ends, i.e., when the current method returns.
+    // Only the (light) Location structures are handed over to the caller.
+    FacQueryScope lQueryScope;
 
     // DEBUG
     OPENTREP_LOG_DEBUG (std::endl
                         << "=========================================");
       
-    // First, cut the travel query in slices and calculate all the partitions
-    // for each of those query slices
-    QuerySlices lQuerySlices (lXapianDatabase, iTravelQuery, iTransliterator);
+    // First, cut the travel query in slices. When available, the table of
+    // the adjacent word pairs and the spelling dictionary spare most of the
+    // queries on the Xapian index.
+    QuerySlices lQuerySlices (iXapianDatabase, iTravelQuery, iTransliterator,
+                              iWordPairTable_ptr, iSpellingDictionary_ptr);
 
     // DEBUG
     OPENTREP_LOG_DEBUG ("+=+=+=+=+=+=+=+=+=+=+=+=+=+=+");
@@ -429,125 +1515,86 @@ namespace OPENTREP {
     }
     OPENTREP_LOG_DEBUG ("Query slices: `" << lQuerySlices << "'");
 
-    // Browse the travel query slices
-    const StringPartitionList_T& lStringPartitionList =
-      lQuerySlices.getStringPartitionList();
-    for (StringPartitionList_T::const_iterator itSlice =
-           lStringPartitionList.begin();
-         itSlice != lStringPartitionList.end(); ++itSlice) {
-      StringPartition lStringPartition = *itSlice;
-      const std::string& lTravelQuerySlice = lStringPartition.getInitialString();
+    // Resources shared by the searches of the travel query slices
+    QuerySearchContext lContext;
+    lContext._queryScope = &lQueryScope;
+    lContext._threadPool = ioThreadPool_ptr;
+    lContext._databaseSet = &lDatabaseSet;
+    lContext._sqlDBType = &iSQLDBType;
+    lContext._sqlDBConnStr = &iSQLDBConnStr;
+    lContext._sqlDBConnPool = ioSQLDBConnPool_ptr;
+    lContext._codeIndex = iCodeIndex_ptr;
+    lContext._exhaustiveSearch = iExhaustiveSearch;
 
-      /**
-       * 0. Initialisation
-       *
-       * Create a ResultCombination BOM instance.
-       */
-      ResultCombination& lResultCombination =
-        FacResultCombination::instance().create (lTravelQuerySlice);
+    // Filter of the invalid (e.g., expired) POR, applied within the matcher
+    const PORValidityDecider lPORValidityDecider (iExpiredPORFiltering,
+                                                  iValidityDate);
+    lContext._porValidityDecider = &lPORValidityDecider;
 
-      // DEBUG
-      // DEBUG
-      OPENTREP_LOG_DEBUG ("+++++++++++++++++++++");
-      OPENTREP_LOG_DEBUG ("Travel query slice: `" << lTravelQuerySlice << "'");
-      OPENTREP_LOG_DEBUG ("Partitions: " << lStringPartition);
+    // Spelling corrections, sought in memory when the dictionary is available
+    lContext._spellingDictionary = iSpellingDictionary_ptr;
 
+    // Word combinations holding words unknown by the index, detected in
+    // memory when the vocabulary is available
+    lContext._termVocabulary = iTermVocabulary_ptr;
 
-      /**
-       * 1.0. Check whether the travel query is made only of IATA/ICAO codes
-       *      and Geonames ID.
-       */
-      WordList_T lCodeList;
-      const bool areAllWordsCodes =
-        areAllCodeOrGeoID (lTravelQuerySlice, lCodeList);
+    // Browse the travel query slices. The slices are independent from
+    // one another: they are searched for in parallel, when a pool of
+    // threads is given.
+    const StringSet& lSliceSet = lQuerySlices.getSlices();
+    std::vector<SliceSearch> lSliceSearchList;
+    lSliceSearchList.reserve (lSliceSet._set.size());
 
-      NbOfMatches_T lNbOfMatches = 0;
-      if (areAllWordsCodes == true && !(iSQLDBType == DBType::NODB)) {
-        /**
-         * All the words/items of the travel query are either IATA/ICAO codes
-         * or Geonames ID. The corresponding details will be retrieved directly
-         * from the underlying database, if existing.
-         * The Xapian database/index is not used.
-         */
-        // DEBUG
-        OPENTREP_LOG_DEBUG ("The travel query string (" << lTravelQuerySlice
-                            << ") is made only of IATA/ICAO codes "
-                            << "or Geonames ID. The " << iSQLDBType.describe()
-                            << " SQL database (" << iSQLDBConnStr
-                            << ") will be used. "
-                            << "The Xapian database will not be used");
+    // When the search is to be explained, every slice search records its
+    // own part of the explanation, so that no synchronisation is needed
+    SliceExplanationList_T* lSliceExplanationList_ptr = NULL;
+    if (ioExplanation_ptr != NULL) {
+      ioExplanation_ptr->setTravelQuery (iTravelQuery);
+      ioExplanation_ptr->setNormalisedQuery (lNormalisedQueryString);
+      lSliceExplanationList_ptr = &ioExplanation_ptr->getSliceList();
+      lSliceExplanationList_ptr->resize (lSliceSet._set.size());
+    }
 
-        lNbOfMatches = OPENTREP::getLocationList (iSQLDBType, iSQLDBConnStr,
-                                                  lCodeList,
-                                                  ioLocationList, ioWordList);
+    unsigned short lSliceIdx = 0;
+    for (StringSet::StringSet_T::const_iterator itSlice =
+           lSliceSet._set.begin(); itSlice != lSliceSet._set.end();
+         ++itSlice, ++lSliceIdx) {
+      const std::string& lTravelQuerySlice = *itSlice;
+      SliceExplanation* lSliceExplanation_ptr = NULL;
+      if (lSliceExplanationList_ptr != NULL) {
+        lSliceExplanation_ptr = &(*lSliceExplanationList_ptr)[lSliceIdx];
+        lSliceExplanation_ptr->_querySlice = lTravelQuerySlice;
       }
+      lSliceSearchList.push_back (SliceSearch (lContext, lSliceIdx,
+                                               lTravelQuerySlice,
+                                               lSliceExplanation_ptr));
+    }
 
-      if (lNbOfMatches == 0) {
-        /**
-         * <ul>
-         *   <li>Some of the words/items of the travel query are neither
-         *        IATA/ICAO codes nor Geonames ID;</li>
-         *   <li>or there is no underlying SQL database;</li>
-         *   <li>or the word/item is 3/4-character long but is not
-         *       a IATA/ICAO code (e.g., lviv)</li>
-         * </ul>
-         * The Xapian database/index must therefore be used.
-         */
-        // DEBUG
-        if (iSQLDBType == DBType::NODB) {
-          OPENTREP_LOG_DEBUG ("No SQL database may be used. "
-                              << "The Xapian database will be used instead");
-        } else {
-          OPENTREP_LOG_DEBUG ("The travel query string (" << lTravelQuerySlice
-                              << ") has got items/words, which are neither "
-                              << "IATA/ICAO codes nor Geonames ID. "
-                              << "The Xapian database/index will be used");
-        }
-
-        /**
-         * 1.1. Perform all the full-text matches, and fill accordingly the
-         *      list of Result instances.
-         */
-        OPENTREP::searchString (lTravelQuerySlice, lXapianDatabase,
-                                lResultCombination, ioWordList);
-
-        /**
-         * 1.2. Calculate/set all the weights for all the matching documents
-         */
-        lResultCombination.calculateAllWeights();
-
-        /**
-         * 2. Calculate the best matching scores / weighting percentages.
-         */
-        OPENTREP::chooseBestMatchingResultHolder (lResultCombination);
-
-        /**
-         * 3. Create the list of Place objects, for each of which a
-         *    look-up is made in the SQL database (e.g., MySQL or Oracle)
-         *    to retrieve complementary data.
-         */
-        // Create a PlaceHolder object, to collect the matching Place objects
-        PlaceHolder& lPlaceHolder = FacPlaceHolder::instance().create();
-        createPlaces (lResultCombination, lPlaceHolder);
-      
-        // DEBUG
-        OPENTREP_LOG_DEBUG (std::endl
-                            << "========================================="
-                            << std::endl << "Summary:" << std::endl
-                            << lPlaceHolder.toShortString() << std::endl
-                            << "========================================="
-                            << std::endl);
+    BasThreadPool::TaskList_T lTaskList;
+    for (std::vector<SliceSearch>::iterator itSliceSearch =
+           lSliceSearchList.begin(); itSliceSearch != lSliceSearchList.end();
+         ++itSliceSearch) {
+      SliceSearch& lSliceSearch = *itSliceSearch;
+      lTaskList.push_back (boost::bind (&interpretTravelQuerySlice,
+                                        &lSliceSearch));
+    }
+    runTasks (ioThreadPool_ptr, lTaskList);
 
-        /**
-         * 4. Create a list of Location structures, which are light copies
-         *    of the Place objects, and add them to the given list.
-         */
-        lPlaceHolder.createLocations (ioLocationList);
-      }
+    // Merge the results, in the order of the travel query slices, so that
+    // the output does not depend on the scheduling of the searches
+    for (std::vector<SliceSearch>::const_iterator itSliceSearch =
+           lSliceSearchList.begin(); itSliceSearch != lSliceSearchList.end();
+         ++itSliceSearch) {
+      const SliceSearch& lSliceSearch = *itSliceSearch;
+      ioLocationList.insert (ioLocationList.end(),
+                             lSliceSearch._locationList.begin(),
+                             lSliceSearch._locationList.end());
+      ioWordList.insert (ioWordList.end(), lSliceSearch._wordList.begin(),
+                         lSliceSearch._wordList.end());
     }
 
     oNbOfMatches = ioLocationList.size();
     return oNbOfMatches;
   }
-  
+
 }
@@ -8,10 +8,31 @@
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/Location.hpp>
 
+/**
+ * Forward declarations
+ */
+// Xapian
+namespace Xapian {
+  class Database;
+}
+
+// SOCI (for SQL database)
+namespace soci {
+  class connection_pool;
+}
+
 namespace OPENTREP {
 
   // Forward declarations
   class OTransliterator;
+  class BasThreadPool;
+  class XapianDatabasePool;
+  struct SliceSearch;
+  struct WordPairTable;
+  struct SpellingDictionary;
+  struct TermVocabulary;
+  struct CodeIndex;
+  struct SearchExplanation;
 
   /**
    * @brief Command wrapping the travel request process.
@@ -32,28 +53,86 @@ namespace OPENTREP {
      */
     static bool areAllCodeOrGeoID (const TravelQuery_T&, WordList_T&);
 
+    /**
+     * Interpret a single slice of the travel query. The matching locations
+     * and the non-matched words are stored within the given SliceSearch
+     * structure, which also refers to the resources shared with the
+     * searches of the other slices.
+     *
+     * That method may be run by any thread of the pool of threads.
+     *
+     * @param SliceSearch* Search of the travel query slice.
+     */
+    static void interpretTravelQuerySlice (SliceSearch*);
+
     /**
      * Interpret the given string, thanks to various pieces of algorithm,
      * including a full-text search on the underlying Xapian index (named
      * "database"). A list of locations/places is returned.
      *
-     * @param const TravelDBFilePath_T& Filepath to the Xapian database.
+     * @param const Xapian::Database& Xapian database (index), already opened.
      * @param const DBType& SQL database type (can be no database at all).
      * @param const SQLDBConnectionString_T& SQL DB connection string.
+     * @param soci::connection_pool* Pool of SQL database connections (NULL
+     *        when there is no, or no accessible, SQL database).
+     * @param BasThreadPool* Pool of threads, on which the query slices and
+     *        their full-text matches are searched for in parallel (NULL
+     *        when the searches are to be sequential).
+     * @param XapianDatabasePool* Pool of Xapian database handles, leased by
+     *        the parallel searches (NULL when the searches are sequential,
+     *        in which case the above Xapian database handle is used).
+     * @param const WordPairTable* Table of the adjacent word pairs of the
+     *        Xapian index, with which the query slices are calculated in
+     *        memory (NULL when not available, in which case the Xapian
+     *        index is queried for every pair of contiguous words).
+     * @param const SpellingDictionary* In-memory spelling dictionary of the
+     *        Xapian index, with which the spelling corrections are sought
+     *        (NULL when not available, in which case the Xapian spelling
+     *        table is used).
+     * @param const TermVocabulary* Vocabulary of the Xapian index, with
+     *        which the word combinations holding unknown words are
+     *        spared the exact full-text match (NULL when not available,
+     *        in which case the Xapian index is queried for them).
+     * @param const CodeIndex* In-memory index of the POR by code, with which
+     *        the query slices made only of IATA/ICAO codes and Geonames IDs
+     *        are answered (NULL when not available, in which case the SQL
+     *        database, if any, is used instead).
      * @param const std::string& (Travel-related) query string (e.g.,
      *        "sna francicso rio de janero lso angles reykyavki nce iev mow").
      * @param LocationList_T& List of (geographical) locations, if any,
      *        matching the given query string.
      * @param WordList_T& List of non-matched words of the query string.
      * @param const OTransliterator& Unicode transliterator.
+     * @param const ExhaustiveSearch_T& Whether all the partitions of the
+     *        query slices should be searched for, rather than only their
+     *        distinct word combinations.
+     * @param const ExpiredPORFiltering_T& Whether the expired POR should be
+     *        filtered out of the results.
+     * @param const Date_T& Date at which the POR of the results must be
+     *        valid (not a date when the POR should not be filtered on
+     *        their validity period).
+     * @param SearchExplanation* Structure in which the search is traced
+     *        (NULL when the search is not to be explained, in which case
+     *        nothing is recorded).
      * @return NbOfMatches_T Number of matches.
      */
-    static NbOfMatches_T interpretTravelRequest (const TravelDBFilePath_T&,
+    static NbOfMatches_T interpretTravelRequest (const Xapian::Database&,
                                                  const DBType&,
                                                  const SQLDBConnectionString_T&,
+                                                 soci::connection_pool*,
+                                                 BasThreadPool*,
+                                                 XapianDatabasePool*,
+                                                 const WordPairTable*,
+                                                 const SpellingDictionary*,
+                                                 const TermVocabulary*,
+                                                 const CodeIndex*,
                                                  const TravelQuery_T&,
                                                  LocationList_T&, WordList_T&,
-                                                 const OTransliterator&);
+                                                 const OTransliterator&,
+                                                 const ExhaustiveSearch_T&,
+                                                 const ExpiredPORFiltering_T&,
+                                                 const Date_T&,
+                                                 SearchExplanation*);
 
   private:
     /**
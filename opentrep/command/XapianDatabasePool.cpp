@@ -0,0 +1,120 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// Xapian
+#include <xapian.h>
+// OpenTrep
+#include <opentrep/command/XapianIndexManager.hpp>
+#include <opentrep/command/XapianDatabasePool.hpp>
+#include <opentrep/service/Logger.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  XapianDatabasePool::
+  XapianDatabasePool (const TravelDBFilePath_T& iTravelDBFilePath)
+    : _travelDBFilePath (iTravelDBFilePath) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  XapianDatabasePool::~XapianDatabasePool() {
+    clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void XapianDatabasePool::clear() {
+    boost::mutex::scoped_lock lGuard (_mutex);
+    for (std::vector<Xapian::Database*>::iterator itDatabase =
+           _freeList.begin(); itDatabase != _freeList.end(); ++itDatabase) {
+      Xapian::Database* lXapianDatabase_ptr = *itDatabase;
+      assert (lXapianDatabase_ptr != NULL);
+
+      _revisionMap.erase (lXapianDatabase_ptr);
+      delete lXapianDatabase_ptr; lXapianDatabase_ptr = NULL;
+    }
+    _freeList.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::Database& XapianDatabasePool::
+  lease (const IndexRevision_T& iIndexRevision) {
+    Xapian::Database* oXapianDatabase_ptr = NULL;
+    IndexRevision_T lHandleRevision;
+    {
+      boost::mutex::scoped_lock lGuard (_mutex);
+      if (_freeList.empty() == false) {
+        oXapianDatabase_ptr = _freeList.back();
+        _freeList.pop_back();
+
+        const RevisionMap_T::const_iterator itRevision =
+          _revisionMap.find (oXapianDatabase_ptr);
+        assert (itRevision != _revisionMap.end());
+        lHandleRevision = itRevision->second;
+      }
+    }
+
+    // No handle is available: open a new one
+    if (oXapianDatabase_ptr == NULL) {
+      oXapianDatabase_ptr = XapianIndexManager::openDatabase (_travelDBFilePath);
+      assert (oXapianDatabase_ptr != NULL);
+
+      const IndexRevision_T& lNewRevision =
+        XapianIndexManager::getRevision (*oXapianDatabase_ptr);
+      boost::mutex::scoped_lock lGuard (_mutex);
+      _revisionMap[oXapianDatabase_ptr] = lNewRevision;
+      return *oXapianDatabase_ptr;
+    }
+
+    // The handle already sees the revision expected by the caller:
+    // reopening it (which checks the files of the index) is not needed
+    if (lHandleRevision == iIndexRevision) {
+      return *oXapianDatabase_ptr;
+    }
+
+    // Take into account the latest revision of the Xapian index, if any,
+    // the format of which is checked again
+    try {
+      oXapianDatabase_ptr->reopen();
+
+      XapianIndexManager::checkFormatVersion (*oXapianDatabase_ptr,
+                                              _travelDBFilePath);
+
+    } catch (const Xapian::Error& error) {
+      forget (oXapianDatabase_ptr);
+      std::ostringstream oStr;
+      oStr << "The Xapian database/index ('" << _travelDBFilePath
+           << "') cannot be re-opened: " << error.get_msg();
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw XapianDatabaseFailureException (oStr.str());
+
+    } catch (const XapianDatabaseFailureException&) {
+      forget (oXapianDatabase_ptr);
+      throw;
+    }
+
+    const IndexRevision_T& lNewRevision =
+      XapianIndexManager::getRevision (*oXapianDatabase_ptr);
+    boost::mutex::scoped_lock lGuard (_mutex);
+    _revisionMap[oXapianDatabase_ptr] = lNewRevision;
+    return *oXapianDatabase_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void XapianDatabasePool::forget (Xapian::Database*& ioXapianDatabase_ptr) {
+    {
+      boost::mutex::scoped_lock lGuard (_mutex);
+      _revisionMap.erase (ioXapianDatabase_ptr);
+    }
+    delete ioXapianDatabase_ptr; ioXapianDatabase_ptr = NULL;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void XapianDatabasePool::giveBack (Xapian::Database& ioXapianDatabase) {
+    boost::mutex::scoped_lock lGuard (_mutex);
+    _freeList.push_back (&ioXapianDatabase);
+  }
+
+}
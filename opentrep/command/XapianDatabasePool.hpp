@@ -0,0 +1,128 @@
+#ifndef __OPENTREP_CMD_XAPIANDATABASEPOOL_HPP
+#define __OPENTREP_CMD_XAPIANDATABASEPOOL_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <map>
+#include <vector>
+// Boost
+#include <boost/thread/mutex.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+
+/**
+ * Forward declarations
+ */
+// Xapian
+namespace Xapian {
+  class Database;
+}
+
+namespace OPENTREP {
+
+  /**
+   * @brief Pool of Xapian database (index) handles.
+   *
+   * A Xapian database handle must not be used by several threads at the
+   * same time. The tasks evaluating the travel queries in parallel (see
+   * BasThreadPool) therefore lease their handles from that pool. The
+   * handles are opened when first needed, and kept afterwards for the
+   * next leases.
+   */
+  class XapianDatabasePool {
+  public:
+    // ////////////////// Business Methods ////////////////
+    /**
+     * Lease a handle, which may then be used exclusively by the caller,
+     * until it is given back. When the handle does not see the given
+     * revision of the index (typically, the revision seen by the handle
+     * of the service context, just refreshed by the caller), it is
+     * refreshed (Xapian::Database::reopen()), so that a re-built index
+     * be taken into account. Otherwise, it is leased as is.
+     *
+     * @param const IndexRevision_T& Revision of the Xapian index expected
+     *        by the caller (see XapianIndexManager::getRevision()).
+     * @return Xapian::Database& Xapian database handle.
+     */
+    Xapian::Database& lease (const IndexRevision_T& iIndexRevision);
+
+    /**
+     * Give back a handle, formerly leased from that pool.
+     *
+     * @param Xapian::Database& Xapian database handle.
+     */
+    void giveBack (Xapian::Database&);
+
+    /**
+     * Close all the handles not leased at the moment.
+     *
+     * That is typically needed before the Xapian index is re-built,
+     * as its directory is then removed and re-created from scratch.
+     */
+    void clear();
+
+  public:
+    // ////////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor.
+     *
+     * @param const TravelDBFilePath_T& File-path of the Xapian index/database.
+     */
+    XapianDatabasePool (const TravelDBFilePath_T&);
+
+    /**
+     * Destructor. The handles are closed.
+     */
+    ~XapianDatabasePool();
+
+  private:
+    /**
+     * Default constructor, not implemented.
+     */
+    XapianDatabasePool();
+
+    /**
+     * Copy constructor, not implemented.
+     */
+    XapianDatabasePool (const XapianDatabasePool&);
+
+  private:
+    /**
+     * Close a handle, which has been leased and cannot be re-used.
+     *
+     * @param Xapian::Database*& Xapian database handle, reset to NULL.
+     */
+    void forget (Xapian::Database*&);
+
+  private:
+    /**
+     * Revision of the index seen by every handle of that pool.
+     */
+    typedef std::map<const Xapian::Database*, IndexRevision_T> RevisionMap_T;
+
+    // ////////////// Attributes ///////////////
+    /**
+     * File-path of the Xapian index/database.
+     */
+    const TravelDBFilePath_T _travelDBFilePath;
+
+    /**
+     * Handles not leased at the moment.
+     */
+    std::vector<Xapian::Database*> _freeList;
+
+    /**
+     * Revision of the index seen by every handle (leased or not).
+     */
+    RevisionMap_T _revisionMap;
+
+    /**
+     * Mutex protecting the list of the handles and their revisions.
+     */
+    boost::mutex _mutex;
+  };
+
+}
+#endif // __OPENTREP_CMD_XAPIANDATABASEPOOL_HPP
@@ -15,6 +15,8 @@
 #include <xapian.h>
 // OpenTrep
 #include <opentrep/Location.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/bom/CodeIndex.hpp>
 #include <opentrep/bom/Result.hpp>
 #include <opentrep/command/XapianIndexManager.hpp>
 #include <opentrep/service/Logger.hpp>
@@ -39,19 +41,88 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  NbOfDBEntries_T XapianIndexManager::
-  getSize (const TravelDBFilePath_T& iTravelDBFilePath) {
-    NbOfDBEntries_T oNbOfDBEntries = 0;
-
+  Xapian::Database* XapianIndexManager::
+  openDatabase (const TravelDBFilePath_T& iTravelDBFilePath) {
     // Check whether the file-path to the Xapian database/index exists
     // and is a directory.
     checkTravelDBFilePath (iTravelDBFilePath);
 
     // Open the Xapian database
-    Xapian::Database lXapianDatabase (iTravelDBFilePath);
+    Xapian::Database* oXapianDatabase_ptr = NULL;
+    try {
+      oXapianDatabase_ptr = new Xapian::Database (iTravelDBFilePath);
+
+    } catch (const Xapian::Error& error) {
+      std::ostringstream oStr;
+      oStr << "The Xapian database/index ('" << iTravelDBFilePath
+           << "') cannot be opened: " << error.get_msg();
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw XapianDatabaseFailureException (oStr.str());
+    }
+    assert (oXapianDatabase_ptr != NULL);
+
+    // Check the version of the format of the Xapian database/index
+    try {
+      checkFormatVersion (*oXapianDatabase_ptr, iTravelDBFilePath);
+
+    } catch (const XapianDatabaseFailureException&) {
+      delete oXapianDatabase_ptr; oXapianDatabase_ptr = NULL;
+      throw;
+    }
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("The Xapian database/index ('" << iTravelDBFilePath
+                        << "') has been opened");
+
+    return oXapianDatabase_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void XapianIndexManager::
+  checkFormatVersion (const Xapian::Database& iXapianDatabase,
+                      const TravelDBFilePath_T& iTravelDBFilePath) {
+    /**
+     * The indexes generated before the introduction of the version
+     * marker do not store the scoring fields nor the validity period
+     * of the POR within value slots; the scoring fields are then parsed
+     * from the document data, which is slower, and no POR is filtered
+     * out on its validity period. The indexes of any other version than
+     * the current one are rejected.
+     */
+    std::ostringstream lExpectedVersionStr;
+    lExpectedVersionStr << K_XAPIAN_INDEX_FORMAT_VERSION;
+    const std::string& lFormatVersionStr =
+      iXapianDatabase.get_metadata (K_XAPIAN_INDEX_FORMAT_VERSION_KEY);
+
+    if (lFormatVersionStr.empty() == true) {
+      OPENTREP_LOG_NOTIFICATION ("The Xapian database/index ('"
+                                 << iTravelDBFilePath << "') does not specify "
+                                 << "any format version. It has probably been "
+                                 << "built by an older version of OpenTREP, "
+                                 << "and should be re-built (until then, the "
+                                 << "scoring details will be parsed from the "
+                                 << "document data, and the POR will not be "
+                                 << "filtered on their validity period)");
+
+    } else if (lFormatVersionStr != lExpectedVersionStr.str()) {
+      std::ostringstream oStr;
+      oStr << "The format version of the Xapian database/index ('"
+           << iTravelDBFilePath << "') is " << lFormatVersionStr
+           << ", whereas the expected version is "
+           << lExpectedVersionStr.str()
+           << ". The Xapian database/index should be re-built";
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw XapianDatabaseFailureException (oStr.str());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T XapianIndexManager::
+  getSize (const Xapian::Database& iXapianDatabase) {
+    NbOfDBEntries_T oNbOfDBEntries = 0;
 
     // Retrieve the actual number of documents indexed by the Xapian database
-    const Xapian::doccount& lDocCount = lXapianDatabase.get_doccount();
+    const Xapian::doccount& lDocCount = iXapianDatabase.get_doccount();
 
     //
     oNbOfDBEntries = static_cast<const NbOfDBEntries_T> (lDocCount);
@@ -59,22 +130,24 @@ namespace OPENTREP {
     return oNbOfDBEntries;
   }
   
+  // //////////////////////////////////////////////////////////////////////
+  IndexRevision_T XapianIndexManager::
+  getRevision (const Xapian::Database& iXapianDatabase) {
+    std::ostringstream oStr;
+    oStr << iXapianDatabase.get_uuid() << "-" << iXapianDatabase.get_doccount()
+         << "-" << iXapianDatabase.get_lastdocid();
+    return oStr.str();
+  }
+
   // //////////////////////////////////////////////////////////////////////
   NbOfMatches_T XapianIndexManager::
-  drawRandomLocations (const TravelDBFilePath_T& iTravelDBFilePath,
+  drawRandomLocations (const Xapian::Database& iXapianDatabase,
                        const NbOfMatches_T& iNbOfDraws,
                        LocationList_T& ioLocationList) {
     NbOfMatches_T oNbOfMatches = 0;
 
-    // Check whether the file-path to the Xapian database/index exists
-    // and is a directory.
-    checkTravelDBFilePath (iTravelDBFilePath);
-
-    // Open the Xapian database
-    Xapian::Database lXapianDatabase (iTravelDBFilePath);
-
     // Retrieve the number of documents indexed by the database
-    const NbOfDBEntries_T& lTotalNbOfDocs = getSize (iTravelDBFilePath);
+    const NbOfDBEntries_T& lTotalNbOfDocs = getSize (iXapianDatabase);
 
     // No need to go further when the Xapian database (index) is empty
     if (lTotalNbOfDocs == 0) {
@@ -96,7 +169,7 @@ namespace OPENTREP {
 
       // Retrieve the document from the Xapian database/index
       Xapian::Document::Internal* lDocPtr =
-        lXapianDatabase.get_document_lazily (lDocID);
+        iXapianDatabase.get_document_lazily (lDocID);
 
       unsigned short currentNbOfIterations = 0;
       while (lDocPtr == NULL && currentNbOfIterations <= 100) {
@@ -110,7 +183,7 @@ namespace OPENTREP {
         lDocID = static_cast<Xapian::docid> (lRandomNbInt);
 
         // Retrieve the document from the Xapian database/index
-        lDocPtr = lXapianDatabase.get_document_lazily (lDocID);
+        lDocPtr = iXapianDatabase.get_document_lazily (lDocID);
       }
 
       // Bad luck: no document ID can be generated so that it corresponds to
@@ -148,4 +221,41 @@ namespace OPENTREP {
     return oNbOfMatches;
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  NbOfDBEntries_T XapianIndexManager::
+  buildCodeIndex (const Xapian::Database& iXapianDatabase,
+                  CodeIndex& ioCodeIndex) {
+    NbOfDBEntries_T oNbOfEntries = 0;
+
+    try {
+      // Browse all the documents of the Xapian index (the empty term
+      // matches all of them)
+      for (Xapian::PostingIterator itDocID = iXapianDatabase.postlist_begin ("");
+           itDocID != iXapianDatabase.postlist_end (""); ++itDocID) {
+        const Xapian::Document& lDoc = iXapianDatabase.get_document (*itDocID);
+
+        // Parse the POR details and create the corresponding Location structure
+        const Location& lLocation = Result::retrieveLocation (lDoc);
+
+        // Index the Location structure
+        ioCodeIndex.addLocation (lLocation);
+        ++oNbOfEntries;
+      }
+
+    } catch (const Xapian::Error& error) {
+      std::ostringstream errorStr;
+      errorStr << "Error when browsing the Xapian database: "
+               << error.get_msg();
+      OPENTREP_LOG_ERROR (errorStr.str());
+      throw XapianException (errorStr.str());
+    }
+
+    // Pre-select the location with the highest PageRank value for
+    // every IATA code
+    ioCodeIndex.finalise();
+
+    //
+    return oNbOfEntries;
+  }
+
 }
@@ -8,36 +8,106 @@
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/LocationList.hpp>
 
+/**
+ * Forward declarations
+ */
+// Xapian
+namespace Xapian {
+  class Database;
+}
+
 namespace OPENTREP {
 
+  // Forward declarations
+  struct CodeIndex;
+
   /**
    * @brief Command wrapping utilities for the management
    *        of the Xapian (database) index.
    */
   class XapianIndexManager {
     friend class OPENTREP_Service;
+    friend class XapianDatabasePool;
   private:
+    /**
+     * Open the Xapian index (named "database") in read-only mode.
+     *
+     * The returned handle is meant to be kept by the caller (typically,
+     * the service context) for the whole life of the service, and to be
+     * refreshed with Xapian::Database::reopen() when the index may have
+     * been rebuilt in the meantime.
+     *
+     * The format version, recorded by the index builder, is checked
+     * (see checkFormatVersion()).
+     *
+     * @param const TravelDBFilePath_T& Filepath to the Xapian database.
+     * @return Xapian::Database* A pointer on the just opened Xapian database.
+     */
+    static Xapian::Database* openDatabase (const TravelDBFilePath_T&);
+
+    /**
+     * Check the version of the format of the Xapian index (named
+     * "database"), as recorded by the index builder. That check is made
+     * when the index is opened, and must be made again every time
+     * the handle is refreshed with a new revision of the index.
+     *
+     * An exception is thrown when the index has been generated with
+     * a format other than the current one. When the index does not
+     * record any format version (i.e., it has been generated by a version
+     * of OpenTREP older than the version marker), it is accepted, and
+     * a notification is logged.
+     *
+     * @param const Xapian::Database& Xapian database (index).
+     * @param const TravelDBFilePath_T& Filepath to the Xapian database.
+     */
+    static void checkFormatVersion (const Xapian::Database&,
+                                    const TravelDBFilePath_T&);
+
     /**
      * Give the number of documents indexed by the Xapian index
      * (named "database").
      *
-     * @param const TravelDBFilePath_T& Filepath to the Xapian database.
+     * @param const Xapian::Database& Xapian database (index).
      * @return NbOfDBEntries_T Number of entries in the database.
      */
-    static NbOfDBEntries_T getSize (const TravelDBFilePath_T&);
+    static NbOfDBEntries_T getSize (const Xapian::Database&);
 
     /**
      * Randomly draw a given number of documents from the Xapian index
      * (named "database").
      *
-     * @param const TravelDBFilePath_T& Filepath to the Xapian database.
+     * @param const Xapian::Database& Xapian database (index).
      * @param LocationList_T& List of Location structures randomly picked-up.
      * @return const NbOfMatches_T& Number of locations to randomly pick-up.
      */
-    static NbOfMatches_T drawRandomLocations (const TravelDBFilePath_T&,
+    static NbOfMatches_T drawRandomLocations (const Xapian::Database&,
                                               const NbOfMatches_T& iNbOfDraws,
                                               LocationList_T&);
 
+  public:
+    /**
+     * Give the revision of the Xapian index (named "database"), which
+     * changes every time the index is re-built. It is made of the UUID
+     * of the index (which changes when the index is re-created from
+     * scratch), of the number of documents and of the last document ID.
+     *
+     * @param const Xapian::Database& Xapian database (index).
+     * @return IndexRevision_T Revision of the Xapian index.
+     */
+    static IndexRevision_T getRevision (const Xapian::Database&);
+
+    /**
+     * Fill the in-memory index of the POR by code with all the documents
+     * of the Xapian index (named "database"). The POR details are parsed
+     * once for all.
+     *
+     * @param const Xapian::Database& Xapian database (index).
+     * @param CodeIndex& In-memory index to be filled, and then finalised.
+     * @return NbOfDBEntries_T Number of indexed POR.
+     */
+    static NbOfDBEntries_T buildCodeIndex (const Xapian::Database&,
+                                           CodeIndex&);
+
   private:
     /**
      * Constructors.
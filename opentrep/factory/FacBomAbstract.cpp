@@ -10,6 +10,7 @@
 // OpenTrep
 #include <opentrep/bom/BomAbstract.hpp>
 #include <opentrep/factory/FacBomAbstract.hpp>
+#include <opentrep/factory/FacQueryScope.hpp>
 
 namespace OPENTREP {
   
@@ -20,6 +21,7 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   void FacBomAbstract::clean() {
+    boost::mutex::scoped_lock lGuard (_poolMutex);
     for (BomPool_T::iterator itBom = _pool.begin();
 	 itBom != _pool.end(); itBom++) {
       BomAbstract* currentBom_ptr = *itBom;
@@ -32,6 +34,22 @@ namespace OPENTREP {
     _pool.clear();
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void FacBomAbstract::addToPool (BomAbstract* ioBomAbstract_ptr) {
+    assert (ioBomAbstract_ptr != NULL);
+
+    // When a query scope is active within the current thread, that latter
+    // takes the ownership of the object
+    FacQueryScope* lQueryScope_ptr = FacQueryScope::getCurrentScope();
+    if (lQueryScope_ptr != NULL) {
+      lQueryScope_ptr->adopt (ioBomAbstract_ptr);
+      return;
+    }
+
+    boost::mutex::scoped_lock lGuard (_poolMutex);
+    _pool.push_back (ioBomAbstract_ptr);
+  }
+
   // //////////////////////////////////////////////////////////////////////
   std::size_t FacBomAbstract::getID (const BomAbstract* iBomAbstract_ptr) {
     const void* lPtr = iBomAbstract_ptr;
@@ -7,6 +7,8 @@
 // STL
 #include <string>
 #include <vector>
+// Boost
+#include <boost/thread/mutex.hpp>
 
 namespace OPENTREP {
 
@@ -44,6 +46,14 @@ namespace OPENTREP {
     /** Destructor. */
     virtual ~FacBomAbstract();
 
+    /** Keep track of a newly instantiated object, so that it be deleted
+        in due time.
+        <br>When a query scope (see FacQueryScope) is active within the
+        calling thread, the object is handed over to that scope, and is
+        deleted when that scope ends. Otherwise, the object is added to
+        the pool of that factory, the access to which is serialised. */
+    void addToPool (BomAbstract*);
+
   private:
     /** Destroyed all the object instantiated by this factory. */
     void clean();
@@ -51,6 +61,9 @@ namespace OPENTREP {
   protected:
     /** List of instantiated Business Objects*/
     BomPool_T _pool;
+
+    /** Mutex serialising the access to the pool of objects. */
+    mutable boost::mutex _poolMutex;
   };
 }
 #endif // __OPENTREP_FAC_FACBOMABSTRACT_HPP
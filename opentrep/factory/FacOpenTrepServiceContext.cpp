@@ -11,23 +11,32 @@
 
 namespace OPENTREP {
 
-  FacOpenTrepServiceContext* FacOpenTrepServiceContext::_instance = NULL;
+  boost::atomic<FacOpenTrepServiceContext*> FacOpenTrepServiceContext::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacOpenTrepServiceContext::~FacOpenTrepServiceContext() {
-    _instance = NULL;
+    _instance.store (NULL, boost::memory_order_release);
   }
 
   // //////////////////////////////////////////////////////////////////////
   FacOpenTrepServiceContext& FacOpenTrepServiceContext::instance() {
+    // Once instantiated, the factory is got without any lock
+    FacOpenTrepServiceContext* lInstance_ptr = _instance.load (boost::memory_order_acquire);
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
+
+    boost::recursive_mutex::scoped_lock
+      lGuard (FacSupervisor::getInstanceMutex());
+    lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacOpenTrepServiceContext();
+      assert (lInstance_ptr != NULL);
 
-    if (_instance == NULL) {
-      _instance = new FacOpenTrepServiceContext();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerServiceFactory (_instance);
+      FacSupervisor::instance().registerServiceFactory (lInstance_ptr);
+      _instance.store (lInstance_ptr, boost::memory_order_release);
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/atomic.hpp>
 // OpenTrep
 #include <opentrep/DBType.hpp>
 #include <opentrep/factory/FacServiceAbstract.hpp>
@@ -81,7 +83,7 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacOpenTrepServiceContext* _instance;
+    static boost::atomic<FacOpenTrepServiceContext*> _instance;
   };
 
 }
@@ -10,7 +10,7 @@
 
 namespace OPENTREP {
 
-  FacPlace* FacPlace::_instance = NULL;
+  boost::atomic<FacPlace*> FacPlace::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacPlace::FacPlace() {
@@ -22,19 +22,28 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacPlace::~FacPlace() {
-    _instance = NULL;
+    _instance.store (NULL, boost::memory_order_release);
   }
 
   // //////////////////////////////////////////////////////////////////////
   FacPlace& FacPlace::instance() {
+    // Once instantiated, the factory is got without any lock
+    FacPlace* lInstance_ptr = _instance.load (boost::memory_order_acquire);
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacPlace();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    boost::recursive_mutex::scoped_lock
+      lGuard (FacSupervisor::getInstanceMutex());
+    lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacPlace();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance.store (lInstance_ptr, boost::memory_order_release);
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -45,7 +54,7 @@ namespace OPENTREP {
     assert (oPlace_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oPlace_ptr);
+    addToPool (oPlace_ptr);
 
     return *oPlace_ptr;
   }
@@ -58,7 +67,7 @@ namespace OPENTREP {
     assert (oPlace_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oPlace_ptr);
+    addToPool (oPlace_ptr);
 
     return *oPlace_ptr;
   }
@@ -71,7 +80,7 @@ namespace OPENTREP {
     assert (oPlace_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oPlace_ptr);
+    addToPool (oPlace_ptr);
 
     return *oPlace_ptr;
   }
@@ -84,7 +93,7 @@ namespace OPENTREP {
     assert (oPlace_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oPlace_ptr);
+    addToPool (oPlace_ptr);
 
     return *oPlace_ptr;
   }
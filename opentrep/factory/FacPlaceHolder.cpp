@@ -12,7 +12,7 @@
 
 namespace OPENTREP {
 
-  FacPlaceHolder* FacPlaceHolder::_instance = NULL;
+  boost::atomic<FacPlaceHolder*> FacPlaceHolder::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacPlaceHolder::FacPlaceHolder () {
@@ -24,19 +24,28 @@ namespace OPENTREP {
   
   // //////////////////////////////////////////////////////////////////////
   FacPlaceHolder::~FacPlaceHolder () {
-    _instance = NULL;
+    _instance.store (NULL, boost::memory_order_release);
   }
 
   // //////////////////////////////////////////////////////////////////////
   FacPlaceHolder& FacPlaceHolder::instance () {
+    // Once instantiated, the factory is got without any lock
+    FacPlaceHolder* lInstance_ptr = _instance.load (boost::memory_order_acquire);
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacPlaceHolder();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    boost::recursive_mutex::scoped_lock
+      lGuard (FacSupervisor::getInstanceMutex());
+    lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacPlaceHolder();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance.store (lInstance_ptr, boost::memory_order_release);
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -47,7 +56,7 @@ namespace OPENTREP {
     assert (oPlaceHolder_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oPlaceHolder_ptr);
+    addToPool (oPlaceHolder_ptr);
 
     return *oPlaceHolder_ptr;
   }
@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/atomic.hpp>
 // OPENTREP
 #include <opentrep/factory/FacBomAbstract.hpp>
 
@@ -49,7 +51,7 @@ namespace OPENTREP {
 
   private:
     /** The unique instance.*/
-    static FacPlaceHolder* _instance;
+    static boost::atomic<FacPlaceHolder*> _instance;
 
   };
 }
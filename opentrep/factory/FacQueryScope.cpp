@@ -0,0 +1,73 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// C
+#include <cassert>
+// Boost
+#include <boost/thread/tss.hpp>
+// OpenTrep
+#include <opentrep/bom/BomAbstract.hpp>
+#include <opentrep/factory/FacQueryScope.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * The scopes live on the stack of their threads: they must not be
+   * deleted when the threads exit.
+   */
+  static void doNotDeleteScope (FacQueryScope*) {
+  }
+
+  /** Current scope of every thread. */
+  static boost::thread_specific_ptr<FacQueryScope>
+  _currentScope (&doNotDeleteScope);
+
+  // //////////////////////////////////////////////////////////////////////
+  FacQueryScope::FacQueryScope()
+    : _parentScope (NULL), _previousScope (_currentScope.get()) {
+    _currentScope.reset (this);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  FacQueryScope::FacQueryScope (FacQueryScope* ioParentScope_ptr)
+    : _parentScope (ioParentScope_ptr), _previousScope (_currentScope.get()) {
+    _currentScope.reset (this);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  FacQueryScope::~FacQueryScope() {
+    // The objects are released in the reverse order of their instantiation,
+    // even though their destructors do not refer to one another
+    for (FacBomAbstract::BomPool_T::reverse_iterator itBom = _pool.rbegin();
+         itBom != _pool.rend(); ++itBom) {
+      BomAbstract* currentBom_ptr = *itBom;
+      assert (currentBom_ptr != NULL);
+
+      delete (currentBom_ptr); currentBom_ptr = NULL;
+    }
+    _pool.clear();
+
+    // Restore the previous scope
+    assert (_currentScope.get() == this);
+    _currentScope.reset (_previousScope);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  FacQueryScope* FacQueryScope::getCurrentScope() {
+    return _currentScope.get();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void FacQueryScope::adopt (BomAbstract* ioBomAbstract_ptr) {
+    assert (ioBomAbstract_ptr != NULL);
+
+    if (_parentScope != NULL) {
+      _parentScope->adopt (ioBomAbstract_ptr);
+      return;
+    }
+
+    boost::mutex::scoped_lock lGuard (_mutex);
+    _pool.push_back (ioBomAbstract_ptr);
+  }
+
+}
@@ -0,0 +1,122 @@
+#ifndef __OPENTREP_FAC_FACQUERYSCOPE_HPP
+#define __OPENTREP_FAC_FACQUERYSCOPE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/thread/mutex.hpp>
+// OpenTrep
+#include <opentrep/factory/FacBomAbstract.hpp>
+
+namespace OPENTREP {
+
+  // Forward declarations
+  class BomAbstract;
+
+  /**
+   * @brief Memory scope of a single travel query.
+   *
+   * The BOM objects needed to interpret a travel query (Result,
+   * ResultHolder, ResultCombination, PlaceHolder and Place objects)
+   * are instantiated by their respective factories. Without any
+   * release, those objects would pile up with every query, until the
+   * factories get cleaned.
+   *
+   * While a FacQueryScope object is alive, it is the current scope of
+   * the thread having constructed it: all the BOM objects instantiated
+   * by the factories within that thread are handed over to that scope,
+   * rather than to the (shared) pools of the factories. When the scope
+   * is destructed (e.g., when the interpretation of the travel query
+   * returns, normally or through an exception), all those objects, along
+   * with the strings and containers they hold, are released in one shot.
+   *
+   * As every thread has its own current scope, several travel queries
+   * may be interpreted concurrently, without their respective objects
+   * being mixed up. Conversely, when the interpretation of a single travel
+   * query is split into tasks run by several threads, every task opens
+   * a scope bound to the scope of the query: the objects instantiated by
+   * the tasks are then handed over to that latter.
+   *
+   * \note The objects instantiated within a given scope must not be
+   *       referred to after the end of that scope. Only light copies
+   *       (e.g., Location structures) may be handed over to the caller.
+   */
+  class FacQueryScope {
+  public:
+    /**
+     * Constructor. Make that scope the current one within the calling
+     * thread.
+     */
+    FacQueryScope();
+
+    /**
+     * Constructor. Make that scope the current one within the calling
+     * thread, while binding it to the given (parent) scope, which may
+     * belong to another thread: all the objects instantiated within that
+     * scope are handed over to the parent scope.
+     *
+     * @param FacQueryScope* Parent scope (NULL for an independent scope).
+     */
+    explicit FacQueryScope (FacQueryScope*);
+
+    /**
+     * Destructor. Release all the objects instantiated since the
+     * construction of the scope, and restore the previous current scope
+     * (if any) of the calling thread.
+     */
+    ~FacQueryScope();
+
+    /**
+     * Get the current scope of the calling thread.
+     *
+     * @return FacQueryScope* The current scope, or NULL if none.
+     */
+    static FacQueryScope* getCurrentScope();
+
+    /**
+     * Take the ownership of the given (newly instantiated) object, or hand
+     * it over to the parent scope, if any. Several threads may hand their
+     * objects over to the same scope at the same time.
+     *
+     * @param BomAbstract* The object to be deleted with that scope.
+     */
+    void adopt (BomAbstract*);
+
+  private:
+    /**
+     * Copy constructor, not implemented.
+     */
+    FacQueryScope (const FacQueryScope&);
+
+    /**
+     * Assignment operator, not implemented.
+     */
+    FacQueryScope& operator= (const FacQueryScope&);
+
+  private:
+    // ////////////// Attributes ///////////////
+    /**
+     * Objects instantiated within that scope.
+     */
+    FacBomAbstract::BomPool_T _pool;
+
+    /**
+     * Mutex serialising the access to the objects of that scope.
+     */
+    boost::mutex _mutex;
+
+    /**
+     * Parent scope, to which the objects are handed over (NULL when that
+     * scope owns its objects).
+     */
+    FacQueryScope* _parentScope;
+
+    /**
+     * Scope which was current, within the same thread, before that one.
+     */
+    FacQueryScope* _previousScope;
+  };
+
+}
+#endif // __OPENTREP_FAC_FACQUERYSCOPE_HPP
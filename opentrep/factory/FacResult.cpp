@@ -10,7 +10,7 @@
 
 namespace OPENTREP {
 
-  FacResult* FacResult::_instance = NULL;
+  boost::atomic<FacResult*> FacResult::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacResult::FacResult () {
@@ -22,19 +22,28 @@ namespace OPENTREP {
 
   // //////////////////////////////////////////////////////////////////////
   FacResult::~FacResult () {
-    _instance = NULL;
+    _instance.store (NULL, boost::memory_order_release);
   }
 
   // //////////////////////////////////////////////////////////////////////
   FacResult& FacResult::instance () {
+    // Once instantiated, the factory is got without any lock
+    FacResult* lInstance_ptr = _instance.load (boost::memory_order_acquire);
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
+
+    boost::recursive_mutex::scoped_lock
+      lGuard (FacSupervisor::getInstanceMutex());
+    lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacResult();
+      assert (lInstance_ptr != NULL);
 
-    if (_instance == NULL) {
-      _instance = new FacResult();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance.store (lInstance_ptr, boost::memory_order_release);
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -46,7 +55,7 @@ namespace OPENTREP {
     assert (oResult_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oResult_ptr);
+    addToPool (oResult_ptr);
 
     return *oResult_ptr;
   }
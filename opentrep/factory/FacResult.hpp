@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/atomic.hpp>
 // OpenTrep
 #include <opentrep/factory/FacBomAbstract.hpp>
 
@@ -59,7 +61,7 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacResult* _instance;
+    static boost::atomic<FacResult*> _instance;
   };
 }
 #endif // __OPENTREP_FAC_FACRESULT_HPP
@@ -12,7 +12,7 @@
 
 namespace OPENTREP {
 
-  FacResultCombination* FacResultCombination::_instance = NULL;
+  boost::atomic<FacResultCombination*> FacResultCombination::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacResultCombination::FacResultCombination() {
@@ -24,19 +24,28 @@ namespace OPENTREP {
   
   // //////////////////////////////////////////////////////////////////////
   FacResultCombination::~FacResultCombination() {
-    _instance = NULL;
+    _instance.store (NULL, boost::memory_order_release);
   }
 
   // //////////////////////////////////////////////////////////////////////
   FacResultCombination& FacResultCombination::instance() {
+    // Once instantiated, the factory is got without any lock
+    FacResultCombination* lInstance_ptr = _instance.load (boost::memory_order_acquire);
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacResultCombination();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    boost::recursive_mutex::scoped_lock
+      lGuard (FacSupervisor::getInstanceMutex());
+    lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacResultCombination();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance.store (lInstance_ptr, boost::memory_order_release);
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -48,7 +57,7 @@ namespace OPENTREP {
     assert (oResultCombination_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oResultCombination_ptr);
+    addToPool (oResultCombination_ptr);
 
     return *oResultCombination_ptr;
   }
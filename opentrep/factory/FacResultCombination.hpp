@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/atomic.hpp>
 // OpenTREP
 #include <opentrep/factory/FacBomAbstract.hpp>
 #include <opentrep/OPENTREP_Types.hpp>
@@ -76,7 +78,7 @@ namespace OPENTREP {
     /**
      * The unique instance.
      */
-    static FacResultCombination* _instance;
+    static boost::atomic<FacResultCombination*> _instance;
   };
 }
 #endif // __OPENTREP_FAC_FACRESULTCOMBINATION_HPP
@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/atomic.hpp>
 // OpenTREP
 #include <opentrep/factory/FacBomAbstract.hpp>
 #include <opentrep/OPENTREP_Types.hpp>
@@ -56,7 +58,7 @@ namespace OPENTREP {
 
   private:
     /** The unique instance.*/
-    static FacResultHolder* _instance;
+    static boost::atomic<FacResultHolder*> _instance;
 
   };
 }
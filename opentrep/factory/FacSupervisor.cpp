@@ -11,20 +11,37 @@
 
 namespace OPENTREP {
 
-  FacSupervisor* FacSupervisor::_instance = NULL;
+  boost::atomic<FacSupervisor*> FacSupervisor::_instance (NULL);
+
+  /** Mutex protecting the instantiation of the singletons. */
+  static boost::recursive_mutex _instanceMutex;
 
   // //////////////////////////////////////////////////////////////////////
   FacSupervisor::FacSupervisor () :
     _logger (NULL) {
   }
     
+  // //////////////////////////////////////////////////////////////////////
+  boost::recursive_mutex& FacSupervisor::getInstanceMutex() {
+    return _instanceMutex;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   FacSupervisor& FacSupervisor::instance() {
-    if (_instance == NULL) {
-      _instance = new FacSupervisor();
+    // Once instantiated, the supervisor is got without any lock
+    FacSupervisor* lInstance_ptr = _instance.load (boost::memory_order_acquire);
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
+
+    boost::recursive_mutex::scoped_lock lGuard (_instanceMutex);
+    lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacSupervisor();
+      _instance.store (lInstance_ptr, boost::memory_order_release);
     }
 
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -86,12 +103,14 @@ namespace OPENTREP {
   
   // //////////////////////////////////////////////////////////////////////
   void FacSupervisor::cleanFactory () {
-	if (_instance != NULL) {
-		_instance->cleanBomLayer();
-		_instance->cleanServiceLayer();
-		_instance->cleanLoggerService();
+    FacSupervisor* lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+	if (lInstance_ptr != NULL) {
+		lInstance_ptr->cleanBomLayer();
+		lInstance_ptr->cleanServiceLayer();
+		lInstance_ptr->cleanLoggerService();
 	}
-    delete (_instance); _instance = NULL;
+    _instance.store (NULL, boost::memory_order_release);
+    delete (lInstance_ptr); lInstance_ptr = NULL;
   }
 
 }
@@ -6,6 +6,9 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <vector>
+// Boost
+#include <boost/atomic.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 
 namespace OPENTREP {
 
@@ -27,6 +30,15 @@ namespace OPENTREP {
         @return FacSupervisor& */
     static FacSupervisor& instance();
 
+    /** Provides the mutex protecting the instantiation of the singletons
+        (that supervisor, the concrete factories and the Logger).
+        <br>The concrete factories are instantiated when first used, which
+        may happen concurrently within several threads. The mutex is
+        recursive, as a concrete factory registers itself to the
+        supervisor while being instantiated.
+        @return boost::recursive_mutex& */
+    static boost::recursive_mutex& getInstanceMutex();
+
     /** Register a newly instantiated concrete factory for the Bom layer.
         <br>When a concrete Factory is firstly instantiated
         this factory have to register itself to the FacSupervisor
@@ -82,7 +94,7 @@ namespace OPENTREP {
 
   private:
     /** The unique instance.*/
-    static FacSupervisor* _instance;
+    static boost::atomic<FacSupervisor*> _instance;
 
     /** Logger (singleton) instance. */
     Logger* _logger;
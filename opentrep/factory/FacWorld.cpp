@@ -15,23 +15,32 @@
 
 namespace OPENTREP {
 
-  FacWorld* FacWorld::_instance = NULL;
+  boost::atomic<FacWorld*> FacWorld::_instance (NULL);
 
   // //////////////////////////////////////////////////////////////////////
   FacWorld::~FacWorld () {
-    _instance = NULL;
+    _instance.store (NULL, boost::memory_order_release);
   }
 
   // //////////////////////////////////////////////////////////////////////
   FacWorld& FacWorld::instance () {
+    // Once instantiated, the factory is got without any lock
+    FacWorld* lInstance_ptr = _instance.load (boost::memory_order_acquire);
+    if (lInstance_ptr != NULL) {
+      return *lInstance_ptr;
+    }
 
-    if (_instance == NULL) {
-      _instance = new FacWorld();
-      assert (_instance != NULL);
-      
-      FacSupervisor::instance().registerBomFactory (_instance);
+    boost::recursive_mutex::scoped_lock
+      lGuard (FacSupervisor::getInstanceMutex());
+    lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+    if (lInstance_ptr == NULL) {
+      lInstance_ptr = new FacWorld();
+      assert (lInstance_ptr != NULL);
+
+      FacSupervisor::instance().registerBomFactory (lInstance_ptr);
+      _instance.store (lInstance_ptr, boost::memory_order_release);
     }
-    return *_instance;
+    return *lInstance_ptr;
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -42,7 +51,7 @@ namespace OPENTREP {
     assert (oWorld_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oWorld_ptr);
+    addToPool (oWorld_ptr);
 
     return *oWorld_ptr;
   }
@@ -94,7 +103,7 @@ namespace OPENTREP {
     assert (oWorld_ptr != NULL);
 
     // The new object is added to the Bom pool
-    _pool.push_back (oWorld_ptr);
+    addToPool (oWorld_ptr);
 
     return *oWorld_ptr;
   }
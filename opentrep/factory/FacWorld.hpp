@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/atomic.hpp>
 // OpenTrep
 #include <opentrep/factory/FacBomAbstract.hpp>
 
@@ -50,7 +52,7 @@ namespace OPENTREP {
 
   private:
     /** The unique instance.*/
-    static FacWorld* _instance;
+    static boost::atomic<FacWorld*> _instance;
 
   };
 }
@@ -0,0 +1,95 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// OpenTrep
+#include <opentrep/service/LogRingBuffer.hpp>
+
+namespace OPENTREP {
+
+  // //////////////////////////////////////////////////////////////////////
+  LogRingBuffer::LogRingBuffer (const size_t iCapacity)
+    : _mask (0), _enqueuePosition (0), _dequeuePosition (0) {
+    size_t lCapacity = 2;
+    while (lCapacity < iCapacity) {
+      lCapacity <<= 1;
+    }
+    _mask = lCapacity - 1;
+
+    _slotList.reserve (lCapacity);
+    for (size_t idx = 0; idx != lCapacity; ++idx) {
+      Slot* lSlot_ptr = new Slot();
+      assert (lSlot_ptr != NULL);
+      lSlot_ptr->_sequence.store (idx, boost::memory_order_relaxed);
+      _slotList.push_back (lSlot_ptr);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  LogRingBuffer::~LogRingBuffer() {
+    for (SlotList_T::iterator itSlot = _slotList.begin();
+         itSlot != _slotList.end(); ++itSlot) {
+      Slot* lSlot_ptr = *itSlot;
+      delete lSlot_ptr; lSlot_ptr = NULL;
+    }
+    _slotList.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool LogRingBuffer::push (std::string& ioRecord) {
+    size_t lPosition = _enqueuePosition.load (boost::memory_order_relaxed);
+    Slot* lSlot_ptr = NULL;
+    while (true) {
+      lSlot_ptr = _slotList[lPosition & _mask];
+      const size_t lSequence =
+        lSlot_ptr->_sequence.load (boost::memory_order_acquire);
+
+      if (lSequence == lPosition) {
+        // The slot is free: claim the position
+        if (_enqueuePosition.compare_exchange_weak (lPosition, lPosition + 1,
+                                                    boost::memory_order_relaxed)
+            == true) {
+          break;
+        }
+        // Another producer claimed it first; lPosition has been re-loaded
+
+      } else if (lSequence < lPosition) {
+        // The slot still holds the record pushed one lap ago: full buffer
+        return false;
+
+      } else {
+        // Another producer claimed the position in the meantime
+        lPosition = _enqueuePosition.load (boost::memory_order_relaxed);
+      }
+    }
+
+    // Fill, and then publish, the slot
+    assert (lSlot_ptr != NULL);
+    lSlot_ptr->_record.swap (ioRecord);
+    ioRecord.clear();
+    lSlot_ptr->_sequence.store (lPosition + 1, boost::memory_order_release);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool LogRingBuffer::pop (std::string& ioRecord) {
+    Slot* lSlot_ptr = _slotList[_dequeuePosition & _mask];
+    const size_t lSequence =
+      lSlot_ptr->_sequence.load (boost::memory_order_acquire);
+    if (lSequence != _dequeuePosition + 1) {
+      // The slot has not been published yet: empty buffer
+      return false;
+    }
+
+    ioRecord.swap (lSlot_ptr->_record);
+    lSlot_ptr->_record.clear();
+
+    // Free the slot for the producers of the next lap
+    lSlot_ptr->_sequence.store (_dequeuePosition + _mask + 1,
+                                boost::memory_order_release);
+    ++_dequeuePosition;
+    return true;
+  }
+
+}
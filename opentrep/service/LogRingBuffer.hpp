@@ -0,0 +1,131 @@
+#ifndef __OPENTREP_SVC_LOGRINGBUFFER_HPP
+#define __OPENTREP_SVC_LOGRINGBUFFER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// Boost
+#include <boost/atomic.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Bounded ring buffer of (pre-formatted) log records, into which
+   *        several threads push concurrently, and from which a single
+   *        thread pops.
+   *
+   * The producers never take any lock: every slot carries a sequence
+   * number, telling whether it is free for the producer claiming a given
+   * position, or filled for the consumer expecting that position
+   * (D. Vyukov's bounded queue). A producer claims a position with a
+   * single compare-and-swap, moves its record into the slot, and then
+   * publishes the slot by updating its sequence number.
+   *
+   * \note Only one thread at a time may pop records (see pop()).
+   */
+  class LogRingBuffer {
+  public:
+    // //////////////// Business Methods //////////////////
+    /**
+     * Push the given record, if there is room for it. The content of the
+     * record is moved into the buffer (the given string is left empty).
+     *
+     * @param std::string& Log record.
+     * @return bool Whether the record has been pushed (false when the
+     *         buffer is full).
+     */
+    bool push (std::string& ioRecord);
+
+    /**
+     * Pop the oldest record, if any.
+     *
+     * @param std::string& Log record, replaced by the popped one.
+     * @return bool Whether a record has been popped (false when the
+     *         buffer is empty).
+     */
+    bool pop (std::string& ioRecord);
+
+    /**
+     * Get the number of slots of the buffer.
+     */
+    size_t getCapacity() const {
+      return _slotList.size();
+    }
+
+  public:
+    // //////////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor.
+     *
+     * @param const size_t Minimal number of slots. It is rounded up to
+     *        the next power of two (and to at least 2).
+     */
+    LogRingBuffer (const size_t iCapacity);
+
+    /**
+     * Destructor.
+     */
+    ~LogRingBuffer();
+
+  private:
+    /**
+     * Default constructor, not implemented.
+     */
+    LogRingBuffer();
+
+    /**
+     * Copy constructor, not implemented.
+     */
+    LogRingBuffer (const LogRingBuffer&);
+
+  private:
+    // //////////////// Type definitions //////////////////
+    /**
+     * Slot of the buffer.
+     */
+    struct Slot {
+      /**
+       * Sequence number: equal to the position when the slot is free for
+       * that position, and to the position plus one once it is filled.
+       */
+      boost::atomic<size_t> _sequence;
+
+      /**
+       * Log record.
+       */
+      std::string _record;
+    };
+
+    /**
+     * List of slots.
+     */
+    typedef std::vector<Slot*> SlotList_T;
+
+  private:
+    // //////////////// Attributes ///////////////
+    /**
+     * Slots of the buffer.
+     */
+    SlotList_T _slotList;
+
+    /**
+     * Mask giving the index of the slot of a position.
+     */
+    size_t _mask;
+
+    /**
+     * Next position to be claimed by the producers.
+     */
+    boost::atomic<size_t> _enqueuePosition;
+
+    /**
+     * Next position to be popped by the consumer.
+     */
+    size_t _dequeuePosition;
+  };
+
+}
+#endif // __OPENTREP_SVC_LOGRINGBUFFER_HPP
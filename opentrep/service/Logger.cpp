@@ -5,13 +5,18 @@
 #include <assert.h>
 // STL
 #include <iostream>
+// Boost
+#include <boost/bind.hpp>
 // Opentrep Logger
+#include <opentrep/basic/BasConst_General.hpp>
 #include <opentrep/factory/FacSupervisor.hpp>
+#include <opentrep/service/LogRingBuffer.hpp>
 #include <opentrep/service/Logger.hpp>
 
 namespace OPENTREP {
 
-    Logger* Logger::_instance = NULL;
+    boost::atomic<Logger*> Logger::_instance (NULL);
+    LOG::EN_LogLevel Logger::_activeLevel = LOG::DEBUG;
   
     // //////////////////////////////////////////////////////////////////////
     Logger::Logger () : _logStream (&std::cout) {
@@ -25,12 +30,26 @@ namespace OPENTREP {
 
     // //////////////////////////////////////////////////////////////////////
     Logger::Logger (const LOG::EN_LogLevel iLevel, std::ostream& ioLogStream) 
-      : _level (iLevel), _logStream (&ioLogStream) {
+      : _level (iLevel), _logStream (&ioLogStream), _ringBuffer (NULL),
+        _writerThread (NULL), _nbOfWriterUsers (0), _isAsync (false),
+        _overflowPolicy (LOG::DROP_RECORDS), _nbOfDroppedRecords (0),
+        _nbOfReportedDroppedRecords (0) {
+      _activeLevel = iLevel;
     }
 
     // //////////////////////////////////////////////////////////////////////
     Logger::~Logger () {
+      {
+        boost::mutex::scoped_lock lGuard (_writerMutex);
+        _nbOfWriterUsers = 1;
+      }
+      stopAsyncWriter();
+
+      delete _ringBuffer; _ringBuffer = NULL;
       _logStream = NULL;
+
+      // The next call to instance() instantiates a new logger
+      _instance.store (NULL, boost::memory_order_release);
     }
 
     // //////////////////////////////////////////////////////////////////////
@@ -47,20 +66,183 @@ namespace OPENTREP {
     // //////////////////////////////////////////////////////////////////////
     void Logger::setLogParameters (const LOG::EN_LogLevel iLogLevel, 
                                    std::ostream& ioLogStream) {
+      // The pending log entries go onto the former log stream
+      while (writePendingRecords() == true) {
+      }
+
+      boost::mutex::scoped_lock lGuard (_logMutex);
       _level = iLogLevel;
+      _activeLevel = iLogLevel;
       _logStream = &ioLogStream;
     }
 
+    // //////////////////////////////////////////////////////////////////////
+    void Logger::setLogLevel (const LOG::EN_LogLevel iLogLevel) {
+      boost::mutex::scoped_lock lGuard (_logMutex);
+      _level = iLogLevel;
+      _activeLevel = iLogLevel;
+    }
+
+    // //////////////////////////////////////////////////////////////////////
+    void Logger::
+    startAsyncWriter (const NbOfLogRecords_T iBufferSize,
+                      const LOG::EN_OverflowPolicy iOverflowPolicy) {
+      boost::mutex::scoped_lock lGuard (_writerMutex);
+      _overflowPolicy.store (iOverflowPolicy);
+
+      ++_nbOfWriterUsers;
+      if (_writerThread != NULL) {
+        return;
+      }
+
+      // The ring buffer is never released while the logger exists, as
+      // a thread may still be pushing into it when the writer is stopped
+      if (_ringBuffer == NULL) {
+        _ringBuffer = new LogRingBuffer (iBufferSize);
+      }
+      assert (_ringBuffer != NULL);
+
+      _writerThread =
+        new boost::thread (boost::bind (&Logger::runAsyncWriter, this));
+      _isAsync.store (true, boost::memory_order_release);
+    }
+
+    // //////////////////////////////////////////////////////////////////////
+    void Logger::stopAsyncWriter() {
+      boost::mutex::scoped_lock lGuard (_writerMutex);
+      if (_nbOfWriterUsers == 0) {
+        return;
+      }
+      --_nbOfWriterUsers;
+      if (_nbOfWriterUsers != 0 || _writerThread == NULL) {
+        return;
+      }
+
+      // From now on, the log entries are written synchronously
+      _isAsync.store (false, boost::memory_order_release);
+      _writerThread->interrupt();
+      _writerThread->join();
+      delete _writerThread; _writerThread = NULL;
+
+      flush();
+    }
+
+    // //////////////////////////////////////////////////////////////////////
+    void Logger::
+    setOverflowPolicy (const LOG::EN_OverflowPolicy iOverflowPolicy) {
+      _overflowPolicy.store (iOverflowPolicy);
+    }
+
+    // //////////////////////////////////////////////////////////////////////
+    NbOfLogRecords_T Logger::getNbOfDroppedRecords() const {
+      return _nbOfDroppedRecords.load (boost::memory_order_relaxed);
+    }
+
+    // //////////////////////////////////////////////////////////////////////
+    bool Logger::pushRecord (std::string& ioRecord) {
+      assert (_ringBuffer != NULL);
+      while (_ringBuffer->push (ioRecord) == false) {
+        if (_overflowPolicy.load (boost::memory_order_relaxed)
+            == LOG::DROP_RECORDS) {
+          _nbOfDroppedRecords.fetch_add (1, boost::memory_order_relaxed);
+          return true;
+        }
+
+        // Wait for the writer to make some room, as long as it is running
+        if (_isAsync.load (boost::memory_order_acquire) == false) {
+          return false;
+        }
+        boost::this_thread::yield();
+      }
+      return true;
+    }
+
+    // //////////////////////////////////////////////////////////////////////
+    bool Logger::writePendingRecords() {
+      if (_ringBuffer == NULL) {
+        return false;
+      }
+
+      boost::mutex::scoped_lock lConsumerGuard (_consumerMutex);
+      std::string lBatch;
+      std::string lRecord;
+      NbOfLogRecords_T lNbOfRecords = 0;
+      while (lNbOfRecords != K_LOG_WRITER_BATCH_SIZE
+             && _ringBuffer->pop (lRecord) == true) {
+        lBatch += lRecord;
+        lBatch += '\n';
+        ++lNbOfRecords;
+      }
+
+      // Report the log entries dropped since the last batch, if any
+      const NbOfLogRecords_T lNbOfDroppedRecords = getNbOfDroppedRecords();
+      if (lNbOfDroppedRecords != _nbOfReportedDroppedRecords) {
+        std::ostringstream lDropStr;
+        lDropStr << __FILE__ << ":" << __LINE__ << ": "
+                 << (lNbOfDroppedRecords - _nbOfReportedDroppedRecords)
+                 << " log entries have been dropped, as the log buffer was"
+                 << " full (" << lNbOfDroppedRecords << " in total)\n";
+        lBatch += lDropStr.str();
+        _nbOfReportedDroppedRecords = lNbOfDroppedRecords;
+      }
+
+      if (lBatch.empty() == true) {
+        return false;
+      }
+
+      boost::mutex::scoped_lock lGuard (_logMutex);
+      assert (_logStream != NULL);
+      _logStream->write (lBatch.data(), lBatch.size());
+      _logStream->flush();
+      return true;
+    }
+
+    // //////////////////////////////////////////////////////////////////////
+    void Logger::runAsyncWriter() {
+      const boost::posix_time::milliseconds
+        lIdlePeriod (K_LOG_WRITER_IDLE_PERIOD);
+
+      // The writer is interrupted (while sleeping) when stopped. The
+      // remaining log entries are then written by stopAsyncWriter()
+      while (true) {
+        if (writePendingRecords() == false) {
+          boost::this_thread::sleep (lIdlePeriod);
+        }
+        boost::this_thread::interruption_point();
+      }
+    }
+
+    // //////////////////////////////////////////////////////////////////////
+    void Logger::flush() {
+      while (writePendingRecords() == true) {
+      }
+
+      boost::mutex::scoped_lock lGuard (_logMutex);
+      assert (_logStream != NULL);
+      _logStream->flush();
+    }
+
     // //////////////////////////////////////////////////////////////////////
     Logger& Logger::instance() {
-      if (_instance == NULL) {
-        _instance = new Logger (LOG::DEBUG, std::cout);
+      // Once instantiated, the logger is got without any lock, so that
+      // the threads issuing log entries do not wait for one another
+      Logger* lInstance_ptr = _instance.load (boost::memory_order_acquire);
+      if (lInstance_ptr != NULL) {
+        return *lInstance_ptr;
+      }
+
+      boost::recursive_mutex::scoped_lock
+        lGuard (FacSupervisor::getInstanceMutex());
+      lInstance_ptr = _instance.load (boost::memory_order_relaxed);
+      if (lInstance_ptr == NULL) {
+        lInstance_ptr = new Logger (LOG::DEBUG, std::cout);
         
-        assert (_instance != NULL);
+        assert (lInstance_ptr != NULL);
 
-        FacSupervisor::instance().registerLoggerService (_instance);
+        FacSupervisor::instance().registerLoggerService (lInstance_ptr);
+        _instance.store (lInstance_ptr, boost::memory_order_release);
       }
-      return *_instance;
+      return *lInstance_ptr;
     }
 
 }
@@ -9,13 +9,43 @@
 // STL
 #include <sstream>
 #include <string>
+// Boost
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 // OPENTREP
 #include <opentrep/OPENTREP_Types.hpp>
 
 // /////////////// LOG MACROS /////////////////
+/**
+ * Most detailed level of the logs compiled in. The log entries of a more
+ * detailed level are stripped by the compiler. By default, the debug and
+ * verbose entries are stripped from the release builds (i.e., when NDEBUG
+ * is defined). That may be overridden at build time, for instance with
+ * -DOPENTREP_LOG_MAX_LEVEL=4 (i.e., OPENTREP::LOG::DEBUG).
+ */
+#ifndef OPENTREP_LOG_MAX_LEVEL
+#  ifdef NDEBUG
+#    define OPENTREP_LOG_MAX_LEVEL OPENTREP::LOG::WARNING
+#  else
+#    define OPENTREP_LOG_MAX_LEVEL OPENTREP::LOG::VERBOSE
+#  endif
+#endif
+
+/**
+ * Whether the log entries of the given level are to be written. Neither
+ * the Logger instance nor its mutex are involved, so that the check is
+ * cheap enough to be made before the log entry is formatted.
+ */
+#define OPENTREP_LOG_IS_ENABLED(iLevel) \
+  ((iLevel) <= (OPENTREP_LOG_MAX_LEVEL) \
+   && OPENTREP::Logger::isEnabled (iLevel))
+
 #define OPENTREP_LOG_CORE(iLevel, iToBeLogged) \
-  { std::ostringstream ostr; ostr << iToBeLogged; \
-    OPENTREP::Logger::instance().log (iLevel, __LINE__, __FILE__, ostr.str()); }
+  { if (OPENTREP_LOG_IS_ENABLED (iLevel)) { \
+      std::ostringstream ostr; ostr << iToBeLogged; \
+      OPENTREP::Logger::instance().log (iLevel, __LINE__, __FILE__, \
+                                        ostr.str()); } }
 
 #define OPENTREP_LOG_CRITICAL(iToBeLogged) \
   OPENTREP_LOG_CORE (OPENTREP::LOG::CRITICAL, iToBeLogged)
@@ -39,9 +69,25 @@
 
 namespace OPENTREP {
 
+  // Forward declarations
+  class LogRingBuffer;
+
   /** Class holding the stream for logs. 
       <br>Note that the error logs are seen as standard output logs, 
-      but with a higher level of visibility. */
+      but with a higher level of visibility.
+      <br>The log entries may be issued concurrently by several threads:
+      each entry is written in one go, under the protection of a mutex,
+      so that the entries of different threads are not interleaved.
+      <br>The log macros check the level (see isEnabled()) before
+      formatting the log entry, so that a disabled log entry costs
+      a mere comparison.
+      <br>When the asynchronous writer is started (see startAsyncWriter()),
+      the formatted log entries are pushed into a lock-free ring buffer,
+      and written, by batches, by a background thread: the threads
+      issuing log entries then never wait for the log stream. When the
+      ring buffer is full, the log entries are either dropped (and
+      counted), or the issuing threads wait for some room, according to
+      the overflow policy. */
   class Logger {
     // Friend classes
     friend class FacSupervisor;
@@ -52,6 +98,17 @@ namespace OPENTREP {
     void log (const LOG::EN_LogLevel iLevel, const int iLineNumber,
               const std::string& iFileName, const T& iToBeLogged) {
       if (iLevel <= _level) {
+        if (_isAsync.load (boost::memory_order_acquire) == true) {
+          std::ostringstream lRecordStr;
+          lRecordStr << iFileName << ":" << iLineNumber
+                     << ": " << iToBeLogged;
+          std::string lRecord = lRecordStr.str();
+          if (pushRecord (lRecord) == true) {
+            return;
+          }
+        }
+
+        boost::mutex::scoped_lock lGuard (_logMutex);
         assert (_logStream != NULL);
         *_logStream << iFileName << ":" << iLineNumber
                     << ": " << iToBeLogged << std::endl;
@@ -60,6 +117,12 @@ namespace OPENTREP {
     
     /** Get the log level. */
     LOG::EN_LogLevel getLogLevel();
+
+    /** State whether the log entries of the given level are to be
+        written, with respect to the current log level. */
+    static bool isEnabled (const LOG::EN_LogLevel iLevel) {
+      return (iLevel <= _activeLevel);
+    }
     
     /** get the log stream. */
     std::ostream& getLogStream();
@@ -67,6 +130,31 @@ namespace OPENTREP {
     /** Set the logger parameters (level and stream). */
     void setLogParameters (const LOG::EN_LogLevel iLogLevel, 
                            std::ostream& ioLogStream);
+
+    /** Set the log level, keeping the same log stream. */
+    void setLogLevel (const LOG::EN_LogLevel iLogLevel);
+
+    /** Start the asynchronous writer, if not already started. Every start
+        must be matched by a stop (see stopAsyncWriter()): the writer is
+        stopped only when all its users have stopped it.
+        <br>The size of the ring buffer is the one given when the writer
+        is started for the first time. */
+    void startAsyncWriter (const NbOfLogRecords_T iBufferSize,
+                           const LOG::EN_OverflowPolicy iOverflowPolicy);
+
+    /** Stop the asynchronous writer, once the pending log entries have
+        been written. The log entries are then written synchronously. */
+    void stopAsyncWriter();
+
+    /** Set the policy applied when the ring buffer is full. */
+    void setOverflowPolicy (const LOG::EN_OverflowPolicy iOverflowPolicy);
+
+    /** Write the pending log entries, and flush the log stream. */
+    void flush();
+
+    /** Get the number of log entries dropped, so far, because the ring
+        buffer was full. */
+    NbOfLogRecords_T getNbOfDroppedRecords() const;
     
     /** Returns a current Logger instance.*/
     static Logger& instance();
@@ -79,6 +167,20 @@ namespace OPENTREP {
     Logger (const LOG::EN_LogLevel iLevel, std::ostream& ioLogStream);
     /** Destructor. */
     ~Logger ();
+
+  private:
+    /** Push the given log entry into the ring buffer, according to the
+        overflow policy.
+        @return bool Whether the log entry has been dealt with (pushed or
+        dropped); false when it is to be written synchronously. */
+    bool pushRecord (std::string& ioRecord);
+
+    /** Write, in one go, a batch of the pending log entries.
+        @return bool Whether there was anything to be written. */
+    bool writePendingRecords();
+
+    /** Main loop of the asynchronous writer. */
+    void runAsyncWriter();
     
   private:
     /** Log level. */
@@ -86,9 +188,45 @@ namespace OPENTREP {
     
     /** Stream dedicated to the logs. */
     std::ostream* _logStream;
+
+    /** Mutex serialising the writes onto the log stream. */
+    boost::mutex _logMutex;
+
+    /** Ring buffer of the log entries to be written asynchronously. */
+    LogRingBuffer* _ringBuffer;
+
+    /** Background thread writing the log entries of the ring buffer. */
+    boost::thread* _writerThread;
+
+    /** Number of users of the asynchronous writer. */
+    unsigned int _nbOfWriterUsers;
+
+    /** Mutex serialising the starts and stops of the writer. */
+    boost::mutex _writerMutex;
+
+    /** Mutex ensuring that a single thread at a time pops log entries
+        from the ring buffer (the writer or a thread flushing the logs). */
+    boost::mutex _consumerMutex;
+
+    /** Whether the log entries are to be pushed into the ring buffer. */
+    boost::atomic<bool> _isAsync;
+
+    /** Policy applied when the ring buffer is full. */
+    boost::atomic<int> _overflowPolicy;
+
+    /** Number of log entries dropped, so far. */
+    boost::atomic<NbOfLogRecords_T> _nbOfDroppedRecords;
+
+    /** Number of dropped log entries already reported in the logs. */
+    NbOfLogRecords_T _nbOfReportedDroppedRecords;
     
     /** Instance object.*/
-    static Logger* _instance;
+    static boost::atomic<Logger*> _instance;
+
+    /** Copy of the log level, readable without the instance object
+        (and without any lock): it is changed only when the logger
+        parameters are set. */
+    static LOG::EN_LogLevel _activeLevel;
   };
   
 }
@@ -3,37 +3,252 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <fstream>
 #include <ostream>
 // Boost
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/ptime.hpp>
+#include <boost/filesystem.hpp>
+// Xapian
+#include <xapian.h>
 // SOCI
 #include <soci/soci.h>
 // OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
 #include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
 #include <opentrep/basic/BasChronometer.hpp>
+#include <opentrep/basic/BasThreadPool.hpp>
+#include <opentrep/bom/QuerySlices.hpp>
+#include <opentrep/bom/WordPairTable.hpp>
+#include <opentrep/bom/SpellingDictionary.hpp>
+#include <opentrep/bom/TermVocabulary.hpp>
+#include <opentrep/bom/CodeIndex.hpp>
 #include <opentrep/factory/FacWorld.hpp>
 #include <opentrep/command/DBManager.hpp>
 #include <opentrep/command/IndexBuilder.hpp>
 #include <opentrep/command/XapianIndexManager.hpp>
+#include <opentrep/command/XapianDatabasePool.hpp>
 #include <opentrep/command/RequestInterpreter.hpp>
 #include <opentrep/factory/FacOpenTrepServiceContext.hpp>
 #include <opentrep/service/OPENTREP_ServiceContext.hpp>
 #include <opentrep/service/ServiceUtilities.hpp>
+#include <opentrep/service/ResultCache.hpp>
 #include <opentrep/service/Logger.hpp>
+#include <opentrep/service/StatisticsRecorder.hpp>
 #include <opentrep/OPENTREP_Service.hpp>
 
 namespace OPENTREP {
 
+  /**
+   * Get the table of the adjacent word pairs of the given revision of the
+   * Xapian index. The table is (re-)loaded from the directory of the index
+   * only when the revision of that latter has changed.
+   *
+   * @return WordPairTablePtr_T The table, or NULL when it is not available
+   *         (e.g., when the index has been built by a former version).
+   */
+  // //////////////////////////////////////////////////////////////////////
+  WordPairTablePtr_T
+  getWordPairTable (OPENTREP_ServiceContext& ioOPENTREP_ServiceContext,
+                    const IndexRevision_T& iIndexRevision) {
+    boost::mutex::scoped_lock
+      lGuard (ioOPENTREP_ServiceContext.getWordPairTableMutex());
+
+    // The table is already up-to-date
+    const IndexRevision_T& lTableRevision =
+      ioOPENTREP_ServiceContext.getWordPairTableRevision();
+    if (lTableRevision == iIndexRevision) {
+      return ioOPENTREP_ServiceContext.getWordPairTable();
+    }
+
+    // Retrieve the file-path of the table, within the directory of the index
+    const TravelDBFilePath_T& lTravelDBFilePathStr =
+      ioOPENTREP_ServiceContext.getTravelDBFilePath();
+    const boost::filesystem::path lTravelDBFilePath (lTravelDBFilePathStr.begin(),
+                                                     lTravelDBFilePathStr.end());
+    const boost::filesystem::path lWordPairTableFilePath =
+      lTravelDBFilePath / K_WORD_PAIR_TABLE_FILENAME;
+
+    // Load the table
+    boost::shared_ptr<WordPairTable> lWordPairTable_ptr (new WordPairTable());
+    const bool hasBeenLoaded =
+      lWordPairTable_ptr->load (lWordPairTableFilePath.string());
+    if (hasBeenLoaded == true) {
+      // DEBUG
+      OPENTREP_LOG_DEBUG (lWordPairTable_ptr->describe() << " loaded from '"
+                          << lWordPairTableFilePath.string() << "'");
+
+    } else {
+      OPENTREP_LOG_NOTIFICATION ("The table of the word pairs ('"
+                                 << lWordPairTableFilePath.string()
+                                 << "') cannot be read. The Xapian index "
+                                 << "will be queried for every word pair.");
+      lWordPairTable_ptr.reset();
+    }
+
+    ioOPENTREP_ServiceContext.setWordPairTable (iIndexRevision,
+                                                lWordPairTable_ptr);
+    return ioOPENTREP_ServiceContext.getWordPairTable();
+  }
+
+  /**
+   * Get the spelling dictionary of the given revision of the Xapian index.
+   * The dictionary is (re-)loaded from the directory of the index only when
+   * the revision of that latter has changed.
+   *
+   * @return SpellingDictionaryPtr_T The dictionary, or NULL when it is not
+   *         available (e.g., when the index has been built by a former
+   *         version).
+   */
+  // //////////////////////////////////////////////////////////////////////
+  SpellingDictionaryPtr_T
+  getSpellingDictionary (OPENTREP_ServiceContext& ioOPENTREP_ServiceContext,
+                         const IndexRevision_T& iIndexRevision) {
+    boost::mutex::scoped_lock
+      lGuard (ioOPENTREP_ServiceContext.getSpellingDictionaryMutex());
+
+    // The dictionary is already up-to-date
+    const IndexRevision_T& lDictionaryRevision =
+      ioOPENTREP_ServiceContext.getSpellingDictionaryRevision();
+    if (lDictionaryRevision == iIndexRevision) {
+      return ioOPENTREP_ServiceContext.getSpellingDictionary();
+    }
+
+    // Retrieve the file-path of the dictionary, within the directory of
+    // the index
+    const TravelDBFilePath_T& lTravelDBFilePathStr =
+      ioOPENTREP_ServiceContext.getTravelDBFilePath();
+    const boost::filesystem::path lTravelDBFilePath (lTravelDBFilePathStr.begin(),
+                                                     lTravelDBFilePathStr.end());
+    const boost::filesystem::path lDictionaryFilePath =
+      lTravelDBFilePath / K_SPELLING_DICTIONARY_FILENAME;
+
+    // Load the dictionary
+    boost::shared_ptr<SpellingDictionary>
+      lSpellingDictionary_ptr (new SpellingDictionary());
+    const bool hasBeenLoaded =
+      lSpellingDictionary_ptr->load (lDictionaryFilePath.string());
+    if (hasBeenLoaded == true) {
+      // DEBUG
+      OPENTREP_LOG_DEBUG (lSpellingDictionary_ptr->describe()
+                          << " loaded from '" << lDictionaryFilePath.string()
+                          << "'");
+
+    } else {
+      OPENTREP_LOG_NOTIFICATION ("The spelling dictionary ('"
+                                 << lDictionaryFilePath.string()
+                                 << "') cannot be read. The spelling "
+                                 << "corrections will be sought within "
+                                 << "the Xapian index.");
+      lSpellingDictionary_ptr.reset();
+    }
+
+    ioOPENTREP_ServiceContext.setSpellingDictionary (iIndexRevision,
+                                                     lSpellingDictionary_ptr);
+    return ioOPENTREP_ServiceContext.getSpellingDictionary();
+  }
+
+  /**
+   * Get the vocabulary of the given revision of the Xapian index. The
+   * vocabulary is (re-)mapped from the directory of the index only when
+   * the revision of that latter has changed.
+   *
+   * @return TermVocabularyPtr_T The vocabulary, or NULL when it is not
+   *         available (e.g., when the index has been built by a former
+   *         version).
+   */
+  // //////////////////////////////////////////////////////////////////////
+  TermVocabularyPtr_T
+  getTermVocabulary (OPENTREP_ServiceContext& ioOPENTREP_ServiceContext,
+                     const IndexRevision_T& iIndexRevision) {
+    boost::mutex::scoped_lock
+      lGuard (ioOPENTREP_ServiceContext.getTermVocabularyMutex());
+
+    // The vocabulary is already up-to-date
+    const IndexRevision_T& lVocabularyRevision =
+      ioOPENTREP_ServiceContext.getTermVocabularyRevision();
+    if (lVocabularyRevision == iIndexRevision) {
+      return ioOPENTREP_ServiceContext.getTermVocabulary();
+    }
+
+    // Retrieve the file-path of the vocabulary, within the directory of
+    // the index
+    const TravelDBFilePath_T& lTravelDBFilePathStr =
+      ioOPENTREP_ServiceContext.getTravelDBFilePath();
+    const boost::filesystem::path lTravelDBFilePath (lTravelDBFilePathStr.begin(),
+                                                     lTravelDBFilePathStr.end());
+    const boost::filesystem::path lVocabularyFilePath =
+      lTravelDBFilePath / K_TERM_VOCABULARY_FILENAME;
+
+    // Map the vocabulary
+    boost::shared_ptr<TermVocabulary>
+      lTermVocabulary_ptr (new TermVocabulary());
+    const bool hasBeenLoaded =
+      lTermVocabulary_ptr->load (lVocabularyFilePath.string());
+    if (hasBeenLoaded == true) {
+      // DEBUG
+      OPENTREP_LOG_DEBUG (lTermVocabulary_ptr->describe()
+                          << " mapped from '" << lVocabularyFilePath.string()
+                          << "'");
+
+    } else {
+      OPENTREP_LOG_NOTIFICATION ("The vocabulary ('"
+                                 << lVocabularyFilePath.string()
+                                 << "') cannot be mapped. The unknown words "
+                                 << "will be detected by the Xapian index.");
+      lTermVocabulary_ptr.reset();
+    }
+
+    ioOPENTREP_ServiceContext.setTermVocabulary (iIndexRevision,
+                                                 lTermVocabulary_ptr);
+    return ioOPENTREP_ServiceContext.getTermVocabulary();
+  }
+
+  /**
+   * Get the in-memory index of the POR by code, corresponding to the given
+   * revision of the Xapian index. The index is (re-)built from the Xapian
+   * index only when the revision of that latter has changed.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  CodeIndexPtr_T
+  getCodeIndex (OPENTREP_ServiceContext& ioOPENTREP_ServiceContext,
+                const Xapian::Database& iXapianDatabase,
+                const IndexRevision_T& iIndexRevision) {
+    boost::mutex::scoped_lock
+      lGuard (ioOPENTREP_ServiceContext.getCodeIndexMutex());
+
+    // The index is already up-to-date
+    const IndexRevision_T& lCodeIndexRevision =
+      ioOPENTREP_ServiceContext.getCodeIndexRevision();
+    if (lCodeIndexRevision == iIndexRevision) {
+      return ioOPENTREP_ServiceContext.getCodeIndex();
+    }
+
+    // Build the index from the documents of the Xapian index
+    BasChronometer lCodeIndexChronometer;
+    lCodeIndexChronometer.start();
+    boost::shared_ptr<CodeIndex> lCodeIndex_ptr (new CodeIndex());
+    XapianIndexManager::buildCodeIndex (iXapianDatabase, *lCodeIndex_ptr);
+    const double lCodeIndexMeasure = lCodeIndexChronometer.elapsed();
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG (lCodeIndex_ptr->describe() << " built in "
+                        << lCodeIndexMeasure << "s");
+
+    ioOPENTREP_ServiceContext.setCodeIndex (iIndexRevision, lCodeIndex_ptr);
+    return ioOPENTREP_ServiceContext.getCodeIndex();
+  }
+
   // //////////////////////////////////////////////////////////////////////
   OPENTREP_Service::
   OPENTREP_Service (std::ostream& ioLogStream, const PORFilePath_T& iPORFilepath,
                     const TravelDBFilePath_T& iTravelDBFilePath,
                     const DBType& iSQLDBType,
-                    const SQLDBConnectionString_T& iSQLDBConnStr)
+                    const SQLDBConnectionString_T& iSQLDBConnStr,
+                    const LOG::EN_LogLevel& iLogLevel)
     : _opentrepServiceContext (NULL) {
     init (ioLogStream, iPORFilepath, iTravelDBFilePath,
-          iSQLDBType, iSQLDBConnStr);
+          iSQLDBType, iSQLDBConnStr, iLogLevel);
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -41,9 +256,11 @@ namespace OPENTREP {
   OPENTREP_Service (std::ostream& ioLogStream,
                     const TravelDBFilePath_T& iTravelDBFilePath,
                     const DBType& iSQLDBType,
-                    const SQLDBConnectionString_T& iSQLDBConnStr)
+                    const SQLDBConnectionString_T& iSQLDBConnStr,
+                    const LOG::EN_LogLevel& iLogLevel)
     : _opentrepServiceContext (NULL) {
-    init (ioLogStream, iTravelDBFilePath, iSQLDBType, iSQLDBConnStr);
+    init (ioLogStream, iTravelDBFilePath, iSQLDBType, iSQLDBConnStr,
+          iLogLevel);
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -65,7 +282,13 @@ namespace OPENTREP {
   // //////////////////////////////////////////////////////////////////////
   void logInit (const LOG::EN_LogLevel iLogLevel,
                 std::ostream& ioLogOutputFile) {
-    Logger::instance().setLogParameters (iLogLevel, ioLogOutputFile);
+    Logger& lLogger = Logger::instance();
+    lLogger.setLogParameters (iLogLevel, ioLogOutputFile);
+
+    // The log entries are written by a background thread, so that the
+    // search threads do not wait for the log file
+    lLogger.startAsyncWriter (DEFAULT_OPENTREP_LOG_BUFFER_SIZE,
+                              DEFAULT_OPENTREP_LOG_OVERFLOW_POLICY);
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -87,9 +310,10 @@ namespace OPENTREP {
   void OPENTREP_Service::init (std::ostream& ioLogStream,
                                const TravelDBFilePath_T& iTravelDBFilePath,
                                const DBType& iSQLDBType,
-                               const SQLDBConnectionString_T& iSQLDBConnStr) {
-    // Set the log file
-    logInit (LOG::DEBUG, ioLogStream);
+                               const SQLDBConnectionString_T& iSQLDBConnStr,
+                               const LOG::EN_LogLevel& iLogLevel) {
+    // Set the log file and level
+    logInit (iLogLevel, ioLogStream);
 
     // Fix the SQL database connection string, if needed
     const SQLDBConnectionString_T& lSQLDBConnStr =
@@ -104,6 +328,31 @@ namespace OPENTREP {
     // Instanciate an empty World object
     World& lWorld = FacWorld::instance().create();
     lOPENTREP_ServiceContext.setWorld (lWorld);
+
+    // Open the Xapian database (index), once for all, when it already exists.
+    // Otherwise, it will be opened when first needed (e.g., once the index
+    // has been built).
+    const boost::filesystem::path lTravelDBFilePath (iTravelDBFilePath.begin(),
+                                                     iTravelDBFilePath.end());
+    if (boost::filesystem::is_directory (lTravelDBFilePath) == true) {
+      refreshXapianDatabase();
+
+      // Build the in-memory index of the POR by code, so that the first
+      // travel queries do not have to wait for it. A failure is not fatal
+      // at that stage, as the index is re-built when first needed.
+      try {
+        const Xapian::Database& lXapianDatabase =
+          lOPENTREP_ServiceContext.getXapianDatabaseHandler();
+        const IndexRevision_T& lIndexRevision =
+          XapianIndexManager::getRevision (lXapianDatabase);
+        getCodeIndex (lOPENTREP_ServiceContext, lXapianDatabase,
+                      lIndexRevision);
+
+      } catch (const RootException& lException) {
+        OPENTREP_LOG_NOTIFICATION ("The index of the POR by code cannot be "
+                                   << "built for now: " << lException.what());
+      }
+    }
   }
   
   // //////////////////////////////////////////////////////////////////////
@@ -111,9 +360,10 @@ namespace OPENTREP {
                                const PORFilePath_T& iPORFilepath,
                                const TravelDBFilePath_T& iTravelDBFilePath,
                                const DBType& iSQLDBType,
-                               const SQLDBConnectionString_T& iSQLDBConnStr) {
-    // Set the log file
-    logInit (LOG::DEBUG, ioLogStream);
+                               const SQLDBConnectionString_T& iSQLDBConnStr,
+                               const LOG::EN_LogLevel& iLogLevel) {
+    // Set the log file and level
+    logInit (iLogLevel, ioLogStream);
 
     // Fix the SQL database connection string, if needed
     const SQLDBConnectionString_T& lSQLDBConnStr =
@@ -133,6 +383,128 @@ namespace OPENTREP {
   
   // //////////////////////////////////////////////////////////////////////
   void OPENTREP_Service::finalise() {
+    // Write the pending log entries, before the log stream goes away
+    Logger::instance().stopAsyncWriter();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::refreshXapianDatabase() {
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    Xapian::Database* lXapianDatabase_ptr =
+      lOPENTREP_ServiceContext.getXapianDatabase();
+    if (lXapianDatabase_ptr == NULL) {
+      // Retrieve the Xapian database name (directorty of the index)
+      const TravelDBFilePath_T& lTravelDBFilePath =
+        lOPENTREP_ServiceContext.getTravelDBFilePath();
+
+      // Open the Xapian database, and hand it over to the service context
+      lXapianDatabase_ptr = XapianIndexManager::openDatabase (lTravelDBFilePath);
+      lOPENTREP_ServiceContext.setXapianDatabase (lXapianDatabase_ptr);
+      return;
+    }
+
+    // Take into account the latest revision of the Xapian index, if any
+    const IndexRevision_T& lFormerRevision =
+      XapianIndexManager::getRevision (*lXapianDatabase_ptr);
+    try {
+      lXapianDatabase_ptr->reopen();
+
+    } catch (const Xapian::Error& error) {
+      std::ostringstream oStr;
+      oStr << "The Xapian database/index ('"
+           << lOPENTREP_ServiceContext.getTravelDBFilePath()
+           << "') cannot be re-opened: " << error.get_msg();
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw XapianDatabaseFailureException (oStr.str());
+    }
+
+    // A new revision of the Xapian index may have been built with another
+    // format: the format version is checked again
+    const IndexRevision_T& lRevision =
+      XapianIndexManager::getRevision (*lXapianDatabase_ptr);
+    if (lRevision != lFormerRevision) {
+      XapianIndexManager::
+        checkFormatVersion (*lXapianDatabase_ptr,
+                            lOPENTREP_ServiceContext.getTravelDBFilePath());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::initSQLDBConnectionPool() {
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // The pool may be needed by several threads at the same time, while
+    // it must be opened only once
+    boost::mutex::scoped_lock
+      lGuard (lOPENTREP_ServiceContext.getSQLDBConnectionPoolMutex());
+
+    // Nothing to do when the pool has already been opened
+    if (lOPENTREP_ServiceContext.getSQLDBConnectionPool() != NULL) {
+      return;
+    }
+
+    // Retrieve the SQL database type
+    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
+      
+    // Retrieve the SQL database connection string
+    const SQLDBConnectionString_T& lSQLDBConnectionString =
+      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+
+    // Retrieve the number of connections of the pool
+    const NbOfDBConnections_T& lPoolSize =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPoolSize();
+
+    // Open the pool of SQL database connections (NULL when there is
+    // no SQL database), and hand it over to the service context
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      DBManager::initSQLDBConnectionPool (lSQLDBType, lSQLDBConnectionString,
+                                          lPoolSize);
+    lOPENTREP_ServiceContext.setSQLDBConnectionPool (lSQLDBConnectionPool_ptr);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::initSearchThreadPool() {
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // The pool may be needed by several threads at the same time, while
+    // it must be started only once
+    boost::mutex::scoped_lock
+      lGuard (lOPENTREP_ServiceContext.getSearchThreadPoolMutex());
+
+    // Nothing to do when the pool has already been started, or when
+    // the searches are to be performed within the calling threads only
+    const NbOfThreads_T& lNbOfThreads =
+      lOPENTREP_ServiceContext.getNbOfSearchThreads();
+    if (lOPENTREP_ServiceContext.getSearchThreadPool() != NULL
+        || lNbOfThreads == 0) {
+      return;
+    }
+
+    // Retrieve the file-path of the Xapian index/database
+    const TravelDBFilePath_T& lTravelDBFilePath =
+      lOPENTREP_ServiceContext.getTravelDBFilePath();
+
+    // Start the threads, and hand them over to the service context
+    XapianDatabasePool* lXapianDatabasePool_ptr =
+      new XapianDatabasePool (lTravelDBFilePath);
+    BasThreadPool* lSearchThreadPool_ptr = new BasThreadPool (lNbOfThreads);
+    lOPENTREP_ServiceContext.setSearchThreadPool (lSearchThreadPool_ptr,
+                                                  lXapianDatabasePool_ptr);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::clearResultCache() {
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    ResultCache* lResultCache_ptr = lOPENTREP_ServiceContext.getResultCache();
+    if (lResultCache_ptr != NULL) {
+      lResultCache_ptr->clear();
+    }
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -172,13 +544,14 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the Xapian database name (directorty of the index)
-    const TravelDBFilePath_T& lTravelDBFilePath =
-      lOPENTREP_ServiceContext.getTravelDBFilePath();
+    // Retrieve the (persistent) Xapian database handle
+    refreshXapianDatabase();
+    const Xapian::Database& lXapianDatabase =
+      lOPENTREP_ServiceContext.getXapianDatabaseHandler();
       
     // Delegate the query execution to the dedicated command
     BasChronometer lIndexSizeChronometer; lIndexSizeChronometer.start();
-    oNbOfEntries = XapianIndexManager::getSize (lTravelDBFilePath);
+    oNbOfEntries = XapianIndexManager::getSize (lXapianDatabase);
     const double lIndexSizeMeasure = lIndexSizeChronometer.elapsed();
       
     // DEBUG
@@ -202,13 +575,14 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext= *_opentrepServiceContext;
 
-    // Retrieve the Xapian database name (directorty of the index)
-    const TravelDBFilePath_T& lTravelDBFilePath =
-      lOPENTREP_ServiceContext.getTravelDBFilePath();
+    // Retrieve the (persistent) Xapian database handle
+    refreshXapianDatabase();
+    const Xapian::Database& lXapianDatabase =
+      lOPENTREP_ServiceContext.getXapianDatabaseHandler();
       
     // Delegate the query execution to the dedicated command
     BasChronometer lRandomGetChronometer; lRandomGetChronometer.start();
-    oNbOfMatches = XapianIndexManager::drawRandomLocations (lTravelDBFilePath,
+    oNbOfMatches = XapianIndexManager::drawRandomLocations (lXapianDatabase,
                                                             iNbOfDraws,
                                                             ioLocationList);
     const double lRandomGetMeasure = lRandomGetChronometer.elapsed();
@@ -243,6 +617,10 @@ namespace OPENTREP {
     BasChronometer lDBCreationChronometer;
     lDBCreationChronometer.start();
 
+    // The SQL database is about to be re-created. Hence, the connections
+    // of the pool, if any, are closed. They will be re-opened when needed.
+    lOPENTREP_ServiceContext.resetSQLDBConnectionPool();
+
     // Create the SQL database user ('trep' on MySQL database)
     // and database ('trep_trep' on MySQL database)
     oCreationSuccessful =
@@ -269,6 +647,13 @@ namespace OPENTREP {
 
     // Set the SQL database connection string
     lOPENTREP_ServiceContext.setSQLDBConnectionString (iSQLDBConnectionString);
+
+    // The connections of the pool, if any, refer to the former SQL database.
+    // The pool will be re-opened when needed.
+    lOPENTREP_ServiceContext.resetSQLDBConnectionPool();
+
+    // The cached results, if any, may come from the former SQL database
+    clearResultCache();
       
     // DEBUG
     OPENTREP_LOG_DEBUG ("Reset of the SQL database connection string: "
@@ -276,7 +661,8 @@ namespace OPENTREP {
   }
 
   // //////////////////////////////////////////////////////////////////////
-  void OPENTREP_Service::createSQLDBTables() {
+  void OPENTREP_Service::
+  setSQLDBConnectionPoolSize (const NbOfDBConnections_T& iPoolSize) {
     if (_opentrepServiceContext == NULL) {
       throw NonInitialisedServiceException ("The OpenTREP service has not been"
                                             " initialised");
@@ -284,26 +670,259 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
+    // Set the number of connections of the pool
+    lOPENTREP_ServiceContext.setSQLDBConnectionPoolSize (iPoolSize);
+
+    // The pool, if any, will be re-opened with the new size when needed
+    lOPENTREP_ServiceContext.resetSQLDBConnectionPool();
       
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Reset of the SQL database connection pool size: "
+                        << lOPENTREP_ServiceContext.display());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setExhaustiveSearch (const ExhaustiveSearch_T& iExhaustiveSearch) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Set the search strategy
+    lOPENTREP_ServiceContext.setExhaustiveSearch (iExhaustiveSearch);
+
+    // The cached results, if any, may have been obtained with the former
+    // search strategy
+    clearResultCache();
+      
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Reset of the search strategy: "
+                        << lOPENTREP_ServiceContext.display());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setExpiredPORFiltering (const ExpiredPORFiltering_T& iExpiredPORFiltering) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Set whether the expired POR are filtered out
+    lOPENTREP_ServiceContext.setExpiredPORFiltering (iExpiredPORFiltering);
+
+    // The cached results, if any, may have been obtained with the former
+    // filtering of the POR
+    clearResultCache();
+      
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Reset of the filtering of the expired POR: "
+                        << lOPENTREP_ServiceContext.display());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::setValidityDate (const Date_T& iValidityDate) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Set the date at which the POR must be valid
+    lOPENTREP_ServiceContext.setValidityDate (iValidityDate);
+
+    // The cached results, if any, may have been obtained with the former
+    // filtering of the POR
+    clearResultCache();
+      
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Reset of the validity date of the POR: "
+                        << lOPENTREP_ServiceContext.display());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setNbOfSearchThreads (const NbOfThreads_T& iNbOfThreads) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Set the number of search threads
+    lOPENTREP_ServiceContext.setNbOfSearchThreads (iNbOfThreads);
+
+    // The pool, if any, will be re-started with the new number of threads
+    // when needed
+    lOPENTREP_ServiceContext.resetSearchThreadPool();
+      
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Reset of the number of search threads: "
+                        << lOPENTREP_ServiceContext.display());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::setLogLevel (const LOG::EN_LogLevel& iLogLevel) {
+    // The log level is held by the (process-wide) logger
+    Logger::instance().setLogLevel (iLogLevel);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::
+  setLogOverflowPolicy (const LOG::EN_OverflowPolicy& iOverflowPolicy) {
+    Logger::instance().setOverflowPolicy (iOverflowPolicy);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::setResultCacheSize (const NbOfBytes_T& iMaxSize) {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Replace the cache, if any, by an empty one of the given size
+    ResultCache* lResultCache_ptr = NULL;
+    if (iMaxSize > 0) {
+      lResultCache_ptr =
+        new ResultCache (iMaxSize, DEFAULT_OPENTREP_RESULT_CACHE_NB_OF_SHARDS);
+    }
+    lOPENTREP_ServiceContext.setResultCache (lResultCache_ptr);
       
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Reset of the result cache size: "
+                        << lOPENTREP_ServiceContext.display());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T OPENTREP_Service::
+  warmUpResultCache (const QueryLogFilePath_T& iQueryLogFilePath) {
+    NbOfMatches_T oNbOfQueries = 0;
+
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
+    // Nothing to do when the results are not cached
+    if (lOPENTREP_ServiceContext.getResultCache() == NULL) {
+      return oNbOfQueries;
+    }
+
+    std::ifstream lQueryLogFile (iQueryLogFilePath.c_str());
+    if (lQueryLogFile.is_open() == false) {
+      std::ostringstream oStr;
+      oStr << "The log of travel queries ('" << iQueryLogFilePath
+           << "') cannot be opened.";
+      OPENTREP_LOG_ERROR (oStr.str());
+      throw FileNotFoundException (oStr.str());
+    }
+
+    // Every line of the file is a travel query, the results of which
+    // are calculated and stored within the cache
+    BasChronometer lWarmUpChronometer;
+    lWarmUpChronometer.start();
+    std::string lTravelQuery;
+    while (std::getline (lQueryLogFile, lTravelQuery)) {
+      if (lTravelQuery.empty() == true) {
+        continue;
+      }
+
+      try {
+        LocationList_T lLocationList;
+        WordList_T lWordList;
+        interpretTravelRequest (lTravelQuery, lLocationList, lWordList);
+        ++oNbOfQueries;
+
+      } catch (const RootException& lException) {
+        OPENTREP_LOG_NOTIFICATION ("The travel query ('" << lTravelQuery
+                                   << "') of the log cannot be interpreted: "
+                                   << lException.what());
+      }
+    }
+    const double lWarmUpMeasure = lWarmUpChronometer.elapsed();
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG ("Warmed up the result cache with " << oNbOfQueries
+                        << " travel queries: " << lWarmUpMeasure << " - "
+                        << lOPENTREP_ServiceContext.display());
+
+    return oNbOfQueries;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfLookups_T OPENTREP_Service::getNbOfResultCacheHits() const {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    const ResultCache* lResultCache_ptr =
+      _opentrepServiceContext->getResultCache();
+    return (lResultCache_ptr != NULL) ? lResultCache_ptr->getNbOfHits() : 0;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfLookups_T OPENTREP_Service::getNbOfResultCacheMisses() const {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    const ResultCache* lResultCache_ptr =
+      _opentrepServiceContext->getResultCache();
+    return (lResultCache_ptr != NULL) ? lResultCache_ptr->getNbOfMisses() : 0;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SearchStatistics OPENTREP_Service::getStatistics() const {
+    SearchStatistics oStatistics;
+    StatisticsRecorder::fillStatistics (oStatistics);
+    return oStatistics;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::resetStatistics() {
+    StatisticsRecorder::reset();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_Service::createSQLDBTables() {
+    if (_opentrepServiceContext == NULL) {
+      throw NonInitialisedServiceException ("The OpenTREP service has not been"
+                                            " initialised");
+    }
+    assert (_opentrepServiceContext != NULL);
+    OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
+
     // Delegate the database creation to the dedicated command
     BasChronometer lDBCreationChronometer;
     lDBCreationChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
+    // Lease a connection from the pool of SQL database connections. It is
+    // given back to the pool when the session goes out of scope.
+    initSQLDBConnectionPool();
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lSQLDBConnectionPool_ptr != NULL);
+    soci::session lSociSession (*lSQLDBConnectionPool_ptr);
 
     // Create the SQL database tables
     DBManager::createSQLDBTables (lSociSession);
 
+    // The cached results, if any, may come from the former SQL database
+    clearResultCache();
+
     const double lDBCreationMeasure = lDBCreationChronometer.elapsed();
       
     // DEBUG
@@ -320,22 +939,17 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
-      
     // Delegate the database creation to the dedicated command
     BasChronometer lDBCreationChronometer;
     lDBCreationChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
+    // Lease a connection from the pool of SQL database connections. It is
+    // given back to the pool when the session goes out of scope.
+    initSQLDBConnectionPool();
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lSQLDBConnectionPool_ptr != NULL);
+    soci::session lSociSession (*lSQLDBConnectionPool_ptr);
 
     // Create the SQL database tables
     DBManager::createSQLDBIndexes (lSociSession);
@@ -359,22 +973,17 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
-      
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
+    // Lease a connection from the pool of SQL database connections. It is
+    // given back to the pool when the session goes out of scope.
+    initSQLDBConnectionPool();
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lSQLDBConnectionPool_ptr != NULL);
+    soci::session lSociSession (*lSQLDBConnectionPool_ptr);
       
     // Get the number of POR stored within the SQLite3/MySQL database
     nbOfMatches = DBManager::displayCount (lSociSession);
@@ -402,22 +1011,17 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
-      
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
+    // Lease a connection from the pool of SQL database connections. It is
+    // given back to the pool when the session goes out of scope.
+    initSQLDBConnectionPool();
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lSQLDBConnectionPool_ptr != NULL);
+    soci::session lSociSession (*lSQLDBConnectionPool_ptr);
       
     // Get the list of POR corresponding to the given IATA code
     const bool lSeveralEntries = false;
@@ -447,22 +1051,17 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
-      
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
+    // Lease a connection from the pool of SQL database connections. It is
+    // given back to the pool when the session goes out of scope.
+    initSQLDBConnectionPool();
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lSQLDBConnectionPool_ptr != NULL);
+    soci::session lSociSession (*lSQLDBConnectionPool_ptr);
       
     // Get the list of POR corresponding to the given ICAO code
     nbOfMatches =
@@ -491,22 +1090,17 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
-      
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
+    // Lease a connection from the pool of SQL database connections. It is
+    // given back to the pool when the session goes out of scope.
+    initSQLDBConnectionPool();
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lSQLDBConnectionPool_ptr != NULL);
+    soci::session lSociSession (*lSQLDBConnectionPool_ptr);
       
     // Get the list of POR corresponding to the given FAA code
     nbOfMatches =
@@ -535,22 +1129,17 @@ namespace OPENTREP {
     assert (_opentrepServiceContext != NULL);
     OPENTREP_ServiceContext& lOPENTREP_ServiceContext = *_opentrepServiceContext;
 
-    // Retrieve the SQL database type
-    const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
-      
-    // Retrieve the SQL database connection string
-    const SQLDBConnectionString_T& lSQLDBConnectionString =
-      lOPENTREP_ServiceContext.getSQLDBConnectionString();
-      
     // Delegate the database look up to the dedicated command
     BasChronometer lDBListChronometer;
     lDBListChronometer.start();
 
-    // Connect to the SQLite3/MySQL database
-    soci::session* lSociSession_ptr =
-      DBManager::initSQLDBSession (lSQLDBType, lSQLDBConnectionString);
-    assert (lSociSession_ptr != NULL);
-    soci::session& lSociSession = *lSociSession_ptr;
+    // Lease a connection from the pool of SQL database connections. It is
+    // given back to the pool when the session goes out of scope.
+    initSQLDBConnectionPool();
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+    assert (lSQLDBConnectionPool_ptr != NULL);
+    soci::session lSociSession (*lSQLDBConnectionPool_ptr);
       
     // Get the list of POR corresponding to the given Geoname ID
     nbOfMatches =
@@ -593,6 +1182,9 @@ namespace OPENTREP {
     oNbOfEntries =
       DBManager::fillInFromPORFile (lPORFilePath,
                                     lSQLDBType, lSQLDBConnectionString);
+
+    // The cached results, if any, may come from the former SQL database
+    clearResultCache();
     const double lBuildSearchIndexMeasure =
       lBuildSearchIndexChronometer.elapsed();
       
@@ -633,6 +1225,11 @@ namespace OPENTREP {
     const OTransliterator& lTransliterator =
       lOPENTREP_ServiceContext.getTransliterator();
       
+    // The directory of the Xapian index is about to be removed and re-created.
+    // Hence, the (persistent) Xapian database handle, if any, is closed.
+    // It will be re-opened when needed.
+    lOPENTREP_ServiceContext.resetXapianDatabase();
+
     // Delegate the index building to the dedicated command
     BasChronometer lBuildSearchIndexChronometer;
     lBuildSearchIndexChronometer.start();
@@ -657,6 +1254,25 @@ namespace OPENTREP {
   interpretTravelRequest (const std::string& iTravelQuery,
                           LocationList_T& ioLocationList,
                           WordList_T& ioWordList) {
+    return searchTravelQuery (iTravelQuery, ioLocationList, ioWordList, NULL);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T OPENTREP_Service::
+  interpretTravelRequest (const std::string& iTravelQuery,
+                          LocationList_T& ioLocationList,
+                          WordList_T& ioWordList,
+                          SearchExplanation& ioExplanation) {
+    ioExplanation.reset();
+    return searchTravelQuery (iTravelQuery, ioLocationList, ioWordList,
+                              &ioExplanation);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfMatches_T OPENTREP_Service::
+  searchTravelQuery (const std::string& iTravelQuery,
+                     LocationList_T& ioLocationList, WordList_T& ioWordList,
+                     SearchExplanation* ioExplanation_ptr) {
     NbOfMatches_T nbOfMatches = 0;
 
     if (_opentrepServiceContext == NULL) {
@@ -689,10 +1305,15 @@ namespace OPENTREP {
       OPENTREP_LOG_ERROR (errorStr.str());
       throw TravelRequestEmptyException (errorStr.str());
     }
+
+    // Time the whole travel query, including the look up within the cache
+    const SearchStageTimer lTravelQueryTimer (SearchStage::TRAVEL_QUERY);
+    StatisticsRecorder::increment (SearchCounter::TRAVEL_QUERIES);
     
-    // Retrieve the Xapian database name (directorty of the index)
-    const TravelDBFilePath_T& lTravelDBFilePath =
-      lOPENTREP_ServiceContext.getTravelDBFilePath();
+    // Retrieve the (persistent) Xapian database handle
+    refreshXapianDatabase();
+    const Xapian::Database& lXapianDatabase =
+      lOPENTREP_ServiceContext.getXapianDatabaseHandler();
       
     // Retrieve the SQL database type
     const DBType& lSQLDBType = lOPENTREP_ServiceContext.getSQLDBType();
@@ -701,18 +1322,121 @@ namespace OPENTREP {
     const SQLDBConnectionString_T& lSQLDBConnString =
       lOPENTREP_ServiceContext.getSQLDBConnectionString();
       
-    // Delegate the query execution to the dedicated command
+    // Make sure that the pool of SQL database connections is opened, when
+    // there is a SQL database. A failure is not fatal at that stage, as the
+    // SQL database is used only when the query is made of codes.
+    try {
+      initSQLDBConnectionPool();
+
+    } catch (const RootException& lException) {
+      OPENTREP_LOG_NOTIFICATION ("The " << lSQLDBType.describe()
+                                 << " SQL database cannot be used for now: "
+                                 << lException.what());
+    }
+    soci::connection_pool* lSQLDBConnectionPool_ptr =
+      lOPENTREP_ServiceContext.getSQLDBConnectionPool();
+
+    // Retrieve the revision of the Xapian index, on which depend the cached
+    // results, the table of the adjacent word pairs, the spelling
+    // dictionary and the vocabulary
+    const IndexRevision_T& lIndexRevision =
+      XapianIndexManager::getRevision (lXapianDatabase);
+
+    // Look up the results within the cache, if any. The cache is keyed on
+    // the normalised travel query, and its results are discarded as soon
+    // as the Xapian index has been re-built. When the search is to be
+    // explained, the cache is not looked up, but it is still filled.
+    ResultCache* lResultCache_ptr = lOPENTREP_ServiceContext.getResultCache();
+    TravelQuery_T lNormalisedQuery;
+    if (lResultCache_ptr != NULL) {
+      SearchStageTimer lNormalisationTimer (SearchStage::NORMALISATION);
+      lNormalisedQuery = QuerySlices::normalise (iTravelQuery, lTransliterator);
+      lNormalisationTimer.stop();
+
+      const bool hasBeenFound = (ioExplanation_ptr == NULL)
+        && lResultCache_ptr->find (lIndexRevision, lNormalisedQuery,
+                                   ioLocationList, ioWordList);
+      if (hasBeenFound == true) {
+        // DEBUG
+        OPENTREP_LOG_DEBUG ("Results of the travel query ('" << iTravelQuery
+                            << "') found within the cache");
+        StatisticsRecorder::increment (SearchCounter::RESULT_CACHE_HITS);
+
+        nbOfMatches = ioLocationList.size();
+        return nbOfMatches;
+      }
+    }
+
+    // Retrieve the search strategy
+    const ExhaustiveSearch_T& lExhaustiveSearch =
+      lOPENTREP_ServiceContext.getExhaustiveSearch();
+
+    // Retrieve the filters of the POR
+    const ExpiredPORFiltering_T& lExpiredPORFiltering =
+      lOPENTREP_ServiceContext.getExpiredPORFiltering();
+    const Date_T& lValidityDate = lOPENTREP_ServiceContext.getValidityDate();
+
+    // Make sure that the pool of search threads is started, unless the
+    // searches are to be performed within the calling thread only
+    initSearchThreadPool();
+    BasThreadPool* lSearchThreadPool_ptr =
+      lOPENTREP_ServiceContext.getSearchThreadPool();
+    XapianDatabasePool* lXapianDatabasePool_ptr =
+      lOPENTREP_ServiceContext.getXapianDatabasePool();
+
+    // Retrieve the table of the adjacent word pairs, if available. The shared
+    // pointer keeps it alive, even if the index is re-built in the meantime.
+    const WordPairTablePtr_T lWordPairTable_ptr =
+      getWordPairTable (lOPENTREP_ServiceContext, lIndexRevision);
+
+    // Retrieve the spelling dictionary, if available
+    const SpellingDictionaryPtr_T lSpellingDictionary_ptr =
+      getSpellingDictionary (lOPENTREP_ServiceContext, lIndexRevision);
+
+    // Retrieve the vocabulary of the index, if available
+    const TermVocabularyPtr_T lTermVocabulary_ptr =
+      getTermVocabulary (lOPENTREP_ServiceContext, lIndexRevision);
+
+    // Retrieve the in-memory index of the POR by code, with which the
+    // travel queries made only of codes are answered
+    const CodeIndexPtr_T lCodeIndex_ptr =
+      getCodeIndex (lOPENTREP_ServiceContext, lXapianDatabase, lIndexRevision);
+      
+    // Delegate the query execution to the dedicated command. The results
+    // are collected apart, so that they may be stored within the cache.
+    LocationList_T lLocationList;
+    WordList_T lWordList;
     BasChronometer lRequestInterpreterChronometer;
     lRequestInterpreterChronometer.start();
-    nbOfMatches =
-      RequestInterpreter::interpretTravelRequest (lTravelDBFilePath,
-                                                  lSQLDBType, lSQLDBConnString,
-                                                  iTravelQuery,
-                                                  ioLocationList, ioWordList,
-                                                  lTransliterator);
+    RequestInterpreter::interpretTravelRequest (lXapianDatabase,
+                                                lSQLDBType, lSQLDBConnString,
+                                                lSQLDBConnectionPool_ptr,
+                                                lSearchThreadPool_ptr,
+                                                lXapianDatabasePool_ptr,
+                                                lWordPairTable_ptr.get(),
+                                                lSpellingDictionary_ptr.get(),
+                                                lTermVocabulary_ptr.get(),
+                                                lCodeIndex_ptr.get(),
+                                                iTravelQuery,
+                                                lLocationList, lWordList,
+                                                lTransliterator,
+                                                lExhaustiveSearch,
+                                                lExpiredPORFiltering,
+                                                lValidityDate,
+                                                ioExplanation_ptr);
     const double lRequestInterpreterMeasure =
       lRequestInterpreterChronometer.elapsed();
 
+    if (lResultCache_ptr != NULL) {
+      lResultCache_ptr->insert (lIndexRevision, lNormalisedQuery,
+                                lLocationList, lWordList);
+    }
+
+    ioLocationList.insert (ioLocationList.end(), lLocationList.begin(),
+                           lLocationList.end());
+    ioWordList.insert (ioWordList.end(), lWordList.begin(), lWordList.end());
+    nbOfMatches = ioLocationList.size();
+
     // DEBUG
     OPENTREP_LOG_DEBUG ("Match query on Xapian database (index): "
                         << lRequestInterpreterMeasure << " - "
@@ -5,20 +5,56 @@
 #include <cassert>
 #include <ostream>
 #include <sstream>
+// Boost
+#include <boost/atomic.hpp>
+// Xapian
+#include <xapian.h>
+// SOCI
+#include <soci/soci.h>
 // OpenTrep
 #include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/basic/BasThreadPool.hpp>
 #include <opentrep/bom/World.hpp>
+#include <opentrep/bom/WordPairTable.hpp>
+#include <opentrep/bom/SpellingDictionary.hpp>
+#include <opentrep/bom/TermVocabulary.hpp>
+#include <opentrep/bom/CodeIndex.hpp>
+#include <opentrep/command/XapianDatabasePool.hpp>
+#include <opentrep/service/ResultCache.hpp>
 #include <opentrep/service/OPENTREP_ServiceContext.hpp>
 
 namespace OPENTREP {
 
+  /**
+   * Last generation of the shared resources, over all the service contexts
+   * of the process.
+   */
+  static boost::atomic<unsigned long> _lastGeneration (0);
+
+  /**
+   * Get a new generation of the shared resources. As it is unique within
+   * the process, the resources left by a thread to a destroyed service
+   * context can never be taken for those of another context (which may
+   * well have been allocated at the same address).
+   */
+  static unsigned long getNewGeneration() {
+    return _lastGeneration.fetch_add (1, boost::memory_order_relaxed) + 1;
+  }
+
   // //////////////////////////////////////////////////////////////////////
   OPENTREP_ServiceContext::OPENTREP_ServiceContext()
     : _world (NULL),
       _porFilePath (DEFAULT_OPENTREP_POR_FILEPATH),
       _travelDBFilePath (DEFAULT_OPENTREP_XAPIAN_DB_FILEPATH),
       _sqlDBType (DEFAULT_OPENTREP_SQL_DB_TYPE),
-      _sqlDBConnectionString (DEFAULT_OPENTREP_SQLITE_DB_FILEPATH) {
+      _sqlDBConnectionString (DEFAULT_OPENTREP_SQLITE_DB_FILEPATH),
+      _sqlDBConnectionPoolSize (DEFAULT_OPENTREP_SQL_DB_CONN_POOL_SIZE),
+      _sqlDBConnectionPool (NULL),
+      _exhaustiveSearch (DEFAULT_OPENTREP_EXHAUSTIVE_SEARCH),
+      _expiredPORFiltering (DEFAULT_OPENTREP_EXPIRED_POR_FILTERING),
+      _nbOfSearchThreads (DEFAULT_OPENTREP_NB_OF_SEARCH_THREADS),
+      _searchThreadPool (NULL), _xapianDatabasePool (NULL),
+      _resultCache (NULL), _generation (getNewGeneration()) {
     assert (false);
   }
 
@@ -30,7 +66,14 @@ namespace OPENTREP {
     : _world (NULL),
       _porFilePath (DEFAULT_OPENTREP_POR_FILEPATH),
       _travelDBFilePath (iTravelDBFilePath),
-      _sqlDBType (iSQLDBType), _sqlDBConnectionString (iSQLDBConnStr) {
+      _sqlDBType (iSQLDBType), _sqlDBConnectionString (iSQLDBConnStr),
+      _sqlDBConnectionPoolSize (DEFAULT_OPENTREP_SQL_DB_CONN_POOL_SIZE),
+      _sqlDBConnectionPool (NULL),
+      _exhaustiveSearch (DEFAULT_OPENTREP_EXHAUSTIVE_SEARCH),
+      _expiredPORFiltering (DEFAULT_OPENTREP_EXPIRED_POR_FILTERING),
+      _nbOfSearchThreads (DEFAULT_OPENTREP_NB_OF_SEARCH_THREADS),
+      _searchThreadPool (NULL), _xapianDatabasePool (NULL),
+      _resultCache (NULL), _generation (getNewGeneration()) {
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -41,11 +84,22 @@ namespace OPENTREP {
                            const SQLDBConnectionString_T& iSQLDBConnStr)
     : _world (NULL), _porFilePath (iPORFilePath),
       _travelDBFilePath (iTravelDBFilePath),
-      _sqlDBType (iSQLDBType), _sqlDBConnectionString (iSQLDBConnStr) {
+      _sqlDBType (iSQLDBType), _sqlDBConnectionString (iSQLDBConnStr),
+      _sqlDBConnectionPoolSize (DEFAULT_OPENTREP_SQL_DB_CONN_POOL_SIZE),
+      _sqlDBConnectionPool (NULL),
+      _exhaustiveSearch (DEFAULT_OPENTREP_EXHAUSTIVE_SEARCH),
+      _expiredPORFiltering (DEFAULT_OPENTREP_EXPIRED_POR_FILTERING),
+      _nbOfSearchThreads (DEFAULT_OPENTREP_NB_OF_SEARCH_THREADS),
+      _searchThreadPool (NULL), _xapianDatabasePool (NULL),
+      _resultCache (NULL), _generation (getNewGeneration()) {
   }
 
   // //////////////////////////////////////////////////////////////////////
   OPENTREP_ServiceContext::~OPENTREP_ServiceContext() {
+    setResultCache (NULL);
+    resetSearchThreadPool();
+    resetSQLDBConnectionPool();
+    resetXapianDatabase();
   }
   
   // //////////////////////////////////////////////////////////////////////
@@ -54,6 +108,119 @@ namespace OPENTREP {
     return *_world;
   }
   
+  // //////////////////////////////////////////////////////////////////////
+  OPENTREP_ServiceContext::ThreadResources::~ThreadResources() {
+    delete _transliterator; _transliterator = NULL;
+    delete _xapianDatabase; _xapianDatabase = NULL;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  OPENTREP_ServiceContext::ThreadResources&
+  OPENTREP_ServiceContext::getThreadResources() const {
+    const unsigned long lGeneration =
+      _generation.load (boost::memory_order_acquire);
+
+    ThreadResources* lThreadResources_ptr = _threadResources.get();
+    if (lThreadResources_ptr == NULL
+        || lThreadResources_ptr->_generation != lGeneration) {
+      lThreadResources_ptr = new ThreadResources (lGeneration);
+      _threadResources.reset (lThreadResources_ptr);
+    }
+    assert (lThreadResources_ptr != NULL);
+    return *lThreadResources_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const OTransliterator& OPENTREP_ServiceContext::getTransliterator() const {
+    ThreadResources& lThreadResources = getThreadResources();
+    if (lThreadResources._transliterator == NULL) {
+      // The ICU transliterators of the context are cloned one thread at a time
+      boost::mutex::scoped_lock lGuard (_threadResourcesMutex);
+      lThreadResources._transliterator = new OTransliterator (_transliterator);
+    }
+    assert (lThreadResources._transliterator != NULL);
+    return *lThreadResources._transliterator;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::
+  setTransliterator (const OTransliterator& iTransliterator) {
+    boost::mutex::scoped_lock lGuard (_threadResourcesMutex);
+    _transliterator = iTransliterator;
+    _generation.store (getNewGeneration(), boost::memory_order_release);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::Database* OPENTREP_ServiceContext::getXapianDatabase() const {
+    const ThreadResources& lThreadResources = getThreadResources();
+    return lThreadResources._xapianDatabase;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  Xapian::Database& OPENTREP_ServiceContext::getXapianDatabaseHandler() const {
+    Xapian::Database* lXapianDatabase_ptr = getXapianDatabase();
+    assert (lXapianDatabase_ptr != NULL);
+    return *lXapianDatabase_ptr;
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::
+  setXapianDatabase (Xapian::Database* ioXapianDatabase_ptr) {
+    ThreadResources& lThreadResources = getThreadResources();
+    if (ioXapianDatabase_ptr == lThreadResources._xapianDatabase) {
+      return;
+    }
+    delete lThreadResources._xapianDatabase;
+    lThreadResources._xapianDatabase = ioXapianDatabase_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::resetXapianDatabase() {
+    _generation.store (getNewGeneration(), boost::memory_order_release);
+
+    // The resources of the calling thread are released straight away
+    _threadResources.reset();
+
+    // No search is running: the handles of the pool are all free
+    if (_xapianDatabasePool != NULL) {
+      _xapianDatabasePool->clear();
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::
+  setSearchThreadPool (BasThreadPool* ioSearchThreadPool_ptr,
+                       XapianDatabasePool* ioXapianDatabasePool_ptr) {
+    if (ioSearchThreadPool_ptr != _searchThreadPool) {
+      // The threads are stopped before the handles they may use are closed
+      delete _searchThreadPool;
+      _searchThreadPool = ioSearchThreadPool_ptr;
+    }
+    if (ioXapianDatabasePool_ptr != _xapianDatabasePool) {
+      delete _xapianDatabasePool;
+      _xapianDatabasePool = ioXapianDatabasePool_ptr;
+    }
+  }
+  
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::setResultCache (ResultCache* ioResultCache_ptr) {
+    if (ioResultCache_ptr == _resultCache) {
+      return;
+    }
+    delete _resultCache;
+    _resultCache = ioResultCache_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void OPENTREP_ServiceContext::
+  setSQLDBConnectionPool (soci::connection_pool* ioSQLDBConnectionPool_ptr) {
+    if (ioSQLDBConnectionPool_ptr == _sqlDBConnectionPool) {
+      return;
+    }
+    delete _sqlDBConnectionPool;
+    _sqlDBConnectionPool = ioSQLDBConnectionPool_ptr;
+  }
+  
   // //////////////////////////////////////////////////////////////////////
   const std::string OPENTREP_ServiceContext::shortDisplay() const {
     std::ostringstream oStr;
@@ -62,6 +229,13 @@ namespace OPENTREP {
          << "; Xapian database (directory of the index): " << _travelDBFilePath
          << "; SQL database (" << _sqlDBType.describe()
          << ") connection string: " << _sqlDBConnectionString
+         << "; SQL connection pool size: " << _sqlDBConnectionPoolSize
+         << "; exhaustive search: " << _exhaustiveSearch
+         << "; expired POR filtering: " << _expiredPORFiltering
+         << "; validity date: " << _validityDate
+         << "; number of search threads: " << _nbOfSearchThreads
+         << "; result cache size: "
+         << ((_resultCache != NULL) ? _resultCache->getMaxSize() : 0)
          << std::endl;
     return oStr.str();
   }
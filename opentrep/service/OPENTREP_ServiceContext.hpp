@@ -6,6 +6,11 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <string>
+// Boost
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
 // OpenTrep
 #include <opentrep/OPENTREP_Types.hpp>
 #include <opentrep/DBType.hpp>
@@ -15,15 +20,51 @@
 // Forward declarations
 namespace soci {
   class session;
+  class connection_pool;
+}
+namespace Xapian {
+  class Database;
 }
 
 namespace OPENTREP {
 
   // Forward declarations
   class World;
+  class BasThreadPool;
+  class XapianDatabasePool;
+  class ResultCache;
+  struct WordPairTable;
+  struct SpellingDictionary;
+  struct TermVocabulary;
+  struct CodeIndex;
+
+  /**
+   * Shared pointer on the table of the adjacent word pairs of the index.
+   */
+  typedef boost::shared_ptr<const WordPairTable> WordPairTablePtr_T;
+
+  /**
+   * Shared pointer on the in-memory spelling dictionary of the index.
+   */
+  typedef boost::shared_ptr<const SpellingDictionary> SpellingDictionaryPtr_T;
+
+  /**
+   * Shared pointer on the (memory-mapped) vocabulary of the index.
+   */
+  typedef boost::shared_ptr<const TermVocabulary> TermVocabularyPtr_T;
+
+  /**
+   * Shared pointer on the in-memory index of the POR by code.
+   */
+  typedef boost::shared_ptr<const CodeIndex> CodeIndexPtr_T;
   
   /**
    * @brief Class holding the context of the OpenTrep services.
+   *
+   * Some of the resources held by the context cannot be shared by several
+   * threads: the ICU transliterators and the Xapian database handles are
+   * not thread-safe. Hence, every thread gets its own Unicode transliterator
+   * (cloned from the one of the context) and its own Xapian database handle.
    */
   class OPENTREP_ServiceContext : public ServiceAbstract {
     friend class FacOpenTrepServiceContext;
@@ -70,10 +111,197 @@ namespace OPENTREP {
     }
     
     /**
-     * Get the Unicode transliterator.
+     * Get the number of connections of the pool of SQL database connections.
+     */
+    const NbOfDBConnections_T& getSQLDBConnectionPoolSize() const {
+      return _sqlDBConnectionPoolSize;
+    }
+
+    /**
+     * Get the pool of SQL database connections, if already opened.
+     */
+    soci::connection_pool* getSQLDBConnectionPool() const {
+      return _sqlDBConnectionPool;
+    }
+
+    /**
+     * State whether all the partitions of the query slices are searched for.
+     */
+    const ExhaustiveSearch_T& getExhaustiveSearch() const {
+      return _exhaustiveSearch;
+    }
+
+    /**
+     * State whether the expired POR are filtered out of the results.
+     */
+    const ExpiredPORFiltering_T& getExpiredPORFiltering() const {
+      return _expiredPORFiltering;
+    }
+
+    /**
+     * Get the date at which the POR of the results must be valid
+     * (not a date when the POR are not filtered on their validity period).
+     */
+    const Date_T& getValidityDate() const {
+      return _validityDate;
+    }
+
+    /**
+     * Get the number of threads of the pool of search threads.
+     */
+    const NbOfThreads_T& getNbOfSearchThreads() const {
+      return _nbOfSearchThreads;
+    }
+
+    /**
+     * Get the pool of search threads, if already started.
+     */
+    BasThreadPool* getSearchThreadPool() const {
+      return _searchThreadPool;
+    }
+
+    /**
+     * Get the pool of Xapian database handles of the search threads,
+     * if already created.
+     */
+    XapianDatabasePool* getXapianDatabasePool() const {
+      return _xapianDatabasePool;
+    }
+
+    /**
+     * Get the cache of the results of the travel queries, if any.
+     */
+    ResultCache* getResultCache() const {
+      return _resultCache;
+    }
+
+    /**
+     * Get the mutex serialising the creation of the pool of search threads.
+     */
+    boost::mutex& getSearchThreadPoolMutex() const {
+      return _searchThreadPoolMutex;
+    }
+
+    /**
+     * Get the table of the adjacent word pairs of the Xapian index, if
+     * already loaded (and if available).
+     */
+    const WordPairTablePtr_T& getWordPairTable() const {
+      return _wordPairTable;
+    }
+
+    /**
+     * Get the revision of the Xapian index, from which the table of the
+     * adjacent word pairs has been loaded.
+     */
+    const IndexRevision_T& getWordPairTableRevision() const {
+      return _wordPairTableRevision;
+    }
+
+    /**
+     * Get the mutex serialising the loading of the table of the adjacent
+     * word pairs.
+     */
+    boost::mutex& getWordPairTableMutex() const {
+      return _wordPairTableMutex;
+    }
+
+    /**
+     * Get the spelling dictionary of the Xapian index, if already loaded
+     * (and if available).
+     */
+    const SpellingDictionaryPtr_T& getSpellingDictionary() const {
+      return _spellingDictionary;
+    }
+
+    /**
+     * Get the revision of the Xapian index, from which the spelling
+     * dictionary has been loaded.
+     */
+    const IndexRevision_T& getSpellingDictionaryRevision() const {
+      return _spellingDictionaryRevision;
+    }
+
+    /**
+     * Get the mutex serialising the loading of the spelling dictionary.
+     */
+    boost::mutex& getSpellingDictionaryMutex() const {
+      return _spellingDictionaryMutex;
+    }
+
+    /**
+     * Get the vocabulary of the Xapian index, if already mapped (and if
+     * available).
+     */
+    const TermVocabularyPtr_T& getTermVocabulary() const {
+      return _termVocabulary;
+    }
+
+    /**
+     * Get the revision of the Xapian index, from which the vocabulary
+     * has been mapped.
+     */
+    const IndexRevision_T& getTermVocabularyRevision() const {
+      return _termVocabularyRevision;
+    }
+
+    /**
+     * Get the mutex serialising the mapping of the vocabulary.
+     */
+    boost::mutex& getTermVocabularyMutex() const {
+      return _termVocabularyMutex;
+    }
+
+    /**
+     * Get the in-memory index of the POR by code, if already built.
+     */
+    const CodeIndexPtr_T& getCodeIndex() const {
+      return _codeIndex;
+    }
+
+    /**
+     * Get the revision of the Xapian index, from which the in-memory
+     * index of the POR by code has been built.
+     */
+    const IndexRevision_T& getCodeIndexRevision() const {
+      return _codeIndexRevision;
+    }
+
+    /**
+     * Get the mutex serialising the building of the in-memory index
+     * of the POR by code.
+     */
+    boost::mutex& getCodeIndexMutex() const {
+      return _codeIndexMutex;
+    }
+    
+    /**
+     * Get the Unicode transliterator of the calling thread.
+     *
+     * The transliterator is cloned from the one of the context when
+     * first needed within the calling thread.
      */
-    const OTransliterator& getTransliterator() const {
-      return _transliterator;
+    const OTransliterator& getTransliterator() const;
+
+    /**
+     * Get the (persistent) Xapian database handle of the calling thread,
+     * if already opened.
+     */
+    Xapian::Database* getXapianDatabase() const;
+
+    /**
+     * Get the (persistent) Xapian database handle of the calling thread.
+     *
+     * The handle must have been opened beforehand.
+     */
+    Xapian::Database& getXapianDatabaseHandler() const;
+
+    /**
+     * Get the mutex serialising the opening of the pool of SQL database
+     * connections.
+     */
+    boost::mutex& getSQLDBConnectionPoolMutex() const {
+      return _sqlDBConnectionPoolMutex;
     }
 
   public:
@@ -114,12 +342,155 @@ namespace OPENTREP {
     }
     
     /**
-     * Set the Unicode transliterator.
+     * Set the number of connections of the pool of SQL database connections.
+     */
+    void setSQLDBConnectionPoolSize (const NbOfDBConnections_T& iPoolSize) {
+      _sqlDBConnectionPoolSize = iPoolSize;
+    }
+
+    /**
+     * Set whether all the partitions of the query slices are searched for.
+     */
+    void setExhaustiveSearch (const ExhaustiveSearch_T& iExhaustiveSearch) {
+      _exhaustiveSearch = iExhaustiveSearch;
+    }
+
+    /**
+     * Set whether the expired POR are filtered out of the results.
+     */
+    void setExpiredPORFiltering (const ExpiredPORFiltering_T& iFiltering) {
+      _expiredPORFiltering = iFiltering;
+    }
+
+    /**
+     * Set the date at which the POR of the results must be valid.
+     */
+    void setValidityDate (const Date_T& iValidityDate) {
+      _validityDate = iValidityDate;
+    }
+
+    /**
+     * Set the number of threads of the pool of search threads.
+     */
+    void setNbOfSearchThreads (const NbOfThreads_T& iNbOfThreads) {
+      _nbOfSearchThreads = iNbOfThreads;
+    }
+
+    /**
+     * Set the pool of search threads, along with the pool of Xapian
+     * database handles used by those threads.
+     *
+     * The service context takes the ownership of the given pools, which
+     * are deleted (and the threads stopped) when the context is destroyed
+     * or when other pools are set.
      */
-    void setTransliterator (const OTransliterator& iTransliterator) {
-      _transliterator = iTransliterator;
+    void setSearchThreadPool (BasThreadPool*, XapianDatabasePool*);
+
+    /**
+     * Stop the pool of search threads, if any. The pool is then re-started,
+     * with the current number of threads, when needed.
+     */
+    void resetSearchThreadPool() {
+      setSearchThreadPool (NULL, NULL);
+    }
+
+    /**
+     * Set the cache of the results of the travel queries (NULL when the
+     * results are not to be cached).
+     *
+     * The service context takes the ownership of the given cache, which
+     * is deleted when the context is destroyed or when another cache is set.
+     */
+    void setResultCache (ResultCache*);
+
+    /**
+     * Set the table of the adjacent word pairs (NULL when not available),
+     * along with the revision of the Xapian index it derives from.
+     */
+    void setWordPairTable (const IndexRevision_T& iRevision,
+                           const WordPairTablePtr_T& iWordPairTable) {
+      _wordPairTableRevision = iRevision;
+      _wordPairTable = iWordPairTable;
+    }
+
+    /**
+     * Set the spelling dictionary (NULL when not available), along with
+     * the revision of the Xapian index it derives from.
+     */
+    void setSpellingDictionary (const IndexRevision_T& iRevision,
+                                const SpellingDictionaryPtr_T& iDictionary) {
+      _spellingDictionaryRevision = iRevision;
+      _spellingDictionary = iDictionary;
+    }
+
+    /**
+     * Set the vocabulary (NULL when not available), along with the
+     * revision of the Xapian index it derives from.
+     */
+    void setTermVocabulary (const IndexRevision_T& iRevision,
+                            const TermVocabularyPtr_T& iVocabulary) {
+      _termVocabularyRevision = iRevision;
+      _termVocabulary = iVocabulary;
     }
 
+    /**
+     * Set the in-memory index of the POR by code (NULL when not available),
+     * along with the revision of the Xapian index it derives from.
+     */
+    void setCodeIndex (const IndexRevision_T& iRevision,
+                       const CodeIndexPtr_T& iCodeIndex) {
+      _codeIndexRevision = iRevision;
+      _codeIndex = iCodeIndex;
+    }
+
+    /**
+     * Set the pool of SQL database connections.
+     *
+     * The service context takes the ownership of the given pool, which
+     * is deleted (and its connections closed) when the context is destroyed
+     * or when another pool is set.
+     */
+    void setSQLDBConnectionPool (soci::connection_pool*);
+
+    /**
+     * Close the pool of SQL database connections, if any.
+     *
+     * That is needed when the SQL database is re-created (e.g., the SQLite3
+     * file is deleted) or when its connection parameters are changed.
+     * The pool is then re-opened when needed.
+     */
+    void resetSQLDBConnectionPool() {
+      setSQLDBConnectionPool (NULL);
+    }
+    
+    /**
+     * Set the Unicode transliterator.
+     *
+     * The transliterators already cloned by the threads are discarded,
+     * and cloned again when next needed.
+     */
+    void setTransliterator (const OTransliterator&);
+
+    /**
+     * Set the (persistent) Xapian database handle of the calling thread.
+     *
+     * The service context takes the ownership of the given handle, which
+     * is deleted when the context is destroyed, when another handle is set
+     * or when the thread exits.
+     */
+    void setXapianDatabase (Xapian::Database*);
+
+    /**
+     * Close the (persistent) Xapian database handles, if any.
+     *
+     * That is typically needed before the Xapian index is re-built,
+     * as its directory is then removed and re-created from scratch.
+     * The handle of the calling thread is closed straight away; the ones
+     * of the other threads are closed (and re-opened) when next used.
+     * The handles of the pool of the search threads are all closed.
+     */
+    void resetXapianDatabase();
+
 
   public:
     // ///////// Display Methods //////////
@@ -172,6 +543,47 @@ namespace OPENTREP {
      * Destructor.
      */
     ~OPENTREP_ServiceContext();
+
+    /**
+     * Resources dedicated to a single thread.
+     */
+    struct ThreadResources {
+      /**
+       * Constructor.
+       */
+      ThreadResources (const unsigned long iGeneration)
+        : _generation (iGeneration), _transliterator (NULL),
+          _xapianDatabase (NULL) {
+      }
+
+      /**
+       * Destructor. The transliterator and the Xapian database handle
+       * are deleted.
+       */
+      ~ThreadResources();
+
+      /**
+       * Generation of the shared resources from which those ones derive.
+       */
+      unsigned long _generation;
+
+      /**
+       * Clone of the Unicode transliterator of the context.
+       */
+      OTransliterator* _transliterator;
+
+      /**
+       * Xapian database (index) handle.
+       */
+      Xapian::Database* _xapianDatabase;
+    };
+
+    /**
+     * Get the resources of the calling thread. They are (re-)created when
+     * they do not exist yet, or when they derive from an out-of-date
+     * generation of the shared resources.
+     */
+    ThreadResources& getThreadResources() const;
       
 
   private:
@@ -211,9 +623,172 @@ namespace OPENTREP {
     SQLDBConnectionString_T _sqlDBConnectionString;
 
     /**
-     * Unicode transliterator.
+     * Number of connections of the pool of SQL database connections.
+     */
+    NbOfDBConnections_T _sqlDBConnectionPoolSize;
+
+    /**
+     * Pool of SQL database connections, opened when first needed. The SQL
+     * database look ups borrow their connections from that pool, rather
+     * than opening a new connection each time.
+     */
+    soci::connection_pool* _sqlDBConnectionPool;
+
+    /**
+     * Whether all the partitions of the query slices are searched for
+     * (exhaustive search), or only the distinct word combinations
+     * (optimal segmentation by dynamic programming).
+     */
+    ExhaustiveSearch_T _exhaustiveSearch;
+
+    /**
+     * Whether the expired POR (i.e., having a non-null envelope ID) are
+     * filtered out of the results of the travel queries.
+     */
+    ExpiredPORFiltering_T _expiredPORFiltering;
+
+    /**
+     * Date at which the POR of the results must be valid. When not a date
+     * (the default), the POR are not filtered on their validity period.
+     */
+    Date_T _validityDate;
+
+    /**
+     * Number of threads of the pool of search threads. When null, the
+     * travel queries are interpreted within the calling thread only.
+     */
+    NbOfThreads_T _nbOfSearchThreads;
+
+    /**
+     * Pool of search threads, started when first needed. The slices of
+     * the travel queries, and the full-text matches within those slices,
+     * are searched for in parallel on those threads.
+     */
+    BasThreadPool* _searchThreadPool;
+
+    /**
+     * Pool of the Xapian database handles used by the search threads.
+     */
+    XapianDatabasePool* _xapianDatabasePool;
+
+    /**
+     * Mutex serialising the creation of the pool of search threads.
+     */
+    mutable boost::mutex _searchThreadPoolMutex;
+
+    /**
+     * Cache of the results of the travel queries (NULL when the results
+     * are not cached).
+     */
+    ResultCache* _resultCache;
+
+    /**
+     * Table of the adjacent word pairs of the Xapian index (NULL when not
+     * available), shared by the travel queries being interpreted.
+     */
+    WordPairTablePtr_T _wordPairTable;
+
+    /**
+     * Revision of the Xapian index, from which the table of the adjacent
+     * word pairs has been loaded.
+     */
+    IndexRevision_T _wordPairTableRevision;
+
+    /**
+     * Mutex serialising the loading of the table of the adjacent word pairs.
+     */
+    mutable boost::mutex _wordPairTableMutex;
+
+    /**
+     * Spelling dictionary of the Xapian index (NULL when not available),
+     * shared by the travel queries being interpreted.
+     */
+    SpellingDictionaryPtr_T _spellingDictionary;
+
+    /**
+     * Revision of the Xapian index, from which the spelling dictionary
+     * has been loaded.
+     */
+    IndexRevision_T _spellingDictionaryRevision;
+
+    /**
+     * Mutex serialising the loading of the spelling dictionary.
+     */
+    mutable boost::mutex _spellingDictionaryMutex;
+
+    /**
+     * Vocabulary of the Xapian index (NULL when not available), mapped
+     * in memory and shared by the travel queries being interpreted.
+     */
+    TermVocabularyPtr_T _termVocabulary;
+
+    /**
+     * Revision of the Xapian index, from which the vocabulary has been
+     * mapped.
+     */
+    IndexRevision_T _termVocabularyRevision;
+
+    /**
+     * Mutex serialising the mapping of the vocabulary.
+     */
+    mutable boost::mutex _termVocabularyMutex;
+
+    /**
+     * In-memory index of the POR by code (NULL when not available),
+     * with which the travel queries made only of codes are answered.
+     */
+    CodeIndexPtr_T _codeIndex;
+
+    /**
+     * Revision of the Xapian index, from which the in-memory index of
+     * the POR by code has been built.
+     */
+    IndexRevision_T _codeIndexRevision;
+
+    /**
+     * Mutex serialising the building of the in-memory index of the POR
+     * by code.
+     */
+    mutable boost::mutex _codeIndexMutex;
+
+    /**
+     * Mutex serialising the opening of the pool of SQL database connections.
+     */
+    mutable boost::mutex _sqlDBConnectionPoolMutex;
+
+    /**
+     * Unicode transliterator, from which the threads clone their own ones.
      */
     OTransliterator _transliterator;
+
+    /**
+     * Generation of the shared resources (Unicode transliterator and
+     * Xapian index), renewed every time one of them is replaced. The
+     * resources of the threads deriving from another generation are then
+     * discarded.
+     *
+     * The generations are drawn from a counter of the whole process, so
+     * that no two service contexts share any. Indeed, the destruction of
+     * the thread-specific pointer below releases only the resources of the
+     * calling thread: those of the other threads are released when those
+     * threads exit, or are replaced when found by a context re-using the
+     * same address (as their generation cannot match).
+     */
+    boost::atomic<unsigned long> _generation;
+
+    /**
+     * Mutex serialising the replacement and the cloning of the
+     * transliterator.
+     */
+    mutable boost::mutex _threadResourcesMutex;
+
+    /**
+     * Resources of every thread. In particular, every thread holds its own
+     * Xapian database (index) handle, opened once and kept for the whole
+     * life of the thread. It is refreshed (Xapian::Database::reopen())
+     * before being used, so that a re-built index is taken into account.
+     */
+    mutable boost::thread_specific_ptr<ThreadResources> _threadResources;
   };
 
 }
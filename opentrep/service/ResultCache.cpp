@@ -0,0 +1,239 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// Boost
+#include <boost/functional/hash/hash.hpp>
+// OpenTrep
+#include <opentrep/Location.hpp>
+#include <opentrep/service/ResultCache.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * Estimate the size, in bytes, of the given list of locations.
+   *
+   * Only the fixed-size part of the Location structures is accounted for,
+   * along with the nested (extra and alternate) locations. The actual
+   * footprint is larger, as the character strings may be allocated on the
+   * heap; hence, the maximal size of the cache is to be understood as an
+   * order of magnitude.
+   */
+  // //////////////////////////////////////////////////////////////////////
+  NbOfBytes_T estimateLocationListSize (const LocationList_T& iLocationList) {
+    NbOfBytes_T oSize = 0;
+    for (LocationList_T::const_iterator itLocation = iLocationList.begin();
+         itLocation != iLocationList.end(); ++itLocation) {
+      const Location& lLocation = *itLocation;
+      oSize += sizeof (Location)
+        + estimateLocationListSize (lLocation.getExtraLocationList())
+        + estimateLocationListSize (lLocation.getAlternateLocationList());
+    }
+    return oSize;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ResultCache::ResultCache (const NbOfBytes_T& iMaxSize,
+                            const unsigned short& iNbOfShards)
+    : _maxSize (iMaxSize) {
+    const unsigned short lNbOfShards = (iNbOfShards == 0) ? 1 : iNbOfShards;
+    for (unsigned short idx = 0; idx != lNbOfShards; ++idx) {
+      _shardList.push_back (new Shard());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ResultCache::~ResultCache() {
+    for (ShardList_T::iterator itShard = _shardList.begin();
+         itShard != _shardList.end(); ++itShard) {
+      Shard* lShard_ptr = *itShard;
+      delete lShard_ptr; lShard_ptr = NULL;
+    }
+    _shardList.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ResultCache::Shard& ResultCache::getShard (const TravelQuery_T& iQuery) const {
+    boost::hash<std::string> lHasher;
+    const std::size_t lShardIdx = lHasher (iQuery) % _shardList.size();
+    Shard* lShard_ptr = _shardList[lShardIdx];
+    assert (lShard_ptr != NULL);
+    return *lShard_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfBytes_T ResultCache::estimateSize (const TravelQuery_T& iQuery,
+                                         const LocationList_T& iLocationList,
+                                         const WordList_T& iWordList) {
+    NbOfBytes_T oSize = sizeof (Entry) + iQuery.size()
+      + estimateLocationListSize (iLocationList);
+    for (WordList_T::const_iterator itWord = iWordList.begin();
+         itWord != iWordList.end(); ++itWord) {
+      const Word_T& lWord = *itWord;
+      oSize += sizeof (Word_T) + lWord.size();
+    }
+    return oSize;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ResultCache::checkRevision (const IndexRevision_T& iRevision) {
+    {
+      boost::shared_lock<boost::shared_mutex> lGuard (_revisionMutex);
+      if (iRevision == _revision) {
+        return;
+      }
+    }
+
+    // The Xapian index has changed: the cached results are out-of-date
+    boost::unique_lock<boost::shared_mutex> lGuard (_revisionMutex);
+    if (iRevision == _revision) {
+      return;
+    }
+    _revision = iRevision;
+    for (ShardList_T::iterator itShard = _shardList.begin();
+         itShard != _shardList.end(); ++itShard) {
+      Shard& lShard = **itShard;
+      boost::mutex::scoped_lock lShardGuard (lShard._mutex);
+      lShard._entryList.clear();
+      lShard._entryMap.clear();
+      lShard._size = 0;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool ResultCache::find (const IndexRevision_T& iRevision,
+                          const TravelQuery_T& iQuery,
+                          LocationList_T& ioLocationList,
+                          WordList_T& ioWordList) {
+    checkRevision (iRevision);
+
+    Shard& lShard = getShard (iQuery);
+    boost::mutex::scoped_lock lGuard (lShard._mutex);
+    EntryMap_T::iterator itEntry = lShard._entryMap.find (iQuery);
+    if (itEntry == lShard._entryMap.end()) {
+      ++lShard._nbOfMisses;
+      return false;
+    }
+    ++lShard._nbOfHits;
+
+    // The entry becomes the most recently used one
+    EntryList_T::iterator itListEntry = itEntry->second;
+    lShard._entryList.splice (lShard._entryList.begin(), lShard._entryList,
+                              itListEntry);
+
+    const Entry& lEntry = *itListEntry;
+    ioLocationList.insert (ioLocationList.end(), lEntry._locationList.begin(),
+                           lEntry._locationList.end());
+    ioWordList.insert (ioWordList.end(), lEntry._wordList.begin(),
+                       lEntry._wordList.end());
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ResultCache::insert (const IndexRevision_T& iRevision,
+                            const TravelQuery_T& iQuery,
+                            const LocationList_T& iLocationList,
+                            const WordList_T& iWordList) {
+    // The revision must not change while the results are being stored
+    boost::shared_lock<boost::shared_mutex> lRevisionGuard (_revisionMutex);
+    if (!(iRevision == _revision)) {
+      return;
+    }
+
+    const NbOfBytes_T lMaxShardSize = _maxSize / _shardList.size();
+    const NbOfBytes_T lSize = estimateSize (iQuery, iLocationList, iWordList);
+    if (lSize > lMaxShardSize) {
+      return;
+    }
+
+    Shard& lShard = getShard (iQuery);
+    boost::mutex::scoped_lock lGuard (lShard._mutex);
+
+    // The results may have been stored by another thread in the meantime
+    if (lShard._entryMap.find (iQuery) != lShard._entryMap.end()) {
+      return;
+    }
+
+    // Evict the least recently used entries, until there is enough room
+    while (lShard._size + lSize > lMaxShardSize
+           && lShard._entryList.empty() == false) {
+      const Entry& lOldEntry = lShard._entryList.back();
+      lShard._size -= lOldEntry._size;
+      lShard._entryMap.erase (lOldEntry._query);
+      lShard._entryList.pop_back();
+    }
+
+    // Store the results as the most recently used entry
+    lShard._entryList.push_front (Entry());
+    Entry& lEntry = lShard._entryList.front();
+    lEntry._query = iQuery;
+    lEntry._locationList = iLocationList;
+    lEntry._wordList = iWordList;
+    lEntry._size = lSize;
+    lShard._entryMap.insert (EntryMap_T::value_type (iQuery,
+                                                     lShard._entryList.begin()));
+    lShard._size += lSize;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ResultCache::clear() {
+    for (ShardList_T::iterator itShard = _shardList.begin();
+         itShard != _shardList.end(); ++itShard) {
+      Shard& lShard = **itShard;
+      boost::mutex::scoped_lock lGuard (lShard._mutex);
+      lShard._entryList.clear();
+      lShard._entryMap.clear();
+      lShard._size = 0;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfLookups_T ResultCache::getNbOfHits() const {
+    NbOfLookups_T oNbOfHits = 0;
+    for (ShardList_T::const_iterator itShard = _shardList.begin();
+         itShard != _shardList.end(); ++itShard) {
+      const Shard& lShard = **itShard;
+      boost::mutex::scoped_lock lGuard (lShard._mutex);
+      oNbOfHits += lShard._nbOfHits;
+    }
+    return oNbOfHits;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfLookups_T ResultCache::getNbOfMisses() const {
+    NbOfLookups_T oNbOfMisses = 0;
+    for (ShardList_T::const_iterator itShard = _shardList.begin();
+         itShard != _shardList.end(); ++itShard) {
+      const Shard& lShard = **itShard;
+      boost::mutex::scoped_lock lGuard (lShard._mutex);
+      oNbOfMisses += lShard._nbOfMisses;
+    }
+    return oNbOfMisses;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfLookups_T ResultCache::getNbOfEntries() const {
+    NbOfLookups_T oNbOfEntries = 0;
+    for (ShardList_T::const_iterator itShard = _shardList.begin();
+         itShard != _shardList.end(); ++itShard) {
+      const Shard& lShard = **itShard;
+      boost::mutex::scoped_lock lGuard (lShard._mutex);
+      oNbOfEntries += lShard._entryMap.size();
+    }
+    return oNbOfEntries;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  NbOfBytes_T ResultCache::getSize() const {
+    NbOfBytes_T oSize = 0;
+    for (ShardList_T::const_iterator itShard = _shardList.begin();
+         itShard != _shardList.end(); ++itShard) {
+      const Shard& lShard = **itShard;
+      boost::mutex::scoped_lock lGuard (lShard._mutex);
+      oSize += lShard._size;
+    }
+    return oSize;
+  }
+
+}
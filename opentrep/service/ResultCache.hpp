@@ -0,0 +1,255 @@
+#ifndef __OPENTREP_SVC_RESULTCACHE_HPP
+#define __OPENTREP_SVC_RESULTCACHE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <list>
+#include <map>
+#include <vector>
+// Boost
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/LocationList.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Cache of the results of the travel queries.
+   *
+   * The results (matching locations and non-matched words) are stored
+   * by normalised travel query, and the least recently used ones are
+   * evicted when the cache exceeds its maximal size (in bytes).
+   *
+   * The cache is split into shards, each one with its own lock and its
+   * own share of the maximal size, so that the concurrent look ups seldom
+   * wait for one another. The shard of a travel query is given by the hash
+   * of that latter.
+   *
+   * The results depend on the revision of the Xapian index: all of them
+   * are discarded as soon as a look up is made with another revision.
+   */
+  class ResultCache {
+  public:
+    // ////////////////// Business Methods ////////////////
+    /**
+     * Look up the results of the given travel query. When found, they are
+     * added to the given lists.
+     *
+     * When the given revision of the Xapian index differs from the one
+     * of the cached results, the cache is emptied beforehand.
+     *
+     * @param const IndexRevision_T& Revision of the Xapian index.
+     * @param const TravelQuery_T& Normalised travel query.
+     * @param LocationList_T& List to which the matching locations are added.
+     * @param WordList_T& List to which the non-matched words are added.
+     * @return bool Whether the results of the travel query have been found.
+     */
+    bool find (const IndexRevision_T&, const TravelQuery_T&,
+               LocationList_T&, WordList_T&);
+
+    /**
+     * Store the results of the given travel query.
+     *
+     * The results are not stored when they have been calculated on another
+     * revision of the Xapian index than the one of the cached results
+     * (e.g., when the index has been re-built in the meantime), nor when
+     * they are bigger than a whole shard.
+     *
+     * @param const IndexRevision_T& Revision of the Xapian index.
+     * @param const TravelQuery_T& Normalised travel query.
+     * @param const LocationList_T& List of the matching locations.
+     * @param const WordList_T& List of the non-matched words.
+     */
+    void insert (const IndexRevision_T&, const TravelQuery_T&,
+                 const LocationList_T&, const WordList_T&);
+
+    /**
+     * Discard all the cached results. The hit and miss counters are kept.
+     */
+    void clear();
+
+    /**
+     * Get the number of look ups having found the results.
+     */
+    NbOfLookups_T getNbOfHits() const;
+
+    /**
+     * Get the number of look ups having not found the results.
+     */
+    NbOfLookups_T getNbOfMisses() const;
+
+    /**
+     * Get the number of cached travel queries.
+     */
+    NbOfLookups_T getNbOfEntries() const;
+
+    /**
+     * Get the (estimated) size, in bytes, of the cached results.
+     */
+    NbOfBytes_T getSize() const;
+
+    /**
+     * Get the maximal size, in bytes, of the cached results.
+     */
+    const NbOfBytes_T& getMaxSize() const {
+      return _maxSize;
+    }
+
+  public:
+    // ////////////// Constructors and Destructors /////////////
+    /**
+     * Main constructor.
+     *
+     * @param const NbOfBytes_T& Maximal size, in bytes, of the cached results.
+     * @param const unsigned short& Number of shards (at least one).
+     */
+    ResultCache (const NbOfBytes_T&, const unsigned short&);
+
+    /**
+     * Destructor.
+     */
+    ~ResultCache();
+
+  private:
+    /**
+     * Default constructor, not implemented.
+     */
+    ResultCache();
+
+    /**
+     * Copy constructor, not implemented.
+     */
+    ResultCache (const ResultCache&);
+
+  private:
+    // //////////////// Type definitions ////////////////
+    /**
+     * Cached results of a travel query.
+     */
+    struct Entry {
+      /**
+       * Normalised travel query.
+       */
+      TravelQuery_T _query;
+
+      /**
+       * List of the matching locations.
+       */
+      LocationList_T _locationList;
+
+      /**
+       * List of the non-matched words.
+       */
+      WordList_T _wordList;
+
+      /**
+       * Estimated size, in bytes, of the entry.
+       */
+      NbOfBytes_T _size;
+    };
+
+    /**
+     * List of entries, from the most recently used to the least recently
+     * used one.
+     */
+    typedef std::list<Entry> EntryList_T;
+
+    /**
+     * Index of the entries by travel query.
+     */
+    typedef std::map<TravelQuery_T, EntryList_T::iterator> EntryMap_T;
+
+    /**
+     * Shard of the cache.
+     */
+    struct Shard {
+      /**
+       * Constructor.
+       */
+      Shard() : _size (0), _nbOfHits (0), _nbOfMisses (0) {
+      }
+
+      /**
+       * Mutex protecting the shard.
+       */
+      mutable boost::mutex _mutex;
+
+      /**
+       * Entries, from the most recently used to the least recently used one.
+       */
+      EntryList_T _entryList;
+
+      /**
+       * Index of the entries by travel query.
+       */
+      EntryMap_T _entryMap;
+
+      /**
+       * Estimated size, in bytes, of the entries.
+       */
+      NbOfBytes_T _size;
+
+      /**
+       * Number of look ups having found (hits) or having not found (misses)
+       * the results.
+       */
+      NbOfLookups_T _nbOfHits;
+      NbOfLookups_T _nbOfMisses;
+    };
+
+    /**
+     * List of the shards.
+     */
+    typedef std::vector<Shard*> ShardList_T;
+
+  private:
+    // ////////////////// Helper Methods ////////////////
+    /**
+     * Get the shard of the given travel query.
+     */
+    Shard& getShard (const TravelQuery_T&) const;
+
+    /**
+     * Take the given revision of the Xapian index into account: when it
+     * differs from the current one, all the cached results are discarded.
+     */
+    void checkRevision (const IndexRevision_T&);
+
+    /**
+     * Estimate the size, in bytes, of the given (cached) results.
+     */
+    static NbOfBytes_T estimateSize (const TravelQuery_T&,
+                                     const LocationList_T&, const WordList_T&);
+
+  private:
+    // ////////////// Attributes ///////////////
+    /**
+     * Maximal size, in bytes, of the cached results.
+     */
+    const NbOfBytes_T _maxSize;
+
+    /**
+     * Shards of the cache.
+     */
+    ShardList_T _shardList;
+
+    /**
+     * Revision of the Xapian index, on which the cached results have been
+     * calculated.
+     */
+    IndexRevision_T _revision;
+
+    /**
+     * Mutex protecting the revision. It is held in shared mode while
+     * the results are stored, and in exclusive mode while the revision
+     * is changed (and the cache emptied).
+     */
+    boost::shared_mutex _revisionMutex;
+  };
+
+}
+#endif // __OPENTREP_SVC_RESULTCACHE_HPP
@@ -0,0 +1,74 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// Boost
+#include <boost/atomic.hpp>
+// OpenTrep
+#include <opentrep/basic/BasLatencyHistogram.hpp>
+#include <opentrep/service/StatisticsRecorder.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * Latency histograms, by stage of the search.
+   */
+  static BasLatencyHistogram _histogramArray[SearchStage::LAST_VALUE];
+
+  /**
+   * Counters of the search.
+   */
+  static boost::atomic<NbOfLookups_T> _counterArray[SearchCounter::LAST_VALUE];
+
+  // //////////////////////////////////////////////////////////////////////
+  void StatisticsRecorder::
+  recordLatency (const SearchStage::EN_SearchStage& iStage,
+                 const Latency_T iLatency) {
+    assert (iStage < SearchStage::LAST_VALUE);
+    _histogramArray[iStage].record (iLatency);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void StatisticsRecorder::
+  increment (const SearchCounter::EN_SearchCounter& iCounter,
+             const NbOfLookups_T iIncrement) {
+    assert (iCounter < SearchCounter::LAST_VALUE);
+    _counterArray[iCounter].fetch_add (iIncrement, boost::memory_order_relaxed);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void StatisticsRecorder::fillStatistics (SearchStatistics& ioStatistics) {
+    for (unsigned short idx = 0; idx != SearchStage::LAST_VALUE; ++idx) {
+      const BasLatencyHistogram& lHistogram = _histogramArray[idx];
+      LatencySummary lSummary;
+      lSummary._count = lHistogram.getCount();
+      lSummary._sum = lHistogram.getSum();
+      lSummary._max = lHistogram.getMax();
+      lSummary._p50 = lHistogram.getPercentile (50.0);
+      lSummary._p90 = lHistogram.getPercentile (90.0);
+      lSummary._p99 = lHistogram.getPercentile (99.0);
+      lSummary._p999 = lHistogram.getPercentile (99.9);
+      ioStatistics.setLatencySummary (static_cast<SearchStage::EN_SearchStage>
+                                      (idx), lSummary);
+    }
+
+    for (unsigned short idx = 0; idx != SearchCounter::LAST_VALUE; ++idx) {
+      const NbOfLookups_T lValue =
+        _counterArray[idx].load (boost::memory_order_relaxed);
+      ioStatistics.setCounter (static_cast<SearchCounter::EN_SearchCounter>
+                               (idx), lValue);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void StatisticsRecorder::reset() {
+    for (unsigned short idx = 0; idx != SearchStage::LAST_VALUE; ++idx) {
+      _histogramArray[idx].reset();
+    }
+    for (unsigned short idx = 0; idx != SearchCounter::LAST_VALUE; ++idx) {
+      _counterArray[idx].store (0, boost::memory_order_relaxed);
+    }
+  }
+
+}
@@ -0,0 +1,123 @@
+#ifndef __OPENTREP_SVC_STATISTICSRECORDER_HPP
+#define __OPENTREP_SVC_STATISTICSRECORDER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/date_time/posix_time/posix_time.hpp>
+// OpenTrep
+#include <opentrep/OPENTREP_Types.hpp>
+#include <opentrep/SearchStatistics.hpp>
+
+namespace OPENTREP {
+
+  /**
+   * @brief Process-wide recorder of the statistics of the search of travel
+   *        queries: latency histograms by stage (see BasLatencyHistogram)
+   *        and counters.
+   *
+   * As the Logger, the recorder is shared by all the threads, and by all
+   * the OPENTREP_Service instances, of the process. The latencies and the
+   * counters are recorded with relaxed atomic operations only, so that
+   * the search threads never wait for one another.
+   */
+  class StatisticsRecorder {
+  public:
+    // ////////////////// Business Methods ////////////////
+    /**
+     * Record the latency of the given stage.
+     *
+     * @param const SearchStage::EN_SearchStage& Stage of the search.
+     * @param const Latency_T Latency, in microseconds.
+     */
+    static void recordLatency (const SearchStage::EN_SearchStage&,
+                               const Latency_T);
+
+    /**
+     * Increment the given counter.
+     *
+     * @param const SearchCounter::EN_SearchCounter& Counter.
+     * @param const NbOfLookups_T Increment.
+     */
+    static void increment (const SearchCounter::EN_SearchCounter&,
+                           const NbOfLookups_T iIncrement = 1);
+
+    /**
+     * Fill the given structure with a snapshot of the statistics.
+     */
+    static void fillStatistics (SearchStatistics&);
+
+    /**
+     * Forget all the recorded latencies, and reset the counters.
+     */
+    static void reset();
+  };
+
+  /**
+   * @brief Chronometer recording, when it goes out of scope (or when it is
+   *        stopped beforehand), the time spent in the given stage of the
+   *        search.
+   */
+  class SearchStageTimer {
+  public:
+    /**
+     * Main constructor. The chronometer is started straight away.
+     */
+    SearchStageTimer (const SearchStage::EN_SearchStage& iStage)
+      : _stage (iStage),
+        _startTime (boost::posix_time::microsec_clock::universal_time()),
+        _isStopped (false) {
+    }
+
+    /**
+     * Destructor. The elapsed time is recorded, unless the chronometer
+     * has already been stopped.
+     */
+    ~SearchStageTimer() {
+      stop();
+    }
+
+    /**
+     * Stop the chronometer, and record the elapsed time.
+     */
+    void stop() {
+      if (_isStopped == true) {
+        return;
+      }
+      _isStopped = true;
+
+      const boost::posix_time::time_duration lElapsedTime =
+        boost::posix_time::microsec_clock::universal_time() - _startTime;
+      const long lElapsedTimeInMicroSeconds = lElapsedTime.total_microseconds();
+      StatisticsRecorder::
+        recordLatency (_stage, (lElapsedTimeInMicroSeconds > 0) ?
+                       static_cast<Latency_T> (lElapsedTimeInMicroSeconds) : 0);
+    }
+
+  private:
+    /**
+     * Default and copy constructors, not implemented.
+     */
+    SearchStageTimer();
+    SearchStageTimer (const SearchStageTimer&);
+
+  private:
+    /**
+     * Stage being timed.
+     */
+    const SearchStage::EN_SearchStage _stage;
+
+    /**
+     * Start time.
+     */
+    const boost::posix_time::ptime _startTime;
+
+    /**
+     * Whether the elapsed time has already been recorded.
+     */
+    bool _isStopped;
+  };
+
+}
+#endif // __OPENTREP_SVC_STATISTICSRECORDER_HPP
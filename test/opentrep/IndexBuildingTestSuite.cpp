@@ -19,6 +19,8 @@
 // OpenTrep
 #include <opentrep/OPENTREP_Service.hpp>
 #include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/bom/TermVocabulary.hpp>
 #include <opentrep/Location.hpp>
 #include <opentrep/config/opentrep-paths.hpp>
 
@@ -110,6 +112,57 @@ BOOST_AUTO_TEST_CASE (opentrep_simple_index) {
   logOutputFile.close();
 }
 
+/**
+ * Test the vocabulary of the terms, saved beside the Xapian index by
+ * the above test, and memory-mapped
+ */
+BOOST_AUTO_TEST_CASE (opentrep_term_vocabulary) {
+
+  const std::string
+    lVocabularyFilePath (X_XAPIAN_DB_FP + "/"
+                         + OPENTREP::K_TERM_VOCABULARY_FILENAME);
+  OPENTREP::TermVocabulary lVocabulary;
+  const bool hasBeenLoaded = lVocabulary.load (lVocabularyFilePath);
+  BOOST_REQUIRE_MESSAGE (hasBeenLoaded == true,
+                         "The vocabulary ('" << lVocabularyFilePath
+                         << "') cannot be mapped");
+  BOOST_CHECK (lVocabulary.size() != 0);
+
+  // Both San Francisco POR (the city and the airport) hold that term
+  BOOST_CHECK (lVocabulary.getDocFrequency ("francisco") >= 2);
+  BOOST_CHECK (lVocabulary.contains ("francicso") == false);
+
+  OPENTREP::TermVocabulary::TermFrequencyList_T lTermList;
+  lVocabulary.getTermsByPrefix ("reykjav", lTermList);
+  BOOST_REQUIRE (lTermList.empty() == false);
+  BOOST_CHECK (lTermList.front().first.compare (0, 7, "reykjav") == 0);
+
+  // Terms spread over several (front-coded) blocks, built in memory
+  OPENTREP::TermVocabulary lBlockVocabulary;
+  for (unsigned short idx = 100; idx != 0; --idx) {
+    std::ostringstream oStr;
+    oStr << "term" << (idx - 1) / 10 << (idx - 1) % 10;
+    lBlockVocabulary.addTerm (oStr.str(), idx);
+  }
+  lBlockVocabulary.finalise();
+  BOOST_CHECK_EQUAL (lBlockVocabulary.size(), 100);
+  BOOST_CHECK_EQUAL (lBlockVocabulary.getDocFrequency ("term00"), 1);
+  BOOST_CHECK_EQUAL (lBlockVocabulary.getDocFrequency ("term47"), 48);
+  BOOST_CHECK_EQUAL (lBlockVocabulary.getDocFrequency ("term99"), 100);
+  BOOST_CHECK_EQUAL (lBlockVocabulary.getDocFrequency ("term"), 0);
+  BOOST_CHECK_EQUAL (lBlockVocabulary.getDocFrequency ("term100"), 0);
+  BOOST_CHECK_EQUAL (lBlockVocabulary.getDocFrequency ("a"), 0);
+  BOOST_CHECK_EQUAL (lBlockVocabulary.getDocFrequency ("z"), 0);
+
+  lTermList.clear();
+  lBlockVocabulary.getTermsByPrefix ("term3", lTermList);
+  BOOST_CHECK_EQUAL (lTermList.size(), 10);
+  lTermList.clear();
+  lBlockVocabulary.getTermsByPrefix ("term", lTermList, 20);
+  BOOST_CHECK_EQUAL (lTermList.size(), 20);
+  BOOST_CHECK_EQUAL (lTermList.back().first, "term19");
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,315 @@
+// /////////////////////////////////////////////////////////////////////////
+//
+// Levenshtein edit distance algorithm
+//
+// /////////////////////////////////////////////////////////////////////////
+// STL
+#include <cstdlib>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE LevenshteinTestSuite
+#include <boost/test/unit_test.hpp>
+// OpenTrep
+#include <opentrep/basic/BasChronometer.hpp>
+#include <opentrep/bom/Levenshtein.hpp>
+#include <opentrep/bom/SpellingDictionary.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("LevenshteinTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+    //boost_utf::unit_test_log.set_threshold_level (boost_utf::log_successful_tests);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+// //////////// Constants for the tests ///////////////
+/**
+ * Number of random pairs of strings, per string length.
+ */
+const unsigned short X_NB_OF_RANDOM_PAIRS (200);
+
+/**
+ * Number of distance calculations for the timing comparison.
+ */
+const unsigned int X_NB_OF_TIMED_CALCULATIONS (100000);
+
+
+// //////////// Helpers for the tests ///////////////
+/**
+ * Generate a random string, made of the first letters of the alphabet.
+ */
+std::string generateString (const unsigned int iLength,
+                            const unsigned short iAlphabetSize) {
+  std::string oString;
+  for (unsigned int idx = 0; idx != iLength; ++idx) {
+    oString += static_cast<char> ('a' + std::rand() % iAlphabetSize);
+  }
+  return oString;
+}
+
+/**
+ * Alter a string with a few random edit operations (substitutions,
+ * deletions, insertions and transpositions).
+ */
+std::string alterString (const std::string& iString,
+                         const unsigned short iNbOfEdits,
+                         const unsigned short iAlphabetSize) {
+  std::string oString (iString);
+  for (unsigned short idx = 0; idx != iNbOfEdits && !oString.empty(); ++idx) {
+    const unsigned int lPos = std::rand() % oString.size();
+    const char lChar = static_cast<char> ('a' + std::rand() % iAlphabetSize);
+    switch (std::rand() % 4) {
+    case 0: oString[lPos] = lChar; break;
+    case 1: oString.erase (lPos, 1); break;
+    case 2: oString.insert (lPos, 1, lChar); break;
+    default:
+      if (lPos + 1 < oString.size()) {
+        std::swap (oString[lPos], oString[lPos + 1]);
+      }
+    }
+  }
+  return oString;
+}
+
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Check the edit distance on a few well-known examples
+ */
+BOOST_AUTO_TEST_CASE (levenshtein_simple_strings) {
+
+  BOOST_CHECK_EQUAL (OPENTREP::Levenshtein::getDistance ("", "nce"), 3);
+  BOOST_CHECK_EQUAL (OPENTREP::Levenshtein::getDistance ("kitten", "sitting"),
+                     3);
+  BOOST_CHECK_EQUAL (OPENTREP::Levenshtein::getDistance ("san francisco",
+                                                         "sna francicso"), 2);
+  BOOST_CHECK_EQUAL (OPENTREP::Levenshtein::getDistance ("reikjavik",
+                                                         "rekyavik"), 2);
+
+  // The transpositions of the first two characters are not counted
+  BOOST_CHECK_EQUAL (OPENTREP::Levenshtein::getDistance ("ab", "ba"), 2);
+  BOOST_CHECK_EQUAL (OPENTREP::Levenshtein::getDistance ("abc", "acb"), 1);
+
+  // UTF-8: "é" is a single code point, but two bytes
+  BOOST_CHECK_EQUAL (OPENTREP::Levenshtein::getDistance ("san josé",
+                                                         "san jose"), 2);
+  BOOST_CHECK_EQUAL (OPENTREP::Levenshtein::getUTF8Distance ("san josé",
+                                                             "san jose"), 1);
+}
+
+/**
+ * Check that the bit-parallel algorithm gives the same distances as the
+ * dynamic programming one, on both sides of the 64-character blocks
+ */
+BOOST_AUTO_TEST_CASE (levenshtein_bit_parallel_comparison) {
+
+  const unsigned int lLengthArray[] = {
+    1, 2, 3, 5, 13, 63, 64, 65, 127, 128, 129, 511, 512, 513
+  };
+  const unsigned short lNbOfLengths =
+    sizeof (lLengthArray) / sizeof (lLengthArray[0]);
+
+  std::srand (42);
+  unsigned int lNbOfMismatches = 0;
+  for (unsigned short idx = 0; idx != lNbOfLengths; ++idx) {
+    for (unsigned short k = 0; k != X_NB_OF_RANDOM_PAIRS; ++k) {
+      const unsigned short lAlphabetSize = 2 + std::rand() % 5;
+      const std::string& lSource =
+        generateString (lLengthArray[idx], lAlphabetSize);
+      const std::string& lTarget = (k % 2 == 0) ?
+        alterString (lSource, std::rand() % 6, lAlphabetSize)
+        : generateString (std::rand() % (lLengthArray[idx] + 3), lAlphabetSize);
+
+      const int lExpectedDistance =
+        OPENTREP::Levenshtein::getDistanceByDynamicProgramming (lSource,
+                                                                lTarget);
+      const int lDistance = OPENTREP::Levenshtein::getDistance (lSource,
+                                                                lTarget);
+      const int lUTF8Distance =
+        OPENTREP::Levenshtein::getUTF8Distance (lSource, lTarget);
+      OPENTREP::Levenshtein::DistanceList_T lDistanceList;
+      OPENTREP::Levenshtein::getDistanceList (lSource,
+                                              OPENTREP::Levenshtein::
+                                              StringList_T (1, lTarget),
+                                              lDistanceList);
+
+      if (lDistance != lExpectedDistance || lUTF8Distance != lExpectedDistance
+          || lDistanceList.front() != lExpectedDistance) {
+        ++lNbOfMismatches;
+        BOOST_TEST_MESSAGE ("'" << lSource << "' vs '" << lTarget
+                            << "': " << lDistance << " (bytes), "
+                            << lUTF8Distance << " (UTF-8), "
+                            << lDistanceList.front() << " (batch), whereas "
+                            << lExpectedDistance << " is expected");
+      }
+    }
+  }
+
+  BOOST_CHECK_EQUAL (lNbOfMismatches, 0);
+}
+
+/**
+ * Compare the timings of the bit-parallel and dynamic programming
+ * algorithms (micro-benchmark)
+ */
+BOOST_AUTO_TEST_CASE (levenshtein_timing_comparison) {
+
+  // Output log File
+  std::string lLogFilename ("LevenshteinTestSuite.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  const std::string lQuery ("sna francicso rio de janero");
+  const std::string lCorrected ("san francisco rio de janeiro");
+
+  // Dynamic programming
+  long lDPSum = 0;
+  OPENTREP::BasChronometer lDPChronometer;
+  lDPChronometer.start();
+  for (unsigned int idx = 0; idx != X_NB_OF_TIMED_CALCULATIONS; ++idx) {
+    lDPSum +=
+      OPENTREP::Levenshtein::getDistanceByDynamicProgramming (lQuery,
+                                                              lCorrected);
+  }
+  const double lDPMeasure = lDPChronometer.elapsed();
+
+  // Bit-parallel
+  long lBitParallelSum = 0;
+  OPENTREP::BasChronometer lBitParallelChronometer;
+  lBitParallelChronometer.start();
+  for (unsigned int idx = 0; idx != X_NB_OF_TIMED_CALCULATIONS; ++idx) {
+    lBitParallelSum += OPENTREP::Levenshtein::getDistance (lQuery, lCorrected);
+  }
+  const double lBitParallelMeasure = lBitParallelChronometer.elapsed();
+
+  // Batch, against the same number of candidates
+  const OPENTREP::Levenshtein::StringList_T
+    lCandidateList (X_NB_OF_TIMED_CALCULATIONS, lCorrected);
+  OPENTREP::Levenshtein::DistanceList_T lDistanceList;
+  OPENTREP::BasChronometer lBatchChronometer;
+  lBatchChronometer.start();
+  OPENTREP::Levenshtein::getDistanceList (lQuery, lCandidateList,
+                                          lDistanceList);
+  const double lBatchMeasure = lBatchChronometer.elapsed();
+
+  logOutputFile << X_NB_OF_TIMED_CALCULATIONS << " distance calculations: "
+                << lDPMeasure << "s (dynamic programming), "
+                << lBitParallelMeasure << "s (bit-parallel), "
+                << lBatchMeasure << "s (bit-parallel, batch)" << std::endl;
+
+  BOOST_CHECK_EQUAL (lDPSum, lBitParallelSum);
+  BOOST_CHECK_EQUAL (lDistanceList.size(), lCandidateList.size());
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Check the spelling corrections given by the in-memory dictionary
+ */
+BOOST_AUTO_TEST_CASE (spelling_dictionary_suggestions) {
+
+  OPENTREP::SpellingDictionary lDictionary;
+  lDictionary.addTerm ("San Francisco", 0.8);
+  lDictionary.addTerm ("san antonio", 0.5);
+  lDictionary.addTerm ("rio de janeiro", 0.6);
+  lDictionary.addTerm ("reykjavik", 0.3);
+  lDictionary.addTerm ("nce", 0.4);
+  lDictionary.addTerm ("nice", 0.5);
+  lDictionary.addTerm ("rice", 0.01);
+  lDictionary.finalise();
+  BOOST_CHECK_EQUAL (lDictionary.size(), 7);
+
+  OPENTREP::NbOfErrors_T lEditDistance = 0;
+  BOOST_CHECK_EQUAL (lDictionary.getSuggestion ("sna francicso",
+                                                lEditDistance),
+                     "san francisco");
+  BOOST_CHECK_EQUAL (lEditDistance, 2);
+  BOOST_CHECK_EQUAL (lDictionary.getSuggestion ("rio de janero",
+                                                lEditDistance),
+                     "rio de janeiro");
+  BOOST_CHECK_EQUAL (lDictionary.getSuggestion ("reykyavki", lEditDistance),
+                     "reykjavik");
+
+  // No error is allowed for strings of less than 4 letters
+  BOOST_CHECK (lDictionary.getSuggestion ("nxe", lEditDistance).empty());
+
+  // The string itself is not given back; between the terms at the same
+  // distance, the one with the highest PageRank is chosen
+  BOOST_CHECK_EQUAL (lDictionary.getSuggestion ("nice", lEditDistance),
+                     "nce");
+
+  // Round trip through the serialised version of the dictionary
+  const std::string lDictionaryFilename ("LevenshteinTestSuite_spelling.txt");
+  lDictionary.save (lDictionaryFilename);
+  OPENTREP::SpellingDictionary lLoadedDictionary;
+  const bool hasBeenLoaded = lLoadedDictionary.load (lDictionaryFilename);
+  BOOST_CHECK (hasBeenLoaded == true);
+  BOOST_CHECK_EQUAL (lLoadedDictionary.size(), lDictionary.size());
+  BOOST_CHECK_EQUAL (lLoadedDictionary.getSuggestion ("sna francicso",
+                                                      lEditDistance),
+                     "san francisco");
+}
+
+/**
+ * Check that the in-memory dictionary folds the case of the non-ASCII
+ * letters, and counts the lengths and the edit distances in (Unicode)
+ * characters rather than in bytes
+ */
+BOOST_AUTO_TEST_CASE (spelling_dictionary_unicode) {
+
+  OPENTREP::SpellingDictionary lDictionary;
+  lDictionary.addTerm ("Zürich", 0.5);
+  lDictionary.addTerm ("Москва", 0.7);
+  lDictionary.addTerm ("São Paulo", 0.6);
+  lDictionary.finalise();
+  BOOST_CHECK_EQUAL (lDictionary.size(), 3);
+
+  // "Мос" is made of 3 letters (6 bytes): no error is allowed
+  BOOST_CHECK_EQUAL (lDictionary.getAllowedDistanceError ("Мос"), 0);
+  BOOST_CHECK_EQUAL (lDictionary.getAllowedDistanceError ("Zürich"), 1);
+
+  OPENTREP::NbOfErrors_T lEditDistance = 0;
+  BOOST_CHECK_EQUAL (lDictionary.getSuggestion ("ZURICH", lEditDistance),
+                     "zürich");
+  BOOST_CHECK_EQUAL (lEditDistance, 1);
+  BOOST_CHECK_EQUAL (lDictionary.getSuggestion ("МОСКВ", lEditDistance),
+                     "москва");
+  BOOST_CHECK_EQUAL (lEditDistance, 1);
+  BOOST_CHECK_EQUAL (lDictionary.getSuggestion ("SAO PAULO", lEditDistance),
+                     "são paulo");
+  BOOST_CHECK_EQUAL (lEditDistance, 1);
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
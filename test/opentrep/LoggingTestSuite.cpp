@@ -0,0 +1,315 @@
+/*!
+ * \page LoggingTestSuite_cpp Command-Line Test to Demonstrate How To Test the OpenTREP Asynchronous Logs
+ * \code
+ */
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+// Boost
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE LoggingTestSuite
+#include <boost/test/unit_test.hpp>
+// OpenTrep
+#include <opentrep/basic/BasConst_General.hpp>
+#include <opentrep/service/Logger.hpp>
+#include <opentrep/service/LogRingBuffer.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("LoggingTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+    //boost_utf::unit_test_log.set_threshold_level (boost_utf::log_successful_tests);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+
+// //////////// Constants for the tests ///////////////
+/**
+ * Number of threads pushing log records.
+ */
+const unsigned short X_NB_OF_THREADS (8);
+
+/**
+ * Size of the ring buffer of the asynchronous logger, when testing the
+ * overflow policy.
+ */
+const OPENTREP::NbOfLogRecords_T X_LOG_BUFFER_SIZE (16);
+
+/**
+ * Number of log records which cannot find room, when testing the overflow
+ * policy.
+ */
+const OPENTREP::NbOfLogRecords_T X_NB_OF_OVERFLOWING_RECORDS (1000);
+
+
+// //////////// Helpers for the tests ///////////////
+/**
+ * Thread pushing numbered log records into a ring buffer, waiting for
+ * some room whenever the buffer is full.
+ */
+struct LogProducer {
+  /** Constructor. */
+  LogProducer (OPENTREP::LogRingBuffer& ioRingBuffer,
+               const unsigned int iNbOfRecords)
+    : _ringBuffer (&ioRingBuffer), _nbOfRecords (iNbOfRecords),
+      _producerIdx (0) {
+  }
+
+  /** Thread entry point. */
+  void run() {
+    for (unsigned int idx = 0; idx != _nbOfRecords; ++idx) {
+      std::ostringstream lRecordStr;
+      lRecordStr << _producerIdx << " " << idx;
+      std::string lRecord = lRecordStr.str();
+      while (_ringBuffer->push (lRecord) == false) {
+        boost::this_thread::yield();
+      }
+    }
+  }
+
+  /** Ring buffer, shared by all the threads. */
+  OPENTREP::LogRingBuffer* _ringBuffer;
+  /** Number of records to be pushed. */
+  unsigned int _nbOfRecords;
+  /** Index of the thread, recorded within every record. */
+  unsigned short _producerIdx;
+};
+
+/**
+ * Stream buffer keeping whatever is written into it, but holding the
+ * writing threads as long as it is not opened. It stands for a log
+ * stream so slow that the asynchronous writer cannot keep up with it.
+ */
+class GatedStreamBuffer : public std::streambuf {
+public:
+  /** Constructor. */
+  GatedStreamBuffer() : _isOpen (false) {
+  }
+
+  /** Let the writing threads go on. */
+  void open() {
+    boost::mutex::scoped_lock lGuard (_mutex);
+    _isOpen = true;
+    _condition.notify_all();
+  }
+
+  /** Get the content written so far. */
+  std::string getContent() {
+    boost::mutex::scoped_lock lGuard (_mutex);
+    return _content;
+  }
+
+protected:
+  /** Write a sequence of characters. */
+  std::streamsize xsputn (const char* iData, std::streamsize iSize) {
+    boost::mutex::scoped_lock lGuard (_mutex);
+    while (_isOpen == false) {
+      _condition.wait (lGuard);
+    }
+    _content.append (iData, iSize);
+    return iSize;
+  }
+
+  /** Write a single character. */
+  int overflow (int iChar) {
+    if (traits_type::eq_int_type (iChar, traits_type::eof()) == false) {
+      const char lChar = traits_type::to_char_type (iChar);
+      xsputn (&lChar, 1);
+    }
+    return traits_type::not_eof (iChar);
+  }
+
+private:
+  /** Whether the writing threads may go on. */
+  bool _isOpen;
+  /** Content written so far. */
+  std::string _content;
+  /** Mutex protecting the above. */
+  boost::mutex _mutex;
+  /** Condition on which the writing threads wait for the opening. */
+  boost::condition_variable _condition;
+};
+
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Push log records into a small ring buffer from several threads, while
+ * popping them from another one, and check that every record comes out
+ * exactly once, and in the order in which its thread pushed it
+ */
+BOOST_AUTO_TEST_CASE (opentrep_log_ring_buffer) {
+
+  const unsigned int lNbOfRecordsPerThread (2000);
+  OPENTREP::LogRingBuffer lRingBuffer (16);
+  BOOST_CHECK_EQUAL (lRingBuffer.getCapacity(), 16);
+
+  std::vector<LogProducer> lProducerList (X_NB_OF_THREADS,
+                                          LogProducer (lRingBuffer,
+                                                       lNbOfRecordsPerThread));
+  boost::thread_group lThreadGroup;
+  for (unsigned short idx = 0; idx != X_NB_OF_THREADS; ++idx) {
+    lProducerList[idx]._producerIdx = idx;
+    lThreadGroup.create_thread (boost::bind (&LogProducer::run,
+                                             &lProducerList[idx]));
+  }
+
+  // Pop the records, as long as some are expected
+  std::vector<unsigned int> lNextRecordList (X_NB_OF_THREADS, 0);
+  const unsigned int lNbOfRecords = X_NB_OF_THREADS * lNbOfRecordsPerThread;
+  unsigned int lNbOfPoppedRecords = 0;
+  unsigned int lNbOfDisorders = 0;
+  std::string lRecord;
+  while (lNbOfPoppedRecords != lNbOfRecords) {
+    if (lRingBuffer.pop (lRecord) == false) {
+      boost::this_thread::yield();
+      continue;
+    }
+    ++lNbOfPoppedRecords;
+
+    std::istringstream lRecordStr (lRecord);
+    unsigned short lProducerIdx = 0;
+    unsigned int lRecordIdx = 0;
+    lRecordStr >> lProducerIdx >> lRecordIdx;
+    BOOST_REQUIRE (lProducerIdx < X_NB_OF_THREADS);
+    if (lRecordIdx != lNextRecordList[lProducerIdx]) {
+      ++lNbOfDisorders;
+    }
+    lNextRecordList[lProducerIdx] = lRecordIdx + 1;
+  }
+  lThreadGroup.join_all();
+
+  BOOST_CHECK_MESSAGE (lNbOfDisorders == 0,
+                       lNbOfDisorders << " log records have been popped out"
+                       << " of the order in which they were pushed.");
+  BOOST_CHECK_MESSAGE (lRingBuffer.pop (lRecord) == false,
+                       "The ring buffer still holds log records.");
+}
+
+/**
+ * Check that a full ring buffer neither gives room to nor alters the
+ * record to be pushed
+ */
+BOOST_AUTO_TEST_CASE (opentrep_log_ring_buffer_full) {
+
+  OPENTREP::LogRingBuffer lRingBuffer (2);
+  std::string lRecord;
+  for (unsigned short idx = 0; idx != lRingBuffer.getCapacity(); ++idx) {
+    lRecord = "record";
+    BOOST_CHECK (lRingBuffer.push (lRecord) == true);
+    BOOST_CHECK (lRecord.empty() == true);
+  }
+
+  lRecord = "overflowing record";
+  BOOST_CHECK (lRingBuffer.push (lRecord) == false);
+  BOOST_CHECK_EQUAL (lRecord, "overflowing record");
+
+  // Once a record has been popped, there is room again
+  std::string lPoppedRecord;
+  BOOST_CHECK (lRingBuffer.pop (lPoppedRecord) == true);
+  BOOST_CHECK_EQUAL (lPoppedRecord, "record");
+  BOOST_CHECK (lRingBuffer.push (lRecord) == true);
+}
+
+/**
+ * Check the default overflow policy of the asynchronous logger: while the
+ * log stream holds the writer, the log entries which do not find room in
+ * the ring buffer are dropped and counted, without the issuing thread
+ * waiting. Every log entry is then either written or counted as dropped,
+ * and the drops are reported within the logs
+ */
+BOOST_AUTO_TEST_CASE (opentrep_log_overflow_policy) {
+
+  GatedStreamBuffer lStreamBuffer;
+  std::ostream lLogStream (&lStreamBuffer);
+
+  OPENTREP::Logger& lLogger = OPENTREP::Logger::instance();
+  lLogger.setLogParameters (OPENTREP::LOG::DEBUG, lLogStream);
+  lLogger.startAsyncWriter (X_LOG_BUFFER_SIZE, OPENTREP::LOG::DROP_RECORDS);
+  const OPENTREP::NbOfLogRecords_T lNbOfFormerDroppedRecords =
+    lLogger.getNbOfDroppedRecords();
+
+  /**
+   * The writer may take a single batch out of the ring buffer, before
+   * being held by the log stream. At most, the ring buffer and that
+   * batch are therefore filled, and the other log entries are dropped.
+   */
+  const OPENTREP::NbOfLogRecords_T lNbOfRecords = X_LOG_BUFFER_SIZE
+    + OPENTREP::K_LOG_WRITER_BATCH_SIZE + X_NB_OF_OVERFLOWING_RECORDS;
+  for (OPENTREP::NbOfLogRecords_T idx = 0; idx != lNbOfRecords; ++idx) {
+    OPENTREP_LOG_ERROR ("Log record #" << idx);
+  }
+  const OPENTREP::NbOfLogRecords_T lNbOfDroppedRecords =
+    lLogger.getNbOfDroppedRecords() - lNbOfFormerDroppedRecords;
+  BOOST_CHECK_MESSAGE (lNbOfDroppedRecords >= X_NB_OF_OVERFLOWING_RECORDS,
+                       "Only " << lNbOfDroppedRecords << " log records have"
+                       << " been dropped, whereas at least "
+                       << X_NB_OF_OVERFLOWING_RECORDS << " are expected.");
+
+  // Let the writer go on, and write the pending log entries
+  lStreamBuffer.open();
+  lLogger.stopAsyncWriter();
+  lLogger.setLogParameters (OPENTREP::LOG::DEBUG, std::cout);
+
+  // Count the written log entries and the reports of the dropped ones
+  std::istringstream lContentStr (lStreamBuffer.getContent());
+  OPENTREP::NbOfLogRecords_T lNbOfWrittenRecords = 0;
+  unsigned int lNbOfDropReports = 0;
+  std::string lLine;
+  while (std::getline (lContentStr, lLine)) {
+    if (lLine.find ("Log record #") != std::string::npos) {
+      ++lNbOfWrittenRecords;
+    } else if (lLine.find ("have been dropped") != std::string::npos) {
+      ++lNbOfDropReports;
+    }
+  }
+
+  BOOST_CHECK_MESSAGE (lNbOfWrittenRecords + lNbOfDroppedRecords
+                       == lNbOfRecords,
+                       lNbOfWrittenRecords << " log records have been"
+                       << " written and " << lNbOfDroppedRecords
+                       << " dropped, whereas " << lNbOfRecords
+                       << " have been issued.");
+  BOOST_CHECK_MESSAGE (lNbOfDropReports != 0,
+                       "The dropped log records have not been reported.");
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
+
+/*!
+ * \endcode
+ */
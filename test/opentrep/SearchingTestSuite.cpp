@@ -9,6 +9,10 @@
 #include <sstream>
 #include <fstream>
 #include <string>
+#include <vector>
+// Boost
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 // Boost Unit Test Framework (UTF)
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
@@ -53,6 +57,117 @@ const std::string X_XAPIAN_DB_FP ("/tmp/opentrep/test_traveldb");
  */
 const std::string X_SQL_DB_STR ("");
 
+/**
+ * Number of threads sharing the same service instance.
+ */
+const unsigned short X_NB_OF_THREADS (8);
+
+/**
+ * Number of times every thread goes through the list of travel queries.
+ */
+const unsigned short X_NB_OF_ROUNDS (10);
+
+
+// //////////// Helpers for the tests ///////////////
+/**
+ * Summarise the result of a travel query as a string, made of the keys
+ * of the matching locations and of the unmatched words.
+ */
+std::string describeResult (const OPENTREP::LocationList_T& iLocationList,
+                            const OPENTREP::WordList_T& iNonMatchedWordList) {
+  std::ostringstream oStr;
+  for (OPENTREP::LocationList_T::const_iterator itLocation =
+         iLocationList.begin(); itLocation != iLocationList.end();
+       ++itLocation) {
+    const OPENTREP::Location& lLocation = *itLocation;
+    oStr << lLocation.getKey().toString() << "; ";
+  }
+  oStr << "unmatched:";
+  for (OPENTREP::WordList_T::const_iterator itWord =
+         iNonMatchedWordList.begin(); itWord != iNonMatchedWordList.end();
+       ++itWord) {
+    oStr << " " << *itWord;
+  }
+  return oStr.str();
+}
+
+/**
+ * Thread hammering a (shared) service instance with travel queries, and
+ * checking that the results do not differ from the reference ones.
+ * As the Boost UTF assertions are not thread-safe, the discrepancies
+ * are only counted here, and checked once the threads are over.
+ */
+struct SearchWorker {
+  /** Constructor. */
+  SearchWorker (OPENTREP::OPENTREP_Service& ioService,
+                const std::vector<std::string>& iTravelQueryList,
+                const std::vector<std::string>& iReferenceList)
+    : _service (&ioService), _travelQueryList (&iTravelQueryList),
+      _referenceList (&iReferenceList), _nbOfMismatches (0),
+      _nbOfFailures (0) {
+  }
+
+  /** Thread entry point. */
+  void run() {
+    for (unsigned short idxRound = 0; idxRound != X_NB_OF_ROUNDS; ++idxRound) {
+      for (std::size_t idx = 0; idx != _travelQueryList->size(); ++idx) {
+        try {
+          OPENTREP::WordList_T lNonMatchedWordList;
+          OPENTREP::LocationList_T lLocationList;
+          _service->interpretTravelRequest ((*_travelQueryList)[idx],
+                                            lLocationList,
+                                            lNonMatchedWordList);
+          if (describeResult (lLocationList, lNonMatchedWordList)
+              != (*_referenceList)[idx]) {
+            ++_nbOfMismatches;
+          }
+
+        } catch (...) {
+          ++_nbOfFailures;
+        }
+      }
+    }
+  }
+
+  /** Service instance, shared by all the threads. */
+  OPENTREP::OPENTREP_Service* _service;
+  /** Travel queries. */
+  const std::vector<std::string>* _travelQueryList;
+  /** Reference results, as given by a single thread. */
+  const std::vector<std::string>* _referenceList;
+  /** Number of results differing from the reference ones. */
+  unsigned int _nbOfMismatches;
+  /** Number of queries having thrown an exception. */
+  unsigned int _nbOfFailures;
+};
+
+/**
+ * Context of a test case: a service instance, working on the Xapian index
+ * of the tests, without SQL database, and logging into its own log file.
+ */
+class SearchContext {
+public:
+  /** Constructor. */
+  SearchContext (const std::string& iLogFilename)
+    : _logOutputFile (iLogFilename.c_str()),
+      _service (_logOutputFile,
+                OPENTREP::TravelDBFilePath_T (X_XAPIAN_DB_FP),
+                OPENTREP::DBType (OPENTREP::DBType::NODB),
+                OPENTREP::SQLDBConnectionString_T (X_SQL_DB_STR)) {
+  }
+
+  /** Get the service instance. */
+  OPENTREP::OPENTREP_Service& getService() {
+    return _service;
+  }
+
+private:
+  /** Log file, opened (and cleaned) before the service is initialised,
+      and closed once the service is over. */
+  std::ofstream _logOutputFile;
+  /** Service instance. */
+  OPENTREP::OPENTREP_Service _service;
+};
 
 // /////////////// Main: Unit Test Suite //////////////
 
@@ -101,6 +216,451 @@ BOOST_AUTO_TEST_CASE (opentrep_simple_search) {
   logOutputFile.close();
 }
 
+/**
+ * Check that the default search (optimal string partition found by
+ * dynamic programming) gives the same results as the exhaustive search
+ * (going through all the string partitions)
+ */
+BOOST_AUTO_TEST_CASE (opentrep_exhaustive_search_comparison) {
+    
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_exhaustive.log");
+
+  // Travel queries
+  const std::string lTravelQueryArray[] = {
+    "sna francicso rio de janero", "lviv kiev kharkov",
+    "chelsea municipal airport", "san francisco rio de janeiro"
+  };
+  const unsigned short nbOfTravelQueries =
+    sizeof (lTravelQueryArray) / sizeof (lTravelQueryArray[0]);
+    
+  // Initialise the context, logging into its own log file
+  SearchContext lSearchContext (lLogFilename);
+  OPENTREP::OPENTREP_Service& opentrepService = lSearchContext.getService();
+
+  for (unsigned short idx = 0; idx != nbOfTravelQueries; ++idx) {
+    const std::string& lTravelQuery = lTravelQueryArray[idx];
+
+    // Query the Xapian database (index) with the default search
+    opentrepService.setExhaustiveSearch (false);
+    OPENTREP::WordList_T lNonMatchedWordList;
+    OPENTREP::LocationList_T lLocationList;
+    opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                            lNonMatchedWordList);
+
+    // Query the Xapian database (index) with the exhaustive search
+    opentrepService.setExhaustiveSearch (true);
+    OPENTREP::WordList_T lExhaustiveNonMatchedWordList;
+    OPENTREP::LocationList_T lExhaustiveLocationList;
+    opentrepService.interpretTravelRequest (lTravelQuery,
+                                            lExhaustiveLocationList,
+                                            lExhaustiveNonMatchedWordList);
+
+    // Compare the results
+    BOOST_REQUIRE_MESSAGE (lLocationList.size()
+                           == lExhaustiveLocationList.size(),
+                           "The travel query ('" << lTravelQuery
+                           << "') matches with " << lLocationList.size()
+                           << " locations, whereas the exhaustive search "
+                           << "gives " << lExhaustiveLocationList.size()
+                           << " locations.");
+
+    OPENTREP::LocationList_T::const_iterator itExhaustiveLocation =
+      lExhaustiveLocationList.begin();
+    for (OPENTREP::LocationList_T::const_iterator itLocation =
+           lLocationList.begin(); itLocation != lLocationList.end();
+         ++itLocation, ++itExhaustiveLocation) {
+      const OPENTREP::Location& lLocation = *itLocation;
+      const OPENTREP::Location& lExhaustiveLocation = *itExhaustiveLocation;
+      BOOST_CHECK_MESSAGE (lLocation.getKey() == lExhaustiveLocation.getKey(),
+                           "The travel query ('" << lTravelQuery
+                           << "') matches with "
+                           << lLocation.getKey().toString()
+                           << ", whereas the exhaustive search gives "
+                           << lExhaustiveLocation.getKey().toString());
+    }
+
+    BOOST_CHECK_MESSAGE (lNonMatchedWordList == lExhaustiveNonMatchedWordList,
+                         "The travel query ('" << lTravelQuery
+                         << "') does not give the same unmatched words "
+                         << "as the exhaustive search.");
+  }
+}
+
+/**
+ * Hammer a single service instance from several threads at the same
+ * time, and check that the results are the same as when the travel
+ * queries are performed one at a time
+ */
+BOOST_AUTO_TEST_CASE (opentrep_concurrent_search) {
+    
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_concurrent.log");
+
+  // Travel queries
+  const std::string lTravelQueryArray[] = {
+    "nce", "sna francicso rio de janero", "lviv kiev kharkov",
+    "chelsea municipal airport", "lso angles reykyavki nce iev mow"
+  };
+  const std::vector<std::string>
+    lTravelQueryList (lTravelQueryArray,
+                      lTravelQueryArray + sizeof (lTravelQueryArray)
+                      / sizeof (lTravelQueryArray[0]));
+    
+  // Initialise the context, logging into its own log file
+  SearchContext lSearchContext (lLogFilename);
+  OPENTREP::OPENTREP_Service& opentrepService = lSearchContext.getService();
+
+  // Reference results, with a single thread
+  std::vector<std::string> lReferenceList;
+  for (std::vector<std::string>::const_iterator itQuery =
+         lTravelQueryList.begin(); itQuery != lTravelQueryList.end();
+       ++itQuery) {
+    OPENTREP::WordList_T lNonMatchedWordList;
+    OPENTREP::LocationList_T lLocationList;
+    opentrepService.interpretTravelRequest (*itQuery, lLocationList,
+                                            lNonMatchedWordList);
+    lReferenceList.push_back (describeResult (lLocationList,
+                                              lNonMatchedWordList));
+  }
+
+  // Same travel queries, performed concurrently by several threads
+  std::vector<SearchWorker> lWorkerList (X_NB_OF_THREADS,
+                                         SearchWorker (opentrepService,
+                                                       lTravelQueryList,
+                                                       lReferenceList));
+  boost::thread_group lThreadGroup;
+  for (unsigned short idx = 0; idx != X_NB_OF_THREADS; ++idx) {
+    lThreadGroup.create_thread (boost::bind (&SearchWorker::run,
+                                             &lWorkerList[idx]));
+  }
+  lThreadGroup.join_all();
+
+  // Check the results of every thread
+  for (unsigned short idx = 0; idx != X_NB_OF_THREADS; ++idx) {
+    const SearchWorker& lWorker = lWorkerList[idx];
+    BOOST_CHECK_MESSAGE (lWorker._nbOfFailures == 0,
+                         "Thread #" << idx << ": " << lWorker._nbOfFailures
+                         << " travel queries have failed.");
+    BOOST_CHECK_MESSAGE (lWorker._nbOfMismatches == 0,
+                         "Thread #" << idx << ": " << lWorker._nbOfMismatches
+                         << " travel queries give other results than"
+                         << " when performed one at a time.");
+  }
+}
+
+/**
+ * Check that the results of the travel queries do not depend on the number
+ * of the search threads, on which the query slices are searched for
+ */
+BOOST_AUTO_TEST_CASE (opentrep_parallel_slice_search) {
+    
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_parallel.log");
+
+  // Travel queries
+  const std::string lTravelQueryArray[] = {
+    "sna francicso rio de janero lso angles reykyavki nce iev mow",
+    "lviv kiev kharkov", "chelsea municipal airport"
+  };
+  const unsigned short nbOfTravelQueries =
+    sizeof (lTravelQueryArray) / sizeof (lTravelQueryArray[0]);
+    
+  // Initialise the context, logging into its own log file
+  SearchContext lSearchContext (lLogFilename);
+  OPENTREP::OPENTREP_Service& opentrepService = lSearchContext.getService();
+
+  for (unsigned short idx = 0; idx != nbOfTravelQueries; ++idx) {
+    const std::string& lTravelQuery = lTravelQueryArray[idx];
+
+    // Query the Xapian database (index) within the calling thread only
+    opentrepService.setNbOfSearchThreads (0);
+    OPENTREP::WordList_T lNonMatchedWordList;
+    OPENTREP::LocationList_T lLocationList;
+    opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                            lNonMatchedWordList);
+    const std::string& lSequentialResult =
+      describeResult (lLocationList, lNonMatchedWordList);
+
+    // Query the Xapian database (index) on a pool of search threads
+    opentrepService.setNbOfSearchThreads (X_NB_OF_THREADS);
+    OPENTREP::WordList_T lParallelNonMatchedWordList;
+    OPENTREP::LocationList_T lParallelLocationList;
+    opentrepService.interpretTravelRequest (lTravelQuery,
+                                            lParallelLocationList,
+                                            lParallelNonMatchedWordList);
+    const std::string& lParallelResult =
+      describeResult (lParallelLocationList, lParallelNonMatchedWordList);
+
+    // Compare the results
+    BOOST_CHECK_MESSAGE (lSequentialResult == lParallelResult,
+                         "The travel query ('" << lTravelQuery
+                         << "') gives '" << lParallelResult
+                         << "' on the search threads, whereas it gives '"
+                         << lSequentialResult << "' within a single thread.");
+  }
+}
+
+/**
+ * Check that the results found within the cache are the same as the ones
+ * of the (first) interpretation of the travel queries
+ */
+BOOST_AUTO_TEST_CASE (opentrep_result_cache) {
+    
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_cache.log");
+
+  // Travel queries
+  const std::string lTravelQueryArray[] = {
+    "sna francicso rio de janero", "lviv kiev kharkov", "nce"
+  };
+  const unsigned short nbOfTravelQueries =
+    sizeof (lTravelQueryArray) / sizeof (lTravelQueryArray[0]);
+    
+  // Initialise the context, logging into its own log file
+  SearchContext lSearchContext (lLogFilename);
+  OPENTREP::OPENTREP_Service& opentrepService = lSearchContext.getService();
+  opentrepService.setResultCacheSize (1024 * 1024);
+
+  for (unsigned short idx = 0; idx != nbOfTravelQueries; ++idx) {
+    const std::string& lTravelQuery = lTravelQueryArray[idx];
+
+    // First interpretation of the travel query, stored within the cache
+    OPENTREP::WordList_T lNonMatchedWordList;
+    OPENTREP::LocationList_T lLocationList;
+    opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                            lNonMatchedWordList);
+    const std::string& lFirstResult =
+      describeResult (lLocationList, lNonMatchedWordList);
+
+    // Same travel query, the results of which are found within the cache
+    OPENTREP::WordList_T lCachedNonMatchedWordList;
+    OPENTREP::LocationList_T lCachedLocationList;
+    opentrepService.interpretTravelRequest (lTravelQuery, lCachedLocationList,
+                                            lCachedNonMatchedWordList);
+    const std::string& lCachedResult =
+      describeResult (lCachedLocationList, lCachedNonMatchedWordList);
+
+    // Compare the results
+    BOOST_CHECK_MESSAGE (lFirstResult == lCachedResult,
+                         "The travel query ('" << lTravelQuery
+                         << "') gives '" << lCachedResult
+                         << "' from the cache, whereas it gives '"
+                         << lFirstResult << "' when interpreted.");
+  }
+
+  // Every travel query has been interpreted once, and found once
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfResultCacheMisses(),
+                     nbOfTravelQueries);
+  BOOST_CHECK_EQUAL (opentrepService.getNbOfResultCacheHits(),
+                     nbOfTravelQueries);
+}
+
+/**
+ * Check that the travel queries made only of codes are answered by the
+ * in-memory index of the POR by code, even without SQL database
+ */
+BOOST_AUTO_TEST_CASE (opentrep_code_search) {
+    
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_codes.log");
+
+  // Travel query, made of a IATA code, a ICAO code and a Geonames ID
+  std::string lTravelQuery ("sfo lfmn 5391959");
+    
+  // Initialise the context, logging into its own log file
+  SearchContext lSearchContext (lLogFilename);
+  OPENTREP::OPENTREP_Service& opentrepService = lSearchContext.getService();
+  
+  // Query the in-memory index of the POR by code
+  OPENTREP::WordList_T lNonMatchedWordList;
+  OPENTREP::LocationList_T lLocationList;
+  const OPENTREP::NbOfMatches_T nbOfMatches =
+    opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                            lNonMatchedWordList);
+  BOOST_REQUIRE_MESSAGE (nbOfMatches == 3,
+                         "The travel query ('" << lTravelQuery
+                         << "') matches with " << nbOfMatches
+                         << " locations, whereas 3 are expected.");
+
+  // SFO (IATA code), NCE (LFMN ICAO code) and SFO (Geonames ID of the city)
+  const std::string lExpectedIataCodeArray[] = { "SFO", "NCE", "SFO" };
+  unsigned short idx = 0;
+  for (OPENTREP::LocationList_T::const_iterator itLocation =
+         lLocationList.begin(); itLocation != lLocationList.end();
+       ++itLocation, ++idx) {
+    const OPENTREP::Location& lLocation = *itLocation;
+    const std::string lIataCode (lLocation.getIataCode());
+    BOOST_CHECK_MESSAGE (lIataCode == lExpectedIataCodeArray[idx],
+                         "The location #" << idx << " has got '" << lIataCode
+                         << "' as IATA code, whereas '"
+                         << lExpectedIataCodeArray[idx] << "' is expected.");
+  }
+}
+
+/**
+ * Check that the filtering of the POR (points of reference), on their
+ * envelope ID and on their validity period, is applied to the travel
+ * queries.
+ */
+BOOST_AUTO_TEST_CASE (opentrep_validity_filtering) {
+    
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_validity.log");
+
+  // Travel query, made of names and of codes
+  const std::string lTravelQuery ("rio de janeiro sfo lfmn");
+    
+  // Initialise the context, logging into its own log file
+  SearchContext lSearchContext (lLogFilename);
+  OPENTREP::OPENTREP_Service& opentrepService = lSearchContext.getService();
+
+  // Interpretation without any filtering
+  OPENTREP::WordList_T lNonMatchedWordList;
+  OPENTREP::LocationList_T lLocationList;
+  opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                          lNonMatchedWordList);
+  const std::string& lResult =
+    describeResult (lLocationList, lNonMatchedWordList);
+  BOOST_REQUIRE_MESSAGE (lLocationList.empty() == false,
+                         "The travel query ('" << lTravelQuery
+                         << "') does not match with any location.");
+
+  // None of the test POR has expired, and all of them are valid today
+  opentrepService.setExpiredPORFiltering (true);
+  opentrepService.setValidityDate (boost::gregorian::day_clock::local_day());
+
+  OPENTREP::WordList_T lValidNonMatchedWordList;
+  OPENTREP::LocationList_T lValidLocationList;
+  opentrepService.interpretTravelRequest (lTravelQuery, lValidLocationList,
+                                          lValidNonMatchedWordList);
+  const std::string& lValidResult =
+    describeResult (lValidLocationList, lValidNonMatchedWordList);
+  BOOST_CHECK_MESSAGE (lValidResult == lResult,
+                       "The travel query ('" << lTravelQuery
+                       << "') gives '" << lValidResult
+                       << "' with the filtering of the POR, whereas it gives '"
+                       << lResult << "' without.");
+
+  // By default, the validity period of the POR ends on 2999-12-31
+  opentrepService.setValidityDate (OPENTREP::Date_T (3000, 1, 1));
+
+  OPENTREP::WordList_T lFutureNonMatchedWordList;
+  OPENTREP::LocationList_T lFutureLocationList;
+  opentrepService.interpretTravelRequest (lTravelQuery, lFutureLocationList,
+                                          lFutureNonMatchedWordList);
+  BOOST_CHECK_MESSAGE (lFutureLocationList.empty() == true,
+                       "The travel query ('" << lTravelQuery
+                       << "') matches with " << lFutureLocationList.size()
+                       << " locations valid in the year 3000, whereas none "
+                       << "is expected.");
+}
+
+/**
+ * Check that the stages of the search of a travel query are timed and
+ * counted, and that the statistics may be dumped for Prometheus
+ */
+BOOST_AUTO_TEST_CASE (opentrep_search_statistics) {
+    
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_statistics.log");
+
+  // Travel query, with a misspelling
+  std::string lTravelQuery ("sna francicso rio de janero");
+    
+  // Initialise the context, logging into its own log file
+  SearchContext lSearchContext (lLogFilename);
+  OPENTREP::OPENTREP_Service& opentrepService = lSearchContext.getService();
+  opentrepService.resetStatistics();
+
+  OPENTREP::WordList_T lNonMatchedWordList;
+  OPENTREP::LocationList_T lLocationList;
+  opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                          lNonMatchedWordList);
+
+  const OPENTREP::SearchStatistics& lStatistics =
+    opentrepService.getStatistics();
+  BOOST_CHECK_EQUAL (lStatistics.getCounter (OPENTREP::SearchCounter::
+                                             TRAVEL_QUERIES), 1);
+  const OPENTREP::LatencySummary& lQuerySummary =
+    lStatistics.getLatencySummary (OPENTREP::SearchStage::TRAVEL_QUERY);
+  BOOST_CHECK_EQUAL (lQuerySummary._count, 1);
+  BOOST_CHECK (lQuerySummary._p50 <= lQuerySummary._max);
+
+  // Every travel query goes through the normalisation, the slicing and
+  // the full-text matches
+  const OPENTREP::SearchStage::EN_SearchStage lStageArray[] = {
+    OPENTREP::SearchStage::NORMALISATION, OPENTREP::SearchStage::SLICING,
+    OPENTREP::SearchStage::FULL_TEXT_MATCHING
+  };
+  for (unsigned short idx = 0; idx != 3; ++idx) {
+    const OPENTREP::SearchStage::EN_SearchStage lStage = lStageArray[idx];
+    BOOST_CHECK_MESSAGE (lStatistics.getLatencySummary (lStage)._count != 0,
+                         "The '" << OPENTREP::SearchStage::getLabel (lStage)
+                         << "' stage has not been timed.");
+  }
+
+  const std::string& lPrometheusString = lStatistics.toPrometheusString();
+  const std::string lTravelQueryCounterStr ("opentrep_travel_queries_total 1");
+  BOOST_CHECK_MESSAGE (lPrometheusString.find (lTravelQueryCounterStr)
+                       != std::string::npos,
+                       "The Prometheus dump does not count the travel query: "
+                       << lPrometheusString);
+}
+
+/**
+ * Check that the search of a travel query may be explained, and that
+ * the explanation does not alter the results
+ */
+BOOST_AUTO_TEST_CASE (opentrep_search_explanation) {
+    
+  // Output log File
+  std::string lLogFilename ("SearchingTestSuite_explanation.log");
+
+  // Travel query, with misspellings
+  std::string lTravelQuery ("sna francicso rio de janero");
+    
+  // Initialise the context, logging into its own log file
+  SearchContext lSearchContext (lLogFilename);
+  OPENTREP::OPENTREP_Service& opentrepService = lSearchContext.getService();
+
+  // Reference results, without any explanation
+  OPENTREP::WordList_T lNonMatchedWordList;
+  OPENTREP::LocationList_T lLocationList;
+  opentrepService.interpretTravelRequest (lTravelQuery, lLocationList,
+                                          lNonMatchedWordList);
+  const std::string& lReference =
+    describeResult (lLocationList, lNonMatchedWordList);
+
+  // Same search, explained
+  OPENTREP::WordList_T lExplainedNonMatchedWordList;
+  OPENTREP::LocationList_T lExplainedLocationList;
+  OPENTREP::SearchExplanation lExplanation;
+  opentrepService.interpretTravelRequest (lTravelQuery, lExplainedLocationList,
+                                          lExplainedNonMatchedWordList,
+                                          lExplanation);
+  const std::string& lExplainedResult =
+    describeResult (lExplainedLocationList, lExplainedNonMatchedWordList);
+  BOOST_CHECK_EQUAL (lExplainedResult, lReference);
+
+  // Every slice has been searched for, and its partitions traced
+  const OPENTREP::SliceExplanationList_T& lSliceList =
+    lExplanation.getSliceList();
+  BOOST_CHECK (lSliceList.empty() == false);
+  for (OPENTREP::SliceExplanationList_T::const_iterator itSlice =
+         lSliceList.begin(); itSlice != lSliceList.end(); ++itSlice) {
+    const OPENTREP::SliceExplanation& lSlice = *itSlice;
+    BOOST_CHECK_MESSAGE (lSlice._wordCombinationList.empty() == false
+                         && lSlice._partitionList.empty() == false,
+                         "The search of the '" << lSlice._querySlice
+                         << "' slice has not been explained.");
+  }
+
+  // The explanation may be exported in JSON
+  const std::string& lJSONString = lExplanation.toJSONString();
+  BOOST_CHECK (lJSONString.find ("\"chosen_partition\"") != std::string::npos);
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
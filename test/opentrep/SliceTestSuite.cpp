@@ -21,6 +21,8 @@
 // OpenTrep
 #include <opentrep/basic/OTransliterator.hpp>
 #include <opentrep/bom/QuerySlices.hpp>
+#include <opentrep/bom/WordPairTable.hpp>
+#include <opentrep/basic/BasConst_General.hpp>
 #include <opentrep/basic/BasConst_OPENTREP_Service.hpp>
 #include <opentrep/OPENTREP_Service.hpp>
 #include <opentrep/service/Logger.hpp>
@@ -145,6 +147,117 @@ BOOST_AUTO_TEST_CASE (slice_small_string) {
   logOutputFile.close();
 }
 
+/**
+ * Test that the table of the adjacent word pairs, built along with the
+ * Xapian index, gives the same slices as the Xapian index itself
+ */
+BOOST_AUTO_TEST_CASE (slice_with_word_pair_table) {
+
+  // Output log File
+  const std::string lLogFilename ("SliceTestSuite_wordPairs.log");
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Initialise the context
+  const OPENTREP::TravelDBFilePath_T lTravelDBFilePath (X_XAPIAN_DB_FP);
+  const OPENTREP::DBType lDBType (OPENTREP::DBType::NODB);
+  const OPENTREP::SQLDBConnectionString_T lSQLDBConnStr (X_SQL_DB_STR);
+  OPENTREP::OPENTREP_Service opentrepService (logOutputFile, lTravelDBFilePath,
+                                              lDBType, lSQLDBConnStr);
+
+  // Load the table of the adjacent word pairs, stored beside the index
+  const boost::filesystem::path lWordPairTableFilePath =
+    boost::filesystem::path (X_XAPIAN_DB_FP)
+    / OPENTREP::K_WORD_PAIR_TABLE_FILENAME;
+  OPENTREP::WordPairTable lWordPairTable;
+  const bool hasBeenLoaded =
+    lWordPairTable.load (lWordPairTableFilePath.string());
+  BOOST_REQUIRE_MESSAGE (hasBeenLoaded == true,
+                         "The table of the word pairs ('"
+                         << lWordPairTableFilePath.string()
+                         << "') cannot be read.");
+
+  // DEBUG
+  OPENTREP_LOG_DEBUG (lWordPairTable.describe());
+
+  // Open the Xapian database
+  Xapian::Database lXapianDatabase (lTravelDBFilePath);
+
+  // Create a Unicode transliterator
+  const OPENTREP::OTransliterator lTransliterator;
+
+  // A few sample strings
+  std::list<std::string> lQueryList;
+  lQueryList.push_back ("los angeles");
+  lQueryList.push_back ("lviv kiev kharkov");
+  lQueryList.push_back ("san francisco rio de janeiro");
+  lQueryList.push_back ("chelsea municipal airport");
+
+  for (std::list<std::string>::const_iterator itQuery = lQueryList.begin();
+       itQuery != lQueryList.end(); ++itQuery) {
+    const std::string& lQuery = *itQuery;
+
+    // Create the query slices, with and without the table
+    const OPENTREP::QuerySlices lXapianQuerySlices (lXapianDatabase, lQuery,
+                                                    lTransliterator);
+    const OPENTREP::QuerySlices lTableQuerySlices (lXapianDatabase, lQuery,
+                                                   lTransliterator,
+                                                   &lWordPairTable, NULL);
+
+    // DEBUG
+    OPENTREP_LOG_DEBUG (lTableQuerySlices.size() << " slices: "
+                        << lTableQuerySlices.describe());
+
+    //
+    BOOST_CHECK_MESSAGE (lTableQuerySlices.describe()
+                         == lXapianQuerySlices.describe(),
+                         "The query ('" << lQuery << "') should be cut in "
+                         << "the same slices with the table of the word pairs ("
+                         << lTableQuerySlices.describe() << ") as with the "
+                         << "Xapian index (" << lXapianQuerySlices.describe()
+                         << ").");
+  }
+
+  // Close the Log outputFile
+  logOutputFile.close();
+}
+
+/**
+ * Test that the table of the adjacent word pairs folds the case of the
+ * non-ASCII letters, both for the indexed words and for the queried ones
+ */
+BOOST_AUTO_TEST_CASE (word_pair_table_unicode_case) {
+
+  // A few indexed names, with non-ASCII capitals
+  OPENTREP::WordPairTable lWordPairTable;
+  OPENTREP::WordList_T lWordList;
+  lWordList.push_back ("Москва");
+  lWordList.push_back ("Россия");
+  lWordPairTable.addWordList (lWordList);
+  lWordList.clear();
+  lWordList.push_back ("Île");
+  lWordList.push_back ("de");
+  lWordList.push_back ("France");
+  lWordPairTable.addWordList (lWordList);
+  lWordPairTable.sort();
+  BOOST_CHECK_EQUAL (lWordPairTable.size(), 3);
+
+  // The pairs are found whatever the case of the queried words
+  BOOST_CHECK (lWordPairTable.contains ("Москва", "Россия") == true);
+  BOOST_CHECK (lWordPairTable.contains ("москва", "РОССИЯ") == true);
+  BOOST_CHECK (lWordPairTable.contains ("île", "de") == true);
+  BOOST_CHECK (lWordPairTable.contains ("ÎLE", "DE") == true);
+  BOOST_CHECK (lWordPairTable.contains ("de", "france") == true);
+
+  // The words must still be adjacent, and in the same order
+  BOOST_CHECK (lWordPairTable.contains ("Île", "France") == false);
+  BOOST_CHECK (lWordPairTable.contains ("Россия", "Москва") == false);
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 